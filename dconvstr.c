@@ -36,9 +36,16 @@
    typedef unsigned char     uint8_t;
    typedef __int32           int32_t;
    typedef unsigned __int32  uint32_t;
+   typedef __int64           int64_t;
    typedef unsigned __int64  uint64_t;
 #endif
 
+// Binary formats with wide mantissa (x87 extended precision and IEEE 754 quadruple precision)
+// share tables of powers of ten with 192-bit mantissas and conversion functions
+#if defined(DCONVSTR_HAVE_LONG_DOUBLE_X87) || defined(DCONVSTR_HAVE_FLOAT128)
+#  define DCONVSTR_HAVE_WIDE_BINARY  1
+#endif
+
 
 //=====================================================================================================
 //
@@ -48,9 +55,47 @@
 // 10^18 constant
 #define POW10_18  ((1000ULL * 1000ULL * 1000ULL) * (1000ULL * 1000ULL * 1000ULL))
 
+// 10^19 constant
+#define POW10_19  (10ULL * POW10_18)
+
 // Double-to-string parser states
 enum  parser_state { S0, S1, S2, S3, S4, S5, S6, S7 };
 
+// Counters of internal code paths (dconvstr_stats_snapshot), kept per thread
+// if this file is compiled with -DDCONVSTR_ENABLE_STATS, and compiled out otherwise
+#ifdef DCONVSTR_ENABLE_STATS
+#  ifdef _MSC_VER
+#    define DCONVSTR_THREAD_LOCAL  __declspec(thread)
+#  else
+#    define DCONVSTR_THREAD_LOCAL  __thread
+#  endif
+static DCONVSTR_THREAD_LOCAL struct dconvstr_stats  stats_;
+#  define DCONVSTR_STATS_INCREMENT( counter )  ( ++stats_.counter )
+#else
+#  define DCONVSTR_STATS_INCREMENT( counter )  ((void) 0)
+#endif
+
+// Static tracepoints (USDT probes of provider "dconvstr") at entry and exit of dconvstr_print
+// and dconvstr_scan, if this file is compiled with -DDCONVSTR_ENABLE_PROBES and sys/sdt.h
+// from SystemTap is available. Probe sites are no-op instructions until a tracer attaches to them.
+#ifdef DCONVSTR_ENABLE_PROBES
+#  include <sys/sdt.h>
+#  define DCONVSTR_PROBE1( name, a1 )              DTRACE_PROBE1( dconvstr, name, a1 )
+#  define DCONVSTR_PROBE3( name, a1, a2, a3 )      DTRACE_PROBE3( dconvstr, name, a1, a2, a3 )
+#  define DCONVSTR_PROBE4( name, a1, a2, a3, a4 )  DTRACE_PROBE4( dconvstr, name, a1, a2, a3, a4 )
+#else
+#  define DCONVSTR_PROBE1( name, a1 )              ((void) 0)
+#  define DCONVSTR_PROBE3( name, a1, a2, a3 )      ((void) 0)
+#  define DCONVSTR_PROBE4( name, a1, a2, a3, a4 )  ((void) 0)
+#endif
+
+// Tables of powers of ten and powers of two. Both tables are produced by dconvstr_tablegen.c,
+// which can also emit tables with other ranges; such tables are used instead of built-in ones
+// if this file is compiled with -DDCONVSTR_TABLES_FILE='"file_name.inc"'.
+#ifdef DCONVSTR_TABLES_FILE
+#  include DCONVSTR_TABLES_FILE
+#else
+
 // Table: powers of ten in binary representation.
 // 10^decimal_exponent ~= binary_mantissa * 2^binary_exponent.
 // 2^63 < binary_mantissa < 2^64, mantissa has been rounded to nearest integer.
@@ -1448,6 +1493,471 @@ static const struct power_of_two  powers_of_two_[] = {
     {   962,  290,   7190772539449263631ULL },    {   963,  290,  14381545078898527262ULL }
 };
 
+#endif // DCONVSTR_TABLES_FILE
+
+// Table of powers of ten for IEEE 754 single precision conversions (dconvstr_print_float,
+// dconvstr_scan_float), produced by dconvstr_tablegen --only=ten --ten=-66:64 --suffix=float
+// Table: powers of ten in binary representation.
+// 10^decimal_exponent ~= binary_mantissa * 2^binary_exponent.
+// 2^63 < binary_mantissa < 2^64, mantissa has been rounded to nearest integer.
+// Covers range of decimal exponents from -66 to 64.
+static const struct power_of_ten  powers_of_ten_float_[] = {
+    { -66, -283,  15541351137805832567ULL },    { -65, -279,   9713344461128645355ULL },
+    { -64, -276,  12141680576410806693ULL },    { -63, -273,  15177100720513508367ULL },
+    { -62, -269,   9485687950320942729ULL },    { -61, -266,  11857109937901178411ULL },
+    { -60, -263,  14821387422376473014ULL },    { -59, -259,   9263367138985295634ULL },
+    { -58, -256,  11579208923731619542ULL },    { -57, -253,  14474011154664524428ULL },
+    { -56, -250,  18092513943330655535ULL },    { -55, -246,  11307821214581659709ULL },
+    { -54, -243,  14134776518227074637ULL },    { -53, -240,  17668470647783843296ULL },
+    { -52, -236,  11042794154864902060ULL },    { -51, -233,  13803492693581127575ULL },
+    { -50, -230,  17254365866976409469ULL },    { -49, -226,  10783978666860255918ULL },
+    { -48, -223,  13479973333575319897ULL },    { -47, -220,  16849966666969149872ULL },
+    { -46, -216,  10531229166855718670ULL },    { -45, -213,  13164036458569648337ULL },
+    { -44, -210,  16455045573212060422ULL },    { -43, -206,  10284403483257537763ULL },
+    { -42, -203,  12855504354071922204ULL },    { -41, -200,  16069380442589902755ULL },
+    { -40, -196,  10043362776618689222ULL },    { -39, -193,  12554203470773361528ULL },
+    { -38, -190,  15692754338466701910ULL },    { -37, -186,   9807971461541688693ULL },
+    { -36, -183,  12259964326927110867ULL },    { -35, -180,  15324955408658888584ULL },
+    { -34, -176,   9578097130411805365ULL },    { -33, -173,  11972621413014756706ULL },
+    { -32, -170,  14965776766268445882ULL },    { -31, -166,   9353610478917778677ULL },
+    { -30, -163,  11692013098647223346ULL },    { -29, -160,  14615016373309029182ULL },
+    { -28, -157,  18268770466636286478ULL },    { -27, -153,  11417981541647679048ULL },
+    { -26, -150,  14272476927059598811ULL },    { -25, -147,  17840596158824498513ULL },
+    { -24, -143,  11150372599265311571ULL },    { -23, -140,  13937965749081639463ULL },
+    { -22, -137,  17422457186352049329ULL },    { -21, -133,  10889035741470030831ULL },
+    { -20, -130,  13611294676837538539ULL },    { -19, -127,  17014118346046923173ULL },
+    { -18, -123,  10633823966279326983ULL },    { -17, -120,  13292279957849158729ULL },
+    { -16, -117,  16615349947311448411ULL },    { -15, -113,  10384593717069655257ULL },
+    { -14, -110,  12980742146337069071ULL },    { -13, -107,  16225927682921336339ULL },
+    { -12, -103,  10141204801825835212ULL },    { -11, -100,  12676506002282294015ULL },
+    { -10,  -97,  15845632502852867519ULL },    {  -9,  -93,   9903520314283042199ULL },
+    {  -8,  -90,  12379400392853802749ULL },    {  -7,  -87,  15474250491067253436ULL },
+    {  -6,  -83,   9671406556917033398ULL },    {  -5,  -80,  12089258196146291747ULL },
+    {  -4,  -77,  15111572745182864684ULL },    {  -3,  -73,   9444732965739290427ULL },
+    {  -2,  -70,  11805916207174113034ULL },    {  -1,  -67,  14757395258967641293ULL },
+    {   0,  -63,   9223372036854775808ULL },    {   1,  -60,  11529215046068469760ULL },
+    {   2,  -57,  14411518807585587200ULL },    {   3,  -54,  18014398509481984000ULL },
+    {   4,  -50,  11258999068426240000ULL },    {   5,  -47,  14073748835532800000ULL },
+    {   6,  -44,  17592186044416000000ULL },    {   7,  -40,  10995116277760000000ULL },
+    {   8,  -37,  13743895347200000000ULL },    {   9,  -34,  17179869184000000000ULL },
+    {  10,  -30,  10737418240000000000ULL },    {  11,  -27,  13421772800000000000ULL },
+    {  12,  -24,  16777216000000000000ULL },    {  13,  -20,  10485760000000000000ULL },
+    {  14,  -17,  13107200000000000000ULL },    {  15,  -14,  16384000000000000000ULL },
+    {  16,  -10,  10240000000000000000ULL },    {  17,   -7,  12800000000000000000ULL },
+    {  18,   -4,  16000000000000000000ULL },    {  19,    0,  10000000000000000000ULL },
+    {  20,    3,  12500000000000000000ULL },    {  21,    6,  15625000000000000000ULL },
+    {  22,   10,   9765625000000000000ULL },    {  23,   13,  12207031250000000000ULL },
+    {  24,   16,  15258789062500000000ULL },    {  25,   20,   9536743164062500000ULL },
+    {  26,   23,  11920928955078125000ULL },    {  27,   26,  14901161193847656250ULL },
+    {  28,   30,   9313225746154785156ULL },    {  29,   33,  11641532182693481445ULL },
+    {  30,   36,  14551915228366851807ULL },    {  31,   39,  18189894035458564758ULL },
+    {  32,   43,  11368683772161602974ULL },    {  33,   46,  14210854715202003717ULL },
+    {  34,   49,  17763568394002504647ULL },    {  35,   53,  11102230246251565404ULL },
+    {  36,   56,  13877787807814456755ULL },    {  37,   59,  17347234759768070944ULL },
+    {  38,   63,  10842021724855044340ULL },    {  39,   66,  13552527156068805425ULL },
+    {  40,   69,  16940658945086006781ULL },    {  41,   73,  10587911840678754238ULL },
+    {  42,   76,  13234889800848442798ULL },    {  43,   79,  16543612251060553497ULL },
+    {  44,   83,  10339757656912845936ULL },    {  45,   86,  12924697071141057420ULL },
+    {  46,   89,  16155871338926321775ULL },    {  47,   93,  10097419586828951109ULL },
+    {  48,   96,  12621774483536188887ULL },    {  49,   99,  15777218104420236108ULL },
+    {  50,  103,   9860761315262647568ULL },    {  51,  106,  12325951644078309460ULL },
+    {  52,  109,  15407439555097886824ULL },    {  53,  113,   9629649721936179265ULL },
+    {  54,  116,  12037062152420224082ULL },    {  55,  119,  15046327690525280102ULL },
+    {  56,  123,   9403954806578300064ULL },    {  57,  126,  11754943508222875080ULL },
+    {  58,  129,  14693679385278593850ULL },    {  59,  132,  18367099231598242312ULL },
+    {  60,  136,  11479437019748901445ULL },    {  61,  139,  14349296274686126806ULL },
+    {  62,  142,  17936620343357658508ULL },    {  63,  146,  11210387714598536567ULL },
+    {  64,  149,  14012984643248170709ULL }
+};
+
+#ifdef DCONVSTR_HAVE_WIDE_BINARY
+
+// Tables of powers of ten for conversions of binary formats with wide mantissa: x87 extended precision
+// and IEEE 754 quadruple precision. Power of ten 10^n is computed as product of two entries:
+// 10^(n - n mod 32) from the coarse table with 192-bit mantissas, and 10^(n mod 32) from the fine
+// table with 128-bit mantissas, which is exact.
+struct  power_of_ten_128
+{
+    int32_t   decimal_exponent;
+    int32_t   binary_exponent;
+    uint64_t  binary_mantissa_high;
+    uint64_t  binary_mantissa_low;
+};
+
+struct  power_of_ten_192
+{
+    int32_t   decimal_exponent;
+    int32_t   binary_exponent;
+    uint64_t  binary_mantissa_high;
+    uint64_t  binary_mantissa_middle;
+    uint64_t  binary_mantissa_low;
+};
+
+// Produced by dconvstr_tablegen --bits=128 --only=ten --ten=0:31 --suffix=wide_fine
+// Table: powers of ten in binary representation.
+// 10^decimal_exponent ~= binary_mantissa * 2^binary_exponent.
+// 2^127 < binary_mantissa < 2^128, mantissa has been rounded to nearest integer.
+// Covers range of decimal exponents from 0 to 31.
+static const struct power_of_ten_128  powers_of_ten_wide_fine_128_[] = {
+    {  0, -127,  0x8000000000000000ULL, 0x0000000000000000ULL },
+    {  1, -124,  0xA000000000000000ULL, 0x0000000000000000ULL },
+    {  2, -121,  0xC800000000000000ULL, 0x0000000000000000ULL },
+    {  3, -118,  0xFA00000000000000ULL, 0x0000000000000000ULL },
+    {  4, -114,  0x9C40000000000000ULL, 0x0000000000000000ULL },
+    {  5, -111,  0xC350000000000000ULL, 0x0000000000000000ULL },
+    {  6, -108,  0xF424000000000000ULL, 0x0000000000000000ULL },
+    {  7, -104,  0x9896800000000000ULL, 0x0000000000000000ULL },
+    {  8, -101,  0xBEBC200000000000ULL, 0x0000000000000000ULL },
+    {  9,  -98,  0xEE6B280000000000ULL, 0x0000000000000000ULL },
+    { 10,  -94,  0x9502F90000000000ULL, 0x0000000000000000ULL },
+    { 11,  -91,  0xBA43B74000000000ULL, 0x0000000000000000ULL },
+    { 12,  -88,  0xE8D4A51000000000ULL, 0x0000000000000000ULL },
+    { 13,  -84,  0x9184E72A00000000ULL, 0x0000000000000000ULL },
+    { 14,  -81,  0xB5E620F480000000ULL, 0x0000000000000000ULL },
+    { 15,  -78,  0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+    { 16,  -74,  0x8E1BC9BF04000000ULL, 0x0000000000000000ULL },
+    { 17,  -71,  0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+    { 18,  -68,  0xDE0B6B3A76400000ULL, 0x0000000000000000ULL },
+    { 19,  -64,  0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+    { 20,  -61,  0xAD78EBC5AC620000ULL, 0x0000000000000000ULL },
+    { 21,  -58,  0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+    { 22,  -54,  0x878678326EAC9000ULL, 0x0000000000000000ULL },
+    { 23,  -51,  0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+    { 24,  -48,  0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL },
+    { 25,  -44,  0x84595161401484A0ULL, 0x0000000000000000ULL },
+    { 26,  -41,  0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL },
+    { 27,  -38,  0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+    { 28,  -34,  0x813F3978F8940984ULL, 0x4000000000000000ULL },
+    { 29,  -31,  0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+    { 30,  -28,  0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL },
+    { 31,  -25,  0xFC6F7C4045812296ULL, 0x4D00000000000000ULL }
+};
+
+// Produced by dconvstr_tablegen --bits=192 --only=ten --ten=-5024:5055 --step=32 --suffix=wide_coarse
+// Table: powers of ten in binary representation.
+// 10^decimal_exponent ~= binary_mantissa * 2^binary_exponent.
+// 2^191 < binary_mantissa < 2^192, mantissa has been rounded to nearest integer.
+// Covers range of decimal exponents from -5024 to 5024 with step 32.
+static const struct power_of_ten_192  powers_of_ten_wide_coarse_192_[] = {
+    { -5024, -16881,  0xC6890560A980BD4EULL, 0x7187D0624136A30FULL, 0x2FE179C2AABB9590ULL },
+    { -4992, -16775,  0xF4B6ACD4DF2955B1ULL, 0xF27331DA557787ECULL, 0x13CFC7011B53A255ULL },
+    { -4960, -16668,  0x96D0FE91C0DFC76DULL, 0xF60BA283DB0DC635ULL, 0x666D1ED732E23F98ULL },
+    { -4928, -16562,  0xB9E5428330737362ULL, 0xBDDB2DFDE3F8A6E3ULL, 0x73A7380ABA84A6B2ULL },
+    { -4896, -16456,  0xE5224AA15F397D98ULL, 0x29608B2D0ACCDAC3ULL, 0x711C6B626C46BD8AULL },
+    { -4864, -16349,  0x8D36F6971766349CULL, 0xAC63454249B771C8ULL, 0x2BFB20990DEDB271ULL },
+    { -4832, -16243,  0xAE0F80A2A8960B10ULL, 0x7AEB29F92ABEB4CAULL, 0xEF6FA39D44EC7C03ULL },
+    { -4800, -16137,  0xD68BD3C92066A797ULL, 0x326CB526B3747638ULL, 0x6B6FF5A002416E72ULL },
+    { -4768, -16030,  0x84396C05C0EEBC9DULL, 0xFE110A64E32DD81BULL, 0x479ECC43D5CB00CFULL },
+    { -4736, -15924,  0xA2FAA242A3BD093CULL, 0xC62364C260A887E2ULL, 0x4C2692FFB4103A61ULL },
+    { -4704, -15818,  0xC8E31DE056F89C19ULL, 0x0915564D8AB057EEULL, 0x25B0419765FDFCDCULL },
+    { -4672, -15712,  0xF79CD0BC0A9865E1ULL, 0xA6246CC005E1B086ULL, 0xA4FBD971B7335438ULL },
+    { -4640, -15605,  0x989A5FA7953007A7ULL, 0x4574B3F93355188BULL, 0x8D631BD52C704337ULL },
+    { -4608, -15499,  0xBC1905F3E898CCA2ULL, 0x41A8BCD577F7A7D8ULL, 0x4A0AD081B987938AULL },
+    { -4576, -15393,  0xE7D92F014768E772ULL, 0x62EAE6F47049FC2FULL, 0x445A492626C350C5ULL },
+    { -4544, -15286,  0x8EE3393B07698E29ULL, 0x62648D93CDF05BA2ULL, 0xC17503760879F1D7ULL },
+    { -4512, -15180,  0xB01F5FC35203ED1BULL, 0x78E2AAD3DDD1E309ULL, 0x5BFA3F9E0731F956ULL },
+    { -4480, -15074,  0xD9167AB0C1965798ULL, 0xA8EDFFDCCFE4DB4BULL, 0xF290163350ECB3ECULL },
+    { -4448, -14967,  0x85CA6ACD9D3E7DAFULL, 0xDCF0FB000A652614ULL, 0x646DEF3E1B8DBCE6ULL },
+    { -4416, -14861,  0xA4E8E60BEEC08B8FULL, 0xD49596808F0F2914ULL, 0x890F060F9004CEDFULL },
+    { -4384, -14755,  0xCB44585821C722ECULL, 0xEC6EC617F2819A18ULL, 0x6489536309952136ULL },
+    { -4352, -14649,  0xFA8BBF517F29408AULL, 0x31C0368CCB2C5757ULL, 0x842DC41B89CA32C7ULL },
+    { -4320, -14542,  0x9A692BD43B368FC3ULL, 0x8389C148C919653AULL, 0xBB9EFF7A25C44471ULL },
+    { -4288, -14436,  0xBE53771CC8F1B8BBULL, 0x6C682809BA47FF0EULL, 0x57B5B173D643F3D4ULL },
+    { -4256, -14330,  0xEA984EC57DE69F13ULL, 0x66E849253E5DA0C2ULL, 0x18746FCC6A190DBAULL },
+    { -4224, -14223,  0x90948EA6C52E5802ULL, 0xD6960685C12CD7C1ULL, 0x9E48B99391902B01ULL },
+    { -4192, -14117,  0xB2357FC2D76029B7ULL, 0xAEAD36C237CBF749ULL, 0x02D3DA4742419C17ULL },
+    { -4160, -14011,  0xDBA8D6D20F6B5894ULL, 0xF0FC278B7F968212ULL, 0x39C70812FFDFD469ULL },
+    { -4128, -13904,  0x876029AD8859B2FDULL, 0x54ACA7F5709CB082ULL, 0x38BBB32AA29CBA1CULL },
+    { -4096, -13798,  0xA6DD04C8D2CE9FDEULL, 0x2DE38123A1C3CFFCULL, 0x20305D0244E091BAULL },
+    { -4064, -13692,  0xCDACCA69A2D4C45AULL, 0x96EDA1512F2FC323ULL, 0xD464C19AA11439B2ULL },
+    { -4032, -13586,  0xFD83933EDA772C0BULL, 0x5052E9289F0F2333ULL, 0x48324E275376DFDEULL },
+    { -4000, -13479,  0x9C3D73864F3805C0ULL, 0x24B99688D11E41BCULL, 0xF95DC6F12034F381ULL },
+    { -3968, -13373,  0xC094AA3EDDB202E4ULL, 0x1A096FC7358788C3ULL, 0x30A0EA226E12164CULL },
+    { -3936, -13267,  0xED5FC2E513417A2FULL, 0xBA641FE889DFD27BULL, 0xC28EE543E6934D16ULL },
+    { -3904, -13160,  0x924B063D1CEB45B3ULL, 0x1436A2DAD831490DULL, 0xBF3F2E0FFC99E3CCULL },
+    { -3872, -13054,  0xB451F3982A13E433ULL, 0x73E14BC8E5EDD724ULL, 0xED3EBB135BB7A7FEULL },
+    { -3840, -12948,  0xDE42FF8D37CAD87FULL, 0x1463EF488D5226CBULL, 0xB171E37A76C65372ULL },
+    { -3808, -12841,  0x88FAB70D8B44952AULL, 0x3F1F93F1943CA9B6ULL, 0x44A66A6D6FD6537BULL },
+    { -3776, -12735,  0xA8D7103B2A9FDDBFULL, 0x2409AC6534C33030ULL, 0x7FC103FC5525486DULL },
+    { -3744, -12629,  0xD01C89F80CD9E07EULL, 0x437ABD5769E5212FULL, 0x43EF9DA83AA68801ULL },
+    { -3712, -12522,  0x804233BF4B0B191CULL, 0x752CD52FAFAF4AF1ULL, 0xFA0C3128067E32AEULL },
+    { -3680, -12416,  0x9E17475E42D0BFACULL, 0x759A4EADDDC5DB0CULL, 0xF67E17045A0CF99BULL },
+    { -3648, -12310,  0xC2DCB3D89FB0F90EULL, 0x75AF8412A0D013FCULL, 0x80D0A82031A01240ULL },
+    { -3616, -12204,  0xF02FA4A2CE256606ULL, 0x7F437695D5CCDBE0ULL, 0x815F276911639E7BULL },
+    { -3584, -12097,  0x9406AF8F83FD6265ULL, 0x4B4DE34E0EBC3E06ULL, 0x45EFB05F20CF48B4ULL },
+    { -3552, -11991,  0xB674CE73BF10EA47ULL, 0x4FE1E9B0FCDF7B3DULL, 0x0F0FB1C7B2581A52ULL },
+    { -3520, -11885,  0xE0E50C894CC21DFDULL, 0x81884DD8CB5EB34AULL, 0x294D82F85639FB9CULL },
+    { -3488, -11778,  0x8A9A21815FAD9D9CULL, 0x576C105A49A6F1ADULL, 0x9A78F9DC1F575DAFULL },
+    { -3456, -11672,  0xAAD71A5AAB16DC6CULL, 0x5086FDECF2F641C6ULL, 0x6AD4B3205EB000B0ULL },
+    { -3424, -11566,  0xD293AD28F3512F42ULL, 0x09CD28999C147C35ULL, 0xF62EE38148951DCCULL },
+    { -3392, -11459,  0x81C72BAE7E65DAD8ULL, 0x5E580222F2F811AEULL, 0x6546F97A4C6298CEULL },
+    { -3360, -11353,  0x9FF6B82EF415D222ULL, 0x60DBD8AA443B560FULL, 0x7A466A75BE73DB21ULL },
+    { -3328, -11247,  0xC52BA8A6AEB15D92ULL, 0x9E98CB984F0D3050ULL, 0xA42303E570B87E7FULL },
+    { -3296, -11141,  0xF3080D8E10F7553FULL, 0x71E6A2E9BBBF5A4BULL, 0x0F34CEA9A11A2971ULL },
+    { -3264, -11034,  0x95C79A5EA669FE86ULL, 0x3615915D6DF7666FULL, 0xA0D0F971C37719E8ULL },
+    { -3232, -10928,  0xB89E23C03D3D9B7FULL, 0xF4D741C050AAA631ULL, 0xF9E0DA6255CDD977ULL },
+    { -3200, -10822,  0xE38F15B51B8440F7ULL, 0x31EA85E808DEBA7FULL, 0x3B735F721430E99EULL },
+    { -3168, -10715,  0x8C3E77C8F46D23BFULL, 0x7FEF20156B676076ULL, 0xBBC5732F8ACEE6ACULL },
+    { -3136, -10609,  0xACDD3555869159D1ULL, 0xEC41C1793D69D0D1ULL, 0x1C5AF3BD4D2C60B5ULL },
+    { -3104, -10503,  0xD5124A6513C582C0ULL, 0x4A1CCB32D5C21BF6ULL, 0x5624493713D5E9B7ULL },
+    { -3072, -10396,  0x8350BF3C91575A87ULL, 0xE79E236BF8BF47A8ULL, 0xE8A94DB92CA58420ULL },
+    { -3040, -10290,  0xA1DBD6FE468072A2ULL, 0xBDE5E7AAB8410244ULL, 0xE798899F46500CCAULL },
+    { -3008, -10184,  0xC7819DA48DDE4790ULL, 0x4E6570CD8536B61FULL, 0x961CD07660C85D30ULL },
+    { -2976, -10078,  0xF5E91783C229830CULL, 0x7087CECF10E2B5A5ULL, 0xA447D2C248554844ULL },
+    { -2944,  -9971,  0x978DD69AF60DC360ULL, 0xE1E20CFD1289138CULL, 0xFDBCB2BA98ABAB85ULL },
+    { -2912,  -9865,  0xBACE07232DF1C802ULL, 0x7C4C65D15C614C56ULL, 0x359A8FA0D014B9A8ULL },
+    { -2880,  -9759,  0xE641334805F3E36FULL, 0xDB67CF7BBBAC365AULL, 0x8EE58FDC35FD6C67ULL },
+    { -2848,  -9652,  0x8DE7C8D0F396CDF1ULL, 0x071D3350FF673295ULL, 0xB5C3206A72838926ULL },
+    { -2816,  -9546,  0xAEE973911228ABCAULL, 0xE3187C34500D9AB3ULL, 0xB7D1F78B317FAE12ULL },
+    { -2784,  -9440,  0xD798785921820787ULL, 0xD94D2137A3A6F4F4ULL, 0xC5DE035910B89A53ULL },
+    { -2752,  -9333,  0x84DEFC62F01C45B0ULL, 0x67AC7C1D9CCD8266ULL, 0xD121690C160997ACULL },
+    { -2720,  -9227,  0xA3C6B505BDA91BCCULL, 0x52D9655BDF62F25CULL, 0x2AE0A362438DF8B0ULL },
+    { -2688,  -9121,  0xC9DEA80D6283A34CULL, 0x474B3CB1FE1D6A7FULL, 0x9FB576046AB35018ULL },
+    { -2656,  -9015,  0xF8D2DCAF37504B51ULL, 0x9492DB3D978AACA8ULL, 0x50D3E92E2E4F8211ULL },
+    { -2624,  -8908,  0x995974653B7E0231ULL, 0x212DA7006DC4E43BULL, 0x5CBD0EA3F3B06E01ULL },
+    { -2592,  -8802,  0xBD048C7DAF8ACADBULL, 0x9736B4514993E0BAULL, 0x71E3EF6C20696A76ULL },
+    { -2560,  -8696,  0xE8FB7DC2DEC0A404ULL, 0x598EEC7D41754C09ULL, 0x5AD05B84C7C4BE7DULL },
+    { -2528,  -8589,  0x8F9623B34A2198AFULL, 0x8CE3C290DF62726AULL, 0x886901BC29574CC8ULL },
+    { -2496,  -8483,  0xB0FBE7AA6CE75997ULL, 0xF73CBDE9FEBC8FCEULL, 0x217B35D5CF1D588BULL },
+    { -2464,  -8377,  0xDA264DF693AC3E30ULL, 0x742AB8F3864562C8ULL, 0x9D19C341F5F42F2BULL },
+    { -2432,  -8270,  0x8671F14568278BEAULL, 0x138204EA625927F7ULL, 0x860AAB5AF5540CCAULL },
+    { -2400,  -8164,  0xA5B763B319D7F1DCULL, 0x0A0F429D93058121ULL, 0x640C845B2AFC2B48ULL },
+    { -2368,  -8058,  0xCC42DD5CB5091819ULL, 0x1D8106CCF8EE85B4ULL, 0x47EA18BE2F96D249ULL },
+    { -2336,  -7952,  0xFBC5778B22FFF09BULL, 0x3781BF4A97122FBCULL, 0x91E46480554BB648ULL },
+    { -2304,  -7845,  0x9B2A840F28A1638FULL, 0xE393A9C032FB0C34ULL, 0x660BDFD108BA798AULL },
+    { -2272,  -7739,  0xBF41C7ED2A1D370BULL, 0x65DE36DC36A40A10ULL, 0xFEF1284B77763E05ULL },
+    { -2240,  -7633,  0xEBBE0DF0C8201AC5ULL, 0x131565BE33DDA91AULL, 0x0CCC12293F1D7A59ULL },
+    { -2208,  -7526,  0x914997B7B12B451CULL, 0xD902EF9EA5BAF811ULL, 0x5524D2AD7F16BB09ULL },
+    { -2176,  -7420,  0xB314A47728F9CD6CULL, 0x9063016130392DF7ULL, 0xEED30CCE7C442266ULL },
+    { -2144,  -7314,  0xDCBBE27475CEFF9CULL, 0xD18F7AECE789392BULL, 0x4C301EEFC58CD34BULL },
+    { -2112,  -7207,  0x8809AC32A8A8A8EDULL, 0xBAE63E54A2044DDDULL, 0xBB3CDBB623256639ULL },
+    { -2080,  -7101,  0xA7ADF4A8F66FF68EULL, 0x205C4FAF4EDD7B60ULL, 0x0AB478814180685EULL },
+    { -2048,  -6995,  0xCEAE534F34362DE4ULL, 0x492512D4F2EAD2CBULL, 0x8263CA5CBC774BD9ULL },
+    { -2016,  -6889,  0xFEC102E2857BC1F9ULL, 0x6C656C3B1F2C9D91ULL, 0xEA8242B0030E4A52ULL },
+    { -1984,  -6782,  0x9D01161BED052BB7ULL, 0x699B5F371124CF4FULL, 0xE67E4DCD407BD3EEULL },
+    { -1952,  -6676,  0xC185CDCC064A81BAULL, 0x50E167BA79E975E1ULL, 0x33377F3919795592ULL },
+    { -1920,  -6570,  0xEE88FCE8152A48DFULL, 0xBFE3C33C58668242ULL, 0x50A8DC181A6AE468ULL },
+    { -1888,  -6463,  0x9302345438DC0E7AULL, 0x69852CC6A07D2F0CULL, 0x56A1BBB0FE3E2F7BULL },
+    { -1856,  -6357,  0xB533BD05F6E01FEDULL, 0x11800AF4BC788512ULL, 0x2BF87D930EBF4397ULL },
+    { -1824,  -6251,  0xDF594D503ADDF379ULL, 0x007A33E8D271B7CAULL, 0x2A050B26F584D3EFULL },
+    { -1792,  -6144,  0x89A63BA4C497B50EULL, 0x6C83AD1260FF20F4ULL, 0xC098E6ED0BFBD6F7ULL },
+    { -1760,  -6038,  0xA9AA79BF6A3AAC53ULL, 0xDDCCE19614FB7834ULL, 0x464CE38E212DD613ULL },
+    { -1728,  -5932,  0xD1211FE37AC6A148ULL, 0x0FC4EAFEDD191926ULL, 0x70B449709C8D8002ULL },
+    { -1696,  -5825,  0x80E2CCE8D01F963AULL, 0xB5A21AF135506167ULL, 0x38839EEB7BABE847ULL },
+    { -1664,  -5719,  0x9EDD3B40CBF457E6ULL, 0x52FFA3F3ADCDF125ULL, 0x6276E8B3738D2F81ULL },
+    { -1632,  -5613,  0xC3D0B2B266412778ULL, 0x322B56A3F15DC601ULL, 0xE6BD6FC40AAF5035ULL },
+    { -1600,  -5507,  0xF15C640B2DE17B85ULL, 0x75D9B3727E6E5A47ULL, 0x8CF6873EF4426490ULL },
+    { -1568,  -5400,  0x94C0092DD4EF9511ULL, 0x43CF71D5C4FD7868ULL, 0x64D1F15DA2C146B2ULL },
+    { -1536,  -5294,  0xB759449F52A711B2ULL, 0x68E1EB75340122D4ULL, 0x0FD924BE26AF7593ULL },
+    { -1504,  -5188,  0xE1FEA64E92B8F6F8ULL, 0x621601D613047373ULL, 0xF3B74CF7CB188290ULL },
+    { -1472,  -5081,  0x8B47AE41B64BDA30ULL, 0x1754B16BEBA6AAD6ULL, 0xA6498798BA280923ULL },
+    { -1440,  -4975,  0xABAD0504A999D9E0ULL, 0x5770075139D01FF3ULL, 0x5C197E9EABACB12FULL },
+    { -1408,  -4869,  0xD39B595AD755EA09ULL, 0x7B5B520AA67D2087ULL, 0x4E241E61E269D4E8ULL },
+    { -1376,  -4762,  0x8269ABE37634AEE0ULL, 0x0655AF3873EEE5A6ULL, 0xDF9BCCCEDEE33586ULL },
+    { -1344,  -4656,  0xA0BF0465B455E921ULL, 0x6E1F7F1642EBAAC8ULL, 0x2822E38FAF74B26EULL },
+    { -1312,  -4550,  0xC6228B76E0EDDE17ULL, 0x14037E4FB249456BULL, 0xF48EE971D1EC008EULL },
+    { -1280,  -4444,  0xF4385D0975EDBABEULL, 0x1F4BF6653CD3B977ULL, 0xDDEE7F83569C8B34ULL },
+    { -1248,  -4337,  0x96832618EAE7FBEAULL, 0x2913574E1B92C759ULL, 0x8509C1BD793FD616ULL },
+    { -1216,  -4231,  0xB9854EC6332E5955ULL, 0xA7890845B98CDE15ULL, 0x9360DCAE892A2B6BULL },
+    { -1184,  -4125,  0xE4AC057C4237088FULL, 0x4C7284F9EDDA793DULL, 0x0DAF84CD3ACF4A01ULL },
+    { -1152,  -4018,  0x8CEE12DBE4A0D94DULL, 0x1668CD8FAD294D80ULL, 0xE4CEEE3337DEC383ULL },
+    { -1120,  -3912,  0xADB5A8BDAAA53051ULL, 0x61363686961A41E5ULL, 0x2862B1F61D64DDC3ULL },
+    { -1088,  -3806,  0xD61D163A16A90D2FULL, 0xFF2F89082E46B1AEULL, 0x7A26B9C407754A72ULL },
+    { -1056,  -3699,  0x83F52C420A0A1BF8ULL, 0xD6E5A8DC8BD7642DULL, 0xF545AAB1B59D6386ULL },
+    { -1024,  -3593,  0xA2A682A5DA57C0BDULL, 0x87A601586BD3F698ULL, 0xF53E94D1B2357C33ULL },
+    {  -992,  -3487,  0xC87B6D2F3F64789EULL, 0x7855B18AC87D35CCULL, 0xB48C0255FBCB6142ULL },
+    {  -960,  -3381,  0xF71D01E03613F568ULL, 0x52E84DE3B97F1642ULL, 0x49C126B8AC219F56ULL },
+    {  -928,  -3274,  0x984B9B19E1F045DDULL, 0x402596199721B820ULL, 0x4BC70AEFB308D9AAULL },
+    {  -896,  -3168,  0xBBB7EF38BB827F2DULL, 0x6D4AA5B50BB5DC0DULL, 0x00DE73D9D5BE6974ULL },
+    {  -864,  -3062,  0xE761832EFDC06462ULL, 0x07CD71A4AD11C394ULL, 0x2DB077BE9D18B000ULL },
+    {  -832,  -2955,  0x8E997872A9B05AC7ULL, 0xE31578D4E269D267ULL, 0xD4E7468E07450E43ULL },
+    {  -800,  -2849,  0xAFC47766CB39A7B0ULL, 0xD7BE2621598B9454ULL, 0xFF7FC50083DC5B76ULL },
+    {  -768,  -2743,  0xD8A66D4A505DE96BULL, 0x5AE1B25946117390ULL, 0x4D0525AF79E132C3ULL },
+    {  -736,  -2636,  0x85855C0F774FB85EULL, 0x4B48B0E153CDCE9AULL, 0x5BC9D091BBF3CB02ULL },
+    {  -704,  -2530,  0xA493C75052EB8374ULL, 0xD521D9ABBFEB2FEDULL, 0xF2D5C346258DA621ULL },
+    {  -672,  -2424,  0xCADB6D313C8736FCULL, 0x2FFFF1289A804C5AULL, 0xC26FFB8E81532726ULL },
+    {  -640,  -2318,  0xFA0A6CDB8871347CULL, 0xD04EE5EFC60D3E49ULL, 0x112EE12926D4BBD3ULL },
+    {  -608,  -2211,  0x9A197865B4730DD0ULL, 0x1C6B313713A077E7ULL, 0xA490A57C5710577AULL },
+    {  -576,  -2105,  0xBDF139F0EE5092C6ULL, 0x8904F03C4C1D014AULL, 0xF834911FFC964B3EULL },
+    {  -544,  -1999,  0xEA1F3806467F9466ULL, 0x36C30D4BCE887FE1ULL, 0x804749D9365AA654ULL },
+    {  -512,  -1892,  0x9049EE32DB23D21CULL, 0x7132D332E3F204D4ULL, 0xE7317D62209B6A94ULL },
+    {  -480,  -1786,  0xB1D983B479007736ULL, 0x61EB52E27BA1A893ULL, 0x52DFFAB57332ADD5ULL },
+    {  -448,  -1680,  0xDB377599B6074244ULL, 0x84C663CEE6B86E7CULL, 0x2726C48A85389FA7ULL },
+    {  -416,  -1573,  0x871A49813FFC68A6ULL, 0x1A4EB006F7CE07DEULL, 0xD7CC4FEE9ED6C1D9ULL },
+    {  -384,  -1467,  0xA686E3E8B11B0857ULL, 0x88DB9FFFD5E6810EULL, 0xA8562A3D2FF7C889ULL },
+    {  -352,  -1361,  0xCD42A11346F34F7DULL, 0x0092757BF2623727ULL, 0x79D697654ECED1ACULL },
+    {  -320,  -1255,  0xFD00B897478238D0ULL, 0x8920B098955522B4ULL, 0xAB9FAC96B03D8444ULL },
+    {  -288,  -1148,  0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL, 0xBEFA78253027DA9DULL },
+    {  -256,  -1042,  0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL, 0xA23E2ED27766E8CDULL },
+    {  -224,   -936,  0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL, 0x4609AC5C7899CA37ULL },
+    {  -192,   -829,  0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL, 0x1C5A40917D0FA664ULL },
+    {  -160,   -723,  0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL, 0x8FE5B452E6B166CEULL },
+    {  -128,   -617,  0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL, 0xE26CA6063461FFFAULL },
+    {   -96,   -510,  0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL, 0x690C0DB23E2755EFULL },
+    {   -64,   -404,  0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL, 0x2A1FEE40D90AAB31ULL },
+    {   -32,   -298,  0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL, 0x0B5B1AA028CCD99EULL },
+    {     0,   -191,  0x8000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    {    32,    -85,  0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL, 0x0000000000000000ULL },
+    {    64,     21,  0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL, 0x50F8080000000000ULL },
+    {    96,    127,  0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL, 0x388DA035C8F16478ULL },
+    {   128,    234,  0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL, 0x0234F3FD7B08DD39ULL },
+    {   160,    340,  0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL, 0x2381CF8591999D64ULL },
+    {   192,    446,  0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL, 0x0F118A2758E233B2ULL },
+    {   224,    553,  0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL, 0xBC10C5C5CDA97C8EULL },
+    {   256,    659,  0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL, 0x851E4CBF3DE2F98BULL },
+    {   288,    765,  0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL, 0xE2228CBF49612182ULL },
+    {   320,    872,  0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL, 0x21CEB9EC7B8C62EDULL },
+    {   352,    978,  0x9FA42700DB900AD2ULL, 0x5EBF18B6D27795FFULL, 0x9DF3E0BD5F019367ULL },
+    {   384,   1084,  0xC4C5E310AEF8AA17ULL, 0x1027FFF56784F444ULL, 0xE117BEFA6FAB7D1AULL },
+    {   416,   1190,  0xF28A9C07E9B09C58ULL, 0xB5E54F71127AD372ULL, 0x8B5081209B8475F5ULL },
+    {   448,   1297,  0x957A4AE1EBF7F3D3ULL, 0xA7EA9C8838CE9437ULL, 0x3C11D8430D5C4803ULL },
+    {   480,   1403,  0xB83ED8DC0795A262ULL, 0x7DF40A744E446163ULL, 0xE14B2084A15836ECULL },
+    {   512,   1509,  0xE319A0AEA60E91C6ULL, 0xCC655C54BC5058F8ULL, 0x9C6583981D134CBAULL },
+    {   544,   1616,  0x8BF61451432D7BC2ULL, 0xC80CFF6EC76DDE09ULL, 0x0DB2FF19C0CA0B65ULL },
+    {   576,   1722,  0xAC83FB896B6795FCULL, 0xC6EBCEFF061B64C5ULL, 0xB3E40992F8B347E2ULL },
+    {   608,   1828,  0xD4A44FB4B8FA79AFULL, 0x9D3C1B8618251F10ULL, 0x5062F7A80E35F08CULL },
+    {   640,   1935,  0x830CF791E54A9D1CULL, 0x96E4AC8AE2F0A61DULL, 0x2E9C7527D11D4E6CULL },
+    {   672,   2041,  0xA1884B69ADE24964ULL, 0x55E04DBA4B3BD4DDULL, 0x84C10A1D22F5ADC5ULL },
+    {   704,   2147,  0xC71AA36A1F8F01CBULL, 0x9DAD43F230E1226EULL, 0x83689C3CBD362290ULL },
+    {   736,   2253,  0xF56A298F437028F3ULL, 0x31A0A1F380BA36EEULL, 0x6EC79EBF79E5BD66ULL },
+    {   768,   2360,  0x973F9CA8CD00A68CULL, 0x6C8D3FCA02CA6DE6ULL, 0xB0D7BA426777344DULL },
+    {   800,   2466,  0xBA6D9B40D7CC9ECCULL, 0xDF143BBE46291876ULL, 0xD9F922F5D6B023A4ULL },
+    {   832,   2572,  0xE5CA5A0B8D737F0EULL, 0x23114665ACC60D3BULL, 0x52210AC35B45B385ULL },
+    {   864,   2679,  0x8D9E89D11346BDA5ULL, 0x7E289E1EABE77166ULL, 0x8471BAFF2D83DF7DULL },
+    {   896,   2785,  0xAE8F2B2CE3D5DBE9ULL, 0x870A8D87239D8F35ULL, 0x412FE9E72AFD355FULL },
+    {   928,   2891,  0xD72930205A0C1B2FULL, 0xAAE8C1D6C83415A0ULL, 0x0F235CBC4C5A9895ULL },
+    {   960,   2998,  0x849A672A0D2ECFD1ULL, 0xC832A5685E79350CULL, 0xBBD356DD36F14528ULL },
+    {   992,   3104,  0xA3722C1341FA93DEULL, 0x13FE73C71DDF07EFULL, 0x57A7FEAA31CAC9D9ULL },
+    {  1024,   3210,  0xC976758681750C17ULL, 0x650D3D28F18B50CEULL, 0x526B988275249B10ULL },
+    {  1056,   3316,  0xF8526DCAA67E0B77ULL, 0x8686AD2B30C2D961ULL, 0x93B6E3A9AE4E696BULL },
+    {  1088,   3423,  0x990A4D36997A9834ULL, 0x1EAC5B7D1142D87CULL, 0x06A04E1F1626B5D3ULL },
+    {  1120,   3529,  0xBCA2FC30CC19F090ULL, 0x9EB5CB19647508C5ULL, 0x7FE40DEFE17E55F6ULL },
+    {  1152,   3635,  0xE8833C181C3BBFE0ULL, 0xDC18D6CE622438A3ULL, 0x0E2BC6F6E25D9E83ULL },
+    {  1184,   3742,  0x8F4C0691750E8305ULL, 0x0A40DE037C9AD730ULL, 0x718B9618B3C6D176ULL },
+    {  1216,   3848,  0xB0A08D798ABCE436ULL, 0x026B8897E82CDE8DULL, 0x5ECC5AB963D91B0BULL },
+    {  1248,   3954,  0xD9B5B441DF1CA24AULL, 0x75BD95CF6D4E57F9ULL, 0x318A871F113842D3ULL },
+    {  1280,   4061,  0x862C8C0EEB856ECBULL, 0x085BCCD5C05EE9F9ULL, 0xECFF2E2C1EAE9DBAULL },
+    {  1312,   4167,  0xA561DA6259253F91ULL, 0x202E275E2E6472B2ULL, 0xE87C8E95FA932E7DULL },
+    {  1344,   4273,  0xCBD96ED6466CF081ULL, 0xBEB7FBDC1CBE8B37ULL, 0x72435286BAF0E84FULL },
+    {  1376,   4379,  0xFB4383271A87A1CEULL, 0xECA608D886D5085FULL, 0x57D614660AF3D417ULL },
+    {  1408,   4486,  0x9ADA6CD496EF0E05ULL, 0x2F1A208FDEDFF747ULL, 0x57E155F4AE05D036ULL },
+    {  1440,   4592,  0xBEDF0FBEEAA56989ULL, 0xB77CAF58B4A564E0ULL, 0x143904E69C22EA22ULL },
+    {  1472,   4698,  0xEB445F92A877BB09ULL, 0xBC921B2C3EB25C7BULL, 0xF0C01C012927F617ULL },
+    {  1504,   4805,  0x90FE99D23E8DF6CFULL, 0x4EC0AAEB679E4D79ULL, 0xA24769CECAE0563AULL },
+    {  1536,   4911,  0xB2B8353B3993A7E4ULL, 0x4257AC3B4C1D7794ULL, 0x7704BD1BB5A5802FULL },
+    {  1568,   5017,  0xDC49F3445824E360ULL, 0xFB0B98F6BBC4F0CBULL, 0xCCC52C236DECD779ULL },
+    {  1600,   5124,  0x87C37487CCF4B0BFULL, 0x532430E7002ACA8EULL, 0x779AFC75BB5D53BFULL },
+    {  1632,   5230,  0xA75767F07481436FULL, 0xE75DD664B8F76AA1ULL, 0x035862A2937636E7ULL },
+    {  1664,   5336,  0xCE43A50AE4F7FB8EULL, 0x7877892520EE1715ULL, 0x5B1545B7A4A86071ULL },
+    {  1696,   5442,  0xFE3D8461CB764145ULL, 0xD440A4FF74D6AF6AULL, 0x05DF329B2FBBA8D7ULL },
+    {  1728,   5549,  0x9CB00BFD6F025339ULL, 0x2E61AA868501E740ULL, 0x5C0648C4E9E45FAAULL },
+    {  1760,   5655,  0xC121EA3B1AA714B6ULL, 0xF84DF185FC7D1BFDULL, 0x698CF65B7421D87AULL },
+    {  1792,   5761,  0xEE0DDD84924AB88CULL, 0x2D4070F33B21AB7BULL, 0xC20578FA3851488CULL },
+    {  1824,   5868,  0x92B6530184ED7FB3ULL, 0x555C13432402E523ULL, 0x7CE0AB319AE71A13ULL },
+    {  1856,   5974,  0xB4D63576CAA95365ULL, 0xF33CE3D6F17B62D1ULL, 0xD92F8109437A02B2ULL },
+    {  1888,   6080,  0xDEE60499182F84B2ULL, 0xF9D2E9FD2F16711FULL, 0x367CFB0AD3F10C00ULL },
+    {  1920,   6187,  0x895F2F074B86004CULL, 0xBC3BC2377649DEEFULL, 0xDEA7BF8E2153308EULL },
+    {  1952,   6293,  0xA952E68C74F91E40ULL, 0x83F904625BF851B2ULL, 0x54DD4ECFD8E2BBD8ULL },
+    {  1984,   6399,  0xD0B52E179D84F732ULL, 0xFC8EA8820C829FE6ULL, 0x351091ED9695D56AULL },
+    {  2016,   6506,  0x80A046447E3D49F1ULL, 0xB7B1ADA9CDEBA84DULL, 0xBB3F8498A972F18FULL },
+    {  2048,   6612,  0x9E8B3B5DC53D5DE4ULL, 0xA74D28CE329ACE52ULL, 0x6A3197BBEBE3034FULL },
+    {  2080,   6718,  0xC36BA032DD07DDFEULL, 0xBD05B64FEB6D2FFFULL, 0xC3C0DD2C7292BA15ULL },
+    {  2112,   6824,  0xF0DFCF43277D1129ULL, 0x6E2CB3E7E6C76433ULL, 0x95D9CA3D05C2DE20ULL },
+    {  2144,   6931,  0x947341BC28B52123ULL, 0xD9DF435D26C85DD5ULL, 0xC276EE727A4BBDD3ULL },
+    {  2176,   7037,  0xB6FAA16AC604D6F6ULL, 0x180F7FCDF9F88B9DULL, 0x006DEAF7B163AA51ULL },
+    {  2208,   7143,  0xE189FFF88A6E300AULL, 0x6C0854DEE9FE3499ULL, 0x13A63E05B09F7F5AULL },
+    {  2240,   7250,  0x8AFFCA2BD1F88549ULL, 0x1E34291B1EF566C7ULL, 0x31BE1482014CDAF0ULL },
+    {  2272,   7356,  0xAB54683B3D20E23BULL, 0x212BBB6587CE8D13ULL, 0x1DBB78C82D0BE126ULL },
+    {  2304,   7462,  0xD32E203241F4806FULL, 0x3F50C802040F4CCCULL, 0x03BAA2F38E354650ULL },
+    {  2336,   7569,  0x82265B7E7EFC84E0ULL, 0xFFE39290A06447D6ULL, 0x5B00AD4466DBCEBEULL },
+    {  2368,   7675,  0xA06C0BD4CE9DB63FULL, 0xD51AF6A3244A6983ULL, 0x1F17DFAE241CFAD8ULL },
+    {  2400,   7781,  0xC5BC4672073224F7ULL, 0xB2C46D6D298A0658ULL, 0xCC84A2629670B8EAULL },
+    {  2432,   7887,  0xF3BA4E7089C084E0ULL, 0x17F49ABD213C38B8ULL, 0xE182161815AA3827ULL },
+    {  2464,   7994,  0x963575CE63B6332DULL, 0x7EFA7D29C44E11B7ULL, 0x56A3106227B87707ULL },
+    {  2496,   8100,  0xB9258C901050BC53ULL, 0x0C1BEB6383DD861CULL, 0xE906612B94CC94B7ULL },
+    {  2528,   8206,  0xE435FD6309D4FB29ULL, 0x2CDA83AE165BF80EULL, 0xDE442DA4F65A1FA0ULL },
+    {  2560,   8313,  0x8CA554C020A1F0A6ULL, 0x5DFED09922680A06ULL, 0xAEF839A8A7F6A14CULL },
+    {  2592,   8419,  0xAD5BFF3854FF2560ULL, 0x2AB1AA038B8D63A1ULL, 0x15E6ADB85C868CC9ULL },
+    {  2624,   8525,  0xD5AE91D3FF7A6F8EULL, 0x1E914685A756A7D6ULL, 0x616A13318FF341B3ULL },
+    {  2656,   8632,  0x83B10FB893300CDEULL, 0x111AE5735EC0E878ULL, 0xF3F69093398E2573ULL },
+    {  2688,   8738,  0xA2528E74EAF101FCULL, 0xF09E780BCC8238D9ULL, 0x5E997E9F45D7897EULL },
+    {  2720,   8844,  0xC813F2038018DCC4ULL, 0x5BE12541BD907F81ULL, 0x83E02C1BBDE40E30ULL },
+    {  2752,   8950,  0xF69D74FC97AEE56AULL, 0x5E0A5C3957F5DBB8ULL, 0x507A83727A7BECF5ULL },
+    {  2784,   9057,  0x97FCFF3458A37B0CULL, 0x97ECAC7332C473B4ULL, 0x5CE629D11D5B38ECULL },
+    {  2816,   9163,  0xBB570A9A9BD977CCULL, 0x4C808753BB22FEF8ULL, 0x6FC5802CDE0B3272ULL },
+    {  2848,   9269,  0xE6EA1521BB43AEBCULL, 0xE471D787C5786319ULL, 0x2FA6B3CA5812EF91ULL },
+    {  2880,   9376,  0x8E4FDDBBD3E242B6ULL, 0xD1445B3F1CC9A09CULL, 0x452107C368A41806ULL },
+    {  2912,   9482,  0xAF69BDF68FC6A740ULL, 0x7730E00421DA4D55ULL, 0x00DB7D919B136C68ULL },
+    {  2944,   9588,  0xD83699BA2AE37E0CULL, 0xB1A05A0D64A2E6E8ULL, 0x2839EEBBD2636AD9ULL },
+    {  2976,   9695,  0x854070F666F8939FULL, 0x2FCF6C219D9E0E06ULL, 0xCF27866B2C6BD992ULL },
+    {  3008,   9801,  0xA43ED4844001A59EULL, 0xBA5DA243711D4F39ULL, 0xAC18F659182B0E64ULL },
+    {  3040,   9907,  0xCA72B831FF7BEF2DULL, 0xB5CEAF53C9875F4BULL, 0x65D2C975F1B0B016ULL },
+    {  3072,  10013,  0xF9895D25D88B5A8AULL, 0xFDD08C4DA13655ECULL, 0xF02C90B784B4227AULL },
+    {  3104,  10120,  0x99C9EE1AA45CBDB6ULL, 0x605990407CF18034ULL, 0x19D07D3DA2917426ULL },
+    {  3136,  10226,  0xBD8F2F7A1BA47D6DULL, 0x566765461BD2F61BULL, 0xB494BCC96D53E49CULL },
+    {  3168,  10332,  0xE9A65FC76A44AAD4ULL, 0xAE2C6960D0C96141ULL, 0x1FB6DD3F85DAB6C0ULL },
+    {  3200,  10439,  0x8FFF7443EC2F51EDULL, 0x36FF0AD5E3A835B0ULL, 0x357C0A5A746A6E68ULL },
+    {  3232,  10545,  0xB17DB720B3868E94ULL, 0x7407CB9251918021ULL, 0x9A567CBBBF855BC8ULL },
+    {  3264,  10651,  0xDAC64EE70F466AE5ULL, 0x032727C1CCEF13BAULL, 0xBEB1AD9E2863C8C1ULL },
+    {  3296,  10758,  0x86D48D6626C27EEBULL, 0xD4E1E0F5D911BD40ULL, 0x62CC2E73300F409FULL },
+    {  3328,  10864,  0xA630EF7D5699FE45ULL, 0x50E3660235410F98ULL, 0xFCA81F202C5D111AULL },
+    {  3360,  10970,  0xCCD8AE88CF70AD84ULL, 0x12E29F09D9061609ULL, 0xC9CF998035A91665ULL },
+    {  3392,  11076,  0xFC7E217A6ACE9F0FULL, 0x7119AA2C0C5EE694ULL, 0x192DF5F08F7399F1ULL },
+    {  3424,  11183,  0x9B9C52DEF0F2F4FFULL, 0xC1AFEB8941B07AE6ULL, 0x3AE0052860CF9F41ULL },
+    {  3456,  11289,  0xBFCE0F5AB8A6761DULL, 0xDA1276A2F5DEBC0BULL, 0x9C65E36AC2D966ACULL },
+    {  3488,  11395,  0xEC6AF63168693F51ULL, 0xB33C91DED66FF3B9ULL, 0x0A233B0E1FF48F39ULL },
+    {  3520,  11502,  0x91B427AB57BCE6ADULL, 0xF739F1CA6F8AE61EULL, 0xEAD238211605495CULL },
+    {  3552,  11608,  0xB397FD9A22D732D7ULL, 0xAE7EDAA76FBBD922ULL, 0xD38E9D0E472B2647ULL },
+    {  3584,  11714,  0xDD5DC8A2BF27F3F7ULL, 0x95AA118EC1D08317ULL, 0x8909E424A112A3CDULL },
+    {  3616,  11821,  0x886D7361002A7720ULL, 0x04B7EF7FAA32153CULL, 0xB5901F20440F36A0ULL },
+    {  3648,  11927,  0xA828F10FB963C71CULL, 0xE012EB55F30D3C0AULL, 0x5E943A525EF980DBULL },
+    {  3680,  12033,  0xCF45EAD490352E65ULL, 0xA3F2E2617152417CULL, 0x52AEFDF41BD4842AULL },
+    {  3712,  12139,  0xFF7BDCD8F586AED0ULL, 0xBB2215057A199356ULL, 0xB96684A8F9A28E61ULL },
+    {  3744,  12246,  0x9D743E108A6A5FB0ULL, 0xEFD29F06B8EB7BA2ULL, 0x7EFDAA0B6B264ABBULL },
+    {  3776,  12352,  0xC213BEA5C91F03D8ULL, 0x421DDC40535F78B3ULL, 0xA524D2082AAC030EULL },
+    {  3808,  12458,  0xEF37F1886F4B6690ULL, 0xF659EDE2159A45ECULL, 0xABE33496AFF629B4ULL },
+    {  3840,  12565,  0x936E07737DC64F6DULL, 0x8C474BB609F40287ULL, 0xD2FEA4FD957EA18EULL },
+    {  3872,  12671,  0xB5B8A47F8889782CULL, 0x89ABF129AF845214ULL, 0xE311AD3969A206E0ULL },
+    {  3904,  12777,  0xDFFD1E7BE8191190ULL, 0xAFB619B59AB7CAB9ULL, 0xB9E4B3D49FB11548ULL },
+    {  3936,  12884,  0x8A0B316BA468D9FDULL, 0xCE808CD18E336B0CULL, 0xBEA644E084723866ULL },
+    {  3968,  12990,  0xAA26EB2095A94E81ULL, 0xE0280DBEA779D3B9ULL, 0x96347E0589F9C014ULL },
+    {  4000,  13096,  0xD1BA8323FE558C61ULL, 0x0D5C82A286614F3EULL, 0xC25558230C550F78ULL },
+    {  4032,  13203,  0x81415538CE493BD5ULL, 0xF22E502FCDD4BCA2ULL, 0x0151DCD7A53488C4ULL },
+    {  4064,  13309,  0x9F51C070F53FB4A9ULL, 0xC3720171212FDA8FULL, 0x93DDE26B36357630ULL },
+    {  4096,  13415,  0xC46052028A20979AULL, 0xC94C153F804A4A92ULL, 0x65761FB2444E2268ULL },
+    {  4128,  13521,  0xF20D6B41853CE899ULL, 0xA5F1001D0CB47329ULL, 0xAA36D42B7931D030ULL },
+    {  4160,  13628,  0x952D234CCB7E5F2AULL, 0x92506FD4D86244D3ULL, 0xAB328000B197F37CULL },
+    {  4192,  13734,  0xB7DFBF27855ED611ULL, 0x26289E8E9E6FCE92ULL, 0x8C77BBDF8BB17DF8ULL },
+    {  4224,  13840,  0xE2A46848A8D6F78BULL, 0x88111764983EDBA9ULL, 0x4DAA4A8EFFDA676CULL },
+    {  4256,  13947,  0x8BADD636CC48B341ULL, 0x0879B2E5F6EE8B1CULL, 0xAC376F28B45E5ACCULL },
+    {  4288,  14053,  0xAC2AEFCB5DFE300AULL, 0x0AEBC0915F75C1F2ULL, 0xCD09809D6B9BBACEULL },
+    {  4320,  14159,  0xD4368DC8BB2A0E80ULL, 0x75A77A3B0BC28F4DULL, 0xB1978DAA93ECAF38ULL },
+    {  4352,  14266,  0x82C952E37BE11CB4ULL, 0x6E6C12AA02B9A1ECULL, 0x538567BFBE0B117AULL },
+    {  4384,  14372,  0xA134EAF486B5D13FULL, 0x578D95D780E47D84ULL, 0xBD6E64DB22A2D08FULL },
+    {  4416,  14478,  0xC6B3DE56DB4AEF75ULL, 0xC11B18BD25918C30ULL, 0x2B9886E4FC08B273ULL },
+    {  4448,  14584,  0xF4EB7D1EE4AC0571ULL, 0x538966169D821439ULL, 0xE1F7F1156B58D832ULL },
+    {  4480,  14691,  0x96F18B1742AAD751ULL, 0x888C9AB2FC5B3437ULL, 0x186EF2C39ACB4103ULL },
+    {  4512,  14797,  0xBA0D61235FD033EBULL, 0x1F1545846AAE50EEULL, 0xEE0EC0CC8AAD3DF9ULL },
+    {  4544,  14903,  0xE553BE2769F4765EULL, 0xD15E6695E9FB0B3EULL, 0x970DB52E1743533BULL },
+    {  4576,  15010,  0x8D55709FBDAEEA74ULL, 0x7ABCD7ED54A929D3ULL, 0x22996FE1DFEE605CULL },
+    {  4608,  15116,  0xAE3511626ED559F0ULL, 0x7EF5F8C1B3A0771CULL, 0x5A43D43795F92EA2ULL },
+    {  4640,  15222,  0xD6BA215817B5591FULL, 0x814A69258DDD6D5AULL, 0x6D69CFD34CF5DADFULL },
+    {  4672,  15329,  0x8455F5578672AD69ULL, 0x796ECF6ADFC25225ULL, 0x3B482D9DC36E244FULL },
+    {  4704,  15435,  0xA31DCEC2FEF14B30ULL, 0xA28A151725A55E10ULL, 0x900AA3C2F02AC9D5ULL },
+    {  4736,  15541,  0xC90E78C7FCBEE713ULL, 0xF3BE171A27BF81DAULL, 0xD75B37A5230067E7ULL },
+    {  4768,  15647,  0xF7D24130E645DDD7ULL, 0x462A2BF67DDFA64BULL, 0x39E35541A56F6AEEULL },
+    {  4800,  15754,  0x98BB4EE309F04D45ULL, 0x5A050B215EEBC516ULL, 0xE1281D24C6F709E5ULL },
+    {  4832,  15860,  0xBC419E3FB5E9D924ULL, 0x6ECC7F9959C7582AULL, 0x7C58659F028B915AULL },
+    {  4864,  15966,  0xE80B387FB9146D6CULL, 0xA6A99EE15AFEDE53ULL, 0xE72AF3FAF80453CEULL },
+    {  4896,  16073,  0x8F020FB0D2B663BDULL, 0x5D9F64C557CE815DULL, 0x88E71481E4CF8EFEULL },
+    {  4928,  16179,  0xB045626FB50A35E7ULL, 0x58F8FDE02C03A6C6ULL, 0xDED179C26D9AB829ULL },
+    {  4960,  16285,  0xD94554ABE1E9DB05ULL, 0x68FC787A6F5F923FULL, 0x3B92C6991EEC0426ULL },
+    {  4992,  16392,  0x85E74AAA26674A71ULL, 0x215ABDF4A82D15A6ULL, 0x9C229C3756B9FB13ULL },
+    {  5024,  16498,  0xA50C7D3824E75EF6ULL, 0x1D76E06CDD5A56E5ULL, 0xB3AC160D2CC065D0ULL }
+};
+
+#endif // DCONVSTR_HAVE_WIDE_BINARY
+
 //=====================================================================================================
 //
 // FUNCTIONS
@@ -1542,24 +2052,21 @@ static inline unsigned int  count_leading_zeros( uint64_t  a )
 
 /**
  *
- *  Convert extended-precision decimal to double-precision binary
- *  (mantissa is rounded to nearest representable value)
+ *  Convert extended-precision decimal to 64-bit binary, without rounding to 53 bits
  *
  *  (a * 10^b) -> (c * 2^d)
  *
  *  a != 0. Decimal point is on the right side of the input mantissa a.
  *
- *  Resulting binary mantissa c is rounded to 53 bits (as in IEEE 754 double-precision binary).
- *  If remainder >= 0.5, then mantissa is rounded up, otherwise it's rounded down.
- *
- *  On exit from this function, binary point is located after first bit of mantissa,
- *  which is always equal to 1 (binary exponent is adjusted accordingly).
+ *  Resulting binary mantissa c has its most significant bit set. Binary point is on the right side
+ *  of c. Product with approximate power of ten is truncated, so c is off by at most few units
+ *  in its least significant bit.
  *
  *  @returns  1  Exited normally, no errors.
  *            0  Invalid argument or internal error.
  *
  */
-static int  convert_extended_decimal_to_binary_and_round(
+static int  convert_extended_decimal_to_binary(
     uint64_t   a,
     int32_t    b,
     uint64_t*  c,
@@ -1595,7 +2102,45 @@ static int  convert_extended_decimal_to_binary_and_round(
     else
         return  0;   // product is unexpectedly zero
 
-    // 3. Round mantissa
+    // 3. Save computation results and exit
+    (*c) = mantissa;
+    (*d) = exponent;
+    return  1;
+}
+
+/**
+ *
+ *  Convert extended-precision decimal to double-precision binary
+ *  (mantissa is rounded to nearest representable value)
+ *
+ *  (a * 10^b) -> (c * 2^d)
+ *
+ *  a != 0. Decimal point is on the right side of the input mantissa a.
+ *
+ *  Resulting binary mantissa c is rounded to 53 bits (as in IEEE 754 double-precision binary).
+ *  If remainder >= 0.5, then mantissa is rounded up, otherwise it's rounded down.
+ *
+ *  On exit from this function, binary point is located after first bit of mantissa,
+ *  which is always equal to 1 (binary exponent is adjusted accordingly).
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Invalid argument or internal error.
+ *
+ */
+static int  convert_extended_decimal_to_binary_and_round(
+    uint64_t   a,
+    int32_t    b,
+    uint64_t*  c,
+    int32_t*   d
+)
+{
+    // 1. Convert (a * 10^b) -> (mantissa * 2^exponent)
+    uint64_t  mantissa = 0;
+    int32_t   exponent = 0;
+    if(! convert_extended_decimal_to_binary( a, b, &mantissa, &exponent ) )
+        return  0;
+
+    // 2. Round mantissa
     uint64_t  remainder = mantissa & 0x07FFULL;  // 0x07FF: 11 least significant bits set, where 11 = 64-53
     if( remainder < 0x0400ULL )
         mantissa -= remainder;
@@ -1610,10 +2155,10 @@ static int  convert_extended_decimal_to_binary_and_round(
         }
     }
 
-    // 4. Move binary point 63 bits to the left: adjust exponent
+    // 3. Move binary point 63 bits to the left: adjust exponent
     exponent += 63;
 
-    // 5. Save computation results and exit
+    // 4. Save computation results and exit
     (*c) = mantissa;
     (*d) = exponent;
     return  1;
@@ -1794,6 +2339,7 @@ static int  convert_binary_to_extended_decimal(
     uint64_t  positive_extent = 0, positive_search_space = next_c - base_c;
     for( uint64_t  bit = 1ULL << (63 - count_leading_zeros( negative_search_space )); bit != 0; bit >>= 1 )
     {
+        DCONVSTR_STATS_INCREMENT( negative_search_iterations );
         if(( bit <= negative_search_space )&&
            ( does_extended_decimal_round_to_given_binary( base_c - negative_extent - bit,
                                                           base_d, a, b ) ))
@@ -1804,6 +2350,7 @@ static int  convert_binary_to_extended_decimal(
     }
     for( uint64_t  bit = 1ULL << (63 - count_leading_zeros( positive_search_space )); bit != 0; bit >>= 1 )
     {
+        DCONVSTR_STATS_INCREMENT( positive_search_iterations );
         if(( bit <= positive_search_space )&&
            ( does_extended_decimal_round_to_given_binary( base_c + positive_extent + bit,
                                                           base_d, a, b ) ))
@@ -1834,1025 +2381,3569 @@ static int  convert_binary_to_extended_decimal(
     return  1;
 }
 
-//=====================================================================================================
+/**
+ *
+ *  Compute floor( x * log10(2) ) for |x| <= 1650
+ *
+ */
+static inline int32_t  floor_log10_pow2( int32_t  x )
+{
+    // 78913 / 2^18 is close enough to log10(2) within given range of x
+    if( x >= 0 )
+        return  ((x * 78913) >> 18);
+    else
+        return  -((((-x) * 78913) + (1 << 18) - 1) >> 18);
+}
 
 /**
  *
- *  Unpack floating-point double precision binary value according to IEEE 754
+ *  Compute floor( x * log10(2) ) for |x| <= 16500
  *
  */
-static void  unpack_ieee754_double(
-    const double*  input,
-    int*           out_is_nan,
-    int*           out_sign,
-    uint64_t*      out_binary_mantissa,
-    int32_t*       out_binary_exponent,
-    int*           out_is_infinity
-)
+static inline int32_t  floor_log10_pow2_wide( int32_t  x )
 {
-    // 1. Unpack bits
-    uint64_t  input_bits     = *( (const uint64_t*)input );
-    uint64_t  input_sign     = (input_bits >> 63);
-    uint64_t  input_exponent = (input_bits >> 52) & 0x7FFULL;
-    uint64_t  input_mantissa = (input_bits & ((1ULL << 52) - 1ULL));
+    // 169464822037455 / 2^49 is close enough to log10(2) within given range of x
+    int64_t  y = ((int64_t)( x )) * 169464822037455LL;
+    if( y >= 0 )
+        return  ((int32_t)( y >> 49 ));
+    else
+        return  -((int32_t)( ((-y) + (1LL << 49) - 1) >> 49 ));
+}
 
-    // 2. Handle special case: NaN
-    if(( input_exponent == 0x7FFULL )&&( input_mantissa != 0 ))
+/**
+ *
+ *  Multiply 1024-bit unsigned integer by 64-bit unsigned integer
+ *
+ *  (u * v) -> u
+ *
+ *  Element u[0] of 16-element array u holds 64 least significant bits.
+ *  Result must fit to 1024 bits.
+ *
+ */
+static inline void  multiply_1024( uint64_t*  u, uint64_t  v )
+{
+    uint64_t  carry = 0;
+    for( int  i = 0; i < 16; ++i )
     {
-        *out_is_nan          = 1;
-        *out_sign            = 0;
-        *out_is_infinity     = 0;
-        *out_binary_exponent = 0;
-        *out_binary_mantissa = 0;
-        return;
+        uint64_t  w[2];
+        multiply_128( u[i], v, w );
+        u[i] = w[0] + carry;
+        carry = w[1] + (u[i] < carry);
     }
-    *out_is_nan = 0;
-  
-    // 3. Handle special case: +INF/-INF
-    *out_sign = (input_sign != 0);
-    if( input_exponent == 0x7FFULL )
+}
+
+/**
+ *
+ *  Count the number of significant bits in 1024-bit unsigned integer
+ *
+ */
+static inline int  bit_length_1024( const uint64_t*  u )
+{
+    for( int  i = 15; i >= 0; --i )
     {
-        *out_is_infinity     = 1;
-        *out_binary_exponent = 0;
-        *out_binary_mantissa = 0;
-        return;
+        if( u[i] != 0 )
+            return  64 * i + 64 - count_leading_zeros( u[i] );
     }
-    *out_is_infinity = 0;
+    return  0;
+}
 
-    // 4. Handle special case: +0/-0
-    if(( input_exponent == 0 )&&( input_mantissa == 0 ))
+/**
+ *
+ *  Compare extended-precision decimal with binary exactly
+ *
+ *  Mantissas a and c are 128-bit unsigned integers (a[0] and c[0] hold 64 least significant bits).
+ *  Sign of (a * 10^b - c * 2^d) is computed with 1024-bit integers, so this function is
+ *  limited to the arguments which satisfy a * 5^b < 2^1024 and c * 5^(-b) < 2^1024
+ *  (it's enough for |b| <= 380, which covers entire range of double precision).
+ *
+ *  @returns  -1, 0 or 1 if (a * 10^b) is less than, equal to or greater than (c * 2^d)
+ *
+ */
+static int  compare_extended_decimal_with_binary(
+    const uint64_t*  a,
+    int32_t          b,
+    const uint64_t*  c,
+    int32_t          d
+)
+{
+    // 1. Move powers of five to one side: compare (x * 2^b) with (y * 2^d),
+    //    where x = a * 5^max(b,0), y = c * 5^max(-b,0)
+    uint64_t  x[16] = { a[0], a[1] };
+    uint64_t  y[16] = { c[0], c[1] };
+    for( int32_t  n = ((b > 0) ? b : -b); n > 0; n -= 27 )
     {
-        *out_binary_exponent = 0;
-        *out_binary_mantissa = 0;
-        return;
+        uint64_t  power_of_five = 1;           // 5^27 is the largest power of five below 2^64
+        for( int32_t  i = 0; ( i < n )&&( i < 27 ); ++i )
+            power_of_five *= 5;
+        multiply_1024( ((b > 0) ? x : y), power_of_five );
     }
 
-    // 5. Handle denormalized numbers
-    if( input_exponent == 0 )
+    // 2. Compare bit lengths of (x * 2^(b-d)) and y first
+    int32_t   shift = b - d;
+    uint64_t* z     = ((shift >= 0) ? x : y);
+    if( shift < 0 )
+        shift = -shift;
+    int  length_x = bit_length_1024( x ) + ((z == x) ? shift : 0);
+    int  length_y = bit_length_1024( y ) + ((z == y) ? shift : 0);
+    if( length_x != length_y )
+        return  (length_x < length_y) ? -1 : 1;
+    if( length_x == 0 )
+        return  0;
+
+    // 3. Bit lengths are equal and do not exceed 1024: shift and compare limb by limb
+    for( ; shift >= 64; shift -= 64 )
     {
-        *out_binary_exponent = -1022;
-        *out_binary_mantissa = (input_mantissa << 11);   // most significant 53rd bit of mantissa is always 0
-        return;
+        for( int  i = 15; i > 0; --i )
+            z[i] = z[i - 1];
+        z[0] = 0;
     }
-
-    // 6. Handle normalized numbers
-    *out_binary_exponent = ((int32_t)input_exponent) - 1023;
-    *out_binary_mantissa = (1ULL << 63) | (input_mantissa << 11);   // 53rd bit of mantissa is always 1
+    if( shift > 0 )
+    {
+        for( int  i = 15; i > 0; --i )
+            z[i] = (z[i] << shift) | (z[i - 1] >> (64 - shift));
+        z[0] = (z[0] << shift);
+    }
+    for( int  i = 15; i >= 0; --i )
+    {
+        if( x[i] != y[i] )
+            return  (x[i] < y[i]) ? -1 : 1;
+    }
+    return  0;
 }
 
 /**
  *
- *  Pack floating-point double precision binary value according to IEEE 754
+ *  Convert double-precision binary to the nearest decimal with given number of significant digits
  *
- *  @returns  0  overflow / underflow condition (when strtod(3) would have set errno = ERANGE).
- *            1  exited normally, neither overflow nor underflow
+ *  (a * 2^b) -> (c * 10^d)
+ *
+ *  a != 0. Binary point is after the most significant bit of the input mantissa a.
+ *
+ *  Unlike convert_binary_to_extended_decimal(), which gives the shortest decimal converted back
+ *  to the same binary, this function rounds exact value of (a * 2^b) to n_digits significant
+ *  digits (1 <= n_digits <= 17), ties to even. First approximation of 19 digits is computed
+ *  with error less than 32 units of its last digit; if it's too close to the midpoint between
+ *  two adjacent decimals to decide on rounding direction, then the midpoint is compared with
+ *  (a * 2^b) exactly.
+ *
+ *  Resulting decimal mantissa is in the range 10^(n_digits-1) <= c < 10^n_digits.
+ *  Decimal point is on the right side of resulting decimal mantissa c.
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Invalid argument or internal error.
  *
  */
-static int  pack_ieee754_double(
-    int       input_is_nan,
-    int       input_sign,
-    uint64_t  input_binary_mantissa,
-    int32_t   input_binary_exponent,
-    int       input_is_infinity,
-    double*   output
+static int  convert_binary_to_nearest_decimal(
+    uint64_t   a,
+    int32_t    b,
+    int        n_digits,
+    uint64_t*  c,
+    int32_t*   d
 )
 {
-    // 1. Initialize values to pack
-    uint64_t  output_sign     = 0;
-    uint64_t  output_exponent = 0;
-    uint64_t  output_mantissa = 0;
+    // 1. Compute first approximation with 19 digits
+    if(( a == 0 )||( n_digits < 1 )||( n_digits > 17 ))
+        return  0;
+    uint64_t  approx   = 0;
+    int32_t   exponent = 0;
+    if(! convert_binary_to_decimal_1st_approx( a, b, &approx, &exponent ) )
+        return  0;
 
-    // 2. Handle special case: NaN
-    int  had_overflow_or_underflow_in_exponent = 0;
-    if( input_is_nan )
+    // 2. Split it to kept digits and remainder, decide on rounding direction
+    uint64_t  scale = 1;
+    for( int  i = n_digits; i < 19; ++i )
+        scale *= 10ULL;
+    uint64_t  kept      = approx / scale;
+    uint64_t  remainder = approx % scale;
+    uint64_t  half      = scale / 2;
+    int  round_up = (remainder >= half);
+    if(( remainder + 32 >= half )&&( remainder <= half + 32 ))
     {
-        output_sign     = 1;              // Quiet NaN
-        output_exponent = 0x7FF;
-        output_mantissa = (1ULL << 51);   // mantissa MSB set
+        // compare midpoint (kept * scale + half) * 10^exponent with (a * 2^(b-63)) exactly
+        uint64_t  midpoint[2] = { kept * scale + half, 0 };
+        uint64_t  binary[2]   = { a, 0 };
+        int  cmp = compare_extended_decimal_with_binary( midpoint, exponent, binary, b - 63 );
+        round_up = ( (cmp < 0) ? 1 : ((cmp > 0) ? 0 : ((int)( kept & 1 ))) );
     }
-    else
+
+    // 3. Round and perform final normalization
+    exponent += 19 - n_digits;
+    if( round_up )
     {
-        // 3. Handle special case: +INF/-INF
-        output_sign = (input_sign ? 1 : 0);
-        if( input_is_infinity )
-        {
-            output_exponent = 0x7FF;
-            output_mantissa = 0;
-        }
-        // 4. Handle special case: +0/-0
-        else if( input_binary_mantissa == 0 )
-        {
-            output_exponent = 0;
-            output_mantissa = 0;
-        }
-        else
+        ++kept;
+        if( kept == (10ULL * POW10_18) / scale )   // 10^n_digits: carry to the next digit
         {
-            unsigned int  lz = count_leading_zeros( input_binary_mantissa );
-            input_binary_mantissa <<= lz;
-            input_binary_exponent  -= lz;
-
-            if( input_binary_exponent > 1023 )
-            {
-                // 5. Handle unintentional infinity (due to exponent overflow)
-                output_exponent = 0x7FF;
-                output_mantissa = 0;
-                had_overflow_or_underflow_in_exponent = 1;
-            }
-            else if( input_binary_exponent >= -1022 )
-            {
-                // 6. Handle normalized numbers
-                output_exponent = ((uint64_t)( input_binary_exponent + 1023 ));
-                output_mantissa = (input_binary_mantissa >> 11) & ((1ULL << 52) - 1ULL);
-            }
-            else
-            {
-                // 7. Handle denormalized numbers
-                //    and unintentional zero (due to exponent underflow)
-                input_binary_mantissa >>= 11;
-                while(( input_binary_mantissa != 0 )&&( input_binary_exponent < -1022 ))
-                {
-                    input_binary_mantissa >>= 1;
-                    ++input_binary_exponent;
-                }
-                output_exponent = 0;
-                output_mantissa = input_binary_mantissa;
-                had_overflow_or_underflow_in_exponent = (input_binary_mantissa == 0);
-            }
+            kept /= 10ULL;
+            ++exponent;
         }
     }
-
-    // 8. Pack bits up
-    uint64_t  output_bits = (output_sign << 63) |
-                            ((output_exponent & 0x7FFULL) << 52) |
-                            (output_mantissa & ((1ULL << 52) - 1ULL));
-    *( (uint64_t*)output ) = output_bits;
-    return(! had_overflow_or_underflow_in_exponent );
+    (*c) = kept;
+    (*d) = exponent;
+    return  1;
 }
 
 /**
  *
- *  Decompress small integer in range 0..9999 to four-digit BCD representation
+ *  Convert extended-precision decimal to IEEE 754 binary format, up to double precision
+ *  (mantissa is rounded to nearest representable value, ties to even)
  *
- */
-static inline void  bcd_decompress_small(
-    uint32_t  compressed_bcd,
-    uint8_t*  decompressed_bcd
-)
-{
-    uint32_t  high_pair = compressed_bcd / 100;
-    uint32_t  low_pair  = compressed_bcd % 100;
-
-    decompressed_bcd[0] = ((uint8_t)( high_pair / 10 ));
-    decompressed_bcd[1] = ((uint8_t)( high_pair % 10 ));
-    decompressed_bcd[2] = ((uint8_t)( low_pair  / 10 ));
-    decompressed_bcd[3] = ((uint8_t)( low_pair  % 10 ));
-}
-
-/**
+ *  (a * 10^b) -> c
  *
- *  Decompress full range unsigned 64-bit integer to twenty-digit BCD representation
+ *  Decimal point is on the right side of the input mantissa a.
+ *  Output c holds bits of the binary value without sign bit. Binary format is defined by
+ *  mantissa_bits (hidden bit included) and exponent_bits: (53, 11) for IEEE 754 double precision,
+ *  (24, 8) for IEEE 754 single precision, (11, 5) for IEEE 754 half precision, (8, 8) for bfloat16.
+ *  Powers of ten are taken from table of table_size entries, which must cover (a * 10^b) for
+ *  entire range of the binary format: powers_of_ten_float_ does it for any a in formats up to
+ *  single precision, powers_of_ten_ does it for double precision if a is normalized to 19 digits.
  *
- *  This implementation was written by Douglas W. Jones, it was taken from
- *  http://homepage.cs.uiowa.edu/~jones/bcd/decimal.html#sixtyfour
+ *  Mantissa is rounded to mantissa_bits bits, or to less bits for denormalized numbers, in a single step,
+ *  so there is no double rounding. Product of a and the power of ten is computed with 128 bits;
+ *  if it's too close to the midpoint between two adjacent representable values to decide
+ *  on rounding direction, then the midpoint is compared with (a * 10^b) exactly.
+ *
+ *  @returns  0  overflow / underflow condition (when strtof(3) would have set errno = ERANGE).
+ *            1  exited normally, neither overflow nor underflow
  *
  */
-static void  bcd_decompress(
-    uint64_t  compressed_bcd,
-    uint8_t*  decompressed_bcd
+static int  convert_extended_decimal_to_ieee754_binary(
+    uint64_t                    a,
+    int32_t                     b,
+    const struct power_of_ten*  table,
+    size_t                      table_size,
+    int                         mantissa_bits,
+    int                         exponent_bits,
+    uint64_t*                   c
 )
 {
-    uint32_t  d0 = compressed_bcd         & 0xFFFF;
-    uint32_t  d1 = (compressed_bcd >> 16) & 0xFFFF;
-    uint32_t  d2 = (compressed_bcd >> 32) & 0xFFFF;
-    uint32_t  d3 = (compressed_bcd >> 48) & 0xFFFF;
+    // 1. Handle zero and exponents out of table range (the latter is always overflow or underflow,
+    //    because table covers a * 10^b for entire range of the binary format)
+    int32_t   bias     = (1 << (exponent_bits - 1)) - 1;
+    uint64_t  infinity = ((1ULL << exponent_bits) - 1ULL) << (mantissa_bits - 1);
+    const struct power_of_ten*  table_begin = table;
+    const struct power_of_ten*  table_last  = table + table_size - 1;
+    if( a == 0 )
+    {
+        (*c) = 0;
+        return  1;
+    }
+    if( b < table_begin->decimal_exponent )
+    {
+        (*c) = 0;
+        return  0;
+    }
+    if( b > table_last->decimal_exponent )
+    {
+        (*c) = infinity;
+        return  0;
+    }
 
-              d0 = 656 * d3 + 7296 * d2 + 5536 * d1 + d0;
-    uint32_t  q  = d0 / 10000;
-              d0 = d0 % 10000;
+    // 2. Convert (a * 10^b) -> (w * 2^e), where 2^127 <= w < 2^128.
+    //    Error of w is less than 2^64, since power of ten is rounded to 64 bits.
+    unsigned int  lz = count_leading_zeros( a );
+    const struct power_of_ten*  power = table_begin + (b - table_begin->decimal_exponent);
+    uint64_t  w[2];
+    multiply_128( a << lz, power->binary_mantissa, w );
+    int32_t  e = power->binary_exponent - ((int32_t)( lz ));
+    if(( w[1] >> 63 ) == 0 )
+    {
+        w[1] = (w[1] << 1) | (w[0] >> 63);
+        w[0] = (w[0] << 1);
+        --e;
+    }
 
-              d1 = q + 7671 * d3 + 9496 * d2 + 6 * d1;
-              q  = d1 / 10000;
-              d1 = d1 % 10000;
+    // 3. Determine number of mantissa bits to keep:
+    //    all mantissa bits for normalized numbers, less bits for denormalized numbers
+    int32_t  x = e + 127;     // 2^x <= (w * 2^e) < 2^(x+1)
+    if( x > bias )
+    {
+        (*c) = infinity;
+        return  0;
+    }
+    int32_t  keep = ( (x >= 1 - bias) ? mantissa_bits : (x + bias - 1 + mantissa_bits) );
+    if( keep < 0 )
+    {
+        (*c) = 0;
+        return  0;
+    }
 
-              d2 = q + 4749 * d3 + 42 * d2;
-              q  = d2 / 10000;
-              d2 = d2 % 10000;
+    // 4. Split w into kept bits q and remainder r, compute (r - half of the least significant kept bit).
+    //    Remainder is (r_high * 2^64 + w[0]), kept bits are in the high half of w.
+    int       shift    = 64 - keep;
+    uint64_t  q        = ( (shift < 64) ? (w[1] >> shift) : 0 );
+    uint64_t  r_high   = ( (shift < 64) ? (w[1] & ((1ULL << shift) - 1ULL)) : w[1] );
+    int64_t   delta    = ((int64_t)( r_high - (1ULL << (shift - 1)) ));
 
-              d3 = q + 281 * d3;
-              q  = d3 / 10000;
-              d3 = d3 % 10000;
+    // 5. Round mantissa. Delta is known with error less than 1 (in units of 2^64):
+    //    decide on rounding direction if it's far enough from zero, otherwise compare exactly.
+    int  round_up = 0;
+    if(( delta > 1 )||(( delta == 1 )&&( w[0] != 0 )))
+        round_up = 1;
+    else if( delta < -1 )
+        round_up = 0;
+    else
+    {
+        uint64_t  decimal[2]  = { a, 0 };
+        uint64_t  midpoint[2] = { 2 * q + 1, 0 };
+        int  cmp = compare_extended_decimal_with_binary( decimal, b, midpoint, e + 64 + shift - 1 );
+        round_up = (( cmp > 0 )||(( cmp == 0 )&&( q & 1 )));
+    }
+    q += round_up;
 
-    bcd_decompress_small( q,  decompressed_bcd      );
-    bcd_decompress_small( d3, decompressed_bcd + 4  );
-    bcd_decompress_small( d2, decompressed_bcd + 8  );
-    bcd_decompress_small( d1, decompressed_bcd + 12 );
-    bcd_decompress_small( d0, decompressed_bcd + 16 );
+    // 6. Pack bits up. Overflow of mantissa after rounding is propagated to exponent by addition.
+    uint64_t  bits = 0;
+    if( x >= 1 - bias )
+        bits = (((uint64_t)( x + bias )) << (mantissa_bits - 1)) + q - (1ULL << (mantissa_bits - 1));
+    else
+        bits = q;
+    if( bits >= infinity )
+    {
+        (*c) = infinity;
+        return  0;
+    }
+    (*c) = bits;
+    return( bits != 0 );
 }
 
 /**
  *
- *  Compress four-digit BCD representation to small integer in range 0..9999
- *
- */
-static inline uint32_t  bcd_compress_small( const uint8_t*  decompressed_bcd )
-{
-    uint32_t  high_pair = 10 * decompressed_bcd[0] + decompressed_bcd[1];
-    uint32_t  low_pair  = 10 * decompressed_bcd[2] + decompressed_bcd[3];
-    return  100 * high_pair + low_pair;
-}
-
-/**
+ *  Convert IEEE 754 single precision binary, or narrower binary, to shortest extended-precision decimal
  *
- *  Compress twenty-digit BCD representation to full range unsigned 64-bit integer
+ *  (a * 2^b) -> (c * 10^d)
  *
- */
-static uint64_t  bcd_compress( const uint8_t*  decompressed_bcd )
-{
-    uint64_t  d2 =         bcd_compress_small( decompressed_bcd      );
-    uint64_t  d1 = 10000 * bcd_compress_small( decompressed_bcd + 4  )
-                         + bcd_compress_small( decompressed_bcd + 8  );
-    uint64_t  d0 = 10000 * bcd_compress_small( decompressed_bcd + 12 )
-                         + bcd_compress_small( decompressed_bcd + 16 );
-    return  ((d2 * (10000ULL * 10000ULL) + d1) * (10000ULL * 10000ULL)) + d0;
-}
-
-/**
+ *  0 < a < 2^mantissa_bits. Binary point is on the right side of the input mantissa a.
+ *  Binary format is defined by mantissa_bits and exponent_bits, like in
+ *  convert_extended_decimal_to_ieee754_binary().
  *
- *  Round twenty-digit BCD representation to given number of significant digits
+ *  Decimal (c * 10^d) has minimal number of significant digits among decimals which are
+ *  converted back to (a * 2^b) by convert_extended_decimal_to_ieee754_binary().
+ *  If there are several such decimals, the closest one to (a * 2^b) is chosen.
  *
- *  Most significant digit must be always equal to zero.
- *  Therefore, number of significant digits can be in range from 1 to 19.
+ *  Resulting decimal mantissa is in the range 10^18 <= c < 10^19.
+ *  Decimal point is on the right side of resulting decimal mantissa c.
  *
- *  @returns  Adjusted number of significant decimal digits
+ *  @returns  1  Exited normally, no errors.
+ *            0  Invalid argument or internal error.
  *
  */
-static int  bcd_round( int  new_ndigits, uint8_t*  decimal_mantissa, int32_t*  exponent )
+static int  convert_float_to_extended_decimal(
+    uint32_t   a,
+    int32_t    b,
+    int        mantissa_bits,
+    int        exponent_bits,
+    uint64_t*  c,
+    int32_t*   d
+)
 {
-    // 1. Bounds check and adjustment
-    if( new_ndigits < 1 )
-        new_ndigits = 1;
-    else if( new_ndigits > 19 )
-        new_ndigits = 19;
+    // 1. Compute bounds of rounding interval in units of 2^(b-2): (4a - 2) and (4a + 2),
+    //    but lower bound is closer if a is power of two and value is normalized.
+    //    Normalize them to 32 bits, so that 2^31 <= upper < 2^32.
+    int32_t   b_min = 3 - (1 << (exponent_bits - 1)) - mantissa_bits;   // exponent of denormalized numbers
+    if(( a == 0 )||( a >= (1U << mantissa_bits) )||( b < b_min ))
+        return  0;
+    uint32_t  bits  = (((uint32_t)( b - b_min )) << (mantissa_bits - 1)) + a;
+    uint32_t  value = 4 * a;
+    uint32_t  lower = 4 * a - ( (( a == (1U << (mantissa_bits - 1)) )&&( b > b_min )) ? 1 : 2 );
+    uint32_t  upper = 4 * a + 2;
+    unsigned int  lz = count_leading_zeros( upper ) - 32;
+    value <<= lz;
+    lower <<= lz;
+    upper <<= lz;
+    int32_t  e = b - 2 - ((int32_t)( lz ));
 
-    if( new_ndigits < 19 )
+    // 2. Convert all three to decimals with common exponent: multiply by 10^t, where t is chosen
+    //    so that (value * 2^e * 10^t) has 19 decimal digits. Approximation error is less than 2.
+    //    Upper bound (upper * 2^e) < 2^(e+32) < 10^(k+1), k = floor( (e+32) * log10(2) ).
+    const struct power_of_ten*  table_begin = powers_of_ten_float_;
+    int32_t   t = 18 - floor_log10_pow2( e + 32 );
+    uint64_t  value_c = 0, lower_c = 0, upper_c = 0;
+    for( int  attempt = 0; ; ++attempt )
     {
-        for( ;; )
-        {
-            // 2. Compute round-up flag
-            int  round_up = ( decimal_mantissa[1 + new_ndigits] >= 5 );
-
-            // 3. Zero out the tail
-            for( int  i = 1 + new_ndigits; i < 20; ++i )
-                decimal_mantissa[i] = 0;
-
-            // 4. Make round-up if necessary
-            if(! round_up )
-                break;
-            for( int  i = new_ndigits; i >= 0; --i )
-            {
-                uint8_t  new_value = decimal_mantissa[i] + 1;
-                if( new_value < 10 )
-                {
-                    decimal_mantissa[i] = new_value;
-                    break;
-                }
-                decimal_mantissa[i] = 0;
-            }
+        int32_t  i = t - table_begin->decimal_exponent;
+        if(( attempt > 1 )||( i < 0 )||( i >= ((int32_t)( sizeof(powers_of_ten_float_)/sizeof(powers_of_ten_float_[0]) )) ))
+            return  0;
+        int32_t  shift = -(e + table_begin[i].binary_exponent);
+        if(( shift <= 0 )||( shift >= 64 ))
+            return  0;
+        uint64_t  w[2];
+        multiply_128( value, table_begin[i].binary_mantissa, w );
+        value_c = (w[1] << (64 - shift)) | (w[0] >> shift);
+        multiply_128( lower, table_begin[i].binary_mantissa, w );
+        lower_c = (w[1] << (64 - shift)) | (w[0] >> shift);
+        multiply_128( upper, table_begin[i].binary_mantissa, w );
+        upper_c = (w[1] << (64 - shift)) | (w[0] >> shift);
+        if( value_c >= POW10_18 )
+            break;
+        ++t;   // first approximation had 18 digits: one more digit is needed
+    }
 
-            // 5. Handle overflow
-            if( decimal_mantissa[0] == 0 )
-                break;     // no overflow
+    // 3. Try decimals with 1, 2, ... significant digits: the ones just below and just above value.
+    //    Candidate is inside of rounding interval if it's far enough from its bounds (compared to
+    //    approximation error), otherwise it is converted back to binary and checked exactly.
+    uint64_t  new_mantissa = 0;
+    for( uint64_t  current_scale = POW10_18; current_scale != 0; current_scale /= 10ULL )
+    {
+        uint64_t  candidate[2];
+        int       is_inside[2];
+        candidate[0] = value_c - (value_c % current_scale);
+        candidate[1] = candidate[0] + current_scale;
+        for( int  j = 0; j < 2; ++j )
+        {
+            uint64_t  x = candidate[j];
+            if(( x + 2 < lower_c )||( x > upper_c + 2 ))
+                is_inside[j] = 0;
+            else if(( x > lower_c + 2 )&&( x + 2 < upper_c ))
+                is_inside[j] = 1;
             else
             {
-                memmove( decimal_mantissa + 1, decimal_mantissa, 19 );
-                decimal_mantissa[0] = 0;
-                ++( *exponent );
-                // if there was an overflow, then make one more iteration
+                uint64_t  x_bits = 0;
+                convert_extended_decimal_to_ieee754_binary( x, -t, powers_of_ten_float_,
+                                                            sizeof(powers_of_ten_float_)/sizeof(powers_of_ten_float_[0]),
+                                                            mantissa_bits, exponent_bits, &x_bits );
+                is_inside[j] = ( x_bits == bits );
             }
         }
+        if(( is_inside[0] )&&( is_inside[1] ))
+        {
+            uint64_t  distance_0 = value_c - candidate[0];
+            uint64_t  distance_1 = candidate[1] - value_c;
+            if(( distance_0 < distance_1 )||
+               (( distance_0 == distance_1 )&&( ((candidate[0] / current_scale) & 1) == 0 )))
+                new_mantissa = candidate[0];
+            else
+                new_mantissa = candidate[1];
+        }
+        else if( is_inside[0] )
+            new_mantissa = candidate[0];
+        else if( is_inside[1] )
+            new_mantissa = candidate[1];
+        if( new_mantissa != 0 )
+            break;
     }
+    if( new_mantissa == 0 )
+        return  0;
 
-    // 6. Return adjusted number of significant decimal digits to the caller
-    return  new_ndigits;
+    // 4. Perform final normalization and offload results
+    if( new_mantissa >= (10ULL * POW10_18) )
+    {
+        new_mantissa /= 10ULL;
+        --t;
+    }
+    (*c) = new_mantissa;
+    (*d) = -t;
+    return  1;
 }
 
-//=====================================================================================================
+#ifdef DCONVSTR_HAVE_WIDE_BINARY
 
 /**
  *
- *  Helper formatting function: Print given number of whitespaces to output buffer
+ *  Count leading zeros in 128-bit unsigned integer
  *
- *  @returns  1  Exited normally, no errors.
- *            0  Overflow in the output buffer.
+ *  Element u[0] of two-element array u holds 64 least significant bits. Argument must not be zero.
  *
  */
-static int  format_pad( char**  outbuf, int*  outbuf_size, int  n )
+static inline unsigned int  count_leading_zeros_128( const uint64_t*  u )
 {
-    if( *outbuf_size < n )
-        return  0;
-    else
-    {
-        *outbuf_size -= n;
-        char*  p = *outbuf;
-        while( n-- > 0 )
-            *p++ = ' ';
-        *outbuf = p;
-        return  1;
-    }
+    return  (u[1] != 0) ? count_leading_zeros( u[1] ) : (64 + count_leading_zeros( u[0] ));
 }
 
 /**
  *
- *  Helper formatting function: Print one character to output buffer
+ *  Shift multi-word unsigned integer to the right
  *
- *  @returns  1  Exited normally, no errors.
- *            0  Overflow in the output buffer.
+ *  (u >> n) -> u, where 0 <= n < 64 * n_words
+ *
+ *  Element u[0] of array u holds 64 least significant bits.
  *
  */
-static int  format_onechar( char**  outbuf, int*  outbuf_size, int  c )
+static inline void  shift_right_wide( uint64_t*  u, int  n_words, unsigned int  n )
 {
-    if( *outbuf_size <= 0 )
-        return  0;
-    else
+    for( ; n >= 64; n -= 64 )
     {
-        *((*outbuf)++) = ((char)c);
-        --(*outbuf_size);
-        return  1;
+        for( int  i = 0; i + 1 < n_words; ++i )
+            u[i] = u[i + 1];
+        u[n_words - 1] = 0;
+    }
+    if( n > 0 )
+    {
+        for( int  i = 0; i + 1 < n_words; ++i )
+            u[i] = (u[i] >> n) | (u[i + 1] << (64 - n));
+        u[n_words - 1] = (u[n_words - 1] >> n);
     }
 }
 
 /**
  *
- *  Helper formatting function: Print given string to output buffer
+ *  Multiply two multi-word unsigned integers
  *
- *  @returns  1  Exited normally, no errors.
- *            0  Overflow in the output buffer.
+ *  (u * v) -> w
+ *
+ *  Element 0 of arrays u (n_u words), v (n_v words) and w (n_u + n_v words) holds 64 least significant bits.
  *
  */
-static int  format_copystr( char**  outbuf, int*  outbuf_size, const char*  str, int  str_size )
+static inline void  multiply_wide( const uint64_t*  u, int  n_u, const uint64_t*  v, int  n_v, uint64_t*  w )
 {
-    if( *outbuf_size < str_size )
-        return  0;
-    else
+    for( int  i = 0; i < n_u + n_v; ++i )
+        w[i] = 0;
+    for( int  i = 0; i < n_u; ++i )
     {
-        *outbuf_size -= str_size;
-        char*  p = *outbuf;
-        while( str_size-- > 0 )
-            *p++ = *str++;
-        *outbuf = p;
-        return  1;
+        uint64_t  carry = 0;
+        for( int  j = 0; j < n_v; ++j )
+        {
+            uint64_t  p[2];
+            multiply_128( u[i], v[j], p );
+            uint64_t  sum = w[i + j] + p[0];
+            uint64_t  high = p[1] + (sum < p[0]);   // no overflow: p[1] <= 2^64 - 2
+            w[i + j] = sum + carry;
+            carry = high + (w[i + j] < carry);
+        }
+        w[i + n_v] = carry;
     }
 }
 
 /**
  *
- *  Helper formatting function: Print exponent like sprintf( p, "e%+02d", e )
+ *  Compute power of ten with 192-bit mantissa
  *
- *  There must be at least 16 bytes in the output buffer.
+ *  10^n ~= m * 2^e, where 2^191 <= m < 2^192
+ *
+ *  Mantissa m (m[0] holds 64 least significant bits) is a product of coarse and fine table entries
+ *  truncated to 192 bits, so its relative error is less than 2^-190.
+ *
+ *  @returns  1  Exited normally.
+ *            0  Power is out of table range.
  *
  */
-static void  format_exponent( char*  buffer, int32_t  exponent, int  is_uppercase )
+static int  get_power_of_ten_192(
+    int32_t    n,
+    uint64_t*  m,
+    int32_t*   e
+)
 {
-    char  tmp_buffer[12];
-
-    *buffer++ = (is_uppercase ? 'E' : 'e');
-    if( exponent < 0 )
-    {
-        *buffer++ = '-';
-        exponent = -exponent;
-    }
-    else
-        *buffer++ = '+';
+    // 1. Find table entries: 10^n = 10^(32*i + j) = 10^(32*i) * 10^j
+    const struct power_of_ten_192*  coarse_begin = powers_of_ten_wide_coarse_192_;
+    int32_t  n_coarse = ((int32_t)( sizeof(powers_of_ten_wide_coarse_192_)/sizeof(powers_of_ten_wide_coarse_192_[0]) ));
+    if( n < coarse_begin->decimal_exponent )
+        return  0;
+    int32_t  i = (n - coarse_begin->decimal_exponent) / 32;
+    if( i >= n_coarse )
+        return  0;
+    const struct power_of_ten_192*  coarse = coarse_begin + i;
+    const struct power_of_ten_128*  fine   = powers_of_ten_wide_fine_128_ + (n - coarse->decimal_exponent);
 
-    int  i = 0;
-    while(( exponent > 0 )&&( i < 12 ))
+    // 2. Multiply mantissas, normalize product and truncate it to 192 bits
+    uint64_t  u[3] = { coarse->binary_mantissa_low, coarse->binary_mantissa_middle, coarse->binary_mantissa_high };
+    uint64_t  v[2] = { fine->binary_mantissa_low,   fine->binary_mantissa_high   };
+    uint64_t  w[5];
+    multiply_wide( u, 3, v, 2, w );
+    int32_t  exponent = coarse->binary_exponent + fine->binary_exponent + 128;
+    if(( w[4] >> 63 ) == 0 )
     {
-        tmp_buffer[i++] = ((char)( (exponent % 10) + '0' ));
-        exponent /= 10;
+        w[4] = (w[4] << 1) | (w[3] >> 63);
+        w[3] = (w[3] << 1) | (w[2] >> 63);
+        w[2] = (w[2] << 1) | (w[1] >> 63);
+        --exponent;
     }
-    while( i < 2 )
-        tmp_buffer[i++] = '0';
-    while( i > 0 )
-        *buffer++ = tmp_buffer[--i];
-    *buffer = 0;
+    m[0] = w[2];
+    m[1] = w[3];
+    m[2] = w[4];
+    (*e) = exponent;
+    return  1;
 }
 
 /**
  *
- *  Print IEEE 754 floating-point double precision value to string
+ *  Convert extended-precision decimal to binary with wide mantissa: x87 extended precision
+ *  or IEEE 754 quadruple precision (mantissa is rounded to nearest representable value, ties to even)
  *
- *  @param  outbuf            Address of variable with a pointer to output buffer filled by the function.
- *                            On entry, this variable is initialized by caller.
- *                            On exit, this variable points to the end of printed string.
- *                           
- *  @param  outbuf_size       Size of output buffer filled by the function.
- *                            On entry, this variable is initialized by caller to maximum allowed size.
- *                            On exit, this variable contains size of unused portion of the output buffer.
- *                           
- *  @param  value             Input value (IEEE 754 floating-point double precision).
- *                           
- *  @param  format_char       Format char. Either 'e', or 'f', or 'g'. Refer to printf(3) manual for details.
- *                           
- *  @param  format_flags      Any combination of the above (DCONVSTR_FLAG_*).
- *                           
- *  @param  format_width      Format width. Used only if DCONVSTR_FLAG_HAVE_WIDTH bit is set in flags.
- *                            Refer to printf(3) manual for details.
+ *  (a * 10^b) -> (c * 2^(max(d,1) - 16382 - mantissa_bits))
  *
- *  @param  format_precision  Format precision. Set it to DCONVSTR_DEFAULT_PRECISION if unsure.
- *                            Refer to printf(3) manual for details.
+ *  Both formats have 15-bit exponent with bias 16383, and differ in mantissa width only:
+ *  mantissa_bits is 64 for x87 extended precision and 113 for quadruple precision.
+ *  Decimal point is on the right side of the input mantissa a, which is 128-bit unsigned integer
+ *  (a[0] holds 64 least significant bits). Output c is 128-bit mantissa with integer bit included
+ *  (bit mantissa_bits-1, it's zero for denormalized numbers), output d is biased exponent:
+ *  0 for denormalized numbers and zero, 0x7FFF for infinity.
  *
- *  @returns  1  if value was successfully converted to string.
- *            0  if there is not enough room in buffer or internal error happened during conversion.
+ *  Product of a and the power of ten is computed with 320 bits. If it's too close to the midpoint
+ *  between two adjacent representable values to decide on rounding direction, then the midpoint is
+ *  compared with (a * 10^b) exactly. Exact comparison is limited to -88 <= b <= 80; out of this
+ *  range (a * 10^b) never equals to a midpoint, and rounding direction is taken from the product,
+ *  which may be wrong only if (a * 10^b) is within 2^-189 relative distance from the midpoint.
+ *
+ *  @returns  0  overflow / underflow condition (when strtold(3) would have set errno = ERANGE).
+ *            1  exited normally, neither overflow nor underflow
  *
  */
-int  dconvstr_print(
-    char**        outbuf,
-    int*          outbuf_size,
-    double        value,
-    int           format_char,
-    unsigned int  format_flags,
-    int           format_width,
-    int           format_precision
+static int  convert_extended_decimal_to_wide_binary(
+    const uint64_t*  a,
+    int32_t          b,
+    int              mantissa_bits,
+    uint64_t*        c,
+    uint32_t*        d
 )
 {
-    // 1. Unpack double precision value
-    int       is_nan      = 0;
-    int       is_negative = 0;
-    int       is_infinity = 0;
-    uint64_t  mantissa    = 0;
-    int32_t   exponent    = 0;
-    unpack_ieee754_double( &value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+    // 1. Handle zero and exponents out of table range (the latter is always overflow or underflow,
+    //    because table covers a * 10^b for entire range of both formats, for any 128-bit a)
+    uint64_t  power[3];
+    int32_t   power_exponent = 0;
+    uint64_t  infinity[2] = { 0, 0 };    // mantissa of infinity: integer bit only
+    infinity[(mantissa_bits - 1) / 64] = (1ULL << ((mantissa_bits - 1) % 64));
+    c[0] = 0;
+    c[1] = 0;
+    (*d) = 0;
+    if(( a[0] == 0 )&&( a[1] == 0 ))
+        return  1;
+    if(! get_power_of_ten_192( b, power, &power_exponent ) )
+    {
+        if( b >= 0 )
+        {
+            c[0] = infinity[0];
+            c[1] = infinity[1];
+            (*d) = 0x7FFFU;
+        }
+        return  0;
+    }
 
-    // 2. Handle special cases
-    if( is_nan )
+    // 2. Convert (a * 10^b) -> (w * 2^e), where 2^319 <= w < 2^320.
+    //    Error of w is less than 2^130, since power of ten has relative error less than 2^-190.
+    unsigned int  lz = count_leading_zeros_128( a );
+    uint64_t  normalized_a[2];
+    if( lz >= 64 )
     {
-        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
-            return  format_copystr( outbuf, outbuf_size, "NAN", 3 );
-        else
-            return  format_copystr( outbuf, outbuf_size, "nan", 3 );
+        normalized_a[1] = (a[0] << (lz - 64));
+        normalized_a[0] = 0;
     }
-    if(( is_infinity )&&( !is_negative ))
+    else if( lz > 0 )
     {
-        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
-            return  format_copystr( outbuf, outbuf_size, "INF", 3 );
-        else
-            return  format_copystr( outbuf, outbuf_size, "inf", 3 );
+        normalized_a[1] = (a[1] << lz) | (a[0] >> (64 - lz));
+        normalized_a[0] = (a[0] << lz);
     }
-    if(( is_infinity )&&( is_negative ))
+    else
     {
-        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
-            return  format_copystr( outbuf, outbuf_size, "-INF", 4 );
-        else
-            return  format_copystr( outbuf, outbuf_size, "-inf", 4 );
+        normalized_a[1] = a[1];
+        normalized_a[0] = a[0];
+    }
+    uint64_t  w[5];
+    multiply_wide( normalized_a, 2, power, 3, w );
+    int32_t  e = power_exponent - ((int32_t)( lz ));
+    if(( w[4] >> 63 ) == 0 )
+    {
+        for( int  i = 4; i > 0; --i )
+            w[i] = (w[i] << 1) | (w[i - 1] >> 63);
+        w[0] = (w[0] << 1);
+        --e;
     }
 
-    // 3. Get exact decimal representation.
-    //    Decimal point is located on the right side of decimal mantissa
-    uint8_t  decimal_mantissa[20];
-    if( mantissa == 0 )
+    // 3. Determine number of mantissa bits to keep:
+    //    mantissa_bits for normalized numbers, less bits for denormalized numbers
+    int32_t  x = e + 319;     // 2^x <= (w * 2^e) < 2^(x+1)
+    if( x > 16383 )
     {
-        memset( decimal_mantissa, 0, sizeof(decimal_mantissa) );
-        exponent = -18;
+        c[0] = infinity[0];
+        c[1] = infinity[1];
+        (*d) = 0x7FFFU;
+        return  0;
+    }
+    int32_t  keep = ( (x >= -16382) ? mantissa_bits : (x + 16382 + mantissa_bits) );
+    if( keep < 0 )
+        return  0;
+
+    // 4. Shift w to the right, so that kept bits q are in w[4] and w[3], and compute
+    //    (remainder - half of the least significant kept bit) in units of 2^128
+    unsigned int  shift = 128 - keep;
+    shift_right_wide( w, 5, shift );
+    e += shift;
+    uint64_t  q[2]  = { w[3], w[4] };
+    int64_t   delta = ((int64_t)( w[2] - (1ULL << 63) ));
+
+    // 5. Round mantissa. Delta is known with error less than 2 (in units of 2^128), because
+    //    shift is at least 15: decide on rounding direction if it's far enough from zero,
+    //    otherwise compare exactly.
+    int  round_up = 0;
+    if( delta > 2 )
+        round_up = 1;
+    else if( delta < -3 )
+        round_up = 0;
+    else if(( b >= -88 )&&( b <= 80 ))
+    {
+        uint64_t  midpoint[2] = { 2 * q[0] + 1, (q[1] << 1) | (q[0] >> 63) };
+        int  cmp = compare_extended_decimal_with_binary( a, b, midpoint, e + 191 );
+        round_up = (( cmp > 0 )||(( cmp == 0 )&&( q[0] & 1 )));
     }
     else
+        round_up = ( delta >= 0 );
+    q[0] += round_up;
+    q[1] += (q[0] < ((uint64_t)( round_up )));
+
+    // 6. Pack bits up. Overflow of mantissa after rounding is propagated to exponent.
+    uint32_t  biased_exponent = ( (x >= -16382) ? ((uint32_t)( x + 16383 )) : 0 );
+    int       is_normalized   = ( (mantissa_bits > 64) ? ((q[1] >> (mantissa_bits - 65)) & 1) : ((q[0] >> (mantissa_bits - 1)) & 1) );
+    int       is_overflow     = ( (mantissa_bits >= 64) ? ((q[1] >> (mantissa_bits - 64)) & 1) : ((q[0] >> mantissa_bits) & 1) );
+    if( is_overflow )
     {
-        if(! convert_binary_to_extended_decimal( mantissa, exponent, &mantissa, &exponent ) )
-            return  0;    // internal error during conversion
-        bcd_decompress( mantissa, decimal_mantissa );
-        if(( decimal_mantissa[0] != 0 )||( decimal_mantissa[1] == 0 ))
-            return  0;    // invariant does not hold : mantissa >= 10^19 || mantissa < 10^18
+        q[0] = infinity[0];
+        q[1] = infinity[1];
+        ++biased_exponent;
     }
+    else if(( biased_exponent == 0 )&&( is_normalized ))
+        biased_exponent = 1;     // denormalized number was rounded up to normalized one
+    if( biased_exponent >= 0x7FFFU )
+    {
+        c[0] = infinity[0];
+        c[1] = infinity[1];
+        (*d) = 0x7FFFU;
+        return  0;
+    }
+    c[0] = q[0];
+    c[1] = q[1];
+    (*d) = biased_exponent;
+    return(( q[0] != 0 )||( q[1] != 0 ));
+}
 
-    // 4. Compute the following fields:
-    //    z1      - number of zeros inserted before the digits
-    //    z2      - number of zeros inserted after the digits
-    //    point   - number of digits printed before decimal point
-    //    ndigits - number of digits to print from decimal_mantissa[1..19].
-    //    suffix  - formatted exponent like "e-5"
-    //    (Code from this section was adopted from http://golang.org/src/lib9/fmt/fltfmt.c)
-    int   point   = 1;
-    int   z1      = 0;
-    int   z2      = 0;
-    int   ndigits = 19;      // initially we have 19 digits (most significant zero digit is ignored)
-    char  suffix[16];
-    int   suffix_width = 0;
+/**
+ *
+ *  Compare two decimals, each split in two parts: u = u[1] * 10^19 + u[0]
+ *
+ *  @returns  -1, 0 or 1 if u is less than, equal to or greater than v
+ *
+ */
+static inline int  compare_split_decimals( const uint64_t*  u, const uint64_t*  v )
+{
+    if( u[1] != v[1] )
+        return  (u[1] < v[1]) ? -1 : 1;
+    if( u[0] != v[0] )
+        return  (u[0] < v[0]) ? -1 : 1;
+    return  0;
+}
 
-    int  original_format_char = format_char;
-    if( format_char == 'g' )
+/**
+ *
+ *  Add two decimals split in two parts: (u + v) -> w, where w = w[1] * 10^19 + w[0]
+ *
+ */
+static inline void  add_split_decimals( const uint64_t*  u, const uint64_t*  v, uint64_t*  w )
+{
+    uint64_t  high = u[1] + v[1];
+    if( u[0] >= POW10_19 - v[0] )
     {
-        // get rid of excess precision
-        if( format_precision == 0 )
-            format_precision = 1;
-        if( format_precision < ndigits )
-        {
-            exponent += (ndigits - format_precision);  // retain invariant "point after mantissa"
-            ndigits = bcd_round( format_precision, decimal_mantissa, &exponent );
-        }
-    
-        // choose format: e or f
-        int  e = exponent + (ndigits - 1);  // now point is after mantissa, move to the left (after 1st digit)
-        if(( e >= -4 )&&( e < format_precision ))    // so printf(3) rules say
-        {
-            format_char = 'f';
-        }
-        else
+        w[0] = u[0] - (POW10_19 - v[0]);
+        w[1] = high + 1;
+    }
+    else
+    {
+        w[0] = u[0] + v[0];
+        w[1] = high;
+    }
+}
+
+/**
+ *
+ *  Split 128-bit unsigned integer u < 10^19 * 2^64 in two decimal parts: u = w[1] * 10^19 + w[0]
+ *
+ */
+static inline void  split_decimal( const uint64_t*  u, uint64_t*  w )
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__) && (__SIZEOF_INT128__ == 16)
+    unsigned __int128  x = (((unsigned __int128)( u[1] )) << 64) | u[0];
+    w[1] = ((uint64_t)( x / POW10_19 ));
+    w[0] = ((uint64_t)( x % POW10_19 ));
+#else
+    // Long division, starting from the highest possible bit of quotient
+    uint64_t  high = u[1];
+    uint64_t  low  = u[0];
+    uint64_t  quotient = 0;
+    for( int  i = ( (high != 0) ? (64 - ((int)( count_leading_zeros( high ) ))) : 0 ); i >= 0; --i )
+    {
+        // compare (high, low) with 10^19 * 2^i, subtract if greater or equal
+        uint64_t  d_high = ( (i > 0) ? (POW10_19 >> (64 - i)) : 0 );
+        uint64_t  d_low  = (POW10_19 << i);
+        if(( high > d_high )||(( high == d_high )&&( low >= d_low )))
         {
-            format_char = 'e';
-            --format_precision;             // one digit before the point, rest after
+            high -= d_high + (low < d_low);
+            low  -= d_low;
+            quotient |= (1ULL << i);
         }
     }
+    w[1] = quotient;
+    w[0] = low;
+#endif
+}
 
-    if( format_char == 'e' )
+/**
+ *
+ *  Join decimal split in two parts to 128-bit unsigned integer: (u[1] * 10^19 + u[0]) -> w
+ *
+ */
+static inline void  join_split_decimal( const uint64_t*  u, uint64_t*  w )
+{
+    multiply_128( u[1], POW10_19, w );
+    w[0] += u[0];
+    w[1] += (w[0] < u[0]);
+}
+
+// Decimals just below and just above value with given number of trailing zeros
+// (in convert_wide_binary_to_extended_decimal), all split in two parts
+struct wide_candidates
+{
+    uint64_t  candidate[2][2];   // candidates: multiples of scale
+    uint64_t  distance[2];       // distance from value to the first candidate
+    uint64_t  scale[2];          // 10^n_zeros
+    int       first_is_odd;      // first candidate is odd multiple of scale
+    int       is_inside[2];      // candidate is inside of rounding interval
+};
+
+/**
+ *
+ *  Compute candidates with given number of trailing zeros for convert_wide_binary_to_extended_decimal()
+ *
+ *  Decimals value, lower and upper bound of rounding interval are elements 0, 1 and 2 of array decimals,
+ *  all in units of 10^-t. Candidate is inside of rounding interval if it's far enough from its bounds
+ *  (compared to approximation error 2), otherwise it is converted back to binary and checked exactly.
+ *
+ *  @returns  1  At least one candidate is inside of rounding interval.
+ *            0  No candidates inside of rounding interval.
+ *
+ */
+static int  find_wide_candidates(
+    const uint64_t           (*decimals)[2],
+    int                      n_zeros,
+    int32_t                  t,
+    int                      mantissa_bits,
+    const uint64_t*          expected_c,
+    uint32_t                 expected_d,
+    struct wide_candidates*  out
+)
+{
+    const uint64_t*  value_c = decimals[0];
+    const uint64_t*  lower_c = decimals[1];
+    const uint64_t*  upper_c = decimals[2];
+
+    // 1. Candidates, distance from value to the first one and scale
+    uint64_t  power = 1;
+    for( int  i = ( (n_zeros >= 19) ? 19 : 0 ); i < n_zeros; ++i )
+        power *= 10;
+    if( n_zeros >= 19 )
     {
-        exponent += (ndigits - 1);    // now point is after mantissa, move to the left (after 1st digit)
+        out->scale[1]     = power;
+        out->scale[0]     = 0;
+        out->distance[1]  = value_c[1] % power;
+        out->distance[0]  = value_c[0];
+        out->first_is_odd = (((value_c[1] - out->distance[1]) / power) & 1);
+    }
+    else
+    {
+        out->scale[1]     = 0;
+        out->scale[0]     = power;
+        out->distance[1]  = 0;
+        out->distance[0]  = value_c[0] % power;
+        out->first_is_odd = (((value_c[0] - out->distance[0]) / power) & 1);
+    }
+    out->candidate[0][1] = value_c[1] - out->distance[1];
+    out->candidate[0][0] = value_c[0] - out->distance[0];
+    add_split_decimals( out->candidate[0], out->scale, out->candidate[1] );
 
-        // compute trailing zero padding or truncate digits
-        if( 1 + format_precision >= ndigits )
-            z2 = 1 + format_precision - ndigits;
+    // 2. Check if candidates are inside of rounding interval
+    uint64_t  two[2] = { 2, 0 };
+    uint64_t  lower_plus_2[2], upper_plus_2[2];
+    add_split_decimals( lower_c, two, lower_plus_2 );
+    add_split_decimals( upper_c, two, upper_plus_2 );
+    for( int  j = 0; j < 2; ++j )
+    {
+        const uint64_t*  x = out->candidate[j];
+        uint64_t  x_plus_2[2];
+        add_split_decimals( x, two, x_plus_2 );
+        if(( compare_split_decimals( x_plus_2, lower_c ) < 0 )||
+           ( compare_split_decimals( x, upper_plus_2 ) > 0 ))
+            out->is_inside[j] = 0;
+        else if(( compare_split_decimals( x, lower_plus_2 ) > 0 )&&
+                ( compare_split_decimals( x_plus_2, upper_c ) < 0 ))
+            out->is_inside[j] = 1;
         else
-            ndigits = bcd_round( 1 + format_precision, decimal_mantissa, &exponent );
-
-        format_exponent( suffix, exponent, format_flags & DCONVSTR_FLAG_UPPERCASE );
-        suffix_width = ((int)( strlen( suffix ) ));
+        {
+            uint64_t  x_joined[2];
+            uint64_t  x_c[2];
+            uint32_t  x_d = 0;
+            join_split_decimal( x, x_joined );
+            convert_extended_decimal_to_wide_binary( x_joined, -t, mantissa_bits, x_c, &x_d );
+            out->is_inside[j] = (( x_c[0] == expected_c[0] )&&( x_c[1] == expected_c[1] )&&( x_d == expected_d ));
+        }
     }
-    else if( format_char == 'f' )
+    return  ( out->is_inside[0] || out->is_inside[1] );
+}
+
+/**
+ *
+ *  Convert binary with wide mantissa (x87 extended precision or IEEE 754 quadruple precision)
+ *  to shortest extended-precision decimal
+ *
+ *  (a * 2^b) -> ((c[1] * 10^19 + c[0]) * 10^d)
+ *
+ *  Input a is 128-bit mantissa (a[0] holds 64 least significant bits), 0 < a < 2^mantissa_bits,
+ *  mantissa_bits is 64 for x87 extended precision and 113 for quadruple precision.
+ *  Binary point is on the right side of the input mantissa a.
+ *
+ *  Decimal (c * 10^d) has minimal number of significant digits among decimals which are
+ *  converted back to (a * 2^b) by convert_extended_decimal_to_wide_binary().
+ *  If there are several such decimals, the closest one to (a * 2^b) is chosen (ties are resolved
+ *  exactly when they are possible, i.e. for small exponents).
+ *
+ *  Resulting decimal mantissa has n digits, where n = 21 for x87 extended precision and n = 36
+ *  for quadruple precision (10^(n-1) <= c < 10^n), and it is split in two parts:
+ *  c[1] = c / 10^19, c[0] = c % 10^19. Decimal point is on the right side of decimal mantissa c.
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Invalid argument or internal error.
+ *
+ */
+static int  convert_wide_binary_to_extended_decimal(
+    const uint64_t*  a,
+    int32_t          b,
+    int              mantissa_bits,
+    uint64_t*        c,
+    int32_t*         d
+)
+{
+    // 1. Compute bounds of rounding interval in units of 2^(b-2): (4a - 2) and (4a + 2),
+    //    but lower bound is closer if a is power of two and value is normalized.
+    //    Normalize them to 128 bits, so that 2^127 <= upper < 2^128.
+    int32_t  min_exponent = -16381 - mantissa_bits;
+    if((( a[0] == 0 )&&( a[1] == 0 ))||( b < min_exponent ))
+        return  0;
+    uint64_t  integer_bit[2] = { 0, 0 };
+    integer_bit[(mantissa_bits - 1) / 64] = (1ULL << ((mantissa_bits - 1) % 64));
+    int       is_normalized = (( a[0] & integer_bit[0] )||( a[1] & integer_bit[1] ));
+    uint64_t  expected_c[2] = { a[0], a[1] };
+    uint32_t  expected_d = ( is_normalized ? ((uint32_t)( b - min_exponent + 1 )) : 0 );
+    uint64_t  bounds[3][2];   // value, lower, upper
+    uint64_t  lower_distance = ( (( a[0] == integer_bit[0] )&&( a[1] == integer_bit[1] )&&( b > min_exponent )) ? 1 : 2 );
+    bounds[0][0] = (a[0] << 2);
+    bounds[0][1] = (a[1] << 2) | (a[0] >> 62);
+    bounds[1][0] = bounds[0][0] - lower_distance;
+    bounds[1][1] = bounds[0][1] - (bounds[0][0] < lower_distance);
+    bounds[2][0] = bounds[0][0] + 2;
+    bounds[2][1] = bounds[0][1] + (bounds[2][0] < 2);
+    unsigned int  lz = count_leading_zeros_128( bounds[2] );
+    for( int  j = 0; j < 3; ++j )
     {
-        // determine where digits go with respect to decimal point
-        if( ndigits + exponent > 0 )
+        if( lz >= 64 )
         {
-            point = ndigits + exponent;
-            z1    = 0;
+            bounds[j][1] = (bounds[j][0] << (lz - 64));
+            bounds[j][0] = 0;
         }
-        else
+        else if( lz > 0 )
         {
-            point = 1;
-            z1    = 1 + -(ndigits + exponent);
+            bounds[j][1] = (bounds[j][1] << lz) | (bounds[j][0] >> (64 - lz));
+            bounds[j][0] = (bounds[j][0] << lz);
         }
+    }
+    int32_t  e = b - 2 - ((int32_t)( lz ));
 
-        // %g specifies prec = number of significant digits
-        // convert to number of digits after decimal point
-        if( original_format_char == 'g' )
-            format_precision += (z1 - point);
-
-        // compute trailing zero padding or truncate digits
-        if( point + format_precision >= z1 + ndigits )
-            z2 = point + format_precision - (z1 + ndigits);
-        else
+    // 2. Convert all three to decimals with common exponent: multiply by 10^t, where t is chosen
+    //    so that (value * 2^e * 10^t) has (n + 2) decimal digits: n digits of the longest result and
+    //    two guard digits. Approximation error is less than 2.
+    //    Upper bound (upper * 2^e) < 2^(e+128) < 10^(k+1), k = floor( (e+128) * log10(2) ).
+    //    Decimals are split in two parts: x = x[1] * 10^19 + x[0].
+    int       n_digits = floor_log10_pow2( mantissa_bits ) + 2;
+    uint64_t  min_value_high = 1;   // 10^(n+1) / 10^19, lower bound of value_c[1]
+    for( int  i = 19; i < n_digits + 1; ++i )
+        min_value_high *= 10;
+    int32_t   t = n_digits + 1 - floor_log10_pow2_wide( e + 128 );
+    uint64_t  decimals[3][2];   // value_c, lower_c, upper_c
+    uint64_t  value_fraction = 0;   // fractional part of value_c in units of 2^-64
+    for( int  attempt = 0; ; ++attempt )
+    {
+        uint64_t  power[3];
+        int32_t   power_exponent = 0;
+        if(( attempt > 1 )||(! get_power_of_ten_192( t, power, &power_exponent ) ))
+            return  0;
+        int32_t  shift = -(e + power_exponent) - 64;
+        if(( shift < 0 )||( shift >= 320 ))
+            return  0;
+        for( int  j = 0; j < 3; ++j )
         {
-            int  new_ndigits = point + format_precision - z1;
-            if( new_ndigits < 0 )
-            {
-                z1 += new_ndigits;
-                ndigits = 0;
-            }
-            else if( new_ndigits == 0 )
-            {
-                if( decimal_mantissa[1] >= 5 )
-                {
-                    decimal_mantissa[1] = 1;
-                    ndigits = 1;
-                    if( z1 > 0 )
-                        --z1;
-                    else
-                        ++point;
-                }
-            }
-            else
-            {
-                int  new_exponent = exponent;
-                ndigits = bcd_round( new_ndigits, decimal_mantissa, &new_exponent );
-                for( ; new_exponent > exponent; --new_exponent )
-                {
-                    ++z2;
-                    if( z1 > 0 )
-                        --z1;
-                    else
-                        ++point;
-                }
-            }
+            uint64_t  w[5];
+            multiply_wide( bounds[j], 2, power, 3, w );
+            shift_right_wide( w, 5, shift );
+            if(( w[3] != 0 )||( w[4] != 0 ))
+                return  0;
+            split_decimal( w + 1, decimals[j] );
+            if( j == 0 )
+                value_fraction = w[0];
         }
-        suffix_width = 0;
+        if( decimals[0][1] >= min_value_high )
+            break;
+        ++t;   // first approximation had (n + 1) digits: one more digit is needed
     }
-    else
+    // 3. Find the shortest decimals inside of rounding interval: the ones just below and just above value
+    //    with the largest number of trailing zeros. If there is such decimal with (k + 1) zeros, it also
+    //    has k zeros, and interval always contains decimals with 2 zeros (n significant digits), so search
+    //    starts from 2 zeros and stops at the first number of zeros without suitable candidates.
+    //    Usually it takes two or three steps, since the shortest decimal has n - 1 or n digits.
+    struct wide_candidates  found;
+    if(! find_wide_candidates( (const uint64_t (*)[2])decimals, 2, t, mantissa_bits, expected_c, expected_d, &found ) )
         return  0;
+    for( int  n_zeros = 3; n_zeros <= n_digits + 1; ++n_zeros )
+    {
+        struct wide_candidates  next;
+        if(! find_wide_candidates( (const uint64_t (*)[2])decimals, n_zeros, t, mantissa_bits, expected_c, expected_d, &next ) )
+            break;
+        found = next;
+    }
 
-    // 5. If %g is given without DCONVSTR_FLAG_SHARP, remove trailing zeros.
-    //    Must do after truncation, so that e.g. print %.3g 1.001 produces 1, not 1.00.
-    //    Sorry, but them's the rules.
-    if(( original_format_char == 'g'      )&&
-       ( !(format_flags & DCONVSTR_FLAG_SHARP) )&&
-       ( z1 + ndigits + z2 >= point       ))
+    // 4. Choose the closest candidate inside of rounding interval, ties to even.
+    //    Doubled distance to the first candidate is compared with scale; if they are too close
+    //    to decide, value is compared exactly with the midpoint between candidates.
+    int  chosen = ( found.is_inside[0] ? 0 : 1 );
+    if(( found.is_inside[0] )&&( found.is_inside[1] ))
     {
-        if( z1 + ndigits < point )
-            z2 = point - (z1 + ndigits);
+        uint64_t  four[2] = { 4, 0 };
+        uint64_t  doubled_distance[2], doubled_distance_plus_4[2], scale_plus_4[2];
+        add_split_decimals( found.distance, found.distance, doubled_distance );
+        add_split_decimals( doubled_distance, four, doubled_distance_plus_4 );
+        add_split_decimals( found.scale, four, scale_plus_4 );
+        int  cmp = 0;
+        if( compare_split_decimals( doubled_distance_plus_4, found.scale ) < 0 )
+            cmp = -1;
+        else if( compare_split_decimals( doubled_distance, scale_plus_4 ) > 0 )
+            cmp = 1;
+        else if(( t >= -80 )&&( t <= 80 ))
+        {
+            // compare (candidate[0] + candidate[1]) * 10^-t with 2a * 2^b
+            uint64_t  second[2], doubled_midpoint[2];
+            uint64_t  doubled_value[2] = { (a[0] << 1), (a[1] << 1) | (a[0] >> 63) };
+            join_split_decimal( found.candidate[0], doubled_midpoint );
+            join_split_decimal( found.candidate[1], second );
+            doubled_midpoint[0] += second[0];
+            doubled_midpoint[1] += second[1] + (doubled_midpoint[0] < second[0]);
+            cmp = -compare_extended_decimal_with_binary( doubled_midpoint, -t, doubled_value, b );
+        }
         else
         {
-            z2 = 0;
-            while(( z1 + ndigits > point )&&( decimal_mantissa[ndigits] == 0 ))
-                --ndigits;
+            // exact ties are not possible here, so it's enough to take into account
+            // the fractional part of value: compare (doubled_distance + 2 * fraction) with scale
+            uint64_t  one[2] = { 1, 0 };
+            uint64_t  doubled_distance_plus_1[2];
+            add_split_decimals( doubled_distance, one, doubled_distance_plus_1 );
+            if( compare_split_decimals( doubled_distance, found.scale ) >= 0 )
+                cmp = 1;
+            else if( compare_split_decimals( doubled_distance_plus_1, found.scale ) == 0 )
+                cmp = ( (value_fraction >= (1ULL << 63)) ? 1 : -1 );
+            else
+                cmp = -1;
         }
+        chosen = ( (cmp < 0) ? 0 : ((cmp > 0) ? 1 : found.first_is_odd) );
     }
+    uint64_t  new_mantissa[2] = { found.candidate[chosen][0], found.candidate[chosen][1] };
+    if( new_mantissa[1] == 0 )
+        return  0;
 
-    // 6. Compute width of all digits and decimal point and suffix if any
-    int  total_width = z1 + ndigits + z2;
-    if( total_width > point )
-        total_width += 1;
-    else if( total_width == point )
+    // 5. Perform final normalization (drop guard digits, which are zeros) and offload results
+    for( int  n_zeros = ( (new_mantissa[1] >= 10 * min_value_high) ? 3 : 2 ); n_zeros > 0; --n_zeros )
     {
-        if( format_flags & DCONVSTR_FLAG_SHARP )
-            total_width += 1;
-        else
-            ++point;        // point is not printed at the end
+        new_mantissa[0] = (new_mantissa[1] % 10) * POW10_18 + new_mantissa[0] / 10;
+        new_mantissa[1] /= 10;
+        --t;
     }
-    total_width += suffix_width;
+    c[0] = new_mantissa[0];
+    c[1] = new_mantissa[1];
+    (*d) = -t;
+    return  1;
+}
 
-    // 7. Determine sign
-    int  sign = 0;
-    if( is_negative )
-        sign = '-';
-    else
-    {
-        if( format_flags & DCONVSTR_FLAG_PRINT_PLUS )
-            sign = '+';
-        if( format_flags & DCONVSTR_FLAG_SPACE_IF_PLUS )
-            sign = ' ';
-    }
-    if( sign )
-        ++total_width;
+#endif // DCONVSTR_HAVE_WIDE_BINARY
 
-    // 8. Compute padding
-    int  padding = 0;
-    if(( format_flags & DCONVSTR_FLAG_HAVE_WIDTH )&&( format_width > total_width ))
-        padding = format_width - total_width;
-    if(( padding                                 )&&
-       ( !(format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY) )&&
-       ( format_flags & DCONVSTR_FLAG_PAD_WITH_ZERO   ))
+//=====================================================================================================
+
+/**
+ *
+ *  Unpack floating-point double precision binary value according to IEEE 754
+ *
+ */
+static void  unpack_ieee754_double(
+    const double*  input,
+    int*           out_is_nan,
+    int*           out_sign,
+    uint64_t*      out_binary_mantissa,
+    int32_t*       out_binary_exponent,
+    int*           out_is_infinity
+)
+{
+    // 1. Unpack bits
+    uint64_t  input_bits     = 0;
+    memcpy( &input_bits, input, sizeof(input_bits) );
+    uint64_t  input_sign     = (input_bits >> 63);
+    uint64_t  input_exponent = (input_bits >> 52) & 0x7FFULL;
+    uint64_t  input_mantissa = (input_bits & ((1ULL << 52) - 1ULL));
+
+    // 2. Handle special case: NaN
+    if(( input_exponent == 0x7FFULL )&&( input_mantissa != 0 ))
     {
-        z1     += padding;
-        point  += padding;
-        padding = 0;
+        *out_is_nan          = 1;
+        *out_sign            = 0;
+        *out_is_infinity     = 0;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
+    }
+    *out_is_nan = 0;
+  
+    // 3. Handle special case: +INF/-INF
+    *out_sign = (input_sign != 0);
+    if( input_exponent == 0x7FFULL )
+    {
+        *out_is_infinity     = 1;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
     }
+    *out_is_infinity = 0;
 
-    // 9. Collect everything together and dump to output buffer
-    if(( padding                                      )&&
-       ( !(format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY) )&&
-       ( !format_pad( outbuf, outbuf_size, padding )  ))
-        return  0;
-    if(( sign )&&(! format_onechar( outbuf, outbuf_size, sign ) ))
-        return  0;
-    const unsigned char*  digits = decimal_mantissa + 1;
-    while(( z1 > 0 )||( ndigits > 0 )||( z2 > 0 ))
+    // 4. Handle special case: +0/-0
+    if(( input_exponent == 0 )&&( input_mantissa == 0 ))
     {
-        int  c = '0';
-        if( z1 > 0 )
-            z1--;
-        else if( ndigits > 0 )
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
+    }
+
+    // 5. Handle denormalized numbers
+    if( input_exponent == 0 )
+    {
+        *out_binary_exponent = -1022;
+        *out_binary_mantissa = (input_mantissa << 11);   // most significant 53rd bit of mantissa is always 0
+        return;
+    }
+
+    // 6. Handle normalized numbers
+    *out_binary_exponent = ((int32_t)input_exponent) - 1023;
+    *out_binary_mantissa = (1ULL << 63) | (input_mantissa << 11);   // 53rd bit of mantissa is always 1
+}
+
+/**
+ *
+ *  Pack floating-point double precision binary value according to IEEE 754
+ *
+ *  @returns  0  overflow / underflow condition (when strtod(3) would have set errno = ERANGE).
+ *            1  exited normally, neither overflow nor underflow
+ *
+ */
+static int  pack_ieee754_double(
+    int       input_is_nan,
+    int       input_sign,
+    uint64_t  input_binary_mantissa,
+    int32_t   input_binary_exponent,
+    int       input_is_infinity,
+    double*   output
+)
+{
+    // 1. Initialize values to pack
+    uint64_t  output_sign     = 0;
+    uint64_t  output_exponent = 0;
+    uint64_t  output_mantissa = 0;
+
+    // 2. Handle special case: NaN
+    int  had_overflow_or_underflow_in_exponent = 0;
+    if( input_is_nan )
+    {
+        output_sign     = 1;              // Quiet NaN
+        output_exponent = 0x7FF;
+        output_mantissa = (1ULL << 51);   // mantissa MSB set
+    }
+    else
+    {
+        // 3. Handle special case: +INF/-INF
+        output_sign = (input_sign ? 1 : 0);
+        if( input_is_infinity )
         {
-            ndigits--;
-            c = '0' + (*digits++);
+            output_exponent = 0x7FF;
+            output_mantissa = 0;
+        }
+        // 4. Handle special case: +0/-0
+        else if( input_binary_mantissa == 0 )
+        {
+            output_exponent = 0;
+            output_mantissa = 0;
         }
         else
-            z2--;
-        if(! format_onechar( outbuf, outbuf_size, c ) )
-            return  0;
-        if(( --point == 0 )&&(! format_onechar( outbuf, outbuf_size, '.' ) ))
-            return  0;
+        {
+            unsigned int  lz = count_leading_zeros( input_binary_mantissa );
+            input_binary_mantissa <<= lz;
+            input_binary_exponent  -= lz;
+
+            if( input_binary_exponent > 1023 )
+            {
+                // 5. Handle unintentional infinity (due to exponent overflow)
+                output_exponent = 0x7FF;
+                output_mantissa = 0;
+                had_overflow_or_underflow_in_exponent = 1;
+            }
+            else if( input_binary_exponent >= -1022 )
+            {
+                // 6. Handle normalized numbers
+                output_exponent = ((uint64_t)( input_binary_exponent + 1023 ));
+                output_mantissa = (input_binary_mantissa >> 11) & ((1ULL << 52) - 1ULL);
+            }
+            else
+            {
+                // 7. Handle denormalized numbers
+                //    and unintentional zero (due to exponent underflow)
+                input_binary_mantissa >>= 11;
+                while(( input_binary_mantissa != 0 )&&( input_binary_exponent < -1022 ))
+                {
+                    input_binary_mantissa >>= 1;
+                    ++input_binary_exponent;
+                }
+                output_exponent = 0;
+                output_mantissa = input_binary_mantissa;
+                had_overflow_or_underflow_in_exponent = (input_binary_mantissa == 0);
+                if( input_binary_mantissa != 0 )
+                    DCONVSTR_STATS_INCREMENT( subnormals_packed );
+            }
+        }
     }
-    if(( suffix_width )&&(! format_copystr( outbuf, outbuf_size, suffix, suffix_width ) ))
-        return  0;
-    if(( padding                                     )&&
-       ( format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY   )&&
-       ( !format_pad( outbuf, outbuf_size, padding ) ))
-        return  0;
-    return  1;
+
+    // 8. Pack bits up
+    uint64_t  output_bits = (output_sign << 63) |
+                            ((output_exponent & 0x7FFULL) << 52) |
+                            (output_mantissa & ((1ULL << 52) - 1ULL));
+    memcpy( output, &output_bits, sizeof(output_bits) );
+    return(! had_overflow_or_underflow_in_exponent );
 }
 
 /**
  *
- *  Convert string to IEEE 754 floating-point double precision value
+ *  Unpack IEEE 754-2008 decimal64 value in binary integer decimal (BID) encoding
  *
- *  @param  input          Input buffer, C-style string. Filled by caller.
+ *  Value is (out_decimal_mantissa * 10^out_decimal_exponent), 0 <= out_decimal_mantissa < 10^16.
+ *  Non-canonical mantissas (10^16 or more) are treated as zero, as required by IEEE 754.
  *
- *  @param  input_end      Address of pointer to end of scanned value in input buffer.
- *                         Filled by function if address is not NULL.
+ */
+static void  unpack_decimal64(
+    uint64_t   input_bits,
+    int*       out_is_nan,
+    int*       out_sign,
+    uint64_t*  out_decimal_mantissa,
+    int32_t*   out_decimal_exponent,
+    int*       out_is_infinity
+)
+{
+    // 1. Handle special cases: NaN and +INF/-INF
+    *out_sign             = ((input_bits >> 63) != 0);
+    *out_is_nan           = (((input_bits >> 58) & 0x1F) == 0x1F);
+    *out_is_infinity      = (((input_bits >> 58) & 0x1F) == 0x1E);
+    *out_decimal_mantissa = 0;
+    *out_decimal_exponent = 0;
+    if(( *out_is_nan )||( *out_is_infinity ))
+        return;
+
+    // 2. Handle finite numbers: 10-bit biased exponent is followed either by 53-bit mantissa,
+    //    or (if two bits after sign are both set) by 51 bits of mantissa with implicit prefix 100
+    uint64_t  mantissa = 0;
+    uint32_t  biased_exponent = 0;
+    if((( input_bits >> 61 ) & 3 ) == 3 )
+    {
+        biased_exponent = ((uint32_t)( (input_bits >> 51) & 0x3FF ));
+        mantissa        = (4ULL << 51) | (input_bits & ((1ULL << 51) - 1ULL));
+    }
+    else
+    {
+        biased_exponent = ((uint32_t)( (input_bits >> 53) & 0x3FF ));
+        mantissa        = (input_bits & ((1ULL << 53) - 1ULL));
+    }
+    *out_decimal_mantissa = ( (mantissa < POW10_18 / 100ULL) ? mantissa : 0 );
+    *out_decimal_exponent = ((int32_t)( biased_exponent )) - 398;
+}
+
+/**
  *
- *  @param  output         Conversion result (IEEE 754 floating-point double precision).
- *                         Set to 0.0 if string in input buffer has syntax errors.
+ *  Pack IEEE 754-2008 decimal64 value in binary integer decimal (BID) encoding
  *
- *  @param  output_erange  Address of overflow/underflow flag variable, filled by function.
- *                         0  if there is no overflow/underflow condition
- *                         1  if there is overflow/underflow condition: strtod(3) would set errno = ERANGE
+ *  Value is (input_decimal_mantissa * 10^input_decimal_exponent), where 0 <= input_decimal_mantissa < 10^16
+ *  and -398 <= input_decimal_exponent <= 369 (all finite double values are within these limits).
  *
- *  @returns  1  if there were no internal errors
- *            0  if there was internal error during conversion.
+ */
+static uint64_t  pack_decimal64(
+    int       input_is_nan,
+    int       input_sign,
+    uint64_t  input_decimal_mantissa,
+    int32_t   input_decimal_exponent,
+    int       input_is_infinity
+)
+{
+    uint64_t  output_sign = ( input_sign ? (1ULL << 63) : 0 );
+    if( input_is_nan )
+        return  output_sign | (0x1FULL << 58);   // quiet NaN
+    if( input_is_infinity )
+        return  output_sign | (0x1EULL << 58);
+    uint64_t  biased_exponent = ((uint64_t)( input_decimal_exponent + 398 ));
+    if( input_decimal_mantissa < (1ULL << 53) )
+        return  output_sign | (biased_exponent << 53) | input_decimal_mantissa;
+    else
+        return  output_sign | (3ULL << 61) | (biased_exponent << 51) | (input_decimal_mantissa & ((1ULL << 51) - 1ULL));
+}
+
+/**
  *
- *  In general, interface of this function is similar to strtod(3), except for returning overflow
- *  condition instead of setting errno. If you want just to convert C-style string to double with
- *  error checking, then set input_end != NULL and use ( ret_value != 0 )&&( **input_end == 0 )
- *  condition as an indication of successful conversion.
+ *  Unpack floating-point single precision binary value according to IEEE 754,
+ *  or value of narrower binary format (defined by mantissa_bits and exponent_bits,
+ *  like in convert_extended_decimal_to_ieee754_binary())
+ *
+ *  Unlike unpack_ieee754_double(), binary point is on the right side of the output mantissa,
+ *  and mantissa is not normalized for denormalized numbers.
  *
  */
-int  dconvstr_scan(
-    const char*   input,
-    const char**  input_end,
-    double*       output,
-    int*          output_erange
+static void  unpack_ieee754_float(
+    uint32_t   input_bits,
+    int        mantissa_bits,
+    int        exponent_bits,
+    int*       out_is_nan,
+    int*       out_sign,
+    uint32_t*  out_binary_mantissa,
+    int32_t*   out_binary_exponent,
+    int*       out_is_infinity
 )
 {
-    // 1. Handle special cases
-    if((( input[0] == 'n' )||( input[0] == 'N' ))&&
-       (( input[1] == 'a' )||( input[1] == 'A' ))&&
-       (( input[2] == 'n' )||( input[2] == 'N' )))
+    // 1. Unpack bits
+    uint32_t  max_exponent   = (1U << exponent_bits) - 1U;
+    int32_t   bias           = (1 << (exponent_bits - 1)) - 1;
+    uint32_t  input_sign     = (input_bits >> (mantissa_bits + exponent_bits - 1)) & 1U;
+    uint32_t  input_exponent = (input_bits >> (mantissa_bits - 1)) & max_exponent;
+    uint32_t  input_mantissa = (input_bits & ((1U << (mantissa_bits - 1)) - 1U));
+
+    // 2. Handle special case: NaN
+    if(( input_exponent == max_exponent )&&( input_mantissa != 0 ))
     {
-        if( input_end )
-            *input_end = input + 3;
+        *out_is_nan          = 1;
+        *out_sign            = 0;
+        *out_is_infinity     = 0;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
+    }
+    *out_is_nan = 0;
 
-        pack_ieee754_double(
-            1,      // input_is_nan
-            0,      // input_sign
-            0,      // input_binary_mantissa
-            0,      // input_binary_exponent
-            0,      // input_is_infinity
-            output
-        );
-        *output_erange = 0;
-        return  1;
+    // 3. Handle special case: +INF/-INF
+    *out_sign = (input_sign != 0);
+    if( input_exponent == max_exponent )
+    {
+        *out_is_infinity     = 1;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
     }
-    else if((( input[0] == 'i' )||( input[0] == 'I' ))&&
-            (( input[1] == 'n' )||( input[1] == 'N' ))&&
-            (( input[2] == 'f' )||( input[2] == 'F' )))
+    *out_is_infinity = 0;
+
+    // 4. Handle denormalized numbers and special case: +0/-0
+    if( input_exponent == 0 )
     {
-        if( input_end )
-            *input_end = input + 3;
-
-        pack_ieee754_double(
-            0,      // input_is_nan
-            0,      // input_sign
-            0,      // input_binary_mantissa
-            0,      // input_binary_exponent
-            1,      // input_is_infinity
-            output
-        );
-        *output_erange = 0;
-        return  1;
+        *out_binary_exponent = (input_mantissa == 0) ? 0 : (2 - bias - mantissa_bits);
+        *out_binary_mantissa = input_mantissa;
+        return;
     }
-    else if(( input[0] == '-' )&&
-            (( input[1] == 'i' )||( input[1] == 'I' ))&&
-            (( input[2] == 'n' )||( input[2] == 'N' ))&&
-            (( input[3] == 'f' )||( input[3] == 'F' )))
-    {
-        if( input_end )
-            *input_end = input + 4;
 
-        pack_ieee754_double(
-            0,      // input_is_nan
-            1,      // input_sign
-            0,      // input_binary_mantissa
-            0,      // input_binary_exponent
-            1,      // input_is_infinity
-            output
-        );
-        *output_erange = 0;
-        return  1;
-    }
+    // 5. Handle normalized numbers
+    *out_binary_exponent = ((int32_t)( input_exponent )) + 1 - bias - mantissa_bits;
+    *out_binary_mantissa = (1U << (mantissa_bits - 1)) | input_mantissa;   // highest bit of mantissa is always 1
+}
 
-    // 2. Parse input string
-    //    (Code from this section was adopted from http://golang.org/src/lib9/fmt/fltfmt.c)
-    uint8_t  parsed_digits[20];
-    int      n_parsed_digits        = 0;      // number of digits in parsed_digits[]
-    int32_t  exponent               = 0;
-    int32_t  exponent_offset        = 0;
-    int      flag_negative_mantissa = 0;
-    int      flag_negative_exponent = 0;
-    int      flag_syntax_error      = 0;
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
 
-    enum parser_state  state = S0;
-        // S0: _          _S0   +S1   #S2   .S3
-        // S1: _+         #S2   .S3
-        // S2: _+#        #S2   .S4   eS5
-        // S3: _+#.       #S4
-        // S4: _+#.#      #S4   eS5
-        // S5: _+#.#e     +S6   #S7
-        // S6: _+#.#e+    #S7
-        // S7: _+#.#e+#   #S7
-    const char*  s = input;
-    while(( !flag_syntax_error )&&( *s ))
+/**
+ *
+ *  Unpack x87 80-bit extended precision binary value
+ *
+ *  Binary point is on the right side of the output mantissa, like in unpack_ieee754_float().
+ *  Invalid encodings (pseudo-NaN, pseudo-infinity, unnormal) are reported as NaN,
+ *  like x87 FPU treats them.
+ *
+ */
+static void  unpack_x87_extended(
+    const long double*  input,
+    int*                out_is_nan,
+    int*                out_sign,
+    uint64_t*           out_binary_mantissa,
+    int32_t*            out_binary_exponent,
+    int*                out_is_infinity
+)
+{
+    // 1. Unpack bits: 64-bit mantissa with explicit integer bit, then 15-bit exponent and sign bit
+    uint64_t  input_mantissa = 0;
+    uint16_t  input_sign_and_exponent = 0;
+    memcpy( &input_mantissa, input, sizeof(input_mantissa) );
+    memcpy( &input_sign_and_exponent, ((const char*)input) + sizeof(input_mantissa), sizeof(input_sign_and_exponent) );
+    uint32_t  input_exponent = input_sign_and_exponent & 0x7FFFU;
+    *out_sign = ( (input_sign_and_exponent >> 15) != 0 );
+
+    // 2. Handle special cases: NaN and +INF/-INF
+    *out_is_nan      = 0;
+    *out_is_infinity = 0;
+    if((( input_exponent == 0x7FFFU )&&( input_mantissa != (1ULL << 63) ))||
+       (( input_exponent != 0 )&&(!( input_mantissa >> 63 ))))
     {
-        char  ch = *s;
-        switch( state )
-        {
-            // State 0: skip leading whitespaces, before mantissa sign and digits
-            case S0:
-                if(( ch == ' ' )||( ch == '\t' ))
-                    ++s;  // remain in state S0
-                else if( ch == '-' )
-                {
-                    ++s;
-                    state = S1;
-                    flag_negative_mantissa = 1;
-                }
-                else if( ch == '+' )
-                {
-                    ++s;
-                    state = S1;
-                }
-                else if(( ch >= '0' )&&( ch <= '9' ))
-                {
-                    state = S2;
-                }
-                else if( ch == '.' )
-                {
-                    ++s;
-                    state = S3;
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+        *out_is_nan          = 1;
+        *out_sign            = 0;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
+    }
+    if( input_exponent == 0x7FFFU )
+    {
+        *out_is_infinity     = 1;
+        *out_binary_exponent = 0;
+        *out_binary_mantissa = 0;
+        return;
+    }
 
-            // State 1: after mantissa sign, before mantissa digits
-            case S1:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                    state = S2;
-                else if( ch == '.' )
-                {
-                    ++s;
-                    state = S3;
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+    // 3. Handle denormalized numbers and special case: +0/-0
+    if( input_exponent == 0 )
+    {
+        *out_binary_exponent = (input_mantissa == 0) ? 0 : -16445;
+        *out_binary_mantissa = input_mantissa;
+        return;
+    }
 
-            // State 2: parsing mantissa digits before point
-            case S2:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                {
-                    ++s;
-                    if( n_parsed_digits < ((int)( sizeof(parsed_digits) )) )
-                    {
-                        parsed_digits[n_parsed_digits] = ch - '0';
-                        if(( ch != '0' )||( n_parsed_digits != 0 ))
-                            ++n_parsed_digits;
-                    }
-                    else
-                        ++exponent_offset;
-                }
-                else if( ch == '.' )
-                {
-                    ++s;
-                    state = S3;
-                }
-                else if(( ch == 'e' )||( ch == 'E' ))
-                {
-                    ++s;
-                    state = S5;
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+    // 4. Handle normalized numbers
+    *out_binary_exponent = ((int32_t)( input_exponent )) - 16446;
+    *out_binary_mantissa = input_mantissa;
+}
 
-            // State 3: parsing first mantissa digit just after the point
-            case S3:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                    state = S4;
-                else
-                    flag_syntax_error = 1;
-                break;
+/**
+ *
+ *  Pack x87 80-bit extended precision binary value
+ *
+ *  Mantissa includes explicit integer bit, exponent is biased (like in output of
+ *  convert_extended_decimal_to_x87_extended()).
+ *
+ */
+static void  pack_x87_extended(
+    int           input_sign,
+    uint64_t      input_mantissa,
+    uint32_t      input_biased_exponent,
+    long double*  output
+)
+{
+    uint16_t  output_sign_and_exponent = ((uint16_t)( (input_biased_exponent & 0x7FFFU) | (input_sign ? 0x8000U : 0) ));
+    memcpy( output, &input_mantissa, sizeof(input_mantissa) );
+    memcpy( ((char*)output) + sizeof(input_mantissa), &output_sign_and_exponent, sizeof(output_sign_and_exponent) );
+}
 
-            // State 4: parsing mantissa digits after the point
-            case S4:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                {
-                    ++s;
-                    if( n_parsed_digits < ((int)( sizeof(parsed_digits) )) )
-                    {
-                        parsed_digits[n_parsed_digits] = ch - '0';
-                        if(( ch != '0' )||( n_parsed_digits != 0 ))
-                            ++n_parsed_digits;
-                        --exponent_offset;
-                    }
-                }
-                else if(( ch == 'e' )||( ch == 'E' ))
-                {
-                    ++s;
-                    state = S5;
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+#endif // DCONVSTR_HAVE_LONG_DOUBLE_X87
 
-            // State 5: parsing sign after the exponent
-            case S5:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                    state = S7;
-                else if( ch == '+' )
-                {
-                    ++s;
-                    state = S6;
-                }
-                else if( ch == '-' )
-                {
-                    ++s;
-                    state = S6;
-                    flag_negative_exponent = 1;
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+#ifdef DCONVSTR_HAVE_FLOAT128
 
-            // State 6: parsing first digits after exponent sign
-            case S6:
-                if(( ch >= '0' )&&( ch <= '9' ))
-                    state = S7;
-                else
-                    flag_syntax_error = 1;
-                break;
+/**
+ *
+ *  Unpack IEEE 754 quadruple precision binary value
+ *
+ *  Output mantissa is 128-bit unsigned integer (out_binary_mantissa[0] holds 64 least significant bits)
+ *  with hidden bit made explicit. Binary point is on the right side of the output mantissa,
+ *  like in unpack_ieee754_float().
+ *
+ */
+static void  unpack_ieee754_quadruple(
+    const __float128*  input,
+    int*               out_is_nan,
+    int*               out_sign,
+    uint64_t*          out_binary_mantissa,
+    int32_t*           out_binary_exponent,
+    int*               out_is_infinity
+)
+{
+    // 1. Unpack bits (little endian): 112-bit mantissa, then 15-bit exponent and sign bit
+    uint64_t  input_bits[2];
+    memcpy( input_bits, input, sizeof(input_bits) );
+    uint32_t  input_exponent = ((uint32_t)( input_bits[1] >> 48 )) & 0x7FFFU;
+    *out_sign = ( (input_bits[1] >> 63) != 0 );
+    out_binary_mantissa[0] = input_bits[0];
+    out_binary_mantissa[1] = input_bits[1] & ((1ULL << 48) - 1ULL);
 
-            // State 7: parsing exponent digits
-            case S7:
-                if(( ch >= '0' )&&( ch <= '9' )) 
-                {
-                    ++s;
-                    if( exponent < 350 )
-                    {
-                        // we aim to avoid overflow/underflow of the exponent 
-                        // by using ( exponent >= 350 ) condition as overflow/underflow flag
-                        exponent = (exponent * 10) + (ch - '0');
-                    }
-                }
-                else
-                    flag_syntax_error = 1;
-                break;
+    // 2. Handle special cases: NaN and +INF/-INF
+    *out_is_nan      = 0;
+    *out_is_infinity = 0;
+    if( input_exponent == 0x7FFFU )
+    {
+        if(( out_binary_mantissa[0] != 0 )||( out_binary_mantissa[1] != 0 ))
+        {
+            *out_is_nan = 1;
+            *out_sign   = 0;
         }
+        else
+            *out_is_infinity = 1;
+        *out_binary_exponent   = 0;
+        out_binary_mantissa[0] = 0;
+        out_binary_mantissa[1] = 0;
+        return;
     }
-    if((! flag_syntax_error )&&(( state == S0 )||( state == S1 )||( state == S3 )||
-                                ( state == S5 )||( state == S6 )))
-        flag_syntax_error = 1;
-    if( input_end )
-        *input_end = flag_syntax_error ? input : s;
 
-    // 3. Zero out the tail of mantissa.
-    //    Move decimal point to the right side of mantissa (adjust exponent offset).
-    //    Get rid of last mantissa digit, set first one to zero, and compress BCD representation of mantissa.
-    if( n_parsed_digits < ((int)( sizeof(parsed_digits) )) )
+    // 3. Handle denormalized numbers and special case: +0/-0
+    if( input_exponent == 0 )
     {
-        int  delta = sizeof(parsed_digits) - n_parsed_digits;
-        memset( parsed_digits + n_parsed_digits, 0, delta );
-        n_parsed_digits += delta;
-        exponent_offset -= delta;
+        *out_binary_exponent = (( out_binary_mantissa[0] == 0 )&&( out_binary_mantissa[1] == 0 )) ? 0 : -16494;
+        return;
     }
-    memmove( parsed_digits + 1, parsed_digits, sizeof(parsed_digits) - 1 ); 
-    parsed_digits[0] = 0;
-    ++exponent_offset;
-    uint64_t  mantissa = bcd_compress( parsed_digits );
 
-    // 4. Compute exponent
-    if( mantissa == 0 )
-        exponent = 0;
-    else
-        exponent = ( (exponent < 350) ? exponent_offset : 0 ) +
-                   ( flag_negative_exponent ? -exponent : exponent );
+    // 4. Handle normalized numbers
+    *out_binary_exponent = ((int32_t)( input_exponent )) - 16495;
+    out_binary_mantissa[1] |= (1ULL << 48);   // highest bit of mantissa is always 1
+}
 
-    // 5. Check exponent for overflow and underflow
-    if( exponent <= -350 )
-    {
-        pack_ieee754_double(
-            0,                       // input_is_nan
-            flag_negative_mantissa,  // input_sign
-            0,                       // input_binary_mantissa
-            0,                       // input_binary_exponent
-            0,                       // input_is_infinity
-            output
-        );
-        *output_erange = 1;      // strtod(3) would set errno = ERANGE
-        return  1;
-    }
-    else if( exponent >= 350 )
-    {
-        pack_ieee754_double(
-            0,                       // input_is_nan
-            flag_negative_mantissa,  // input_sign
-            0,                       // input_binary_mantissa
-            0,                       // input_binary_exponent
+/**
+ *
+ *  Pack IEEE 754 quadruple precision binary value
+ *
+ *  Mantissa includes integer bit (which is hidden in packed value), exponent is biased
+ *  (like in output of convert_extended_decimal_to_wide_binary()).
+ *
+ */
+static void  pack_ieee754_quadruple(
+    int              input_sign,
+    const uint64_t*  input_mantissa,
+    uint32_t         input_biased_exponent,
+    __float128*      output
+)
+{
+    uint64_t  output_bits[2];
+    output_bits[0] = input_mantissa[0];
+    output_bits[1] = (input_mantissa[1] & ((1ULL << 48) - 1ULL)) |
+                     (((uint64_t)( input_biased_exponent & 0x7FFFU )) << 48) |
+                     (input_sign ? (1ULL << 63) : 0);
+    memcpy( output, output_bits, sizeof(output_bits) );
+}
+
+#endif // DCONVSTR_HAVE_FLOAT128
+
+
+/**
+ *
+ *  Decompress small integer in range 0..9999 to four-digit BCD representation
+ *
+ */
+static inline void  bcd_decompress_small(
+    uint32_t  compressed_bcd,
+    uint8_t*  decompressed_bcd
+)
+{
+    uint32_t  high_pair = compressed_bcd / 100;
+    uint32_t  low_pair  = compressed_bcd % 100;
+
+    decompressed_bcd[0] = ((uint8_t)( high_pair / 10 ));
+    decompressed_bcd[1] = ((uint8_t)( high_pair % 10 ));
+    decompressed_bcd[2] = ((uint8_t)( low_pair  / 10 ));
+    decompressed_bcd[3] = ((uint8_t)( low_pair  % 10 ));
+}
+
+/**
+ *
+ *  Decompress full range unsigned 64-bit integer to twenty-digit BCD representation
+ *
+ *  This implementation was written by Douglas W. Jones, it was taken from
+ *  http://homepage.cs.uiowa.edu/~jones/bcd/decimal.html#sixtyfour
+ *
+ */
+static void  bcd_decompress(
+    uint64_t  compressed_bcd,
+    uint8_t*  decompressed_bcd
+)
+{
+    uint32_t  d0 = compressed_bcd         & 0xFFFF;
+    uint32_t  d1 = (compressed_bcd >> 16) & 0xFFFF;
+    uint32_t  d2 = (compressed_bcd >> 32) & 0xFFFF;
+    uint32_t  d3 = (compressed_bcd >> 48) & 0xFFFF;
+
+              d0 = 656 * d3 + 7296 * d2 + 5536 * d1 + d0;
+    uint32_t  q  = d0 / 10000;
+              d0 = d0 % 10000;
+
+              d1 = q + 7671 * d3 + 9496 * d2 + 6 * d1;
+              q  = d1 / 10000;
+              d1 = d1 % 10000;
+
+              d2 = q + 4749 * d3 + 42 * d2;
+              q  = d2 / 10000;
+              d2 = d2 % 10000;
+
+              d3 = q + 281 * d3;
+              q  = d3 / 10000;
+              d3 = d3 % 10000;
+
+    bcd_decompress_small( q,  decompressed_bcd      );
+    bcd_decompress_small( d3, decompressed_bcd + 4  );
+    bcd_decompress_small( d2, decompressed_bcd + 8  );
+    bcd_decompress_small( d1, decompressed_bcd + 12 );
+    bcd_decompress_small( d0, decompressed_bcd + 16 );
+}
+
+/**
+ *
+ *  Compress four-digit BCD representation to small integer in range 0..9999
+ *
+ */
+static inline uint32_t  bcd_compress_small( const uint8_t*  decompressed_bcd )
+{
+    uint32_t  high_pair = 10 * decompressed_bcd[0] + decompressed_bcd[1];
+    uint32_t  low_pair  = 10 * decompressed_bcd[2] + decompressed_bcd[3];
+    return  100 * high_pair + low_pair;
+}
+
+/**
+ *
+ *  Compress twenty-digit BCD representation to full range unsigned 64-bit integer
+ *
+ */
+static uint64_t  bcd_compress( const uint8_t*  decompressed_bcd )
+{
+    uint64_t  d2 =         bcd_compress_small( decompressed_bcd      );
+    uint64_t  d1 = 10000 * bcd_compress_small( decompressed_bcd + 4  )
+                         + bcd_compress_small( decompressed_bcd + 8  );
+    uint64_t  d0 = 10000 * bcd_compress_small( decompressed_bcd + 12 )
+                         + bcd_compress_small( decompressed_bcd + 16 );
+    return  ((d2 * (10000ULL * 10000ULL) + d1) * (10000ULL * 10000ULL)) + d0;
+}
+
+/**
+ *
+ *  Round BCD representation of (1 + ndigits) digits to given number of significant digits
+ *
+ *  Most significant digit must be always equal to zero.
+ *  Therefore, number of significant digits can be in range from 1 to ndigits
+ *  (ndigits is 19 for single and double precision values, 21 for extended precision).
+ *
+ *  @returns  Adjusted number of significant decimal digits
+ *
+ */
+static int  bcd_round( int  new_ndigits, int  ndigits, uint8_t*  decimal_mantissa, int32_t*  exponent )
+{
+    // 1. Bounds check and adjustment
+    if( new_ndigits < 1 )
+        new_ndigits = 1;
+    else if( new_ndigits > ndigits )
+        new_ndigits = ndigits;
+
+    if( new_ndigits < ndigits )
+    {
+        for( ;; )
+        {
+            // 2. Compute round-up flag
+            int  round_up = ( decimal_mantissa[1 + new_ndigits] >= 5 );
+
+            // 3. Zero out the tail
+            for( int  i = 1 + new_ndigits; i <= ndigits; ++i )
+                decimal_mantissa[i] = 0;
+
+            // 4. Make round-up if necessary
+            if(! round_up )
+                break;
+            for( int  i = new_ndigits; i >= 0; --i )
+            {
+                uint8_t  new_value = decimal_mantissa[i] + 1;
+                if( new_value < 10 )
+                {
+                    decimal_mantissa[i] = new_value;
+                    break;
+                }
+                decimal_mantissa[i] = 0;
+            }
+
+            // 5. Handle overflow
+            if( decimal_mantissa[0] == 0 )
+                break;     // no overflow
+            else
+            {
+                DCONVSTR_STATS_INCREMENT( bcd_round_carries );
+                memmove( decimal_mantissa + 1, decimal_mantissa, ndigits );
+                decimal_mantissa[0] = 0;
+                ++( *exponent );
+                // if there was an overflow, then make one more iteration
+            }
+        }
+    }
+
+    // 6. Return adjusted number of significant decimal digits to the caller
+    return  new_ndigits;
+}
+
+//=====================================================================================================
+
+/**
+ *
+ *  Helper formatting function: Print given number of whitespaces to output buffer
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Overflow in the output buffer.
+ *
+ */
+static int  format_pad( char**  outbuf, int*  outbuf_size, int  n )
+{
+    if( *outbuf_size < n )
+        return  0;
+    else
+    {
+        *outbuf_size -= n;
+        char*  p = *outbuf;
+        while( n-- > 0 )
+            *p++ = ' ';
+        *outbuf = p;
+        return  1;
+    }
+}
+
+/**
+ *
+ *  Helper formatting function: Print one character to output buffer
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Overflow in the output buffer.
+ *
+ */
+static int  format_onechar( char**  outbuf, int*  outbuf_size, int  c )
+{
+    if( *outbuf_size <= 0 )
+        return  0;
+    else
+    {
+        *((*outbuf)++) = ((char)c);
+        --(*outbuf_size);
+        return  1;
+    }
+}
+
+/**
+ *
+ *  Helper formatting function: Print given string to output buffer
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Overflow in the output buffer.
+ *
+ */
+static int  format_copystr( char**  outbuf, int*  outbuf_size, const char*  str, int  str_size )
+{
+    if( *outbuf_size < str_size )
+        return  0;
+    else
+    {
+        *outbuf_size -= str_size;
+        char*  p = *outbuf;
+        while( str_size-- > 0 )
+            *p++ = *str++;
+        *outbuf = p;
+        return  1;
+    }
+}
+
+/**
+ *
+ *  Helper formatting function: Print exponent like sprintf( p, "e%+02d", e )
+ *
+ *  There must be at least 16 bytes in the output buffer.
+ *
+ */
+static void  format_exponent( char*  buffer, int32_t  exponent, int  is_uppercase )
+{
+    char  tmp_buffer[12];
+
+    *buffer++ = (is_uppercase ? 'E' : 'e');
+    if( exponent < 0 )
+    {
+        *buffer++ = '-';
+        exponent = -exponent;
+    }
+    else
+        *buffer++ = '+';
+
+    int  i = 0;
+    while(( exponent > 0 )&&( i < 12 ))
+    {
+        tmp_buffer[i++] = ((char)( (exponent % 10) + '0' ));
+        exponent /= 10;
+    }
+    while( i < 2 )
+        tmp_buffer[i++] = '0';
+    while( i > 0 )
+        *buffer++ = tmp_buffer[--i];
+    *buffer = 0;
+}
+
+/**
+ *
+ *  Print decimal value to string according to printf(3)-like format specification
+ *
+ *  Decimal point is located on the right side of decimal mantissa, which is given as
+ *  BCD representation of (1 + mantissa_ndigits) digits: decimal_mantissa[0] == 0,
+ *  decimal_mantissa[1] != 0 (unless value is zero). Decimal mantissa is modified by this function.
+ *
+ *  @returns  1  Exited normally, no errors.
+ *            0  Overflow in the output buffer or invalid format.
+ *
+ */
+static int  format_decimal(
+    char**        outbuf,
+    int*          outbuf_size,
+    int           is_nan,
+    int           is_negative,
+    int           is_infinity,
+    uint8_t*      decimal_mantissa,
+    int           mantissa_ndigits,
+    int32_t       exponent,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    // 1. Handle special cases
+    if( is_nan )
+    {
+        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
+            return  format_copystr( outbuf, outbuf_size, "NAN", 3 );
+        else
+            return  format_copystr( outbuf, outbuf_size, "nan", 3 );
+    }
+    if(( is_infinity )&&( !is_negative ))
+    {
+        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
+            return  format_copystr( outbuf, outbuf_size, "INF", 3 );
+        else
+            return  format_copystr( outbuf, outbuf_size, "inf", 3 );
+    }
+    if(( is_infinity )&&( is_negative ))
+    {
+        if( format_flags & DCONVSTR_FLAG_UPPERCASE )
+            return  format_copystr( outbuf, outbuf_size, "-INF", 4 );
+        else
+            return  format_copystr( outbuf, outbuf_size, "-inf", 4 );
+    }
+
+    // 2. Compute the following fields:
+    //    z1      - number of zeros inserted before the digits
+    //    z2      - number of zeros inserted after the digits
+    //    point   - number of digits printed before decimal point
+    //    ndigits - number of digits to print from decimal_mantissa[1..mantissa_ndigits].
+    //    suffix  - formatted exponent like "e-5"
+    //    (Code from this section was adopted from http://golang.org/src/lib9/fmt/fltfmt.c)
+    int   point   = 1;
+    int   z1      = 0;
+    int   z2      = 0;
+    int   ndigits = mantissa_ndigits;   // initially we have all digits (most significant zero digit is ignored)
+    char  suffix[16];
+    int   suffix_width = 0;
+
+    int  original_format_char = format_char;
+    if( format_char == 'g' )
+    {
+        // get rid of excess precision
+        if( format_precision == 0 )
+            format_precision = 1;
+        if( format_precision < ndigits )
+        {
+            exponent += (ndigits - format_precision);  // retain invariant "point after mantissa"
+            ndigits = bcd_round( format_precision, mantissa_ndigits, decimal_mantissa, &exponent );
+        }
+    
+        // choose format: e or f
+        int  e = exponent + (ndigits - 1);  // now point is after mantissa, move to the left (after 1st digit)
+        if(( e >= -4 )&&( e < format_precision ))    // so printf(3) rules say
+        {
+            format_char = 'f';
+        }
+        else
+        {
+            format_char = 'e';
+            --format_precision;             // one digit before the point, rest after
+        }
+    }
+
+    if( format_char == 'e' )
+    {
+        exponent += (ndigits - 1);    // now point is after mantissa, move to the left (after 1st digit)
+
+        // compute trailing zero padding or truncate digits
+        if( 1 + format_precision >= ndigits )
+            z2 = 1 + format_precision - ndigits;
+        else
+            ndigits = bcd_round( 1 + format_precision, mantissa_ndigits, decimal_mantissa, &exponent );
+
+        format_exponent( suffix, exponent, format_flags & DCONVSTR_FLAG_UPPERCASE );
+        suffix_width = ((int)( strlen( suffix ) ));
+    }
+    else if( format_char == 'f' )
+    {
+        // determine where digits go with respect to decimal point
+        if( ndigits + exponent > 0 )
+        {
+            point = ndigits + exponent;
+            z1    = 0;
+        }
+        else
+        {
+            point = 1;
+            z1    = 1 + -(ndigits + exponent);
+        }
+
+        // %g specifies prec = number of significant digits
+        // convert to number of digits after decimal point
+        if( original_format_char == 'g' )
+            format_precision += (z1 - point);
+
+        // compute trailing zero padding or truncate digits
+        if( point + format_precision >= z1 + ndigits )
+            z2 = point + format_precision - (z1 + ndigits);
+        else
+        {
+            int  new_ndigits = point + format_precision - z1;
+            if( new_ndigits < 0 )
+            {
+                z1 += new_ndigits;
+                ndigits = 0;
+            }
+            else if( new_ndigits == 0 )
+            {
+                if( decimal_mantissa[1] >= 5 )
+                {
+                    decimal_mantissa[1] = 1;
+                    ndigits = 1;
+                    if( z1 > 0 )
+                        --z1;
+                    else
+                        ++point;
+                }
+                else
+                    ndigits = 0;
+            }
+            else
+            {
+                int  new_exponent = exponent;
+                ndigits = bcd_round( new_ndigits, mantissa_ndigits, decimal_mantissa, &new_exponent );
+                for( ; new_exponent > exponent; --new_exponent )
+                {
+                    ++z2;
+                    if( z1 > 0 )
+                        --z1;
+                    else
+                        ++point;
+                }
+            }
+        }
+        suffix_width = 0;
+    }
+    else
+        return  0;
+
+    // 3. If %g is given without DCONVSTR_FLAG_SHARP, remove trailing zeros.
+    //    Must do after truncation, so that e.g. print %.3g 1.001 produces 1, not 1.00.
+    //    Sorry, but them's the rules.
+    if(( original_format_char == 'g'      )&&
+       ( !(format_flags & DCONVSTR_FLAG_SHARP) )&&
+       ( z1 + ndigits + z2 >= point       ))
+    {
+        if( z1 + ndigits < point )
+            z2 = point - (z1 + ndigits);
+        else
+        {
+            z2 = 0;
+            while(( z1 + ndigits > point )&&( decimal_mantissa[ndigits] == 0 ))
+                --ndigits;
+        }
+    }
+
+    // 4. Compute width of all digits and decimal point and suffix if any
+    int  total_width = z1 + ndigits + z2;
+    if( total_width > point )
+        total_width += 1;
+    else if( total_width == point )
+    {
+        if( format_flags & DCONVSTR_FLAG_SHARP )
+            total_width += 1;
+        else
+            ++point;        // point is not printed at the end
+    }
+    total_width += suffix_width;
+
+    // 5. Determine sign
+    int  sign = 0;
+    if( is_negative )
+        sign = '-';
+    else
+    {
+        if( format_flags & DCONVSTR_FLAG_PRINT_PLUS )
+            sign = '+';
+        else if( format_flags & DCONVSTR_FLAG_SPACE_IF_PLUS )    // space is ignored if plus is given
+            sign = ' ';
+    }
+    if( sign )
+        ++total_width;
+
+    // 6. Compute padding
+    int  padding = 0;
+    if(( format_flags & DCONVSTR_FLAG_HAVE_WIDTH )&&( format_width > total_width ))
+        padding = format_width - total_width;
+    if(( padding                                 )&&
+       ( !(format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY) )&&
+       ( format_flags & DCONVSTR_FLAG_PAD_WITH_ZERO   ))
+    {
+        z1     += padding;
+        point  += padding;
+        padding = 0;
+    }
+
+    // 7. Collect everything together and dump to output buffer
+    if(( padding                                      )&&
+       ( !(format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY) )&&
+       ( !format_pad( outbuf, outbuf_size, padding )  ))
+        return  0;
+    if(( sign )&&(! format_onechar( outbuf, outbuf_size, sign ) ))
+        return  0;
+    const unsigned char*  digits = decimal_mantissa + 1;
+    while(( z1 > 0 )||( ndigits > 0 )||( z2 > 0 ))
+    {
+        int  c = '0';
+        if( z1 > 0 )
+            z1--;
+        else if( ndigits > 0 )
+        {
+            ndigits--;
+            c = '0' + (*digits++);
+        }
+        else
+            z2--;
+        if(! format_onechar( outbuf, outbuf_size, c ) )
+            return  0;
+        if(( --point == 0 )&&(! format_onechar( outbuf, outbuf_size, '.' ) ))
+            return  0;
+    }
+    if(( suffix_width )&&(! format_copystr( outbuf, outbuf_size, suffix, suffix_width ) ))
+        return  0;
+    if(( padding                                     )&&
+       ( format_flags & DCONVSTR_FLAG_LEFT_JUSTIFY   )&&
+       ( !format_pad( outbuf, outbuf_size, padding ) ))
+        return  0;
+    return  1;
+}
+
+/**
+ *
+ *  Print IEEE 754 floating-point double precision value to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *
+ */
+static int  print_double(
+    char**        outbuf,
+    int*          outbuf_size,
+    double        value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    // 1. Unpack double precision value
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    unpack_ieee754_double( &value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+
+    // 2. Get exact decimal representation.
+    //    Decimal point is located on the right side of decimal mantissa
+    uint8_t  decimal_mantissa[20];
+    if( mantissa == 0 )
+    {
+        if(( is_nan )||( is_infinity ))
+            DCONVSTR_STATS_INCREMENT( special_values );
+        else
+            DCONVSTR_STATS_INCREMENT( zeros );
+        memset( decimal_mantissa, 0, sizeof(decimal_mantissa) );
+        exponent = -18;
+    }
+    else
+    {
+        if(! convert_binary_to_extended_decimal( mantissa, exponent, &mantissa, &exponent ) )
+            return  0;    // internal error during conversion
+        bcd_decompress( mantissa, decimal_mantissa );
+        if(( decimal_mantissa[0] != 0 )||( decimal_mantissa[1] == 0 ))
+            return  0;    // invariant does not hold : mantissa >= 10^19 || mantissa < 10^18
+    }
+
+    // 3. Print decimal representation
+    return  format_decimal( outbuf, outbuf_size, is_nan, is_negative, is_infinity, decimal_mantissa, 19,
+                            exponent, format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Print IEEE 754 floating-point double precision value to string
+ *
+ *  @param  outbuf            Address of variable with a pointer to output buffer filled by the function.
+ *                            On entry, this variable is initialized by caller.
+ *                            On exit, this variable points to the end of printed string.
+ *                           
+ *  @param  outbuf_size       Size of output buffer filled by the function.
+ *                            On entry, this variable is initialized by caller to maximum allowed size.
+ *                            On exit, this variable contains size of unused portion of the output buffer.
+ *                           
+ *  @param  value             Input value (IEEE 754 floating-point double precision).
+ *                           
+ *  @param  format_char       Format char. Either 'e', or 'f', or 'g'. Refer to printf(3) manual for details.
+ *                           
+ *  @param  format_flags      Any combination of the above (DCONVSTR_FLAG_*).
+ *                           
+ *  @param  format_width      Format width. Used only if DCONVSTR_FLAG_HAVE_WIDTH bit is set in flags.
+ *                            Refer to printf(3) manual for details.
+ *
+ *  @param  format_precision  Format precision. Set it to DCONVSTR_DEFAULT_PRECISION if unsure.
+ *                            Refer to printf(3) manual for details.
+ *
+ *  @returns  1  if value was successfully converted to string.
+ *            0  if there is not enough room in buffer or internal error happened during conversion.
+ *
+ */
+DCONVSTR_API int  dconvstr_print(
+    char**        outbuf,
+    int*          outbuf_size,
+    double        value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+#ifdef DCONVSTR_ENABLE_PROBES
+    const char*  outbuf_start = *outbuf;
+    union { double  d; uint64_t  u; }  value_bits;
+    value_bits.d = value;
+#endif
+
+    // Probe arguments: format char, precision, size of output buffer, raw bits of value
+    DCONVSTR_PROBE4( print__entry, format_char, format_precision, *outbuf_size, value_bits.u );
+    int  status = print_double( outbuf, outbuf_size, value, format_char, format_flags, format_width,
+                                format_precision );
+
+    // Probe arguments: format char, length of printed string, status
+    DCONVSTR_PROBE3( print__return, format_char, (int)( *outbuf - outbuf_start ), status );
+    return  status;
+}
+
+/**
+ *
+ *  Parse decimal floating-point value from string to BCD representation
+ *
+ *  On exit, parsed value is (decimal_digits * 10^out_decimal_exponent), where decimal_digits is
+ *  BCD representation of (1 + ndigits) digits: decimal_digits[0] == 0, decimal_digits[1] != 0
+ *  unless value is zero. Digits after ndigits significant ones are truncated; if any of them is
+ *  not zero, *out_is_inexact is set to 1 (if out_is_inexact != NULL), so that caller may tell
+ *  exact value from the value which is strictly between two adjacent truncated values.
+ *  Decimal exponent is not bounded by range of any binary format. If exponent written in the
+ *  input string has absolute value of max_exponent or more, it is returned without adjustment,
+ *  so that caller may treat it as overflow or underflow condition.
+ *
+ *  Syntax errors are reported like in strtod(3), by setting *input_end = input (if input_end != NULL).
+ *  Parsing stops at the end of string, or at the terminator character if it's not zero
+ *  (this is how values are separated from each other in arrays).
+ *
+ */
+static void  scan_decimal_digits(
+    const char*   input,
+    const char**  input_end,
+    int           terminator,
+    uint8_t*      decimal_digits,
+    int           ndigits,
+    int32_t       max_exponent,
+    int*          out_is_nan,
+    int*          out_sign,
+    int32_t*      out_decimal_exponent,
+    int*          out_is_infinity,
+    int*          out_is_inexact
+)
+{
+    // 1. Handle special cases
+    memset( decimal_digits, 0, 1 + ndigits );
+    *out_is_nan           = 0;
+    *out_sign             = 0;
+    *out_decimal_exponent = 0;
+    *out_is_infinity      = 0;
+    if( out_is_inexact )
+        *out_is_inexact = 0;
+    if((( input[0] == 'n' )||( input[0] == 'N' ))&&
+       (( input[1] == 'a' )||( input[1] == 'A' ))&&
+       (( input[2] == 'n' )||( input[2] == 'N' )))
+    {
+        if( input_end )
+            *input_end = input + 3;
+        *out_is_nan = 1;
+        return;
+    }
+    else if((( input[0] == 'i' )||( input[0] == 'I' ))&&
+            (( input[1] == 'n' )||( input[1] == 'N' ))&&
+            (( input[2] == 'f' )||( input[2] == 'F' )))
+    {
+        if( input_end )
+            *input_end = input + 3;
+        *out_is_infinity = 1;
+        return;
+    }
+    else if(( input[0] == '-' )&&
+            (( input[1] == 'i' )||( input[1] == 'I' ))&&
+            (( input[2] == 'n' )||( input[2] == 'N' ))&&
+            (( input[3] == 'f' )||( input[3] == 'F' )))
+    {
+        if( input_end )
+            *input_end = input + 4;
+        *out_sign        = 1;
+        *out_is_infinity = 1;
+        return;
+    }
+
+    // 2. Parse input string
+    //    (Code from this section was adopted from http://golang.org/src/lib9/fmt/fltfmt.c)
+    uint8_t* parsed_digits          = decimal_digits;
+    int      parsed_digits_size     = 1 + ndigits;
+    int      n_parsed_digits        = 0;      // number of digits in parsed_digits[]
+    int32_t  exponent               = 0;
+    int32_t  exponent_offset        = 0;
+    int      flag_negative_mantissa = 0;
+    int      flag_negative_exponent = 0;
+    int      flag_syntax_error      = 0;
+    int      flag_truncated         = 0;      // there were digits after parsed_digits_size significant ones
+    int      flag_inexact           = 0;      // some of truncated digits were not zero
+
+    enum parser_state  state = S0;
+        // S0: _          _S0   +S1   #S2   .S3
+        // S1: _+         #S2   .S3
+        // S2: _+#        #S2   .S4   eS5
+        // S3: _+#.       #S4
+        // S4: _+#.#      #S4   eS5
+        // S5: _+#.#e     +S6   #S7
+        // S6: _+#.#e+    #S7
+        // S7: _+#.#e+#   #S7
+    const char*  s = input;
+    while(( !flag_syntax_error )&&( *s )&&(( *s != terminator )||( state == S0 )))
+    {
+        char  ch = *s;
+
+        // Blanks after digits are allowed before terminator (e.g. "1.5\r\n" with '\n' between values)
+        if(( terminator != 0 )&&(( state == S2 )||( state == S4 )||( state == S7 ))&&
+           (( ch == ' ' )||( ch == '\t' )||( ch == '\r' )))
+        {
+            const char*  t = s;
+            while(( *t != terminator )&&(( *t == ' ' )||( *t == '\t' )||( *t == '\r' )))
+                ++t;
+            if(( *t != 0 )&&( *t != terminator ))
+                flag_syntax_error = 1;
+            break;
+        }
+
+        switch( state )
+        {
+            // State 0: skip leading whitespaces, before mantissa sign and digits
+            case S0:
+                if(( ch == ' ' )||( ch == '\t' ))
+                    ++s;  // remain in state S0
+                else if( ch == '-' )
+                {
+                    ++s;
+                    state = S1;
+                    flag_negative_mantissa = 1;
+                }
+                else if( ch == '+' )
+                {
+                    ++s;
+                    state = S1;
+                }
+                else if(( ch >= '0' )&&( ch <= '9' ))
+                {
+                    state = S2;
+                }
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = S3;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 1: after mantissa sign, before mantissa digits
+            case S1:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                    state = S2;
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = S3;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 2: parsing mantissa digits before point
+            case S2:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                {
+                    ++s;
+                    if( n_parsed_digits < parsed_digits_size )
+                    {
+                        parsed_digits[n_parsed_digits] = ch - '0';
+                        if(( ch != '0' )||( n_parsed_digits != 0 ))
+                            ++n_parsed_digits;
+                    }
+                    else
+                    {
+                        ++exponent_offset;
+                        flag_truncated = 1;
+                        if( ch != '0' )
+                            flag_inexact = 1;
+                    }
+                }
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = S3;
+                }
+                else if(( ch == 'e' )||( ch == 'E' ))
+                {
+                    ++s;
+                    state = S5;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 3: parsing first mantissa digit just after the point
+            case S3:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                    state = S4;
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 4: parsing mantissa digits after the point
+            case S4:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                {
+                    ++s;
+                    if( n_parsed_digits < parsed_digits_size )
+                    {
+                        parsed_digits[n_parsed_digits] = ch - '0';
+                        if(( ch != '0' )||( n_parsed_digits != 0 ))
+                            ++n_parsed_digits;
+                        --exponent_offset;
+                    }
+                    else
+                    {
+                        flag_truncated = 1;
+                        if( ch != '0' )
+                            flag_inexact = 1;
+                    }
+                }
+                else if(( ch == 'e' )||( ch == 'E' ))
+                {
+                    ++s;
+                    state = S5;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 5: parsing sign after the exponent
+            case S5:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                    state = S7;
+                else if( ch == '+' )
+                {
+                    ++s;
+                    state = S6;
+                }
+                else if( ch == '-' )
+                {
+                    ++s;
+                    state = S6;
+                    flag_negative_exponent = 1;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 6: parsing first digits after exponent sign
+            case S6:
+                if(( ch >= '0' )&&( ch <= '9' ))
+                    state = S7;
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 7: parsing exponent digits
+            case S7:
+                if(( ch >= '0' )&&( ch <= '9' )) 
+                {
+                    ++s;
+                    if( exponent < max_exponent )
+                    {
+                        // we aim to avoid overflow/underflow of the exponent 
+                        // by using ( exponent >= max_exponent ) condition as overflow/underflow flag
+                        exponent = (exponent * 10) + (ch - '0');
+                    }
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+        }
+    }
+    if((! flag_syntax_error )&&(( state == S0 )||( state == S1 )||( state == S3 )||
+                                ( state == S5 )||( state == S6 )))
+        flag_syntax_error = 1;
+    if( input_end )
+        *input_end = flag_syntax_error ? input : s;
+    if(( flag_truncated )&&(! flag_syntax_error ))
+        DCONVSTR_STATS_INCREMENT( scan_digit_truncations );
+
+    // 3. Zero out the tail of mantissa.
+    //    Move decimal point to the right side of mantissa (adjust exponent offset).
+    //    Get rid of last mantissa digit and set first one to zero.
+    int  is_zero = ( n_parsed_digits == 0 );
+    if( n_parsed_digits < parsed_digits_size )
+    {
+        int  delta = parsed_digits_size - n_parsed_digits;
+        memset( parsed_digits + n_parsed_digits, 0, delta );
+        n_parsed_digits += delta;
+        exponent_offset -= delta;
+    }
+    if( parsed_digits[parsed_digits_size - 1] != 0 )
+        flag_inexact = 1;
+    memmove( parsed_digits + 1, parsed_digits, parsed_digits_size - 1 ); 
+    parsed_digits[0] = 0;
+    ++exponent_offset;
+
+    // 4. Compute exponent
+    if( is_zero )
+        exponent = 0;
+    else
+        exponent = ( (exponent < max_exponent) ? exponent_offset : 0 ) +
+                   ( flag_negative_exponent ? -exponent : exponent );
+
+    // 5. Save parsing results and exit
+    *out_sign             = flag_negative_mantissa;
+    *out_decimal_exponent = exponent;
+    if(( out_is_inexact )&&(! flag_syntax_error ))
+        *out_is_inexact = flag_inexact;
+}
+
+/**
+ *
+ *  Parse decimal floating-point value from string
+ *
+ *  On exit, parsed value is (out_decimal_mantissa * 10^out_decimal_exponent), with 19 significant
+ *  digits in decimal mantissa (10^18 <= out_decimal_mantissa < 10^19) unless value is zero.
+ *  If exponent written in the input string has absolute value of 350 or more, it is returned
+ *  without adjustment, so that caller may treat it as overflow or underflow condition.
+ *  Other details are the same as in scan_decimal_digits().
+ *
+ */
+static void  scan_decimal(
+    const char*   input,
+    const char**  input_end,
+    int           terminator,
+    int*          out_is_nan,
+    int*          out_sign,
+    uint64_t*     out_decimal_mantissa,
+    int32_t*      out_decimal_exponent,
+    int*          out_is_infinity
+)
+{
+    uint8_t  decimal_digits[20];
+    scan_decimal_digits( input, input_end, terminator, decimal_digits, 19, 350,
+                         out_is_nan, out_sign, out_decimal_exponent, out_is_infinity, NULL );
+    *out_decimal_mantissa = bcd_compress( decimal_digits );
+}
+
+/**
+ *
+ *  Convert extended-precision decimal to IEEE 754 floating-point double precision value
+ *
+ *  (mantissa * 10^exponent) -> output, where mantissa is either zero, or normalized to 19 digits
+ *  (10^18 <= mantissa < 10^19) like in output of scan_decimal(). Parameters and return value
+ *  are the same as in dconvstr_scan().
+ *
+ */
+static int  convert_decimal_to_double(
+    int       is_nan,
+    int       is_negative,
+    int       is_infinity,
+    uint64_t  mantissa,
+    int32_t   exponent,
+    double*   output,
+    int*      output_erange
+)
+{
+    // 1. Handle special cases
+    if(( is_nan )||( is_infinity ))
+    {
+        pack_ieee754_double(
+            is_nan,                  // input_is_nan
+            is_negative,             // input_sign
+            0,                       // input_binary_mantissa
+            0,                       // input_binary_exponent
+            is_infinity,             // input_is_infinity
+            output
+        );
+        DCONVSTR_STATS_INCREMENT( special_values );
+        *output_erange = 0;
+        return  1;
+    }
+
+    // 2. Check exponent for overflow and underflow: it's always the case for normalized mantissa
+    //    with exponent beyond powers_of_ten_ table (below 10^-325 or from 10^312)
+    if( exponent < -344 )
+    {
+        pack_ieee754_double(
+            0,                       // input_is_nan
+            is_negative,             // input_sign
+            0,                       // input_binary_mantissa
+            0,                       // input_binary_exponent
+            0,                       // input_is_infinity
+            output
+        );
+        DCONVSTR_STATS_INCREMENT( erange );
+        *output_erange = 1;      // strtod(3) would set errno = ERANGE
+        return  1;
+    }
+    else if( exponent > 293 )
+    {
+        pack_ieee754_double(
+            0,                       // input_is_nan
+            is_negative,             // input_sign
+            0,                       // input_binary_mantissa
+            0,                       // input_binary_exponent
             1,                       // input_is_infinity
             output
         );
+        DCONVSTR_STATS_INCREMENT( erange );
         *output_erange = 1;      // strtod(3) would set errno = ERANGE
         return  1;
     }
 
-    // 6. Convert to binary representation, pack bits up and exit
-    if( mantissa != 0 )
+    // 3. Convert to binary representation, pack bits up and exit
+    if( mantissa != 0 )
+    {
+        if(! convert_extended_decimal_to_binary_and_round( mantissa, exponent, &mantissa, &exponent ) )
+            return  0;           // internal error
+    }
+    else
+        DCONVSTR_STATS_INCREMENT( zeros );
+    *output_erange = (! pack_ieee754_double(
+        0,                       // input_is_nan
+        is_negative,             // input_sign
+        mantissa,                // input_binary_mantissa
+        exponent,                // input_binary_exponent
+        0,                       // input_is_infinity
+        output
+    ) );
+    if( *output_erange )
+        DCONVSTR_STATS_INCREMENT( erange );
+    return  1;
+}
+
+/**
+ *
+ *  Convert string to IEEE 754 floating-point double precision value
+ *
+ *  @param  input          Input buffer, C-style string. Filled by caller.
+ *
+ *  @param  input_end      Address of pointer to end of scanned value in input buffer.
+ *                         Filled by function if address is not NULL.
+ *
+ *  @param  output         Conversion result (IEEE 754 floating-point double precision).
+ *                         Set to 0.0 if string in input buffer has syntax errors.
+ *
+ *  @param  output_erange  Address of overflow/underflow flag variable, filled by function.
+ *                         0  if there is no overflow/underflow condition
+ *                         1  if there is overflow/underflow condition: strtod(3) would set errno = ERANGE
+ *
+ *  @returns  1  if there were no internal errors
+ *            0  if there was internal error during conversion.
+ *
+ *  In general, interface of this function is similar to strtod(3), except for returning overflow
+ *  condition instead of setting errno. If you want just to convert C-style string to double with
+ *  error checking, then set input_end != NULL and use ( ret_value != 0 )&&( **input_end == 0 )
+ *  condition as an indication of successful conversion.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan(
+    const char*   input,
+    const char**  input_end,
+    double*       output,
+    int*          output_erange
+)
+{
+    // 1. Parse input string
+    //    Probe arguments: input string
+    DCONVSTR_PROBE1( scan__entry, input );
+#ifdef DCONVSTR_ENABLE_PROBES
+    const char*  probe_input_end = input;
+    if(! input_end )
+        input_end = &probe_input_end;
+#endif
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    scan_decimal( input, input_end, 0, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+
+    // 2. Convert to binary representation
+    int  status = convert_decimal_to_double( is_nan, is_negative, is_infinity, mantissa, exponent,
+                                             output, output_erange );
+
+    // 3. Probe arguments: length of scanned input (0 on syntax error), overflow/underflow flag, status
+    DCONVSTR_PROBE3( scan__return, (int)( *input_end - input ), *output_erange, status );
+    return  status;
+}
+
+/**
+ *
+ *  Print value of IEEE 754 single precision binary format, or of narrower binary format, to string
+ *
+ *  Binary format is defined by mantissa_bits and exponent_bits, like in
+ *  convert_extended_decimal_to_ieee754_binary(). Value is printed using the shortest decimal
+ *  representation which is converted back to the same binary value by scan_ieee754_float().
+ *
+ */
+static int  print_ieee754_float(
+    char**        outbuf,
+    int*          outbuf_size,
+    uint32_t      value_bits,
+    int           mantissa_bits,
+    int           exponent_bits,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    // 1. Unpack binary value
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint32_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    unpack_ieee754_float( value_bits, mantissa_bits, exponent_bits,
+                          &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+
+    // 2. Get shortest decimal representation.
+    //    Decimal point is located on the right side of decimal mantissa
+    uint8_t  decimal_mantissa[20];
+    if( mantissa == 0 )
+    {
+        memset( decimal_mantissa, 0, sizeof(decimal_mantissa) );
+        exponent = -18;
+    }
+    else
+    {
+        uint64_t  decimal = 0;
+        if(! convert_float_to_extended_decimal( mantissa, exponent, mantissa_bits, exponent_bits, &decimal, &exponent ) )
+            return  0;    // internal error during conversion
+        bcd_decompress( decimal, decimal_mantissa );
+        if(( decimal_mantissa[0] != 0 )||( decimal_mantissa[1] == 0 ))
+            return  0;    // invariant does not hold : mantissa >= 10^19 || mantissa < 10^18
+    }
+
+    // 3. Print decimal representation
+    return  format_decimal( outbuf, outbuf_size, is_nan, is_negative, is_infinity, decimal_mantissa, 19,
+                            exponent, format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Compare decimal value written in string with binary exactly
+ *
+ *  Input string is parsed again with 120 significant digits, which is enough for any midpoint
+ *  between adjacent values of IEEE 754 single precision or narrower binary format: such midpoint
+ *  is (c * 2^d), where c < 2^25 and -150 <= d <= 104, so it has at most 113 significant digits.
+ *  Value written in the input string must be positive and finite.
+ *
+ *  @returns  -1, 0 or 1 if decimal value is less than, equal to or greater than (c * 2^d)
+ *
+ */
+static int  compare_decimal_string_with_binary(
+    const char*   input,
+    int           terminator,
+    uint32_t      c,
+    int32_t       d
+)
+{
+    // 1. Parse input string: value is (x * 10^x_exponent), where x is 121-digit integer, x[0] == 0, x[1] != 0
+    uint8_t   x[121];
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    int       is_inexact  = 0;
+    int32_t   x_exponent  = 0;
+    scan_decimal_digits( input, NULL, terminator, x, 120, 350,
+                         &is_nan, &is_negative, &x_exponent, &is_infinity, &is_inexact );
+
+    // 2. Write (c * 2^d) as decimal integer z (z[0] holds least significant digit) multiplied by 10^z_exponent:
+    //    z = c * 5^(-d), z_exponent = d for negative d; z = c * 2^d, z_exponent = 0 otherwise
+    uint8_t   z[120];
+    int       z_size     = 0;
+    int32_t   z_exponent = ( d < 0 ) ? d : 0;
+    for( ; c != 0; c /= 10 )
+        z[z_size++] = c % 10;
+    for( int32_t  i = 0; i < (( d < 0 ) ? -d : d ); ++i )
+    {
+        int  carry = 0;
+        for( int  j = 0; j < z_size; ++j )
+        {
+            int  digit = z[j] * (( d < 0 ) ? 5 : 2) + carry;
+            z[j]  = digit % 10;
+            carry = digit / 10;
+        }
+        if( carry != 0 )
+            z[z_size++] = carry;
+    }
+
+    // 3. Normalize z to the same representation as x: (y * 10^y_exponent), y[0] == 0, y[1] != 0
+    uint8_t   y[121];
+    int32_t   y_exponent = z_exponent - (120 - z_size);
+    memset( y, 0, sizeof(y) );
+    for( int  j = 0; j < z_size; ++j )
+        y[1 + j] = z[z_size - 1 - j];
+
+    // 4. Compare exponents, then digits, then truncated digits of x (if any)
+    if( x_exponent != y_exponent )
+        return  ( x_exponent > y_exponent ) ? 1 : -1;
+    int  cmp = memcmp( x, y, sizeof(x) );
+    if( cmp != 0 )
+        return  ( cmp > 0 ) ? 1 : -1;
+    return  is_inexact ? 1 : 0;
+}
+
+/**
+ *
+ *  Round decimal value with more than 19 significant digits to IEEE 754 single precision binary format,
+ *  or to narrower binary format
+ *
+ *  Value written in the input string is strictly between (a * 10^b) and ((a + 1) * 10^b), where
+ *  a holds 19 significant digits of the value, and *c holds the result of rounding (a * 10^b)
+ *  by convert_extended_decimal_to_ieee754_binary(). If ((a + 1) * 10^b) is rounded to another
+ *  binary value, the value is compared with the midpoint between these two binary values, and
+ *  *c is corrected. Parameters and return value are the same as in
+ *  convert_extended_decimal_to_ieee754_binary().
+ *
+ */
+static int  round_truncated_decimal_to_ieee754_float(
+    const char*   input,
+    int           terminator,
+    uint64_t      a,
+    int32_t       b,
+    int           mantissa_bits,
+    int           exponent_bits,
+    uint64_t*     c
+)
+{
+    // 1. Round upper bound of the value; nothing to do if both bounds are rounded to the same binary value
+    uint64_t  infinity   = ((1ULL << exponent_bits) - 1ULL) << (mantissa_bits - 1);
+    uint64_t  lower_bits = *c;
+    uint64_t  upper_bits = 0;
+    convert_extended_decimal_to_ieee754_binary( a + 1, b, powers_of_ten_float_,
+                                                sizeof(powers_of_ten_float_)/sizeof(powers_of_ten_float_[0]),
+                                                mantissa_bits, exponent_bits, &upper_bits );
+    if( upper_bits == lower_bits + 1 )
+    {
+        // 2. Compute midpoint between adjacent binary values: (2m + 1) * 2^(e - 1)
+        int32_t   bias            = (1 << (exponent_bits - 1)) - 1;
+        int32_t   biased_exponent = (int32_t)( lower_bits >> (mantissa_bits - 1) );
+        uint64_t  m               = lower_bits & ((1ULL << (mantissa_bits - 1)) - 1ULL);
+        if( biased_exponent != 0 )
+            m |= (1ULL << (mantissa_bits - 1));
+        int32_t   e               = (( biased_exponent != 0 ) ? biased_exponent : 1) - bias - (mantissa_bits - 1);
+        uint64_t  midpoint[2]     = { 2 * m + 1, 0 };
+
+        // 3. Compare the midpoint with bounds of the value, and then with the value itself
+        //    (only if the midpoint is strictly between the bounds); ties are rounded to even
+        uint64_t  lower_bound[2]  = { a, 0 };
+        uint64_t  upper_bound[2]  = { a + 1, 0 };
+        int       cmp             = 0;
+        if( compare_extended_decimal_with_binary( lower_bound, b, midpoint, e - 1 ) >= 0 )
+            cmp = 1;
+        else if( compare_extended_decimal_with_binary( upper_bound, b, midpoint, e - 1 ) <= 0 )
+            cmp = -1;
+        else
+            cmp = compare_decimal_string_with_binary( input, terminator, (uint32_t)( midpoint[0] ), e - 1 );
+        *c = (( cmp > 0 )||(( cmp == 0 )&&( lower_bits & 1 ))) ? upper_bits : lower_bits;
+    }
+    return  ( *c != 0 )&&( *c != infinity );
+}
+
+/**
+ *
+ *  Convert string to value of IEEE 754 single precision binary format, or of narrower binary format
+ *
+ *  Binary format is defined by mantissa_bits and exponent_bits, like in
+ *  convert_extended_decimal_to_ieee754_binary(). Value is rounded to the binary format directly
+ *  (not through double precision), so there is no double rounding. Digits after 19 significant
+ *  ones are taken into account by round_truncated_decimal_to_ieee754_float().
+ *  Parsing stops at the terminator character, like in scan_decimal().
+ *
+ */
+static void  scan_ieee754_float(
+    const char*   input,
+    const char**  input_end,
+    int           terminator,
+    int           mantissa_bits,
+    int           exponent_bits,
+    uint32_t*     output_bits,
+    int*          output_erange
+)
+{
+    // 1. Parse input string
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    int       is_inexact  = 0;    // digits after 19 significant ones are not all zeros
+    uint8_t   decimal_digits[20];
+    scan_decimal_digits( input, input_end, terminator, decimal_digits, 19, 350,
+                         &is_nan, &is_negative, &exponent, &is_infinity, &is_inexact );
+    mantissa = bcd_compress( decimal_digits );
+
+    // 2. Convert to binary representation (special cases included)
+    uint32_t  infinity = ((1U << exponent_bits) - 1U) << (mantissa_bits - 1);
+    uint32_t  bits     = 0;
+    *output_erange = 0;
+    if( is_nan )
+    {
+        is_negative = 1;                  // Quiet NaN, like in pack_ieee754_double()
+        bits = infinity | (1U << (mantissa_bits - 2));
+    }
+    else if( is_infinity )
+        bits = infinity;
+    else
+    {
+        uint64_t  wide_bits = 0;
+        *output_erange = (! convert_extended_decimal_to_ieee754_binary( mantissa, exponent, powers_of_ten_float_,
+                                                                        sizeof(powers_of_ten_float_)/sizeof(powers_of_ten_float_[0]),
+                                                                        mantissa_bits, exponent_bits, &wide_bits ) );
+        if( is_inexact )
+            *output_erange = (! round_truncated_decimal_to_ieee754_float( input, terminator, mantissa, exponent,
+                                                                          mantissa_bits, exponent_bits, &wide_bits ) );
+        bits = ((uint32_t)( wide_bits ));
+    }
+
+    // 3. Pack sign bit and exit
+    *output_bits = bits | (is_negative ? (1U << (mantissa_bits + exponent_bits - 1)) : 0);
+}
+
+/**
+ *
+ *  Print array of 16-bit binary values to string, values are separated by separator character
+ *
+ */
+static int  print_ieee754_float_array(
+    char**                 outbuf,
+    int*                   outbuf_size,
+    const unsigned short*  values,
+    int                    n_values,
+    int                    mantissa_bits,
+    int                    exponent_bits,
+    int                    separator,
+    int                    format_char,
+    unsigned int           format_flags,
+    int                    format_width,
+    int                    format_precision
+)
+{
+    for( int  i = 0; i < n_values; ++i )
+    {
+        if(( i > 0 )&&(! format_onechar( outbuf, outbuf_size, separator ) ))
+            return  0;
+        if(! print_ieee754_float( outbuf, outbuf_size, values[i], mantissa_bits, exponent_bits,
+                                  format_char, format_flags, format_width, format_precision ) )
+            return  0;
+    }
+    return  1;
+}
+
+/**
+ *
+ *  Convert string to array of 16-bit binary values, values are separated by separator character
+ *
+ */
+static int  scan_ieee754_float_array(
+    const char*      input,
+    const char**     input_end,
+    unsigned short*  output,
+    int              max_values,
+    int*             n_values,
+    int              mantissa_bits,
+    int              exponent_bits,
+    int              separator,
+    int*             output_erange
+)
+{
+    const char*  s    = input;
+    const char*  last = input;
+    int          n    = 0;
+    *output_erange = 0;
+    while( n < max_values )
+    {
+        while(( *s != separator )&&(( *s == ' ' )||( *s == '\t' )||( *s == '\r' )))
+            ++s;
+        const char*  end    = s;
+        uint32_t     bits   = 0;
+        int          erange = 0;
+        scan_ieee754_float( s, &end, separator, mantissa_bits, exponent_bits, &bits, &erange );
+        if( end == s )
+            break;      // syntax error: stop after the last well-formed value
+        output[n++] = (unsigned short)bits;
+        *output_erange |= erange;
+        s = last = end;
+        while(( *s != separator )&&(( *s == ' ' )||( *s == '\t' )||( *s == '\r' )))
+            ++s;        // blanks between value and separator
+        if(( separator == 0 )||( *s != separator ))
+            break;
+        ++s;
+    }
+    *n_values = n;
+    if( input_end )
+        *input_end = last;
+    return  1;
+}
+
+/**
+ *
+ *  Print IEEE 754 floating-point single precision value to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *  Value is printed using the shortest decimal representation which is converted back to
+ *  the same single precision value by dconvstr_scan_float().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_float(
+    char**        outbuf,
+    int*          outbuf_size,
+    float         value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    uint32_t  value_bits = 0;
+    memcpy( &value_bits, &value, sizeof(value_bits) );
+    return  print_ieee754_float( outbuf, outbuf_size, value_bits, 24, 8,
+                                 format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to IEEE 754 floating-point single precision value
+ *
+ *  Parameters and return value are the same as in dconvstr_scan().
+ *  Value is rounded to single precision directly (not through double precision),
+ *  so there is no double rounding.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_float(
+    const char*   input,
+    const char**  input_end,
+    float*        output,
+    int*          output_erange
+)
+{
+    uint32_t  output_bits = 0;
+    scan_ieee754_float( input, input_end, 0, 24, 8, &output_bits, output_erange );
+    memcpy( output, &output_bits, sizeof(output_bits) );
+    return  1;
+}
+
+/**
+ *
+ *  Print array of IEEE 754 half precision (binary16) values to string
+ *
+ */
+DCONVSTR_API int  dconvstr_print_half_array(
+    char**                 outbuf,
+    int*                   outbuf_size,
+    const unsigned short*  values,
+    int                    n_values,
+    int                    separator,
+    int                    format_char,
+    unsigned int           format_flags,
+    int                    format_width,
+    int                    format_precision
+)
+{
+    return  print_ieee754_float_array( outbuf, outbuf_size, values, n_values, 11, 5, separator,
+                                       format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to array of IEEE 754 half precision (binary16) values
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_half_array(
+    const char*      input,
+    const char**     input_end,
+    unsigned short*  output,
+    int              max_values,
+    int*             n_values,
+    int              separator,
+    int*             output_erange
+)
+{
+    return  scan_ieee754_float_array( input, input_end, output, max_values, n_values, 11, 5,
+                                      separator, output_erange );
+}
+
+/**
+ *
+ *  Print array of bfloat16 values to string
+ *
+ */
+DCONVSTR_API int  dconvstr_print_bfloat16_array(
+    char**                 outbuf,
+    int*                   outbuf_size,
+    const unsigned short*  values,
+    int                    n_values,
+    int                    separator,
+    int                    format_char,
+    unsigned int           format_flags,
+    int                    format_width,
+    int                    format_precision
+)
+{
+    return  print_ieee754_float_array( outbuf, outbuf_size, values, n_values, 8, 8, separator,
+                                       format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to array of bfloat16 values
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_bfloat16_array(
+    const char*      input,
+    const char**     input_end,
+    unsigned short*  output,
+    int              max_values,
+    int*             n_values,
+    int              separator,
+    int*             output_erange
+)
+{
+    return  scan_ieee754_float_array( input, input_end, output, max_values, n_values, 8, 8,
+                                      separator, output_erange );
+}
+
+/**
+ *
+ *  Convert IEEE 754 floating-point double precision value to IEEE 754-2008 decimal64 value
+ *
+ */
+DCONVSTR_API int  dconvstr_double_to_decimal64(
+    double               value,
+    int                  mode,
+    unsigned long long*  output,
+    int*                 output_lossy
+)
+{
+    // 1. Unpack double precision value
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    if(( mode != DCONVSTR_DECIMAL64_SHORTEST )&&( mode != DCONVSTR_DECIMAL64_NEAREST ))
+        return  0;
+    unpack_ieee754_double( &value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+    *output_lossy = 0;
+    if(( is_nan )||( is_infinity )||( mantissa == 0 ))
+    {
+        *output = pack_decimal64( is_nan, is_negative, 0, 0, is_infinity );
+        return  1;
+    }
+
+    // 2. Get decimal representation: shortest one if it has at most 16 digits (its last 3 digits
+    //    out of 19 are zeros), otherwise correctly rounded to 16 digits. Shortest decimal is
+    //    checked against dconvstr_decimal64_to_double(), which breaks exact ties to even: in rare
+    //    cases it doesn't give the same double, and correctly rounded decimal is used instead.
+    uint64_t  value_bits = 0;
+    uint64_t  check_bits = 0;
+    uint64_t  decimal_mantissa = 0;
+    int32_t   decimal_exponent = 0;
+    memcpy( &value_bits, &value, sizeof(value_bits) );
+    value_bits &= ~(1ULL << 63);
+    if( mode == DCONVSTR_DECIMAL64_SHORTEST )
     {
-        if(! convert_extended_decimal_to_binary_and_round( mantissa, exponent, &mantissa, &exponent ) )
-            return  0;           // internal error
+        if(! convert_binary_to_extended_decimal( mantissa, exponent, &decimal_mantissa, &decimal_exponent ) )
+            return  0;    // internal error during conversion
+        convert_extended_decimal_to_ieee754_binary( decimal_mantissa, decimal_exponent, powers_of_ten_,
+                                                    sizeof(powers_of_ten_)/sizeof(powers_of_ten_[0]), 53, 11, &check_bits );
+        if(( decimal_mantissa % 1000ULL == 0 )&&( check_bits == value_bits ))
+        {
+            decimal_mantissa /= 1000ULL;
+            decimal_exponent += 3;
+        }
+        else
+            mode = DCONVSTR_DECIMAL64_NEAREST;
     }
-    *output_erange = (! pack_ieee754_double(
-        0,                       // input_is_nan
-        flag_negative_mantissa,  // input_sign
-        mantissa,                // input_binary_mantissa
-        exponent,                // input_binary_exponent
-        0,                       // input_is_infinity
-        output
-    ) );
+    if( mode == DCONVSTR_DECIMAL64_NEAREST )
+    {
+        if(! convert_binary_to_nearest_decimal( mantissa, exponent, 16, &decimal_mantissa, &decimal_exponent ) )
+            return  0;    // internal error during conversion
+
+        // check if decimal is converted back to the same double
+        convert_extended_decimal_to_ieee754_binary( decimal_mantissa * 1000ULL, decimal_exponent - 3, powers_of_ten_,
+                                                    sizeof(powers_of_ten_)/sizeof(powers_of_ten_[0]), 53, 11, &check_bits );
+        *output_lossy = ( check_bits != value_bits );
+    }
+
+    // 3. Remove trailing zeros and pack bits up
+    while( decimal_mantissa % 10ULL == 0 )
+    {
+        decimal_mantissa /= 10ULL;
+        ++decimal_exponent;
+    }
+    *output = pack_decimal64( 0, is_negative, decimal_mantissa, decimal_exponent, 0 );
+    return  1;
+}
+
+/**
+ *
+ *  Convert IEEE 754-2008 decimal64 value to IEEE 754 floating-point double precision value
+ *
+ *  Coefficient of decimal64 is exact, so result is correctly rounded (unlike in dconvstr_scan(),
+ *  which works with approximate powers of ten and rounds in the round-half-up manner).
+ *
+ */
+DCONVSTR_API int  dconvstr_decimal64_to_double(
+    unsigned long long  value,
+    double*             output,
+    int*                output_erange
+)
+{
+    // 1. Unpack decimal64 value and normalize its mantissa to 19 digits, like in scan_decimal()
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    unpack_decimal64( value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+    if( mantissa == 0 )
+        exponent = 0;
+    else
+    {
+        while( mantissa < POW10_18 )
+        {
+            mantissa *= 10ULL;
+            --exponent;
+        }
+    }
+
+    // 2. Handle special values and zeros
+    if(( is_nan )||( is_infinity )||( mantissa == 0 ))
+        return  convert_decimal_to_double( is_nan, is_negative, is_infinity, mantissa, exponent,
+                                           output, output_erange );
+
+    // 3. Convert to binary representation with correct rounding, add sign bit and exit
+    uint64_t  output_bits = 0;
+    *output_erange = (! convert_extended_decimal_to_ieee754_binary( mantissa, exponent, powers_of_ten_,
+                                                                    sizeof(powers_of_ten_)/sizeof(powers_of_ten_[0]),
+                                                                    53, 11, &output_bits ) );
+    if( *output_erange )
+        DCONVSTR_STATS_INCREMENT( erange );
+    output_bits |= ( ((uint64_t)( is_negative ? 1 : 0 )) << 63 );
+    memcpy( output, &output_bits, sizeof(output_bits) );
+    return  1;
+}
+
+#ifdef DCONVSTR_HAVE_WIDE_BINARY
+
+/**
+ *
+ *  Print binary value with wide mantissa (x87 extended precision or IEEE 754 quadruple precision)
+ *
+ *  Unpacked value is (mantissa * 2^exponent), mantissa is 128-bit unsigned integer.
+ *  Other parameters and return value are the same as in dconvstr_print().
+ *
+ */
+static int  print_wide_binary(
+    char**           outbuf,
+    int*             outbuf_size,
+    int              is_nan,
+    int              is_negative,
+    int              is_infinity,
+    const uint64_t*  mantissa,
+    int32_t          exponent,
+    int              mantissa_bits,
+    int              format_char,
+    unsigned int     format_flags,
+    int              format_width,
+    int              format_precision
+)
+{
+    // 1. Get shortest decimal representation (21 or 36 digits, split in two parts).
+    //    Decimal point is located on the right side of decimal mantissa
+    int      n_digits      = floor_log10_pow2( mantissa_bits ) + 2;
+    int      n_high_digits = n_digits - 19;
+    uint8_t  decimal_mantissa[37];
+    if(( mantissa[0] == 0 )&&( mantissa[1] == 0 ))
+    {
+        memset( decimal_mantissa, 0, sizeof(decimal_mantissa) );
+        exponent = 1 - n_digits;
+    }
+    else
+    {
+        uint64_t  decimal[2];
+        uint8_t   decompressed[20];
+        if(! convert_wide_binary_to_extended_decimal( mantissa, exponent, mantissa_bits, decimal, &exponent ) )
+            return  0;    // internal error during conversion
+        uint64_t  min_high = 1;
+        for( int  i = 1; i < n_high_digits; ++i )
+            min_high *= 10;
+        if(( decimal[1] < min_high )||( decimal[1] >= 10 * min_high )||( decimal[0] >= POW10_19 ))
+            return  0;    // invariant does not hold : mantissa >= 10^n || mantissa < 10^(n-1)
+        bcd_decompress( decimal[1], decompressed );
+        decimal_mantissa[0] = 0;
+        memcpy( decimal_mantissa + 1, decompressed + 20 - n_high_digits, n_high_digits );
+        bcd_decompress( decimal[0], decompressed );
+        memcpy( decimal_mantissa + 1 + n_high_digits, decompressed + 1, 19 );
+    }
+
+    // 2. Print decimal representation
+    return  format_decimal( outbuf, outbuf_size, is_nan, is_negative, is_infinity, decimal_mantissa, n_digits,
+                            exponent, format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to binary value with wide mantissa (x87 extended precision or IEEE 754 quadruple precision)
+ *
+ *  Output is 128-bit mantissa with integer bit and biased exponent, like in output of
+ *  convert_extended_decimal_to_wide_binary(), and sign; special values are encoded as well.
+ *  Other parameters are the same as in dconvstr_scan().
+ *
+ */
+static void  scan_wide_binary(
+    const char*   input,
+    const char**  input_end,
+    int           mantissa_bits,
+    int*          output_sign,
+    uint64_t*     output_mantissa,
+    uint32_t*     output_biased_exponent,
+    int*          output_erange
+)
+{
+    // 1. Parse input string. Exponent range is wide enough for both formats:
+    //    values are in range from 3.6e-4951 to 1.2e+4932 (x87) and from 6.5e-4966 to 1.2e+4932 (quadruple);
+    //    exponent saturated at the limit lacks offset of digits, so it is handled as overflow/underflow below
+    int       is_nan      = 0;
+    int       is_infinity = 0;
+    int32_t   exponent    = 0;
+    uint8_t   decimal_digits[39];
+    scan_decimal_digits( input, input_end, 0, decimal_digits, 38, 5100,
+                         &is_nan, output_sign, &exponent, &is_infinity, NULL );
+
+    // 2. Compress 38 digits to 128-bit mantissa: (first 19 digits) * 10^19 + (last 19 digits)
+    uint8_t   last_digits[20];
+    uint64_t  mantissa[2];
+    last_digits[0] = 0;
+    memcpy( last_digits + 1, decimal_digits + 20, 19 );
+    uint64_t  low = bcd_compress( last_digits );
+    multiply_128( bcd_compress( decimal_digits ), POW10_19, mantissa );
+    mantissa[0] += low;
+    mantissa[1] += (mantissa[0] < low);
+
+    // 3. Convert to binary representation (special cases included)
+    uint64_t  integer_bit[2] = { 0, 0 };
+    integer_bit[(mantissa_bits - 1) / 64] = (1ULL << ((mantissa_bits - 1) % 64));
+    *output_erange = 0;
+    if( is_nan )
+    {
+        *output_sign = 1;                                    // Quiet NaN, like in pack_ieee754_double()
+        output_mantissa[0] = integer_bit[0] | (integer_bit[0] >> 1);
+        output_mantissa[1] = integer_bit[1] | (integer_bit[1] >> 1);
+        *output_biased_exponent = 0x7FFFU;
+    }
+    else if( is_infinity )
+    {
+        output_mantissa[0] = integer_bit[0];
+        output_mantissa[1] = integer_bit[1];
+        *output_biased_exponent = 0x7FFFU;
+    }
+    else if(( exponent <= -5100 )&&(( mantissa[0] | mantissa[1] ) != 0 ))
+    {
+        output_mantissa[0] = output_mantissa[1] = 0;         // below 10^-5062, underflow to zero
+        *output_biased_exponent = 0;
+        *output_erange = 1;
+    }
+    else if( exponent >= 5100 )
+    {
+        output_mantissa[0] = integer_bit[0];                 // above 10^5137, overflow to infinity
+        output_mantissa[1] = integer_bit[1];
+        *output_biased_exponent = 0x7FFFU;
+        *output_erange = 1;
+    }
+    else
+        *output_erange = (! convert_extended_decimal_to_wide_binary( mantissa, exponent, mantissa_bits,
+                                                                     output_mantissa, output_biased_exponent ) );
+}
+
+#endif // DCONVSTR_HAVE_WIDE_BINARY
+
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
+
+/**
+ *
+ *  Print x87 80-bit extended precision value to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *  Value is printed using the shortest decimal representation which is converted back to
+ *  the same extended precision value by dconvstr_scan_ld().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_ld(
+    char**        outbuf,
+    int*          outbuf_size,
+    long double   value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa[2] = { 0, 0 };
+    int32_t   exponent    = 0;
+    unpack_x87_extended( &value, &is_nan, &is_negative, mantissa, &exponent, &is_infinity );
+    return  print_wide_binary( outbuf, outbuf_size, is_nan, is_negative, is_infinity, mantissa, exponent, 64,
+                               format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to x87 80-bit extended precision value
+ *
+ *  Parameters and return value are the same as in dconvstr_scan().
+ *  Up to 38 significant digits are parsed, and value is rounded to extended precision directly.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_ld(
+    const char*   input,
+    const char**  input_end,
+    long double*  output,
+    int*          output_erange
+)
+{
+    int       is_negative     = 0;
+    uint64_t  mantissa[2]     = { 0, 0 };
+    uint32_t  biased_exponent = 0;
+    scan_wide_binary( input, input_end, 64, &is_negative, mantissa, &biased_exponent, output_erange );
+    pack_x87_extended( is_negative, mantissa[0], biased_exponent, output );
     return  1;
 }
+
+#endif // DCONVSTR_HAVE_LONG_DOUBLE_X87
+
+#ifdef DCONVSTR_HAVE_FLOAT128
+
+/**
+ *
+ *  Print IEEE 754 quadruple precision value to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *  Value is printed using the shortest decimal representation which is converted back to
+ *  the same quadruple precision value by dconvstr_scan_float128().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_float128(
+    char**        outbuf,
+    int*          outbuf_size,
+    __float128    value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa[2] = { 0, 0 };
+    int32_t   exponent    = 0;
+    unpack_ieee754_quadruple( &value, &is_nan, &is_negative, mantissa, &exponent, &is_infinity );
+    return  print_wide_binary( outbuf, outbuf_size, is_nan, is_negative, is_infinity, mantissa, exponent, 113,
+                               format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Convert string to IEEE 754 quadruple precision value
+ *
+ *  Parameters and return value are the same as in dconvstr_scan().
+ *  Up to 38 significant digits are parsed, and value is rounded to quadruple precision directly.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_float128(
+    const char*   input,
+    const char**  input_end,
+    __float128*   output,
+    int*          output_erange
+)
+{
+    int       is_negative     = 0;
+    uint64_t  mantissa[2]     = { 0, 0 };
+    uint32_t  biased_exponent = 0;
+    scan_wide_binary( input, input_end, 113, &is_negative, mantissa, &biased_exponent, output_erange );
+    pack_ieee754_quadruple( is_negative, mantissa, biased_exponent, output );
+    return  1;
+}
+
+#endif // DCONVSTR_HAVE_FLOAT128
+
+//=====================================================================================================
+//
+// STATISTICS
+//
+
+/**
+ *
+ *  Get counters of internal code paths taken by the calling thread
+ *
+ */
+DCONVSTR_API int  dconvstr_stats_snapshot( struct dconvstr_stats*  output )
+{
+#ifdef DCONVSTR_ENABLE_STATS
+    *output = stats_;
+    return  1;
+#else
+    memset( output, 0, sizeof(*output) );
+    return  0;
+#endif
+}
+
+/**
+ *
+ *  Reset counters of internal code paths taken by the calling thread to zeros
+ *
+ */
+DCONVSTR_API void  dconvstr_stats_reset( void )
+{
+#ifdef DCONVSTR_ENABLE_STATS
+    memset( &stats_, 0, sizeof(stats_) );
+#endif
+}
+
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+
+//=====================================================================================================
+//
+// INTERNAL STAGES (TEST-ONLY INTERFACE, SEE dconvstr_internal.h)
+//
+
+#include "dconvstr_internal.h"
+
+void  dconvstr_internal_unpack_ieee754_double(
+    const double*  input,
+    int*           out_is_nan,
+    int*           out_sign,
+    uint64_t*      out_binary_mantissa,
+    int32_t*       out_binary_exponent,
+    int*           out_is_infinity
+)
+{
+    unpack_ieee754_double( input, out_is_nan, out_sign, out_binary_mantissa, out_binary_exponent, out_is_infinity );
+}
+
+int  dconvstr_internal_convert_binary_to_extended_decimal(
+    uint64_t   a,
+    int32_t    b,
+    uint64_t*  c,
+    int32_t*   d
+)
+{
+    return  convert_binary_to_extended_decimal( a, b, c, d );
+}
+
+void  dconvstr_internal_bcd_decompress(
+    uint64_t  compressed_bcd,
+    uint8_t*  decompressed_bcd
+)
+{
+    bcd_decompress( compressed_bcd, decompressed_bcd );
+}
+
+int  dconvstr_internal_bcd_round( int  new_ndigits, int  ndigits, uint8_t*  decimal_mantissa, int32_t*  exponent )
+{
+    return  bcd_round( new_ndigits, ndigits, decimal_mantissa, exponent );
+}
+
+int  dconvstr_internal_format_decimal(
+    char**        outbuf,
+    int*          outbuf_size,
+    int           is_nan,
+    int           is_negative,
+    int           is_infinity,
+    uint8_t*      decimal_mantissa,
+    int           mantissa_ndigits,
+    int32_t       exponent,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    return  format_decimal( outbuf, outbuf_size, is_nan, is_negative, is_infinity, decimal_mantissa,
+                            mantissa_ndigits, exponent, format_char, format_flags, format_width, format_precision );
+}
+
+void  dconvstr_internal_scan_decimal_digits(
+    const char*   input,
+    const char**  input_end,
+    uint8_t*      decimal_digits,
+    int*          out_is_nan,
+    int*          out_sign,
+    int32_t*      out_decimal_exponent,
+    int*          out_is_infinity
+)
+{
+    // the same parameters as in scan_decimal() called by dconvstr_scan()
+    scan_decimal_digits( input, input_end, 0, decimal_digits, 19, 350,
+                         out_is_nan, out_sign, out_decimal_exponent, out_is_infinity, NULL );
+}
+
+uint64_t  dconvstr_internal_bcd_compress( const uint8_t*  decompressed_bcd )
+{
+    return  bcd_compress( decompressed_bcd );
+}
+
+int  dconvstr_internal_convert_extended_decimal_to_binary_and_round(
+    uint64_t   a,
+    int32_t    b,
+    uint64_t*  c,
+    int32_t*   d
+)
+{
+    return  convert_extended_decimal_to_binary_and_round( a, b, c, d );
+}
+
+int  dconvstr_internal_pack_ieee754_double(
+    int       input_is_nan,
+    int       input_sign,
+    uint64_t  input_binary_mantissa,
+    int32_t   input_binary_exponent,
+    int       input_is_infinity,
+    double*   output
+)
+{
+    return  pack_ieee754_double( input_is_nan, input_sign, input_binary_mantissa, input_binary_exponent,
+                                 input_is_infinity, output );
+}
+
+#endif // DCONVSTR_EXPOSE_INTERNALS
@@ -29,6 +29,10 @@
 #ifndef DCONVSTR_H
 #define DCONVSTR_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #define DCONVSTR_FLAG_HAVE_WIDTH     0x0001
 #define DCONVSTR_FLAG_LEFT_JUSTIFY   0x0002
 #define DCONVSTR_FLAG_SHARP          0x0004
@@ -39,6 +43,33 @@
 
 #define DCONVSTR_DEFAULT_PRECISION   6
 
+// Header-only mode: if DCONVSTR_HEADER_ONLY is defined before inclusion of this header, it includes
+// dconvstr.c, and functions are defined as static inline in every translation unit. Then calls with
+// constant format arguments can be inlined and specialized by compiler without link-time optimization,
+// and dconvstr.c is not compiled separately. Each translation unit which calls the functions gets
+// its own copy of precomputed tables (and its own counters with DCONVSTR_ENABLE_STATS).
+#ifdef DCONVSTR_HEADER_ONLY
+#  define DCONVSTR_API  static inline
+#else
+#  define DCONVSTR_API
+#endif
+
+// Modes of conversion from double to decimal64 (dconvstr_double_to_decimal64)
+#define DCONVSTR_DECIMAL64_SHORTEST  0
+#define DCONVSTR_DECIMAL64_NEAREST   1
+
+// Defined if long double is x87 80-bit extended precision (GCC and Clang on x86 and x86-64),
+// so that dconvstr_print_ld() and dconvstr_scan_ld() are available
+#if ( defined(__x86_64__) || defined(__i386__) )&&( defined(__LDBL_MANT_DIG__) )&&( __LDBL_MANT_DIG__ == 64 )
+#  define DCONVSTR_HAVE_LONG_DOUBLE_X87  1
+#endif
+
+// Defined if compiler provides IEEE 754 quadruple precision type __float128 (GCC and Clang on x86-64
+// and other little-endian targets), so that dconvstr_print_float128() and dconvstr_scan_float128() are available
+#if ( defined(__SIZEOF_FLOAT128__) )&&( defined(__BYTE_ORDER__) )&&( __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ )
+#  define DCONVSTR_HAVE_FLOAT128  1
+#endif
+
 /**
  *
  *  Print IEEE 754 floating-point double precision value to string
@@ -67,7 +98,7 @@
  *            0  if there is not enough room in buffer or internal error happened during conversion.
  *
  */
-int  dconvstr_print(
+DCONVSTR_API int  dconvstr_print(
     char**        outbuf,
     int*          outbuf_size,
     double        value,
@@ -102,11 +133,332 @@ int  dconvstr_print(
  *  condition as an indication of successful conversion.
  *
  */
-int  dconvstr_scan(
+DCONVSTR_API int  dconvstr_scan(
     const char*   input,
     const char**  input_end,
     double*       output,
     int*          output_erange
 );
 
+/**
+ *
+ *  Print IEEE 754 floating-point single precision value to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *
+ *  Value is printed using the shortest decimal representation which is converted back to the same
+ *  single precision value, so 0.1f is printed as "0.1" and not as "0.10000000149011612"
+ *  (as it would have been if the value was converted to double and printed by dconvstr_print()).
+ *
+ */
+DCONVSTR_API int  dconvstr_print_float(
+    char**        outbuf,
+    int*          outbuf_size,
+    float         value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+);
+
+/**
+ *
+ *  Convert string to IEEE 754 floating-point single precision value
+ *
+ *  Parameters and return value are the same as in dconvstr_scan(), except for output
+ *  (IEEE 754 floating-point single precision). Value is correctly rounded to single precision
+ *  in one step, without double rounding which happens if string is converted to double first.
+ *  All significant digits are taken into account, even if there are more than 19 of them.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_float(
+    const char*   input,
+    const char**  input_end,
+    float*        output,
+    int*          output_erange
+);
+
+/**
+ *
+ *  Print array of IEEE 754 half precision (binary16) values to string
+ *
+ *  @param  values      Values to print, as raw bits (sign bit is the highest bit of unsigned short).
+ *
+ *  @param  n_values    Number of values in the array.
+ *
+ *  @param  separator   Character printed between adjacent values, e.g. ',' or '\n'.
+ *
+ *  Other parameters and return value are the same as in dconvstr_print(). Every value is printed
+ *  using the shortest decimal representation which is converted back to the same half precision
+ *  value by dconvstr_scan_half_array(); format is applied to each value separately.
+ *
+ */
+DCONVSTR_API int  dconvstr_print_half_array(
+    char**                 outbuf,
+    int*                   outbuf_size,
+    const unsigned short*  values,
+    int                    n_values,
+    int                    separator,
+    int                    format_char,
+    unsigned int           format_flags,
+    int                    format_width,
+    int                    format_precision
+);
+
+/**
+ *
+ *  Convert string to array of IEEE 754 half precision (binary16) values
+ *
+ *  @param  input          Input buffer, C-style string. Filled by caller.
+ *
+ *  @param  input_end      Address of pointer to end of the last scanned value in input buffer.
+ *                         Filled by function if address is not NULL.
+ *
+ *  @param  output         Conversion results, as raw bits. Filled by function.
+ *
+ *  @param  max_values     Maximal number of values to scan (size of output array).
+ *
+ *  @param  n_values       Address of number of scanned values, filled by function.
+ *
+ *  @param  separator      Character between adjacent values, e.g. ',' or '\n'.
+ *                         Spaces, tabs and carriage returns before and after each value are
+ *                         skipped, so "1 , 2" and lines ending with "\r\n" are accepted.
+ *
+ *  @param  output_erange  Address of overflow/underflow flag variable, filled by function:
+ *                         1 if there was overflow/underflow condition for any of scanned values.
+ *
+ *  @returns  1  if there were no internal errors
+ *            0  if there was internal error during conversion.
+ *
+ *  Scanning stops at the end of string, after max_values values, or at the first value with
+ *  syntax errors (including characters other than blanks between value and separator); values
+ *  scanned before it are returned, and input_end points to the end of the last one. Each value
+ *  is correctly rounded to half precision in one step.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_half_array(
+    const char*      input,
+    const char**     input_end,
+    unsigned short*  output,
+    int              max_values,
+    int*             n_values,
+    int              separator,
+    int*             output_erange
+);
+
+/**
+ *
+ *  Print array of bfloat16 values to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print_half_array().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_bfloat16_array(
+    char**                 outbuf,
+    int*                   outbuf_size,
+    const unsigned short*  values,
+    int                    n_values,
+    int                    separator,
+    int                    format_char,
+    unsigned int           format_flags,
+    int                    format_width,
+    int                    format_precision
+);
+
+/**
+ *
+ *  Convert string to array of bfloat16 values
+ *
+ *  Parameters and return value are the same as in dconvstr_scan_half_array().
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_bfloat16_array(
+    const char*      input,
+    const char**     input_end,
+    unsigned short*  output,
+    int              max_values,
+    int*             n_values,
+    int              separator,
+    int*             output_erange
+);
+
+/**
+ *
+ *  Convert IEEE 754 floating-point double precision value to IEEE 754-2008 decimal64 value
+ *  in binary integer decimal (BID) encoding, without intermediate string
+ *
+ *  @param  value           Input value (IEEE 754 floating-point double precision).
+ *
+ *  @param  mode            DCONVSTR_DECIMAL64_SHORTEST: the shortest decimal which is converted back
+ *                          to the same double (like in dconvstr_print()), if it has at most 16 significant
+ *                          digits and dconvstr_decimal64_to_double() gives the same double for it;
+ *                          otherwise the nearest one, as in DCONVSTR_DECIMAL64_NEAREST mode.
+ *                          DCONVSTR_DECIMAL64_NEAREST: exact value of double correctly rounded
+ *                          to 16 significant digits, ties to even.
+ *
+ *  @param  output          Conversion result: raw bits of decimal64 value. Trailing zeros of decimal
+ *                          mantissa are removed (0.1 is encoded as 1E-1). NaN is converted to quiet NaN.
+ *
+ *  @param  output_lossy    Address of flag variable, filled by function.
+ *                          0  if output is converted back to the same double by dconvstr_decimal64_to_double()
+ *                          1  otherwise (there's no such decimal64 value with 16 significant digits)
+ *
+ *  @returns  1  if there were no internal errors
+ *            0  if there was internal error during conversion, or mode is invalid.
+ *
+ */
+DCONVSTR_API int  dconvstr_double_to_decimal64(
+    double               value,
+    int                  mode,
+    unsigned long long*  output,
+    int*                 output_lossy
+);
+
+/**
+ *
+ *  Convert IEEE 754-2008 decimal64 value in binary integer decimal (BID) encoding to IEEE 754
+ *  floating-point double precision value, without intermediate string
+ *
+ *  Result is exact value of decimal64 correctly rounded to double, ties to even (unlike in
+ *  dconvstr_scan(), results may differ for values very close to the midpoint between two doubles).
+ *  Output_erange has the same meaning as in dconvstr_scan(). Both NaN encodings (quiet and
+ *  signaling) give NaN.
+ *
+ *  @returns  1  if there were no internal errors
+ *            0  if there was internal error during conversion.
+ *
+ */
+DCONVSTR_API int  dconvstr_decimal64_to_double(
+    unsigned long long  value,
+    double*             output,
+    int*                output_erange
+);
+
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
+
+/**
+ *
+ *  Print x87 80-bit extended precision value (long double) to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *
+ *  Value is printed using the shortest decimal representation (at most 21 significant digits)
+ *  which is converted back to the same long double value by dconvstr_scan_ld().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_ld(
+    char**        outbuf,
+    int*          outbuf_size,
+    long double   value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+);
+
+/**
+ *
+ *  Convert string to x87 80-bit extended precision value (long double)
+ *
+ *  Parameters and return value are the same as in dconvstr_scan(), except for output.
+ *  Up to 38 significant digits of input are taken into account; value is rounded to 64-bit
+ *  mantissa in one step, with ties resolved to even.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_ld(
+    const char*   input,
+    const char**  input_end,
+    long double*  output,
+    int*          output_erange
+);
+
+#endif // DCONVSTR_HAVE_LONG_DOUBLE_X87
+
+#ifdef DCONVSTR_HAVE_FLOAT128
+
+/**
+ *
+ *  Print IEEE 754 quadruple precision value (__float128) to string
+ *
+ *  Parameters and return value are the same as in dconvstr_print().
+ *
+ *  Value is printed using the shortest decimal representation (at most 36 significant digits)
+ *  which is converted back to the same __float128 value by dconvstr_scan_float128().
+ *
+ */
+DCONVSTR_API int  dconvstr_print_float128(
+    char**        outbuf,
+    int*          outbuf_size,
+    __float128    value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+);
+
+/**
+ *
+ *  Convert string to IEEE 754 quadruple precision value (__float128)
+ *
+ *  Parameters and return value are the same as in dconvstr_scan(), except for output.
+ *  Up to 38 significant digits of input are taken into account; value is rounded to 113-bit
+ *  mantissa in one step, with ties resolved to even.
+ *
+ */
+DCONVSTR_API int  dconvstr_scan_float128(
+    const char*   input,
+    const char**  input_end,
+    __float128*   output,
+    int*          output_erange
+);
+
+#endif // DCONVSTR_HAVE_FLOAT128
+
+// Counters of internal code paths, see dconvstr_stats_snapshot()
+struct dconvstr_stats
+{
+    unsigned long long  special_values;              // NaN and infinities printed or scanned as double
+    unsigned long long  zeros;                       // zeros printed or scanned as double
+    unsigned long long  subnormals_packed;           // scanned values packed as double denormals
+    unsigned long long  bcd_round_carries;           // round-ups carried out of the leading digit (9.96 -> 10.0)
+    unsigned long long  erange;                      // scans as double with overflow/underflow condition
+    unsigned long long  negative_search_iterations;  // binary search steps for lower bound of shortest decimal
+    unsigned long long  positive_search_iterations;  // binary search steps for upper bound of shortest decimal
+    unsigned long long  scan_digit_truncations;      // scanned values with digits beyond significant ones
+};
+
+/**
+ *
+ *  Get counters of internal code paths taken by the calling thread
+ *
+ *  @param  output  Counters accumulated by the calling thread since its start or since the last
+ *                  call of dconvstr_stats_reset(). Filled by function; set to zeros if counters
+ *                  are not compiled in.
+ *
+ *  @returns  1  if counters are compiled in (dconvstr.c was compiled with -DDCONVSTR_ENABLE_STATS)
+ *            0  otherwise.
+ *
+ *  Counters are kept in thread-local storage, so they don't need any synchronization; each thread
+ *  sees only conversions made by itself. Carries and truncations are counted for conversions of all
+ *  formats, other counters only for conversions of double precision values (dconvstr_print(),
+ *  dconvstr_scan() and conversions between double and decimal64).
+ *
+ */
+DCONVSTR_API int  dconvstr_stats_snapshot( struct dconvstr_stats*  output );
+
+/**
+ *
+ *  Reset counters of internal code paths taken by the calling thread to zeros
+ *
+ */
+DCONVSTR_API void  dconvstr_stats_reset( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef DCONVSTR_HEADER_ONLY
+#  include "dconvstr.c"
+#endif
+
 #endif // DCONVSTR_H
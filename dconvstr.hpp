@@ -0,0 +1,463 @@
+/*
+ *  C++ interface of dconvstr compatible with std::to_chars() and std::from_chars()
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DCONVSTR_HPP
+#define DCONVSTR_HPP
+
+#include "dconvstr.h"
+
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+namespace dconvstr {
+
+namespace detail {
+
+// Shortest decimal representation of double, as printed by dconvstr_print():
+// value is 0.d1d2...dn * 10^(exponent + 1), i.e. d1.d2...dn * 10^exponent
+struct decimal
+{
+    char  digits[24];
+    int   n_digits;
+    int   exponent;
+};
+
+/**
+ *
+ *  Compare [first, last) with lowercase string ignoring case, returns length of str if it matches
+ *
+ */
+inline int  match_nocase( const char*  first, const char*  last, const char*  str )
+{
+    int  n = 0;
+    for( ; str[n] != 0; ++n )
+    {
+        if(( first + n == last )||(( first[n] | 0x20 ) != str[n] ))
+            return  0;
+    }
+    return  n;
+}
+
+/**
+ *
+ *  Get digits of the shortest decimal which is converted back to the same finite value
+ *
+ *  Trailing zeros are removed; zero has one digit '0'. Returns false on internal error.
+ *
+ */
+inline bool  get_shortest_decimal( double  value, decimal&  d )
+{
+    // 1. Print value as [-]d.dddddddddddddddde[+-]xxx (17 significant digits, zero padded)
+    char   buf[32];
+    char*  buf_end  = buf;
+    int    buf_size = sizeof(buf);
+    if(! dconvstr_print( &buf_end, &buf_size, value, 'e', 0, 0, 16 ) )
+        return  false;
+
+    // 2. Collect digits, remove trailing zeros
+    const char*  s = buf;
+    if( *s == '-' )
+        ++s;
+    d.n_digits = 0;
+    for( ; ( s != buf_end )&&( *s != 'e' ); ++s )
+    {
+        if( *s != '.' )
+            d.digits[d.n_digits++] = *s;
+    }
+    while(( d.n_digits > 1 )&&( d.digits[d.n_digits - 1] == '0' ))
+        --d.n_digits;
+
+    // 3. Parse exponent
+    if(( s == buf_end )||( buf_end - s < 3 ))
+        return  false;
+    bool  is_negative_exponent = ( s[1] == '-' );
+    d.exponent = 0;
+    for( s += 2; s != buf_end; ++s )
+        d.exponent = d.exponent * 10 + (*s - '0');
+    if( is_negative_exponent )
+        d.exponent = -d.exponent;
+    return  true;
+}
+
+/**
+ *
+ *  Length of decimal in scientific format, like "1.25e-07", without sign
+ *
+ */
+inline int  scientific_length( const decimal&  d )
+{
+    int  abs_exponent = ( (d.exponent < 0) ? -d.exponent : d.exponent );
+    return  d.n_digits + ( (d.n_digits > 1) ? 1 : 0 ) + 2 + ( (abs_exponent >= 100) ? 3 : 2 );
+}
+
+/**
+ *
+ *  Length of decimal in fixed format, like "0.000000125", without sign
+ *
+ */
+inline int  fixed_length( const decimal&  d )
+{
+    if( d.exponent >= d.n_digits - 1 )
+        return  d.exponent + 1;                    // digits and zeros, no point
+    else if( d.exponent >= 0 )
+        return  d.n_digits + 1;                    // digits with point inside
+    else
+        return  2 + (-d.exponent - 1) + d.n_digits;    // "0.", zeros, digits
+}
+
+/**
+ *
+ *  Write sign and decimal in scientific (format_char == 'e') or fixed (format_char == 'f') format
+ *
+ */
+inline std::to_chars_result  write_decimal( char*  first, char*  last, bool  is_negative, const decimal&  d, int  format_char )
+{
+    // 1. Check room in buffer
+    int  length = ( is_negative ? 1 : 0 ) + ( (format_char == 'e') ? scientific_length( d ) : fixed_length( d ) );
+    if( last - first < length )
+        return  { last, std::errc::value_too_large };
+    char*  p = first;
+    if( is_negative )
+        *p++ = '-';
+
+    // 2. Scientific format
+    if( format_char == 'e' )
+    {
+        *p++ = d.digits[0];
+        if( d.n_digits > 1 )
+        {
+            *p++ = '.';
+            for( int  i = 1; i < d.n_digits; ++i )
+                *p++ = d.digits[i];
+        }
+        int  abs_exponent = ( (d.exponent < 0) ? -d.exponent : d.exponent );
+        *p++ = 'e';
+        *p++ = ( (d.exponent < 0) ? '-' : '+' );
+        if( abs_exponent >= 100 )
+            *p++ = (char)( '0' + abs_exponent / 100 );
+        *p++ = (char)( '0' + (abs_exponent / 10) % 10 );
+        *p++ = (char)( '0' + abs_exponent % 10 );
+        return  { p, std::errc() };
+    }
+
+    // 3. Fixed format
+    if( d.exponent < 0 )
+    {
+        *p++ = '0';
+        *p++ = '.';
+        for( int  i = 0; i < -d.exponent - 1; ++i )
+            *p++ = '0';
+    }
+    for( int  i = 0; i < d.n_digits; ++i )
+    {
+        *p++ = d.digits[i];
+        if(( i == d.exponent )&&( i != d.n_digits - 1 ))
+            *p++ = '.';
+    }
+    for( int  i = d.n_digits; i <= d.exponent; ++i )
+        *p++ = '0';
+    return  { p, std::errc() };
+}
+
+/**
+ *
+ *  Write "inf", "-inf", "nan" or "-nan" if value is not finite
+ *
+ *  Returns true if value is not finite (and result is filled), false otherwise.
+ *
+ */
+inline bool  write_special( char*  first, char*  last, double  value, std::to_chars_result&  result )
+{
+    if( std::isfinite( value ) )
+        return  false;
+    const char*  str = ( std::isnan( value ) ? "nan" : "inf" );
+    bool  is_negative = std::signbit( value );
+    if( last - first < ( is_negative ? 4 : 3 ) )
+    {
+        result = { last, std::errc::value_too_large };
+        return  true;
+    }
+    char*  p = first;
+    if( is_negative )
+        *p++ = '-';
+    for( int  i = 0; i < 3; ++i )
+        *p++ = str[i];
+    result = { p, std::errc() };
+    return  true;
+}
+
+} // namespace detail
+
+/**
+ *
+ *  Print double to [first, last) in the shortest representation which is converted back to the same
+ *  value, in fixed or scientific format, whichever is shorter (fixed one on tie), like std::to_chars()
+ *
+ *  @returns  { end of printed string, std::errc() }  on success
+ *            { last, std::errc::value_too_large }     if there is not enough room in buffer
+ *
+ *  String is not terminated with zero. Digits are the same as printed by dconvstr_print() with
+ *  "%.17g" format, and they often differ from digits printed by std::to_chars(): for about 37%
+ *  of random finite doubles (736538 of 2000000), the last digit is different, because
+ *  dconvstr_print() does not pick the closest one of several decimals of the same length which
+ *  are converted back to the value (e.g. 1.8088101387491815e-140, while std::to_chars() prints
+ *  1.8088101387491814e-140). For about 0.06% of them (mostly denormals) it picks a longer decimal,
+ *  e.g. 4.9406564584124659e-324 instead of 5e-324. In fixed format, digits beyond the shortest
+ *  representation are zeros, while std::to_chars() prints exact value of large integers.
+ *
+ */
+inline std::to_chars_result  to_chars( char*  first, char*  last, double  value )
+{
+    std::to_chars_result  result;
+    if( detail::write_special( first, last, value, result ) )
+        return  result;
+    detail::decimal  d;
+    if(! detail::get_shortest_decimal( value, d ) )
+        return  { last, std::errc::value_too_large };
+    int  format_char = ( (detail::fixed_length( d ) <= detail::scientific_length( d )) ? 'f' : 'e' );
+    return  detail::write_decimal( first, last, std::signbit( value ), d, format_char );
+}
+
+/**
+ *
+ *  Print double to [first, last) in the shortest representation in given format, like std::to_chars()
+ *
+ *  chars_format::fixed and chars_format::scientific select the format, chars_format::general selects
+ *  it like printf(3) does with %g format and default precision: fixed one if decimal exponent is
+ *  at least -4 and less than 6, scientific one otherwise.
+ *  Hexadecimal format is not supported: { last, std::errc::invalid_argument } is returned.
+ *  Other details are the same as in to_chars( first, last, value ).
+ *
+ */
+inline std::to_chars_result  to_chars( char*  first, char*  last, double  value, std::chars_format  fmt )
+{
+    if( fmt == std::chars_format::hex )
+        return  { last, std::errc::invalid_argument };
+    std::to_chars_result  result;
+    if( detail::write_special( first, last, value, result ) )
+        return  result;
+    detail::decimal  d;
+    if(! detail::get_shortest_decimal( value, d ) )
+        return  { last, std::errc::value_too_large };
+    int  format_char = 'e';
+    if( fmt == std::chars_format::fixed )
+        format_char = 'f';
+    else if(( fmt == std::chars_format::general )&&( d.exponent >= -4 )&&( d.exponent < DCONVSTR_DEFAULT_PRECISION ))
+        format_char = 'f';
+    return  detail::write_decimal( first, last, std::signbit( value ), d, format_char );
+}
+
+/**
+ *
+ *  Print double to [first, last) in given format with given precision, like std::to_chars()
+ *
+ *  Result is the same as of dconvstr_print() with 'f', 'e' or 'g' format char: digits beyond the
+ *  shortest representation are zeros, unlike in std::to_chars(), which prints exact value of double.
+ *  Negative precision selects the default one (6). Hexadecimal format is not supported:
+ *  { last, std::errc::invalid_argument } is returned.
+ *
+ */
+inline std::to_chars_result  to_chars( char*  first, char*  last, double  value, std::chars_format  fmt, int  precision )
+{
+    int  format_char = 0;
+    if( fmt == std::chars_format::fixed )
+        format_char = 'f';
+    else if( fmt == std::chars_format::scientific )
+        format_char = 'e';
+    else if( fmt == std::chars_format::general )
+        format_char = 'g';
+    else
+        return  { last, std::errc::invalid_argument };
+    std::to_chars_result  result;
+    if( detail::write_special( first, last, value, result ) )
+        return  result;
+    char*  outbuf      = first;
+    int    outbuf_size = ( (last - first > INT_MAX) ? INT_MAX : (int)( last - first ) );
+    if(! dconvstr_print( &outbuf, &outbuf_size, value, format_char, 0, 0,
+                         ( (precision < 0) ? DCONVSTR_DEFAULT_PRECISION : precision ) ) )
+        return  { last, std::errc::value_too_large };
+    return  { outbuf, std::errc() };
+}
+
+/**
+ *
+ *  Convert string in [first, last) to double, like std::from_chars()
+ *
+ *  @param  fmt  chars_format::general (default): exponent is optional,
+ *               chars_format::scientific: exponent is required,
+ *               chars_format::fixed: exponent is not allowed (parsing stops before it).
+ *               Hexadecimal format is not supported: { first, std::errc::invalid_argument } is returned.
+ *
+ *  @returns  { end of parsed value, std::errc() }                      on success
+ *            { first, std::errc::invalid_argument }                      if there is no value at first
+ *            { end of parsed value, std::errc::result_out_of_range }     on overflow or underflow,
+ *                                                                        value is not modified then
+ *
+ *  Like in std::from_chars(), leading whitespace and plus sign are not accepted, "inf", "infinity",
+ *  "nan" and "nan(chars)" are accepted ignoring case. String does not need to be terminated with zero.
+ *  Result is the same as of dconvstr_scan(), which is not always correctly rounded: for about 0.05%
+ *  of strings with 16 significant digits (490 of 1000000 random doubles printed with "%.15e"),
+ *  it differs from result of std::from_chars() by one unit in the last place. Besides, digits
+ *  after 19 significant ones are truncated.
+ *
+ */
+inline std::from_chars_result  from_chars( const char*  first, const char*  last, double&  value,
+                                           std::chars_format  fmt = std::chars_format::general )
+{
+    // 1. Check format and parse sign
+    if( fmt == std::chars_format::hex )
+        return  { first, std::errc::invalid_argument };
+    const char*  s = first;
+    bool  is_negative = (( s != last )&&( *s == '-' ));
+    if( is_negative )
+        ++s;
+
+    // 2. Handle special values
+    if( int  n = detail::match_nocase( s, last, "inf" ) )
+    {
+        s += n;
+        s += detail::match_nocase( s, last, "inity" );
+        value = ( is_negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity() );
+        return  { s, std::errc() };
+    }
+    if( int  n = detail::match_nocase( s, last, "nan" ) )
+    {
+        s += n;
+        if(( s != last )&&( *s == '(' ))
+        {
+            const char*  p = s + 1;
+            while(( p != last )&&((( *p >= '0' )&&( *p <= '9' ))||(( (*p | 0x20) >= 'a' )&&( (*p | 0x20) <= 'z' ))||( *p == '_' )))
+                ++p;
+            if(( p != last )&&( *p == ')' ))
+                s = p + 1;
+        }
+        value = ( is_negative ? -std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::quiet_NaN() );
+        return  { s, std::errc() };
+    }
+
+    // 3. Parse mantissa: keep 40 significant digits, value is (digits * 10^exponent)
+    char          buf[64];
+    int           n_buf       = 0;
+    int           n_sign      = ( is_negative ? 1 : 0 );
+    int           n_digits    = 0;     // number of digits in mantissa, including zeros
+    std::int64_t  exponent    = 0;
+    if( is_negative )
+        buf[n_buf++] = '-';
+    for( ; ( s != last )&&( *s >= '0' )&&( *s <= '9' ); ++s, ++n_digits )
+    {
+        if(( *s == '0' )&&( n_buf == n_sign ))
+            continue;                       // leading zero
+        if( n_buf < n_sign + 40 )
+            buf[n_buf++] = *s;
+        else
+            ++exponent;                     // truncated digit before point
+    }
+    if(( s != last )&&( *s == '.' ))
+    {
+        for( ++s; ( s != last )&&( *s >= '0' )&&( *s <= '9' ); ++s, ++n_digits )
+        {
+            if(( *s == '0' )&&( n_buf == n_sign ))
+                --exponent;                 // leading zero after point
+            else if( n_buf < n_sign + 40 )
+            {
+                buf[n_buf++] = *s;
+                --exponent;
+            }
+        }
+    }
+    if( n_digits == 0 )
+        return  { first, std::errc::invalid_argument };
+
+    // 4. Parse exponent
+    if(( fmt != std::chars_format::fixed )&&( s != last )&&(( *s == 'e' )||( *s == 'E' )))
+    {
+        const char*  p = s + 1;
+        bool  is_negative_exponent = (( p != last )&&( *p == '-' ));
+        if(( p != last )&&(( *p == '-' )||( *p == '+' )))
+            ++p;
+        if(( p != last )&&( *p >= '0' )&&( *p <= '9' ))
+        {
+            std::int64_t  written_exponent = 0;
+            for( ; ( p != last )&&( *p >= '0' )&&( *p <= '9' ); ++p )
+            {
+                if( written_exponent < 1000000000 )
+                    written_exponent = written_exponent * 10 + (*p - '0');
+            }
+            exponent += ( is_negative_exponent ? -written_exponent : written_exponent );
+            s = p;
+        }
+        else if( fmt == std::chars_format::scientific )
+            return  { first, std::errc::invalid_argument };
+    }
+    else if( fmt == std::chars_format::scientific )
+        return  { first, std::errc::invalid_argument };
+
+    // 5. Convert normalized string "[-]digitsE[-]exponent" with dconvstr_scan()
+    if( n_buf == n_sign )
+    {
+        buf[n_buf++] = '0';
+        exponent = 0;
+    }
+    if( exponent < -2000000000 )
+        exponent = -2000000000;
+    else if( exponent > 2000000000 )
+        exponent = 2000000000;
+    buf[n_buf++] = 'e';
+    if( exponent < 0 )
+    {
+        buf[n_buf++] = '-';
+        exponent = -exponent;
+    }
+    char  exponent_digits[16];
+    int   n_exponent_digits = 0;
+    do
+    {
+        exponent_digits[n_exponent_digits++] = (char)( '0' + exponent % 10 );
+        exponent /= 10;
+    }
+    while( exponent != 0 );
+    while( n_exponent_digits != 0 )
+        buf[n_buf++] = exponent_digits[--n_exponent_digits];
+    buf[n_buf] = 0;
+    double  result = 0.0;
+    int     erange = 0;
+    if(! dconvstr_scan( buf, nullptr, &result, &erange ) )
+        return  { first, std::errc::invalid_argument };
+    if( erange )
+        return  { s, std::errc::result_out_of_range };
+    value = result;
+    return  { s, std::errc() };
+}
+
+} // namespace dconvstr
+
+#endif // DCONVSTR_HPP
@@ -26,6 +26,10 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE      // for CPU_SET() and clock_gettime()
+#endif
+
 #include "dconvstr.h"
 
 #include <string.h>
@@ -36,35 +40,221 @@
 
 #ifndef _MSC_VER
 #  include <stdint.h>
+#  include <inttypes.h>
 #else
 #  include <intrin.h>
 #  define  strtoull          _strtoui64
+#  define  PRIu64            "I64u"
+   typedef unsigned char     uint8_t;
+   typedef __int32           int32_t;
    typedef unsigned __int64  uint64_t;
 #endif
 
 #if defined(_WIN32) || defined(_WIN64)
 #  include <windows.h>
 #elif defined(__linux__)
-#  define __USE_GNU
 #  include <sched.h>
 #  include <unistd.h>
+#  include <time.h>
+#  include <pthread.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <linux/perf_event.h>
 #else
 #  include <pthread.h>
 #  include <pthread_np.h>
+#  include <time.h>
 #endif
 
 #ifdef USE_PLAN9_LIBC
 #  include <fmt.h>
 #endif
 
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+#  include "dconvstr_internal.h"
+#endif
+
 
 //=====================================================================================================
 //
-// CONSTANTS AND GLOBAL VARIABLES
+// TYPES, CONSTANTS AND GLOBAL VARIABLES
 //
 
+// Number of values in one batch: values are generated once per workload, then printed and scanned
+// in batches, so that timer is read once per batch, not once per conversion
+#define BATCH_SIZE        4096
+
+// Maximum length of printed value (including terminating zero)
+#define MAX_STRING_SIZE   384
+
+// Workload: named distribution of input values
+struct workload
+{
+    const char*  name;
+    double       (*generate)();
+};
+
+// Output format used both for printing and for scanning of printed strings
+struct output_format
+{
+    const char*  name;
+    const char*  printf_format;   // equivalent format string of printf(3)
+    int          format_char;
+    int          format_precision;
+    int          is_exact;        // printed value is converted back to the same double
+    int          is_shortest;     // libraries with shortest mode use it instead of precision
+};
+
+// Library under test: adapters return length of printed string / number of scanned characters,
+// or -1 on error
+struct library
+{
+    const char*  name;
+    int          (*print)( char*  str, int  str_size, double  value, const struct output_format*  format );
+    int          (*scan)( const char*  str, double*  value );
+};
+
+// Hardware performance counters (Linux perf_event_open only)
+enum
+{
+    COUNTER_CYCLES = 0,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_L1D_MISSES,
+    COUNTER_LLC_MISSES,
+    N_COUNTERS
+};
+
+// Result of measurement of one operation (print or scan) for one library
+struct measurement
+{
+    uint64_t  n_ops;
+    uint64_t  cycles;
+    uint64_t  nanoseconds;
+    uint64_t  bytes;
+    uint64_t  counters[N_COUNTERS];
+};
+
 static uint64_t  local_rng_state_ = 0;
 
+// Input values and strings of the current workload, one per thread (too large for stack)
+struct batch
+{
+    double  values[BATCH_SIZE];
+    double  scanned_values[BATCH_SIZE];
+    char    strings[BATCH_SIZE][MAX_STRING_SIZE];
+    int     string_lengths[BATCH_SIZE];
+};
+
+static struct batch  batch_;
+
+// Latency histogram: values below 32 cycles have own buckets, larger values are grouped in 16 buckets
+// per power of two (relative error below 1/16, like HDR histogram with 1 significant digit and a half)
+#define HISTOGRAM_BUCKETS  976
+
+// Number of the slowest inputs reported in latency benchmark
+#define N_SLOWEST          5
+
+// Histogram of latencies of single conversions (in cycles). Every input of the batch is converted
+// n_batches times; the minimum latency of each input filters out interrupts and preemptions, so the
+// slowest inputs are found by it.
+struct histogram
+{
+    uint64_t  counts[HISTOGRAM_BUCKETS];
+    uint64_t  n_samples;
+    uint64_t  max;
+    uint64_t  input_min_cycles[BATCH_SIZE];
+};
+
+// Output modes of throughput benchmark
+enum
+{
+    OUTPUT_TABLE = 0,
+    OUTPUT_CSV,
+    OUTPUT_JSON
+};
+
+// Record of baseline file: "workload,format,op,library" key and cycles per conversion
+struct baseline_record
+{
+    char    key[128];
+    double  cycles_per_op;
+};
+
+#define MAX_BASELINE_RECORDS  4096
+
+static int                     output_mode_ = OUTPUT_TABLE;
+static int                     n_json_records_ = 0;
+static struct baseline_record  baseline_records_[MAX_BASELINE_RECORDS];
+static int                     n_baseline_records_ = 0;
+static double                  regression_threshold_ = 5.0;   // percent
+
+// Corpus of numbers in text form: tokens are stored in text as zero-terminated strings
+struct corpus
+{
+    const char*  name;
+    char*        text;
+    size_t       text_size;
+    char**       numbers;
+    size_t       n_numbers;
+    size_t       numbers_size;   // total length of all numbers in bytes
+};
+
+#define MAX_CORPORA  16
+
+// Buffer which is streamed through between conversions in cache-cold mode of latency benchmark
+static unsigned char*  pollution_buffer_ = NULL;
+static size_t          pollution_buffer_size_ = 0;
+
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+// Inputs and outputs of internal stages of dconvstr_print() and dconvstr_scan() for the current batch
+struct stage_data
+{
+    // dconvstr_print() stages
+    uint64_t  binary_mantissas[BATCH_SIZE];
+    int32_t   binary_exponents[BATCH_SIZE];
+    uint64_t  decimal_mantissas[BATCH_SIZE];
+    int32_t   decimal_exponents[BATCH_SIZE];
+    uint8_t   decimal_digits[BATCH_SIZE][20];
+    int       signs[BATCH_SIZE];
+
+    // dconvstr_scan() stages
+    uint8_t   scanned_digits[BATCH_SIZE][20];
+    int32_t   scanned_exponents[BATCH_SIZE];
+    int       scanned_signs[BATCH_SIZE];
+    uint64_t  scanned_mantissas[BATCH_SIZE];
+    uint64_t  rounded_mantissas[BATCH_SIZE];
+    int32_t   rounded_exponents[BATCH_SIZE];
+};
+
+// Internal stage: processes the whole batch
+struct stage
+{
+    const char*  name;
+    void         (*run)();
+    int          is_included_in_sum;   // 0 if stage is a part of another stage or the full conversion
+};
+
+static struct stage_data  stage_data_;
+#endif
+
+// Maximum number of threads in scaling benchmark
+#define MAX_THREADS       1024
+
+// Context of one thread of scaling benchmark
+struct thread_context
+{
+    struct batch                 b;
+    const struct library*        library;
+    const struct output_format*  format;
+    uint64_t                     n_batches;
+    int                          operation;   // 0 = print, 1 = scan
+};
+
+// File descriptors of opened hardware performance counters (-1 if not available)
+static int  counter_fds_[N_COUNTERS] = { -1, -1, -1, -1, -1 };
+static int  counters_enabled_ = 0;
+
 //=====================================================================================================
 //
 // FUNCTIONS
@@ -86,6 +276,16 @@ static inline uint64_t  local_rng_get_random_uint64()
     return  (a << 32) | b;
 }
 
+/**
+ *
+ *  Generate random double uniformly distributed in [0, 1) with 53 random bits
+ *
+ */
+static inline double  local_rng_get_random_unit()
+{
+    return  ((double)( local_rng_get_random_uint64() >> 11 )) * (1.0 / 9007199254740992.0);
+}
+
 /**
  *
  *  Read timestamp counter (processor built-in)
@@ -104,163 +304,1849 @@ static inline uint64_t  read_timestamp_counter()
 
 /**
  *
- *  Execute benchmark test
+ *  Read monotonic wall clock in nanoseconds
  *
  */
-static void  benchmark()
+static inline uint64_t  read_wall_clock()
 {
-    fprintf( stderr, "Running benchmark, please wait...\n" );
+#if defined(_WIN32) || defined(_WIN64)
+    LARGE_INTEGER  counter, frequency;
+    QueryPerformanceCounter( &counter );
+    QueryPerformanceFrequency( &frequency );
+    return  (uint64_t)( ((double)counter.QuadPart) * 1e9 / ((double)frequency.QuadPart) );
+#else
+    struct timespec  ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return  ((uint64_t)ts.tv_sec) * 1000000000ULL + ((uint64_t)ts.tv_nsec);
+#endif
+}
+
+//=====================================================================================================
+//
+// HARDWARE PERFORMANCE COUNTERS
+//
+/**
+ *
+ *  Open hardware performance counters of the current thread (user mode only)
+ *
+ *  Counters which can't be opened (not permitted by perf_event_paranoid, not supported by CPU
+ *  or hypervisor) are skipped. Returns number of opened counters.
+ *
+ */
+static int  open_counters()
+{
+    int  n_opened = 0;
+#ifdef __linux__
+    static const struct { uint32_t  type; uint64_t  config; }  events[N_COUNTERS] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES    },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS  },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+        { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL  | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) }
+    };
+    for( int  i = 0; i < N_COUNTERS; ++i )
+    {
+        struct perf_event_attr  attr;
+        memset( &attr, 0, sizeof(attr) );
+        attr.size           = sizeof(attr);
+        attr.type           = events[i].type;
+        attr.config         = events[i].config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        counter_fds_[i] = (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+        n_opened += ( counter_fds_[i] >= 0 );
+    }
+#endif
+    return  n_opened;
+}
 
-    uint64_t  t0, t1;
-    uint64_t  dconvstr_time1 = 0, dconvstr_time2 = 0;
-    uint64_t  libc_time1     = 0, libc_time2     = 0;
+/**
+ *
+ *  Reset and start all opened hardware performance counters
+ *
+ */
+static inline void  start_counters()
+{
+#ifdef __linux__
+    for( int  i = 0; i < N_COUNTERS; ++i )
+    {
+        if( counter_fds_[i] >= 0 )
+        {
+            ioctl( counter_fds_[i], PERF_EVENT_IOC_RESET,  0 );
+            ioctl( counter_fds_[i], PERF_EVENT_IOC_ENABLE, 0 );
+        }
+    }
+#endif
+}
 
-    uint64_t  loop_limit;
-#ifndef USE_PLAN9_LIBC
-    loop_limit = 0x1000000;
+/**
+ *
+ *  Stop all opened hardware performance counters and add their values to result
+ *
+ */
+static inline void  stop_counters( struct measurement*  result )
+{
+#ifdef __linux__
+    for( int  i = 0; i < N_COUNTERS; ++i )
+        if( counter_fds_[i] >= 0 )
+            ioctl( counter_fds_[i], PERF_EVENT_IOC_DISABLE, 0 );
+    for( int  i = 0; i < N_COUNTERS; ++i )
+    {
+        uint64_t  value = 0;
+        if(( counter_fds_[i] >= 0 )&&( read( counter_fds_[i], &value, sizeof(value) ) == sizeof(value) ))
+            result->counters[i] += value;
+    }
 #else
-    loop_limit = 0x100000;
+    (void) result;
 #endif
-    for( uint64_t  i = 0; i < loop_limit; ++i )
-    {
-        // 1. Generate random double-precision floating point value
-        uint64_t  raw_random_value;
-        do {
-            raw_random_value = local_rng_get_random_uint64();     // skip NAN/INF because not every libc
-        } while( ((raw_random_value >> 52) & 0x7FF) == 0x7FF );   // can parse its own output
-        double  random_value = 0.0;
-        memcpy( &random_value, &raw_random_value, sizeof(random_value) );
-
-        // 2. Print number to string (using full precision) with dconvstr library
-        char   str[128];
-        int    str_size = sizeof(str) - 1;
-        char*  str_end = str;
-        t0 = read_timestamp_counter();
-        int  dconvstr_print_status = dconvstr_print(
-            &str_end, &str_size, random_value,
-            'e', 0, 0, 20
-        );
-        t1 = read_timestamp_counter();
-        dconvstr_time1 += (t1 - t0);
-        if((! dconvstr_print_status )||( str_end + str_size != str + sizeof(str) - 1 ))
-        {
-            fprintf( stderr, "Failed 1\n" );
-            exit(-1);
-        }
-        *str_end = 0;
+}
 
-        // 3. Convert string back to number using dconvstr library
-        const char*  str_actual_end = NULL;
-        double  alt_random_value = 0.0;
-        int  erange_condition = 1;
-        t0 = read_timestamp_counter();
-        int  dconvstr_scan_status = dconvstr_scan(
-            str, &str_actual_end, &alt_random_value, &erange_condition
-        );
-        t1 = read_timestamp_counter();
-        dconvstr_time2 += (t1 - t0);
-        if((! dconvstr_scan_status )||( erange_condition )||( str_actual_end != str_end )||
-           ( 0 != memcmp( &random_value, &alt_random_value, sizeof(double) ) ))
-        {
-            fprintf( stderr, "Failed 2\n" );
-            exit(-1);
-        }
+//=====================================================================================================
+//
+// WORKLOADS
+//
+/**
+ *
+ *  Uniformly random 64-bit patterns, except for NaN and infinity (huge exponents, 17 digits)
+ *
+ */
+static double  generate_random_bits()
+{
+    uint64_t  raw_random_value;
+    do {
+        raw_random_value = local_rng_get_random_uint64();     // skip NAN/INF because not every libc
+    } while( ((raw_random_value >> 52) & 0x7FF) == 0x7FF );   // can parse its own output
+    double  random_value = 0.0;
+    memcpy( &random_value, &raw_random_value, sizeof(random_value) );
+    return  random_value;
+}
+
+/**
+ *
+ *  Small non-negative integers: counters, quantities, identifiers
+ *
+ */
+static double  generate_small_integer()
+{
+    return  (double)( local_rng_get_random_uint64() % 10000 );
+}
+
+/**
+ *
+ *  Prices with two decimal places, from 0.01 to 99999.99
+ *
+ */
+static double  generate_price()
+{
+    return  ((double)( local_rng_get_random_uint64() % 9999999 + 1 )) / 100.0;
+}
+
+/**
+ *
+ *  Values uniformly distributed in [0, 1): probabilities, ratios, normalized coordinates
+ *
+ */
+static double  generate_unit_range()
+{
+    return  local_rng_get_random_unit();
+}
+
+/**
+ *
+ *  Scientific spread: mantissa uniform in [1, 10), decimal exponent uniform in [-30, 30], random sign
+ *
+ */
+static double  generate_scientific()
+{
+    double  mantissa = 1.0 + 9.0 * local_rng_get_random_unit();
+    int     exponent = (int)( local_rng_get_random_uint64() % 61 ) - 30;
+    double  value    = mantissa * pow( 10.0, exponent );
+    return  ( (local_rng_get_random_uint64() & 1) ? -value : value );
+}
+
+/**
+ *
+ *  Denormalized numbers with random mantissa and sign
+ *
+ */
+static double  generate_subnormal()
+{
+    uint64_t  raw_random_value = local_rng_get_random_uint64() & 0x800FFFFFFFFFFFFFULL;
+    if(( raw_random_value << 1 ) == 0 )
+        raw_random_value |= 1;
+    double  random_value = 0.0;
+    memcpy( &random_value, &raw_random_value, sizeof(random_value) );
+    return  random_value;
+}
+
+static const struct workload  workloads_[] = {
+    { "random-bits",    generate_random_bits   },
+    { "small-integers", generate_small_integer },
+    { "prices",         generate_price         },
+    { "unit-range",     generate_unit_range    },
+    { "scientific",     generate_scientific    },
+    { "subnormals",     generate_subnormal     }
+};
+
+// In "shortest" format dconvstr prints the shortest round-trip decimal with "%.17g", std::to_chars()
+// prints it in shortest mode, libc prints 17 digits. Upper case formats are omitted because they
+// share code paths with lower case ones in all libraries.
+static const struct output_format  output_formats_[] = {
+    { "shortest", "%.17g", 'g', 17, 1, 1 },
+    { "%.20e",    "%.20e", 'e', 20, 1, 0 },
+    { "%.6e",     "%.6e",  'e',  6, 0, 0 },
+    { "%.6f",     "%.6f",  'f',  6, 0, 0 },
+    { "%g",       "%g",    'g',  6, 0, 0 }
+};
+
+#define N_OUTPUT_FORMATS  ( (int)( sizeof(output_formats_) / sizeof(output_formats_[0]) ) )
+
+//=====================================================================================================
+//
+// LIBRARIES
+//
+/**
+ *
+ *  Print value with dconvstr library
+ *
+ */
+static int  dconvstr_library_print( char*  str, int  str_size, double  value, const struct output_format*  format )
+{
+    char*  str_end = str;
+    int    str_rest = str_size - 1;
+    if(! dconvstr_print( &str_end, &str_rest, value, format->format_char, 0, 0, format->format_precision ) )
+        return  -1;
+    *str_end = 0;
+    return  (int)( str_end - str );
+}
+
+/**
+ *
+ *  Scan value with dconvstr library
+ *
+ */
+static int  dconvstr_library_scan( const char*  str, double*  value )
+{
+    const char*  str_end = NULL;
+    int  erange_condition = 0;
+    if(! dconvstr_scan( str, &str_end, value, &erange_condition ) )
+        return  -1;
+    return  (int)( str_end - str );
+}
 
-        // 4. Print number to string (using full precision) with libc
-        memset( str, 0, sizeof(str) );
+/**
+ *
+ *  Print value with libc
+ *
+ */
+static int  libc_print( char*  str, int  str_size, double  value, const struct output_format*  format )
+{
 #ifndef USE_PLAN9_LIBC
-        t0 = read_timestamp_counter();
-        snprintf( str, sizeof(str)-1, "%.20e", random_value );
-        t1 = read_timestamp_counter();
-        libc_time1 += (t1 - t0);
+    int  n = snprintf( str, str_size, format->printf_format, value );
 #else
-        t0 = read_timestamp_counter();
-        snprint( str, sizeof(str)-1, "%.20e", random_value );
-        t1 = read_timestamp_counter();
-        libc_time1 += (t1 - t0);
+    int  n = snprint( str, str_size, format->printf_format, value );
 #endif
+    return  ( (n >= 0)&&(n < str_size) ) ? n : -1;
+}
 
-        // 5. Convert string back to number using libc
-        char*  str_actual_end2 = NULL;
-        errno = 0;
-        t0 = read_timestamp_counter();
+/**
+ *
+ *  Scan value with libc
+ *
+ */
+static int  libc_scan( const char*  str, double*  value )
+{
+    char*  str_end = NULL;
+    errno = 0;
 #ifndef USE_PLAN9_LIBC
-        alt_random_value = strtod( str, &str_actual_end2 );
+    *value = strtod( str, &str_end );
 #else
-        alt_random_value = fmtstrtod( str, &str_actual_end2 );
+    *value = fmtstrtod( str, &str_end );
 #endif
-        t1 = read_timestamp_counter();
-        libc_time2 += (t1 - t0);
-        if( str_actual_end2 != str + strlen( str ) )
-        {
-            fprintf( stderr, "Failed 3\n" );
-            exit(-1);
-        }
+    return  (int)( str_end - str );
+}
 
-#ifdef USE_PLAN9_LIBC
-        if( (i & 0xFFF) == 0xFFF )
-            fprintf( stderr, "." );
-#endif
-    }
+#ifdef DCONVSTR_BENCHMARK_CHARCONV
+// Adapters to std::to_chars() and std::from_chars(), see dconvstr_benchmark_charconv.cpp
+int  dconvstr_benchmark_to_chars( char*  str, int  str_size, double  value, int  format_char, int  format_precision );
+int  dconvstr_benchmark_from_chars( const char*  str, double*  value );
 
-    if(( dconvstr_time1 != 0 )&&( dconvstr_time2 != 0 )&&( libc_time1 != 0 )&&( libc_time2 != 0 ))
-    {
-        double  r1 = ((double)libc_time1) / ((double)dconvstr_time1);
-        double  r2 = ((double)libc_time2) / ((double)dconvstr_time2);
-        fprintf( stderr, "Double-to-string conversion: time ratio = %g\n"
-                         "String-to-double conversion: time ratio = %g\n",
-                         r1, r2 );
-    }
+/**
+ *
+ *  Print value with std::to_chars()
+ *
+ */
+static int  charconv_print( char*  str, int  str_size, double  value, const struct output_format*  format )
+{
+    return  dconvstr_benchmark_to_chars(
+        str, str_size, value,
+        ( format->is_shortest ? 0 : format->format_char ), format->format_precision
+    );
 }
+#endif
+
+#ifdef DCONVSTR_BENCHMARK_TEMPLATE
+// Adapters to template printers with format fixed at compile time, see dconvstr_benchmark_template.cpp
+int  dconvstr_benchmark_print_template( char*  str, int  str_size, double  value, int  format_char, int  format_precision );
+int  dconvstr_benchmark_scan_template( const char*  str, double*  value );
 
 /**
  *
- *  Program entry point
+ *  Print value with dconvstr::print<format, precision>()
  *
  */
-#ifndef USE_PLAN9_LIBC
-int  main( int  argc, const char* const*  argv )
+static int  template_print( char*  str, int  str_size, double  value, const struct output_format*  format )
+{
+    return  dconvstr_benchmark_print_template( str, str_size, value, format->format_char, format->format_precision );
+}
+#endif
+
+static const struct library  libraries_[] = {
+    { "dconvstr",  dconvstr_library_print, dconvstr_library_scan        },
+#if defined(USE_PLAN9_LIBC)
+    { "plan9",     libc_print,             libc_scan                    },
+#elif defined(__GLIBC__)
+    { "glibc",     libc_print,             libc_scan                    },
 #else
-int  p9main( int  argc, const char* const*  argv )
+    { "libc",      libc_print,             libc_scan                    },
+#endif
+#ifdef DCONVSTR_BENCHMARK_CHARCONV
+    { "charconv",  charconv_print,         dconvstr_benchmark_from_chars },
 #endif
+#ifdef DCONVSTR_BENCHMARK_TEMPLATE
+    { "template",  template_print,         dconvstr_benchmark_scan_template },
+#endif
+};
+
+#define N_LIBRARIES  ( (int)( sizeof(libraries_) / sizeof(libraries_[0]) ) )
+
+//=====================================================================================================
+//
+// BENCHMARK
+//
+/**
+ *
+ *  Print and scan batch of values with given library and format n_batches times
+ *
+ */
+static void  benchmark_batch(
+    struct batch*                b,
+    const struct library*        library,
+    const struct output_format*  format,
+    uint64_t                     n_batches,
+    struct measurement*          print_result,
+    struct measurement*          scan_result
+)
 {
-    // 1. Check command line
-    if( argc > 2 )
+    memset( print_result, 0, sizeof(*print_result) );
+    memset( scan_result,  0, sizeof(*scan_result)  );
+    for( uint64_t  batch = 0; batch < n_batches; ++batch )
     {
-        fprintf( stderr, "Usage: dconvstr_benchmark [initial_rng_state]\n" );
-        exit(-1);
-    }
-    fprintf( stderr, "Running dconvstr_benchmark, build date " __DATE__ " " __TIME__ "\n" );
+        // 1. Print all values of the batch
+        if( counters_enabled_ )
+            start_counters();
+        uint64_t  t0 = read_wall_clock();
+        uint64_t  c0 = read_timestamp_counter();
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            b->string_lengths[i] = library->print( b->strings[i], MAX_STRING_SIZE, b->values[i], format );
+        uint64_t  c1 = read_timestamp_counter();
+        uint64_t  t1 = read_wall_clock();
+        if( counters_enabled_ )
+            stop_counters( print_result );
+        uint64_t  batch_bytes = 0;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+        {
+            if( b->string_lengths[i] < 0 )
+            {
+                fprintf( stderr, "Print failed in %s library for value %.17g\n", library->name, b->values[i] );
+                exit(-1);
+            }
+            batch_bytes += b->string_lengths[i];
+        }
+        print_result->n_ops       += BATCH_SIZE;
+        print_result->cycles      += (c1 - c0);
+        print_result->nanoseconds += (t1 - t0);
+        print_result->bytes       += batch_bytes;
 
-    // 2. Initialize local RNG (optional)
-    if( argc == 2 )
-    {
-        errno = 0;
-        uint64_t  parse_result = strtoull( argv[1], 0, 10 );
-        if( errno != 0 )
+        // 2. Scan all printed strings
+        if( counters_enabled_ )
+            start_counters();
+        t0 = read_wall_clock();
+        c0 = read_timestamp_counter();
+        int  n_mismatches = 0;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            n_mismatches += ( library->scan( b->strings[i], &b->scanned_values[i] ) != b->string_lengths[i] );
+        c1 = read_timestamp_counter();
+        t1 = read_wall_clock();
+        if( counters_enabled_ )
+            stop_counters( scan_result );
+        scan_result->n_ops       += BATCH_SIZE;
+        scan_result->cycles      += (c1 - c0);
+        scan_result->nanoseconds += (t1 - t0);
+        scan_result->bytes       += batch_bytes;
+
+        // 3. Check results: all strings are parsed up to the end, and values are restored exactly
+        //    if format has enough digits
+        if( n_mismatches != 0 )
         {
-            fprintf( stderr, "Can't parse command line (initial RNG state)\n" );
+            fprintf( stderr, "Scan failed in %s library: strings not parsed up to the end\n", library->name );
+            exit(-1);
+        }
+        if(( format->is_exact )&&( 0 != memcmp( b->values, b->scanned_values, sizeof(b->values) ) ))
+        {
+            fprintf( stderr, "Scan failed in %s library: values not restored exactly with format %s\n",
+                     library->name, format->name );
             exit(-1);
         }
-        local_rng_state_ = parse_result;
     }
+}
 
-    // 3. Set thread affinity so read_timestamp_counter() won't return garbage
-#if defined(_WIN32) || defined(_WIN64)
-    SetThreadAffinityMask( GetCurrentThread(), 1 );
-#elif defined(__linux__)
-    cpu_set_t  cpuset;
-    CPU_ZERO( &cpuset );
-    CPU_SET( 0, &cpuset );
-    sched_setaffinity( getpid(), sizeof(cpuset), &cpuset );
-#else
-    cpuset_t  cpuset;
-    CPU_ZERO( &cpuset );
-    CPU_SET( 0, &cpuset );
-    pthread_setaffinity_np( pthread_self(), sizeof(cpuset), &cpuset );
-#endif
+/**
+ *
+ *  Load baseline file (CSV output of previous run with --output=csv)
+ *
+ */
+static void  load_baseline( const char*  file_name )
+{
+    FILE*  f = fopen( file_name, "r" );
+    if( f == NULL )
+    {
+        fprintf( stderr, "Can't open baseline file %s\n", file_name );
+        exit(-1);
+    }
+    char  line[1024];
+    while(( fgets( line, sizeof(line), f ) != NULL )&&( n_baseline_records_ < MAX_BASELINE_RECORDS ))
+    {
+        // workload,format,op,library,cycles_per_op,... (header line and malformed lines are skipped)
+        struct baseline_record*  record = baseline_records_ + n_baseline_records_;
+        char*  p = line;
+        int  n_commas = 0;
+        while(( *p != 0 )&&( n_commas < 4 ))
+            n_commas += ( *p++ == ',' );
+        if(( n_commas != 4 )||( (size_t)( p - line ) > sizeof(record->key) ))
+            continue;
+        char*  number_end = NULL;
+        record->cycles_per_op = strtod( p, &number_end );
+        if(( number_end == p )||( *number_end != ',' ))
+            continue;
+        memcpy( record->key, line, p - line - 1 );
+        record->key[p - line - 1] = 0;
+        ++n_baseline_records_;
+    }
+    fclose( f );
+    if( n_baseline_records_ == 0 )
+    {
+        fprintf( stderr, "No records in baseline file %s\n", file_name );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Find baseline cycles/op for given workload, format, operation and library (0 if not found)
+ *
+ */
+static double  find_baseline(
+    const struct workload*       workload,
+    const struct output_format*  format,
+    const char*                  operation,
+    const struct library*        library
+)
+{
+    char  key[sizeof(baseline_records_[0].key)];
+    snprintf( key, sizeof(key), "%s,%s,%s,%s", workload->name, format->name, operation, library->name );
+    for( int  i = 0; i < n_baseline_records_; ++i )
+        if( 0 == strcmp( key, baseline_records_[i].key ) )
+            return  baseline_records_[i].cycles_per_op;
+    return  0.0;
+}
 
-    // 4. Run benchmark
-    benchmark();
+/**
+ *
+ *  Print header of measurement results (table header, CSV header or opening bracket of JSON array)
+ *
+ */
+static void  print_measurement_header()
+{
+    if( output_mode_ == OUTPUT_CSV )
+    {
+        fprintf( stdout, "workload,format,op,library,cycles_per_op,ns_per_op,mb_per_s,ratio" );
+        if( counters_enabled_ )
+            fprintf( stdout, ",instructions_per_op,branch_misses_per_op,l1d_misses_per_op,llc_misses_per_op,ipc" );
+        if( n_baseline_records_ != 0 )
+            fprintf( stdout, ",baseline_cycles_per_op,delta_percent,regression" );
+        fprintf( stdout, "\n" );
+    }
+    else if( output_mode_ == OUTPUT_JSON )
+    {
+        fprintf( stdout, "[\n" );
+    }
+    else
+    {
+        fprintf( stdout, "%-16s %-9s %-6s %-10s %12s %10s %10s %8s",
+                 "workload", "format", "op", "library", "cycles/op", "ns/op", "MB/s", "ratio" );
+        if( counters_enabled_ )
+            fprintf( stdout, " %10s %10s %10s %10s %6s", "instr/op", "brmiss/op", "L1Dmiss/op", "LLCmiss/op", "IPC" );
+        if( n_baseline_records_ != 0 )
+            fprintf( stdout, " %12s %8s", "baseline", "delta" );
+        fprintf( stdout, "\n" );
+    }
+}
+
+/**
+ *
+ *  Print measurement result as a table row, CSV line or JSON object;
+ *  returns 1 if result is a regression against baseline
+ *
+ */
+static int  print_measurement(
+    const struct workload*       workload,
+    const struct output_format*  format,
+    const char*                  operation,
+    const struct library*        library,
+    const struct measurement*    result,
+    const struct measurement*    reference
+)
+{
+    // 1. Compute metrics; counter metrics are negative if not available
+    double  metrics[4 + N_COUNTERS];
+    metrics[0] = ((double)result->cycles) / ((double)result->n_ops);
+    metrics[1] = ((double)result->nanoseconds) / ((double)result->n_ops);
+    metrics[2] = ( (result->nanoseconds != 0) ? ((double)result->bytes) * 1e3 / ((double)result->nanoseconds) : 0.0 );
+    metrics[3] = ((double)result->cycles) / ((double)reference->cycles);
+    int  n_metrics = 4;
+    if( counters_enabled_ )
+    {
+        // instructions, branch misses and cache misses per conversion, then instructions per cycle
+        for( int  i = COUNTER_INSTRUCTIONS; i < N_COUNTERS; ++i )
+            metrics[n_metrics++] = ( (counter_fds_[i] >= 0) ? ((double)result->counters[i]) / ((double)result->n_ops) : -1.0 );
+        if(( counter_fds_[COUNTER_CYCLES] >= 0 )&&( counter_fds_[COUNTER_INSTRUCTIONS] >= 0 )&&
+           ( result->counters[COUNTER_CYCLES] != 0 ))
+            metrics[n_metrics++] = ((double)result->counters[COUNTER_INSTRUCTIONS]) / ((double)result->counters[COUNTER_CYCLES]);
+        else
+            metrics[n_metrics++] = -1.0;
+    }
+
+    // 2. Compare with baseline
+    double  baseline = ( (n_baseline_records_ != 0) ? find_baseline( workload, format, operation, library ) : 0.0 );
+    double  delta = ( (baseline > 0.0) ? 100.0 * (metrics[0] - baseline) / baseline : 0.0 );
+    int  is_regression = ( delta > regression_threshold_ );
+
+    // 3. Print
+    static const char* const  metric_names[4 + N_COUNTERS] = {
+        "cycles_per_op", "ns_per_op", "mb_per_s", "ratio", "instructions_per_op", "branch_misses_per_op",
+        "l1d_misses_per_op", "llc_misses_per_op", "ipc"
+    };
+    if( output_mode_ == OUTPUT_CSV )
+    {
+        fprintf( stdout, "%s,%s,%s,%s", workload->name, format->name, operation, library->name );
+        for( int  i = 0; i < n_metrics; ++i )
+        {
+            if( metrics[i] < 0.0 )
+                fprintf( stdout, "," );
+            else
+                fprintf( stdout, ",%.3f", metrics[i] );
+        }
+        if(( n_baseline_records_ != 0 )&&( baseline > 0.0 ))
+            fprintf( stdout, ",%.3f,%.2f,%d", baseline, delta, is_regression );
+        else if( n_baseline_records_ != 0 )
+            fprintf( stdout, ",,,0" );
+        fprintf( stdout, "\n" );
+    }
+    else if( output_mode_ == OUTPUT_JSON )
+    {
+        fprintf( stdout, "%s  { \"workload\": \"%s\", \"format\": \"%s\", \"op\": \"%s\", \"library\": \"%s\"",
+                 ( (n_json_records_++ == 0) ? "" : ",\n" ), workload->name, format->name, operation, library->name );
+        for( int  i = 0; i < n_metrics; ++i )
+        {
+            if( metrics[i] < 0.0 )
+                fprintf( stdout, ", \"%s\": null", metric_names[i] );
+            else
+                fprintf( stdout, ", \"%s\": %.3f", metric_names[i], metrics[i] );
+        }
+        if(( n_baseline_records_ != 0 )&&( baseline > 0.0 ))
+            fprintf( stdout, ", \"baseline_cycles_per_op\": %.3f, \"delta_percent\": %.2f, \"regression\": %s",
+                     baseline, delta, ( is_regression ? "true" : "false" ) );
+        fprintf( stdout, " }" );
+    }
+    else
+    {
+        fprintf( stdout, "%-16s %-9s %-6s %-10s %12.1f %10.1f %10.1f %8.2f",
+                 workload->name, format->name, operation, library->name,
+                 metrics[0], metrics[1], metrics[2], metrics[3] );
+        for( int  i = 4; i < n_metrics; ++i )
+        {
+            int  width = ( (i + 1 < n_metrics) ? 10 : 6 );   // the last one is IPC
+            if( metrics[i] < 0.0 )
+                fprintf( stdout, " %*s", width, "-" );
+            else
+                fprintf( stdout, " %*.2f", width, metrics[i] );
+        }
+        if( n_baseline_records_ != 0 )
+        {
+            if( baseline > 0.0 )
+                fprintf( stdout, " %12.1f %+7.1f%%%s", baseline, delta, ( is_regression ? "  REGRESSION" : "" ) );
+            else
+                fprintf( stdout, " %12s %8s", "-", "-" );
+        }
+        fprintf( stdout, "\n" );
+    }
+    return  is_regression;
+}
+
+/**
+ *
+ *  Print summary table: nanoseconds per conversion for each format and operation (rows)
+ *  and each library (columns), over all workloads which were run (table output only)
+ *
+ */
+static void  print_summary( struct measurement  (*summary)[2][N_LIBRARIES] )
+{
+    static const char* const  operations[2] = { "print", "scan" };
+    fprintf( stdout, "\nSummary, ns/op over all workloads:\n%-9s %-6s", "format", "op" );
+    for( int  l = 0; l < N_LIBRARIES; ++l )
+        fprintf( stdout, " %10s", libraries_[l].name );
+    fprintf( stdout, "\n" );
+    for( int  f = 0; f < N_OUTPUT_FORMATS; ++f )
+    {
+        for( int  op = 0; op < 2; ++op )
+        {
+            fprintf( stdout, "%-9s %-6s", output_formats_[f].name, operations[op] );
+            for( int  l = 0; l < N_LIBRARIES; ++l )
+                fprintf( stdout, " %10.1f", ((double)summary[f][op][l].nanoseconds) / ((double)summary[f][op][l].n_ops) );
+            fprintf( stdout, "\n" );
+        }
+    }
+}
+
+/**
+ *
+ *  Execute benchmark test
+ *
+ *  For each workload, each output format and each library, values are printed to strings and
+ *  strings are scanned back. Results are reported in cycles/op, ns/op and MB/s (of printed text),
+ *  and as ratio of running time to the running time of dconvstr, followed by summary table.
+ *  If baseline is loaded, cycles/op are compared with it.
+ *
+ *  @returns  Number of regressions against baseline, i.e. results slower than baseline by more than
+ *            regression threshold
+ *
+ */
+static int  benchmark( const char*  workload_name, uint64_t  n_ops )
+{
+    static struct measurement  summary[N_OUTPUT_FORMATS][2][N_LIBRARIES];
+    int  n_regressions = 0;
+
+    fprintf( stderr, "Running benchmark, please wait...\n" );
+    print_measurement_header();
+
+    uint64_t  n_batches = (n_ops + BATCH_SIZE - 1) / BATCH_SIZE;
+    int  n_workloads = 0;
+    for( size_t  w = 0; w < sizeof(workloads_) / sizeof(workloads_[0]); ++w )
+    {
+        // 1. Generate input values of the workload
+        const struct workload*  workload = workloads_ + w;
+        if(( workload_name != NULL )&&( 0 != strcmp( workload_name, workload->name ) ))
+            continue;
+        ++n_workloads;
+        uint64_t  saved_rng_state = local_rng_state_;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            batch_.values[i] = workload->generate();
+        local_rng_state_ = saved_rng_state;   // the same values in every workload run with given RNG state
+
+        // 2. Measure each library with each format
+        for( int  f = 0; f < N_OUTPUT_FORMATS; ++f )
+        {
+            const struct output_format*  format = output_formats_ + f;
+            struct measurement  reference_print, reference_scan;
+            for( int  l = 0; l < N_LIBRARIES; ++l )
+            {
+                struct measurement  print_result, scan_result;
+                benchmark_batch( &batch_, libraries_ + l, format, n_batches, &print_result, &scan_result );
+                if( l == 0 )
+                {
+                    reference_print = print_result;
+                    reference_scan  = scan_result;
+                }
+                n_regressions += print_measurement( workload, format, "print", libraries_ + l, &print_result, &reference_print );
+                n_regressions += print_measurement( workload, format, "scan",  libraries_ + l, &scan_result,  &reference_scan  );
+                summary[f][0][l].n_ops       += print_result.n_ops;
+                summary[f][0][l].nanoseconds += print_result.nanoseconds;
+                summary[f][1][l].n_ops       += scan_result.n_ops;
+                summary[f][1][l].nanoseconds += scan_result.nanoseconds;
+            }
+        }
+    }
+    if( n_workloads == 0 )
+    {
+        fprintf( stderr, "Unknown workload: %s\n", workload_name );
+        exit(-1);
+    }
+    if( output_mode_ == OUTPUT_JSON )
+        fprintf( stdout, "\n]\n" );
+    else if( output_mode_ == OUTPUT_TABLE )
+        print_summary( summary );
+    if( n_baseline_records_ != 0 )
+        fprintf( stderr, "%d regression(s) beyond %.1f%% threshold\n", n_regressions, regression_threshold_ );
+    return  n_regressions;
+}
+
+//=====================================================================================================
+//
+// LATENCY BENCHMARK
+//
+/**
+ *
+ *  Get index of histogram bucket for given number of cycles
+ *
+ */
+static inline int  histogram_bucket( uint64_t  cycles )
+{
+    if( cycles < 32 )
+        return  (int) cycles;
+    int  shift = 0;
+    while(( cycles >> shift ) >= 32 )
+        ++shift;
+    return  (shift + 1) * 16 + (int)( cycles >> shift ) - 16;
+}
+
+/**
+ *
+ *  Get the highest number of cycles which falls into given histogram bucket
+ *
+ */
+static inline uint64_t  histogram_bucket_top( int  bucket )
+{
+    if( bucket < 32 )
+        return  (uint64_t) bucket;
+    int  shift = bucket / 16 - 1;
+    return  ( ((uint64_t)( bucket % 16 + 17 )) << shift ) - 1;
+}
+
+/**
+ *
+ *  Add latency of one conversion to histogram; index is index of input value in batch
+ *
+ */
+static inline void  histogram_add( struct histogram*  h, uint64_t  cycles, int  index )
+{
+    ++h->counts[ histogram_bucket( cycles ) ];
+    if(( h->n_samples < BATCH_SIZE )||( h->input_min_cycles[index] > cycles ))
+        h->input_min_cycles[index] = cycles;
+    ++h->n_samples;
+    if( h->max < cycles )
+        h->max = cycles;
+}
+
+/**
+ *
+ *  Get latency percentile from histogram (fraction is from 0 to 1)
+ *
+ */
+static uint64_t  histogram_percentile( const struct histogram*  h, double  fraction )
+{
+    uint64_t  rank = (uint64_t)( fraction * (double)h->n_samples );
+    uint64_t  count = 0;
+    for( int  bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket )
+    {
+        count += h->counts[bucket];
+        if( count > rank )
+        {
+            uint64_t  top = histogram_bucket_top( bucket );
+            return  ( (top < h->max) ? top : h->max );
+        }
+    }
+    return  h->max;
+}
+
+/**
+ *
+ *  Measure overhead of reading timestamp counter (minimum over many attempts)
+ *
+ */
+static uint64_t  measure_timer_overhead()
+{
+    uint64_t  overhead = (uint64_t)(-1);
+    for( int  i = 0; i < 10000; ++i )
+    {
+        uint64_t  c0 = read_timestamp_counter();
+        uint64_t  c1 = read_timestamp_counter();
+        if( overhead > c1 - c0 )
+            overhead = c1 - c0;
+    }
+    return  overhead;
+}
+
+/**
+ *
+ *  Evict conversion tables, code and data from caches by streaming through pollution buffer
+ *
+ *  Every cache line of the buffer is modified, so lines evicted from caches are not only the clean
+ *  ones. Buffer larger than the last level cache evicts everything; smaller buffer evicts L1 and L2.
+ *
+ */
+static void  pollute_cache()
+{
+    for( size_t  i = 0; i < pollution_buffer_size_; i += 64 )
+        ++pollution_buffer_[i];
+}
+
+/**
+ *
+ *  Print and scan batch of values with given library and format n_batches times, timing every call;
+ *  in cache-cold mode, caches are polluted before every call
+ *
+ */
+static void  benchmark_latency_batch(
+    struct batch*                b,
+    const struct library*        library,
+    const struct output_format*  format,
+    uint64_t                     n_batches,
+    uint64_t                     timer_overhead,
+    int                          is_cold,
+    struct histogram*            print_histogram,
+    struct histogram*            scan_histogram
+)
+{
+    memset( print_histogram, 0, sizeof(*print_histogram) );
+    memset( scan_histogram,  0, sizeof(*scan_histogram)  );
+    for( uint64_t  batch = 0; batch < n_batches; ++batch )
+    {
+        // 1. Print values one by one
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+        {
+            if( is_cold )
+                pollute_cache();
+            uint64_t  c0 = read_timestamp_counter();
+            b->string_lengths[i] = library->print( b->strings[i], MAX_STRING_SIZE, b->values[i], format );
+            uint64_t  c1 = read_timestamp_counter();
+            histogram_add( print_histogram, (c1 - c0 > timer_overhead) ? c1 - c0 - timer_overhead : 0, i );
+            if( b->string_lengths[i] < 0 )
+            {
+                fprintf( stderr, "Print failed in %s library for value %.17g\n", library->name, b->values[i] );
+                exit(-1);
+            }
+        }
+
+        // 2. Scan strings one by one
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+        {
+            if( is_cold )
+                pollute_cache();
+            uint64_t  c0 = read_timestamp_counter();
+            int  n_scanned = library->scan( b->strings[i], &b->scanned_values[i] );
+            uint64_t  c1 = read_timestamp_counter();
+            histogram_add( scan_histogram, (c1 - c0 > timer_overhead) ? c1 - c0 - timer_overhead : 0, i );
+            if( n_scanned != b->string_lengths[i] )
+            {
+                fprintf( stderr, "Scan failed in %s library: string %s not parsed up to the end\n",
+                         library->name, b->strings[i] );
+                exit(-1);
+            }
+        }
+
+        // 3. Check that values are restored exactly if format has enough digits
+        if(( format->is_exact )&&( 0 != memcmp( b->values, b->scanned_values, sizeof(b->values) ) ))
+        {
+            fprintf( stderr, "Scan failed in %s library: values not restored exactly with format %s\n",
+                     library->name, format->name );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Print latency percentiles as a table row; for dconvstr, also list the slowest inputs
+ *
+ */
+static void  print_latency(
+    const struct batch*          b,
+    const struct workload*       workload,
+    const struct output_format*  format,
+    const char*                  operation,
+    const struct library*        library,
+    const struct histogram*      h
+)
+{
+    fprintf( stdout, "%-16s %-9s %-6s %-10s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+             workload->name, format->name, operation, library->name,
+             histogram_percentile( h, 0.5 ), histogram_percentile( h, 0.99 ),
+             histogram_percentile( h, 0.999 ), h->max );
+    if( library != libraries_ )
+        return;
+
+    // Select inputs with the highest minimum latency
+    int  slowest[N_SLOWEST];
+    int  n_slowest = 0;
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        int  position = ( (n_slowest < N_SLOWEST) ? n_slowest++ : N_SLOWEST );
+        while(( position > 0 )&&( h->input_min_cycles[ slowest[position - 1] ] < h->input_min_cycles[i] ))
+        {
+            if( position < N_SLOWEST )
+                slowest[position] = slowest[position - 1];
+            --position;
+        }
+        if( position < N_SLOWEST )
+            slowest[position] = i;
+    }
+    fprintf( stdout, "    slowest:" );
+    for( int  i = 0; i < n_slowest; ++i )
+        fprintf( stdout, " %.17g (%" PRIu64 ")", b->values[ slowest[i] ], h->input_min_cycles[ slowest[i] ] );
+    fprintf( stdout, "\n" );
+}
+
+/**
+ *
+ *  Print warm and cold latency percentiles as a table row
+ *
+ */
+static void  print_cold_latency(
+    const struct workload*       workload,
+    const struct output_format*  format,
+    const char*                  operation,
+    const struct library*        library,
+    const struct histogram*      warm,
+    const struct histogram*      cold
+)
+{
+    uint64_t  warm_p50 = histogram_percentile( warm, 0.5 );
+    uint64_t  cold_p50 = histogram_percentile( cold, 0.5 );
+    fprintf( stdout, "%-16s %-9s %-6s %-10s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+             workload->name, format->name, operation, library->name,
+             warm_p50, histogram_percentile( warm, 0.99 ), cold_p50, histogram_percentile( cold, 0.99 ),
+             (cold_p50 > warm_p50) ? cold_p50 - warm_p50 : 0 );
+}
+
+/**
+ *
+ *  Execute latency benchmark
+ *
+ *  Every conversion is timed separately with timestamp counter (minus its own overhead). For each
+ *  workload, format, operation and library reports percentiles p50, p99, p99.9 and maximum latency
+ *  in cycles, and for dconvstr lists input values of the slowest conversions with their latencies
+ *  (minimum over repetitions of each input).
+ *
+ *  In cache-cold mode (is_cold != 0), warm latencies are followed by latencies of cold calls (one pass
+ *  over the batch, each call preceded by cache pollution), and by difference of their medians,
+ *  which is the cost of cache misses on conversion tables, code and data.
+ *
+ */
+static void  benchmark_latency( const char*  workload_name, uint64_t  n_ops, int  is_cold )
+{
+    static struct histogram  print_histogram, scan_histogram;
+    static struct histogram  cold_print_histogram, cold_scan_histogram;
+
+    fprintf( stderr, "Running latency benchmark, please wait...\n" );
+    uint64_t  timer_overhead = measure_timer_overhead();
+    fprintf( stdout, "Latency in cycles (timer overhead of %" PRIu64 " cycles subtracted)\n", timer_overhead );
+    if( is_cold )
+    {
+        fprintf( stdout, "Cache pollution of %u KB before every cold call\n", (unsigned)( pollution_buffer_size_ / 1024 ) );
+        fprintf( stdout, "%-16s %-9s %-6s %-10s %10s %10s %10s %10s %10s\n",
+                 "workload", "format", "op", "library", "warm p50", "warm p99", "cold p50", "cold p99", "penalty" );
+    }
+    else
+    {
+        fprintf( stdout, "%-16s %-9s %-6s %-10s %10s %10s %10s %10s\n",
+                 "workload", "format", "op", "library", "p50", "p99", "p99.9", "max" );
+    }
+
+    uint64_t  n_batches = (n_ops + BATCH_SIZE - 1) / BATCH_SIZE;
+    int  n_workloads = 0;
+    for( size_t  w = 0; w < sizeof(workloads_) / sizeof(workloads_[0]); ++w )
+    {
+        // 1. Generate input values of the workload
+        const struct workload*  workload = workloads_ + w;
+        if(( workload_name != NULL )&&( 0 != strcmp( workload_name, workload->name ) ))
+            continue;
+        ++n_workloads;
+        uint64_t  saved_rng_state = local_rng_state_;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            batch_.values[i] = workload->generate();
+        local_rng_state_ = saved_rng_state;
+
+        // 2. Measure each library with each format
+        for( int  f = 0; f < N_OUTPUT_FORMATS; ++f )
+        {
+            for( int  l = 0; l < N_LIBRARIES; ++l )
+            {
+                benchmark_latency_batch( &batch_, libraries_ + l, output_formats_ + f, n_batches, timer_overhead, 0,
+                                         &print_histogram, &scan_histogram );
+                if( is_cold )
+                {
+                    benchmark_latency_batch( &batch_, libraries_ + l, output_formats_ + f, 1, timer_overhead, 1,
+                                             &cold_print_histogram, &cold_scan_histogram );
+                    print_cold_latency( workload, output_formats_ + f, "print", libraries_ + l,
+                                        &print_histogram, &cold_print_histogram );
+                    print_cold_latency( workload, output_formats_ + f, "scan",  libraries_ + l,
+                                        &scan_histogram,  &cold_scan_histogram  );
+                }
+                else
+                {
+                    print_latency( &batch_, workload, output_formats_ + f, "print", libraries_ + l, &print_histogram );
+                    print_latency( &batch_, workload, output_formats_ + f, "scan",  libraries_ + l, &scan_histogram  );
+                }
+            }
+        }
+    }
+    if( n_workloads == 0 )
+    {
+        fprintf( stderr, "Unknown workload: %s\n", workload_name );
+        exit(-1);
+    }
+}
+
+//=====================================================================================================
+//
+// CORPUS BENCHMARK
+//
+/**
+ *
+ *  Split corpus text into numbers
+ *
+ *  Numbers are separated by whitespace, commas, semicolons, colons, brackets and quotes, so that
+ *  files with one number per line, CSV files and JSON files are accepted. Tokens which are not numbers
+ *  in their entirety (e.g. JSON keys) are skipped. Text is modified in place.
+ *
+ */
+static void  split_corpus( struct corpus*  c )
+{
+    // 1. Replace delimiters with zeros and count tokens
+    size_t  n_tokens = 0;
+    for( size_t  i = 0; i < c->text_size; ++i )
+    {
+        if( NULL != strchr( " \t\r\n,;:[]{}()\"'", c->text[i] ) )
+            c->text[i] = 0;
+        else if(( i == 0 )||( c->text[i - 1] == 0 ))
+            ++n_tokens;
+    }
+
+    // 2. Collect tokens which are numbers
+    c->numbers = (char**) malloc( (n_tokens + 1) * sizeof(char*) );
+    if( c->numbers == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        exit(-1);
+    }
+    c->n_numbers    = 0;
+    c->numbers_size = 0;
+    for( size_t  i = 0; i < c->text_size; ++i )
+    {
+        if(( c->text[i] != 0 )&&(( i == 0 )||( c->text[i - 1] == 0 )))
+        {
+            const char*  str_end = NULL;
+            double  value = 0.0;
+            int  erange_condition = 0;
+            if(( dconvstr_scan( c->text + i, &str_end, &value, &erange_condition ) )&&( *str_end == 0 )&&
+               ( str_end != c->text + i ))
+            {
+                c->numbers[ c->n_numbers++ ] = c->text + i;
+                c->numbers_size += (size_t)( str_end - (c->text + i) );
+            }
+        }
+    }
+}
+
+/**
+ *
+ *  Load corpus from file
+ *
+ */
+static void  load_corpus( struct corpus*  c, const char*  file_name )
+{
+    FILE*  f = fopen( file_name, "rb" );
+    if( f == NULL )
+    {
+        fprintf( stderr, "Can't open corpus file %s\n", file_name );
+        exit(-1);
+    }
+    size_t  capacity = 1 << 16;
+    c->name      = file_name;
+    c->text      = (char*) malloc( capacity + 1 );
+    c->text_size = 0;
+    while( c->text != NULL )
+    {
+        c->text_size += fread( c->text + c->text_size, 1, capacity - c->text_size, f );
+        if( c->text_size < capacity )
+            break;
+        capacity *= 2;
+        char*  text = (char*) realloc( c->text, capacity + 1 );
+        if( text == NULL )
+            free( c->text );
+        c->text = text;
+    }
+    fclose( f );
+    if( c->text == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        exit(-1);
+    }
+    c->text[c->text_size] = 0;
+    split_corpus( c );
+}
+
+/**
+ *
+ *  Generate built-in corpus
+ *
+ *  "canada": polygon coordinates like in canada.json (longitude and latitude pairs, printed with
+ *  17 significant digits after rounding to 6 decimal places, e.g. -65.613616999999977);
+ *  "mesh": 3D mesh like in mesh.json (vertex coordinates with up to 6 significant digits,
+ *  normals in [-1, 1] and integer vertex indices).
+ *
+ */
+static void  generate_corpus( struct corpus*  c, const char*  name )
+{
+    // 1. Allocate text buffer for 100000 numbers
+    const size_t  n_numbers = 100000;
+    size_t  capacity = n_numbers * 32;
+    c->name      = name;
+    c->text      = (char*) malloc( capacity );
+    c->text_size = 0;
+    if( c->text == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        exit(-1);
+    }
+
+    // 2. Print numbers as JSON array
+    uint64_t  saved_rng_state = local_rng_state_;
+    if( 0 == strcmp( name, "builtin:canada" ) )
+    {
+        double  longitude = -100.0, latitude = 60.0;
+        for( size_t  i = 0; i < n_numbers / 2; ++i )
+        {
+            // random walk along the border, coordinates rounded to 6 decimal places
+            longitude += ( local_rng_get_random_unit() - 0.5 ) * 0.01;
+            latitude  += ( local_rng_get_random_unit() - 0.5 ) * 0.01;
+            double  x = floor( longitude * 1e6 + 0.5 ) / 1e6;
+            double  y = floor( latitude  * 1e6 + 0.5 ) / 1e6;
+            c->text_size += snprintf( c->text + c->text_size, capacity - c->text_size, "[%.17g,%.17g],", x, y );
+        }
+    }
+    else if( 0 == strcmp( name, "builtin:mesh" ) )
+    {
+        for( size_t  i = 0; i < n_numbers / 10; ++i )
+        {
+            double  x = ( local_rng_get_random_unit() - 0.5 ) * 20.0;
+            double  y = ( local_rng_get_random_unit() - 0.5 ) * 20.0;
+            double  z = ( local_rng_get_random_unit() - 0.5 ) * 20.0;
+            double  nx = local_rng_get_random_unit() * 2.0 - 1.0;
+            double  ny = local_rng_get_random_unit() * 2.0 - 1.0;
+            double  nz = local_rng_get_random_unit() * 2.0 - 1.0;
+            unsigned int  a = (unsigned int)( local_rng_get_random_uint64() % 65536 );
+            c->text_size += snprintf( c->text + c->text_size, capacity - c->text_size,
+                                      "[%.6g,%.6g,%.6g],[%.4f,%.4f,%.4f],[%u,%u,%u,%u],",
+                                      x, y, z, nx, ny, nz, a, a + 1, a + 2, a + 3 );
+        }
+    }
+    else
+    {
+        fprintf( stderr, "Unknown built-in corpus: %s (available: builtin:canada, builtin:mesh)\n", name );
+        exit(-1);
+    }
+    local_rng_state_ = saved_rng_state;
+    split_corpus( c );
+}
+
+/**
+ *
+ *  Execute corpus benchmark
+ *
+ *  For each corpus and each library, all numbers of the corpus are scanned from their original text,
+ *  then the scanned values are printed back in "shortest" format. Corpus is processed repeatedly until
+ *  at least n_ops numbers are converted. Reports millions of numbers per second, megabytes of text
+ *  per second (original text for scan, printed text for print) and nanoseconds per number.
+ *
+ */
+static void  benchmark_corpora( struct corpus*  corpora, int  n_corpora, uint64_t  n_ops )
+{
+    static const char* const  operations[2] = { "scan", "print" };
+    fprintf( stderr, "Running corpus benchmark, please wait...\n" );
+    fprintf( stdout, "%-24s %-6s %-10s %10s %10s %10s %10s\n",
+             "corpus", "op", "library", "numbers", "Mnum/s", "MB/s", "ns/number" );
+    for( int  k = 0; k < n_corpora; ++k )
+    {
+        struct corpus*  c = corpora + k;
+        if( c->n_numbers == 0 )
+        {
+            fprintf( stderr, "No numbers in corpus %s\n", c->name );
+            exit(-1);
+        }
+        double*  values = (double*) malloc( c->n_numbers * sizeof(double) );
+        if( values == NULL )
+        {
+            fprintf( stderr, "Out of memory\n" );
+            exit(-1);
+        }
+        uint64_t  n_passes = ( n_ops + c->n_numbers - 1 ) / c->n_numbers;
+        for( int  l = 0; l < N_LIBRARIES; ++l )
+        {
+            const struct library*  library = libraries_ + l;
+            uint64_t  nanoseconds[2] = { 0, 0 }, bytes[2] = { 0, 0 };
+            for( uint64_t  pass = 0; pass < n_passes; ++pass )
+            {
+                // 1. Scan numbers from original text
+                uint64_t  t0 = read_wall_clock();
+                int  n_failures = 0;
+                for( size_t  i = 0; i < c->n_numbers; ++i )
+                    n_failures += ( library->scan( c->numbers[i], values + i ) <= 0 );
+                uint64_t  t1 = read_wall_clock();
+                nanoseconds[0] += (t1 - t0);
+                bytes[0]       += c->numbers_size;
+                if( n_failures != 0 )
+                {
+                    fprintf( stderr, "Scan failed in %s library on corpus %s\n", library->name, c->name );
+                    exit(-1);
+                }
+
+                // 2. Print numbers back
+                char  str[MAX_STRING_SIZE];
+                uint64_t  printed_size = 0;
+                t0 = read_wall_clock();
+                for( size_t  i = 0; i < c->n_numbers; ++i )
+                    printed_size += library->print( str, sizeof(str), values[i], output_formats_ );
+                t1 = read_wall_clock();
+                nanoseconds[1] += (t1 - t0);
+                bytes[1]       += printed_size;
+            }
+
+            // 3. Report
+            for( int  op = 0; op < 2; ++op )
+            {
+                double  n_numbers = ((double)c->n_numbers) * ((double)n_passes);
+                fprintf( stdout, "%-24s %-6s %-10s %10lu %10.3f %10.1f %10.1f\n",
+                         c->name, operations[op], library->name, (unsigned long) c->n_numbers,
+                         n_numbers * 1e3 / ((double)nanoseconds[op]), ((double)bytes[op]) * 1e3 / ((double)nanoseconds[op]),
+                         ((double)nanoseconds[op]) / n_numbers );
+            }
+        }
+        free( values );
+    }
+}
+
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+//=====================================================================================================
+//
+// STAGE BENCHMARK
+//
+// Stages of dconvstr_print() and dconvstr_scan() are run over the batch in the same order as in the
+// full conversion; each stage takes its input from the output of the previous one, so every stage is
+// timed in isolation on the same input set. Format is "shortest" ('g' with precision 17).
+//
+static void  stage_unpack_ieee754_double()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        int  is_nan = 0, is_infinity = 0;
+        dconvstr_internal_unpack_ieee754_double( batch_.values + i, &is_nan, stage_data_.signs + i,
+                                                 stage_data_.binary_mantissas + i, stage_data_.binary_exponents + i,
+                                                 &is_infinity );
+    }
+}
+
+static void  stage_convert_binary_to_extended_decimal()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        if( stage_data_.binary_mantissas[i] == 0 )
+        {
+            stage_data_.decimal_mantissas[i] = 0;
+            stage_data_.decimal_exponents[i] = -18;
+        }
+        else
+        {
+            dconvstr_internal_convert_binary_to_extended_decimal(
+                stage_data_.binary_mantissas[i], stage_data_.binary_exponents[i],
+                stage_data_.decimal_mantissas + i, stage_data_.decimal_exponents + i
+            );
+        }
+    }
+}
+
+static void  stage_bcd_decompress()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+        dconvstr_internal_bcd_decompress( stage_data_.decimal_mantissas[i], stage_data_.decimal_digits[i] );
+}
+
+static void  stage_bcd_round()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        uint8_t  digits[20];   // rounding is done in place, so digits are copied
+        int32_t  exponent = stage_data_.decimal_exponents[i] + 2;
+        memcpy( digits, stage_data_.decimal_digits[i], sizeof(digits) );
+        dconvstr_internal_bcd_round( 17, 19, digits, &exponent );
+    }
+}
+
+static void  stage_format_decimal()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        uint8_t  digits[20];   // rounding is done in place, so digits are copied
+        memcpy( digits, stage_data_.decimal_digits[i], sizeof(digits) );
+        char*  str_end = batch_.strings[i];
+        int    str_rest = MAX_STRING_SIZE - 1;
+        dconvstr_internal_format_decimal( &str_end, &str_rest, 0, stage_data_.signs[i], 0, digits, 19,
+                                          stage_data_.decimal_exponents[i], 'g', 0, 0, 17 );
+        *str_end = 0;
+    }
+}
+
+static void  stage_full_print()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+        dconvstr_library_print( batch_.strings[i], MAX_STRING_SIZE, batch_.values[i], output_formats_ );
+}
+
+static void  stage_scan_decimal_digits()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        const char*  str_end = NULL;
+        int  is_nan = 0, is_infinity = 0;
+        dconvstr_internal_scan_decimal_digits( batch_.strings[i], &str_end, stage_data_.scanned_digits[i],
+                                               &is_nan, stage_data_.scanned_signs + i,
+                                               stage_data_.scanned_exponents + i, &is_infinity );
+    }
+}
+
+static void  stage_bcd_compress()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+        stage_data_.scanned_mantissas[i] = dconvstr_internal_bcd_compress( stage_data_.scanned_digits[i] );
+}
+
+static void  stage_convert_extended_decimal_to_binary_and_round()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+    {
+        stage_data_.rounded_mantissas[i] = 0;
+        stage_data_.rounded_exponents[i] = 0;
+        if( stage_data_.scanned_mantissas[i] != 0 )
+            dconvstr_internal_convert_extended_decimal_to_binary_and_round(
+                stage_data_.scanned_mantissas[i], stage_data_.scanned_exponents[i],
+                stage_data_.rounded_mantissas + i, stage_data_.rounded_exponents + i
+            );
+    }
+}
+
+static void  stage_pack_ieee754_double()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+        dconvstr_internal_pack_ieee754_double( 0, stage_data_.scanned_signs[i], stage_data_.rounded_mantissas[i],
+                                               stage_data_.rounded_exponents[i], 0, batch_.scanned_values + i );
+}
+
+static void  stage_full_scan()
+{
+    for( int  i = 0; i < BATCH_SIZE; ++i )
+        dconvstr_library_scan( batch_.strings[i], batch_.scanned_values + i );
+}
+
+static const struct stage  print_stages_[] = {
+    { "unpack_ieee754_double",                        stage_unpack_ieee754_double,                        1 },
+    { "convert_binary_to_extended_decimal",           stage_convert_binary_to_extended_decimal,           1 },
+    { "bcd_decompress",                               stage_bcd_decompress,                               1 },
+    { "bcd_round (part of format_decimal)",           stage_bcd_round,                                    0 },
+    { "format_decimal",                               stage_format_decimal,                               1 },
+    { "dconvstr_print (full)",                        stage_full_print,                                   0 }
+};
+
+static const struct stage  scan_stages_[] = {
+    { "scan_decimal_digits (parser loop)",            stage_scan_decimal_digits,                          1 },
+    { "bcd_compress",                                 stage_bcd_compress,                                 1 },
+    { "convert_extended_decimal_to_binary_and_round", stage_convert_extended_decimal_to_binary_and_round, 1 },
+    { "pack_ieee754_double",                          stage_pack_ieee754_double,                          1 },
+    { "dconvstr_scan (full)",                         stage_full_scan,                                    0 }
+};
+
+/**
+ *
+ *  Time given stages over the current batch n_batches times and print breakdown
+ *
+ */
+static void  benchmark_stage_list( const struct stage*  stages, int  n_stages, uint64_t  n_batches )
+{
+    // 1. Run all stages once, so that every stage has its input ready
+    for( int  s = 0; s < n_stages; ++s )
+        stages[s].run();
+
+    // 2. Time each stage
+    uint64_t  cycles[16], nanoseconds[16], sum_of_cycles = 0;
+    for( int  s = 0; s < n_stages; ++s )
+    {
+        uint64_t  t0 = read_wall_clock();
+        uint64_t  c0 = read_timestamp_counter();
+        for( uint64_t  batch = 0; batch < n_batches; ++batch )
+            stages[s].run();
+        uint64_t  c1 = read_timestamp_counter();
+        uint64_t  t1 = read_wall_clock();
+        cycles[s]      = c1 - c0;
+        nanoseconds[s] = t1 - t0;
+        if( stages[s].is_included_in_sum )
+            sum_of_cycles += cycles[s];
+    }
+
+    // 3. Print breakdown: share of each stage in the sum of stages
+    double  n_ops = (double)( n_batches * BATCH_SIZE );
+    for( int  s = 0; s < n_stages; ++s )
+    {
+        fprintf( stdout, "    %-46s %12.1f %10.1f %9.1f%%\n", stages[s].name,
+                 ((double)cycles[s]) / n_ops, ((double)nanoseconds[s]) / n_ops,
+                 100.0 * ((double)cycles[s]) / ((double)sum_of_cycles) );
+    }
+    fprintf( stdout, "    %-46s %12.1f\n", "sum of stages", ((double)sum_of_cycles) / n_ops );
+}
+
+/**
+ *
+ *  Execute stage benchmark
+ *
+ *  For each workload, reports cycles and nanoseconds per conversion for each internal stage of
+ *  dconvstr_print() and dconvstr_scan(), and share of the stage in the sum of stages. Full conversion
+ *  is timed too: the difference from the sum of stages is the overhead of calls between stages.
+ *
+ */
+static void  benchmark_stages( const char*  workload_name, uint64_t  n_ops )
+{
+    fprintf( stderr, "Running stage benchmark, please wait...\n" );
+    uint64_t  n_batches = (n_ops + BATCH_SIZE - 1) / BATCH_SIZE;
+    int  n_workloads = 0;
+    for( size_t  w = 0; w < sizeof(workloads_) / sizeof(workloads_[0]); ++w )
+    {
+        // 1. Generate input values of the workload
+        const struct workload*  workload = workloads_ + w;
+        if(( workload_name != NULL )&&( 0 != strcmp( workload_name, workload->name ) ))
+            continue;
+        ++n_workloads;
+        uint64_t  saved_rng_state = local_rng_state_;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            batch_.values[i] = workload->generate();
+        local_rng_state_ = saved_rng_state;
+
+        // 2. Time stages of print, then stages of scan (which parse strings printed by print stages)
+        fprintf( stdout, "%s\n", workload->name );
+        fprintf( stdout, "    %-46s %12s %10s %10s\n", "stage", "cycles/op", "ns/op", "share" );
+        benchmark_stage_list( print_stages_, (int)( sizeof(print_stages_) / sizeof(print_stages_[0]) ), n_batches );
+        benchmark_stage_list( scan_stages_,  (int)( sizeof(scan_stages_)  / sizeof(scan_stages_[0])  ), n_batches );
+
+        // 3. Check that stages have done the same work as full conversions
+        if( 0 != memcmp( batch_.values, batch_.scanned_values, sizeof(batch_.values) ) )
+        {
+            fprintf( stderr, "Stage benchmark failed: values not restored exactly\n" );
+            exit(-1);
+        }
+    }
+    if( n_workloads == 0 )
+    {
+        fprintf( stderr, "Unknown workload: %s\n", workload_name );
+        exit(-1);
+    }
+}
+#endif // DCONVSTR_EXPOSE_INTERNALS
+
+//=====================================================================================================
+//
+// SCALING BENCHMARK
+//
+/**
+ *
+ *  Get number of CPUs available to the process
+ *
+ */
+static int  get_number_of_cpus()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO  system_info;
+    GetSystemInfo( &system_info );
+    return  (int) system_info.dwNumberOfProcessors;
+#elif defined(__linux__)
+    cpu_set_t  cpuset;
+    if( 0 == sched_getaffinity( 0, sizeof(cpuset), &cpuset ) )
+        return  CPU_COUNT( &cpuset );
+    return  (int) sysconf( _SC_NPROCESSORS_ONLN );
+#elif !defined(USE_PLAN9_LIBC)
+    return  (int) sysconf( _SC_NPROCESSORS_ONLN );
+#else
+    return  1;
+#endif
+}
+
+/**
+ *
+ *  Thread procedure of scaling benchmark
+ *
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI  scaling_thread( LPVOID  arg )
+#else
+static void*  scaling_thread( void*  arg )
+#endif
+{
+    struct thread_context*  context = (struct thread_context*) arg;
+    struct batch*  b = &context->b;
+    for( uint64_t  batch = 0; batch < context->n_batches; ++batch )
+    {
+        if( context->operation == 0 )
+        {
+            for( int  i = 0; i < BATCH_SIZE; ++i )
+                b->string_lengths[i] = context->library->print( b->strings[i], MAX_STRING_SIZE, b->values[i], context->format );
+        }
+        else
+        {
+            for( int  i = 0; i < BATCH_SIZE; ++i )
+                context->library->scan( b->strings[i], &b->scanned_values[i] );
+        }
+    }
+    return  0;
+}
+
+/**
+ *
+ *  Execute scaling benchmark
+ *
+ *  Runs 1, 2, 4, ... up to max_threads threads, each converting its own values (generated from its own
+ *  RNG stream) in "shortest" format. Printing and scanning are run separately, and each is timed from
+ *  creation of the first thread to completion of the last one, so the result is correct even when
+ *  threads outnumber CPUs. Reports aggregate conversions per second and scaling efficiency, i.e. ratio
+ *  of aggregate throughput to the throughput of one thread multiplied by number of threads.
+ *  dconvstr has no locks and no shared writable state, so efficiency is expected to stay close to 1
+ *  as long as threads run on different physical cores.
+ *
+ */
+static void  benchmark_scaling( const char*  workload_name, uint64_t  n_ops, int  max_threads )
+{
+#ifndef USE_PLAN9_LIBC
+    static struct thread_context*  contexts[MAX_THREADS];
+    static const char* const  operations[2] = { "print", "scan" };
+
+    // 1. Find workload and allocate contexts, each separately to avoid false sharing
+    const struct workload*  workload = ( (workload_name == NULL) ? workloads_ : NULL );
+    for( size_t  w = 0; ( workload == NULL )&&( w < sizeof(workloads_) / sizeof(workloads_[0]) ); ++w )
+        if( 0 == strcmp( workload_name, workloads_[w].name ) )
+            workload = workloads_ + w;
+    if( workload == NULL )
+    {
+        fprintf( stderr, "Unknown workload: %s\n", workload_name );
+        exit(-1);
+    }
+    for( int  t = 0; t < max_threads; ++t )
+    {
+        contexts[t] = (struct thread_context*) malloc( sizeof(struct thread_context) );
+        if( contexts[t] == NULL )
+        {
+            fprintf( stderr, "Out of memory\n" );
+            exit(-1);
+        }
+
+        // 2. Generate values of each thread from its own RNG stream
+        uint64_t  saved_rng_state = local_rng_state_;
+        local_rng_state_ += 0x9E3779B97F4A7C15ULL * (uint64_t)t;
+        for( int  i = 0; i < BATCH_SIZE; ++i )
+            contexts[t]->b.values[i] = workload->generate();
+        local_rng_state_ = saved_rng_state;
+    }
+
+    fprintf( stderr, "Running scaling benchmark (workload %s), please wait...\n", workload->name );
+    fprintf( stdout, "%-8s %-6s %-10s %12s %10s\n", "threads", "op", "library", "Mops/s", "efficiency" );
+    uint64_t  n_batches = (n_ops + BATCH_SIZE - 1) / BATCH_SIZE;
+    for( int  l = 0; l < N_LIBRARIES; ++l )
+    {
+        double  single_thread_throughput[2] = { 0.0, 0.0 };
+        for( int  n_threads = 1; ; n_threads = ( (n_threads * 2 < max_threads) ? n_threads * 2 : max_threads ) )
+        {
+            for( int  op = 0; op < 2; ++op )
+            {
+                // 3. Run threads
+#if defined(_WIN32) || defined(_WIN64)
+                static HANDLE  threads[MAX_THREADS];
+#else
+                static pthread_t  threads[MAX_THREADS];
+#endif
+                uint64_t  t0 = read_wall_clock();
+                for( int  t = 0; t < n_threads; ++t )
+                {
+                    contexts[t]->library   = libraries_ + l;
+                    contexts[t]->format    = output_formats_;
+                    contexts[t]->n_batches = n_batches;
+                    contexts[t]->operation = op;
+#if defined(_WIN32) || defined(_WIN64)
+                    threads[t] = CreateThread( NULL, 0, scaling_thread, contexts[t], 0, NULL );
+                    if( threads[t] == NULL )
+#else
+                    if( 0 != pthread_create( &threads[t], NULL, scaling_thread, contexts[t] ) )
+#endif
+                    {
+                        fprintf( stderr, "Can't create thread\n" );
+                        exit(-1);
+                    }
+                }
+                for( int  t = 0; t < n_threads; ++t )
+                {
+#if defined(_WIN32) || defined(_WIN64)
+                    WaitForSingleObject( threads[t], INFINITE );
+                    CloseHandle( threads[t] );
+#else
+                    pthread_join( threads[t], NULL );
+#endif
+                }
+                uint64_t  t1 = read_wall_clock();
+
+                // 4. Check that scanned values are restored exactly
+                for( int  t = 0; ( op == 1 )&&( t < n_threads ); ++t )
+                {
+                    if( 0 != memcmp( contexts[t]->b.values, contexts[t]->b.scanned_values, sizeof(contexts[t]->b.values) ) )
+                    {
+                        fprintf( stderr, "Scan failed in %s library: values not restored exactly\n", libraries_[l].name );
+                        exit(-1);
+                    }
+                }
+
+                // 5. Report aggregate throughput
+                double  throughput = ((double)( n_batches * BATCH_SIZE * n_threads )) * 1e3 / ((double)( t1 - t0 ));
+                if( n_threads == 1 )
+                    single_thread_throughput[op] = throughput;
+                fprintf( stdout, "%-8d %-6s %-10s %12.3f %10.2f\n", n_threads, operations[op], libraries_[l].name,
+                         throughput, throughput / (single_thread_throughput[op] * n_threads) );
+            }
+            if( n_threads == max_threads )
+                break;
+        }
+    }
+    for( int  t = 0; t < max_threads; ++t )
+        free( contexts[t] );
+#else
+    (void) workload_name;
+    (void) n_ops;
+    (void) max_threads;
+    fprintf( stderr, "Scaling benchmark is not supported with Plan 9 libc\n" );
+    exit(-1);
+#endif
+}
+
+/**
+ *
+ *  Print usage information
+ *
+ */
+static void  print_usage()
+{
+    fprintf(
+        stderr,
+        "Usage: dconvstr_benchmark [options] [initial_rng_state]\n"
+        "    --workload=NAME  run only one workload, one of:"
+    );
+    for( size_t  w = 0; w < sizeof(workloads_) / sizeof(workloads_[0]); ++w )
+        fprintf( stderr, " %s", workloads_[w].name );
+    fprintf(
+        stderr,
+        "\n"
+        "    --ops=N          number of conversions per workload, format and library (default 262144)\n"
+        "    --counters       report hardware performance counters per conversion (Linux only)\n"
+        "    --latency        time every conversion, report p50/p99/p99.9/max and the slowest inputs\n"
+        "    --cold[=KB]      latency benchmark with caches polluted by KB kilobytes (default 4096)\n"
+        "                     before every call, compared with warm latency\n"
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+        "    --stages         time internal stages of dconvstr_print() and dconvstr_scan() separately\n"
+#endif
+        "    --output=FORMAT  output format of throughput benchmark: table (default), csv or json\n"
+        "    --baseline=FILE  compare cycles/op with CSV output of previous run, exit with code 2\n"
+        "                     if any result is slower by more than threshold\n"
+        "    --threshold=PCT  regression threshold in percent (default 5)\n"
+        "    --corpus=FILE    scan numbers from text file (one per line, CSV or JSON) and print them\n"
+        "                     back; may be repeated; FILE builtin:canada or builtin:mesh selects\n"
+        "                     generated corpus of coordinates or mesh data\n"
+        "    --threads[=N]    run scaling benchmark with 1, 2, 4, ... up to N threads (default: all CPUs)\n"
+    );
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+#ifndef USE_PLAN9_LIBC
+int  main( int  argc, const char* const*  argv )
+#else
+int  p9main( int  argc, const char* const*  argv )
+#endif
+{
+    // 1. Parse command line
+    fprintf( stderr, "Running dconvstr_benchmark, build date " __DATE__ " " __TIME__ "\n" );
+    const char*  workload_name = NULL;
+    uint64_t     n_ops = 0x40000;
+    int          use_counters = 0;
+    int          max_threads = 0;
+    int          latency_mode = 0;
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+    int          stages_mode = 0;
+#endif
+    size_t       pollution_kb = 0;
+    const char*  corpus_names[MAX_CORPORA];
+    int          n_corpora = 0;
+    for( int  i = 1; i < argc; ++i )
+    {
+        errno = 0;
+        if( 0 == strncmp( argv[i], "--workload=", 11 ) )
+            workload_name = argv[i] + 11;
+        else if( 0 == strcmp( argv[i], "--counters" ) )
+            use_counters = 1;
+        else if( 0 == strcmp( argv[i], "--latency" ) )
+            latency_mode = 1;
+        else if( 0 == strncmp( argv[i], "--corpus=", 9 ) )
+        {
+            if( n_corpora == MAX_CORPORA )
+            {
+                fprintf( stderr, "Too many corpora (at most %d)\n", MAX_CORPORA );
+                exit(-1);
+            }
+            corpus_names[n_corpora++] = argv[i] + 9;
+        }
+        else if( 0 == strcmp( argv[i], "--output=table" ) )
+            output_mode_ = OUTPUT_TABLE;
+        else if( 0 == strcmp( argv[i], "--output=csv" ) )
+            output_mode_ = OUTPUT_CSV;
+        else if( 0 == strcmp( argv[i], "--output=json" ) )
+            output_mode_ = OUTPUT_JSON;
+        else if( 0 == strncmp( argv[i], "--baseline=", 11 ) )
+            load_baseline( argv[i] + 11 );
+        else if( 0 == strncmp( argv[i], "--threshold=", 12 ) )
+        {
+            char*  number_end = NULL;
+            regression_threshold_ = strtod( argv[i] + 12, &number_end );
+            if(( *number_end != 0 )||( regression_threshold_ < 0.0 ))
+            {
+                fprintf( stderr, "Can't parse command line (regression threshold)\n" );
+                exit(-1);
+            }
+        }
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+        else if( 0 == strcmp( argv[i], "--stages" ) )
+            stages_mode = 1;
+#endif
+        else if( 0 == strcmp( argv[i], "--cold" ) )
+            pollution_kb = 4096;
+        else if( 0 == strncmp( argv[i], "--cold=", 7 ) )
+        {
+            pollution_kb = (size_t) strtoull( argv[i] + 7, 0, 10 );
+            if(( errno != 0 )||( pollution_kb == 0 ))
+            {
+                fprintf( stderr, "Can't parse command line (size of cache pollution)\n" );
+                exit(-1);
+            }
+        }
+        else if( 0 == strcmp( argv[i], "--threads" ) )
+            max_threads = get_number_of_cpus();
+        else if( 0 == strncmp( argv[i], "--threads=", 10 ) )
+        {
+            max_threads = atoi( argv[i] + 10 );
+            if(( max_threads <= 0 )||( max_threads > MAX_THREADS ))
+            {
+                fprintf( stderr, "Can't parse command line (number of threads)\n" );
+                exit(-1);
+            }
+        }
+        else if( 0 == strncmp( argv[i], "--ops=", 6 ) )
+        {
+            n_ops = strtoull( argv[i] + 6, 0, 10 );
+            if(( errno != 0 )||( n_ops == 0 ))
+            {
+                fprintf( stderr, "Can't parse command line (number of operations)\n" );
+                exit(-1);
+            }
+        }
+        else if(( argv[i][0] >= '0' )&&( argv[i][0] <= '9' ))
+        {
+            // 2. Initialize local RNG (optional)
+            uint64_t  parse_result = strtoull( argv[i], 0, 10 );
+            if( errno != 0 )
+            {
+                fprintf( stderr, "Can't parse command line (initial RNG state)\n" );
+                exit(-1);
+            }
+            local_rng_state_ = parse_result;
+        }
+        else
+        {
+            print_usage();
+            exit(-1);
+        }
+    }
+
+    // 3. Run scaling benchmark (optional): threads are not pinned, and scheduler places them
+    if( max_threads != 0 )
+    {
+        benchmark_scaling( workload_name, n_ops, max_threads );
+        return  0;
+    }
+
+    // 4. Set thread affinity so read_timestamp_counter() won't return garbage; on Linux, stay on
+    //    the current CPU because CPU 0 may be outside of the allowed set (e.g. in containers)
+#if defined(_WIN32) || defined(_WIN64)
+    SetThreadAffinityMask( GetCurrentThread(), 1 );
+#elif defined(__linux__)
+    cpu_set_t  cpuset;
+    int  current_cpu = sched_getcpu();
+    CPU_ZERO( &cpuset );
+    CPU_SET( (current_cpu >= 0) ? current_cpu : 0, &cpuset );
+    if( 0 != sched_setaffinity( 0, sizeof(cpuset), &cpuset ) )
+        fprintf( stderr, "Warning: can't set thread affinity, cycle counts may be inaccurate\n" );
+#else
+    cpuset_t  cpuset;
+    CPU_ZERO( &cpuset );
+    CPU_SET( 0, &cpuset );
+    pthread_setaffinity_np( pthread_self(), sizeof(cpuset), &cpuset );
+#endif
+
+    // 5. Open hardware performance counters (optional); fall back to timestamp counter only
+    if( use_counters )
+    {
+        counters_enabled_ = ( open_counters() != 0 );
+        if(! counters_enabled_ )
+            fprintf( stderr, "Warning: hardware performance counters are not available "
+                             "(check /proc/sys/kernel/perf_event_paranoid), running without them\n" );
+    }
+
+    // 6. Allocate pollution buffer for cache-cold mode
+    if( pollution_kb != 0 )
+    {
+        pollution_buffer_size_ = pollution_kb * 1024;
+        pollution_buffer_ = (unsigned char*) calloc( pollution_buffer_size_, 1 );
+        if( pollution_buffer_ == NULL )
+        {
+            fprintf( stderr, "Out of memory\n" );
+            exit(-1);
+        }
+    }
+
+    // 7. Run benchmark
+    if( n_corpora != 0 )
+    {
+        static struct corpus  corpora[MAX_CORPORA];
+        for( int  k = 0; k < n_corpora; ++k )
+        {
+            if( 0 == strncmp( corpus_names[k], "builtin:", 8 ) )
+                generate_corpus( corpora + k, corpus_names[k] );
+            else
+                load_corpus( corpora + k, corpus_names[k] );
+        }
+        benchmark_corpora( corpora, n_corpora, n_ops );
+    }
+    else if(( latency_mode )||( pollution_kb != 0 ))
+        benchmark_latency( workload_name, n_ops, (pollution_kb != 0) );
+#ifdef DCONVSTR_EXPOSE_INTERNALS
+    else if( stages_mode )
+        benchmark_stages( workload_name, n_ops );
+#endif
+    else if( benchmark( workload_name, n_ops ) != 0 )
+        return  2;
     return  0;
 }
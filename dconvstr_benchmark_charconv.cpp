@@ -0,0 +1,82 @@
+/*
+ *  Adapters of C++17 std::to_chars() and std::from_chars() for dconvstr_benchmark.c
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <charconv>
+#include <system_error>
+
+extern "C" {
+
+int  dconvstr_benchmark_to_chars( char*  str, int  str_size, double  value, int  format_char, int  format_precision );
+int  dconvstr_benchmark_from_chars( const char*  str, double*  value );
+
+}
+
+/**
+ *
+ *  Print value with std::to_chars()
+ *
+ *  Format characters 'e', 'f' and 'g' select scientific, fixed and general format with given
+ *  precision; zero format character selects shortest round-trip representation.
+ *  Returns length of printed string (terminated with zero), or -1 on error.
+ *
+ */
+int  dconvstr_benchmark_to_chars( char*  str, int  str_size, double  value, int  format_char, int  format_precision )
+{
+    char*  str_last = str + str_size - 1;
+    std::to_chars_result  result;
+    switch( format_char )
+    {
+        case 'e': result = std::to_chars( str, str_last, value, std::chars_format::scientific, format_precision ); break;
+        case 'f': result = std::to_chars( str, str_last, value, std::chars_format::fixed,      format_precision ); break;
+        case 'g': result = std::to_chars( str, str_last, value, std::chars_format::general,    format_precision ); break;
+        default:  result = std::to_chars( str, str_last, value );                                                   break;
+    }
+    if( result.ec != std::errc() )
+        return  -1;
+    *result.ptr = 0;
+    return  (int)( result.ptr - str );
+}
+
+/**
+ *
+ *  Scan value with std::from_chars()
+ *
+ *  Returns number of scanned characters, or -1 on error. Unlike strtod(), from_chars() does not
+ *  skip leading whitespace and does not accept leading plus sign, which is never printed anyway.
+ *
+ */
+int  dconvstr_benchmark_from_chars( const char*  str, double*  value )
+{
+    const char*  str_end = str;
+    while( *str_end != 0 )
+        ++str_end;
+    std::from_chars_result  result = std::from_chars( str, str_end, *value );
+    if(( result.ec != std::errc() )&&( result.ec != std::errc::result_out_of_range ))
+        return  -1;
+    return  (int)( result.ptr - str );
+}
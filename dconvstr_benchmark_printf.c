@@ -0,0 +1,180 @@
+/*
+ *  Benchmark of snprintf(3) with and without printf handlers of dconvstr (dconvstr_printf.h)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  Each workload formats the same random values with snprintf(3), first with glibc conversions,
+//  then with handlers installed by dconvstr_register_printf_handlers(). Handlers can't be
+//  uninstalled, so the order is fixed. Usage:
+//
+//      dconvstr_benchmark_printf [n_calls]
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE      // for clock_gettime()
+#endif
+
+#include "dconvstr_printf.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+
+
+//=====================================================================================================
+//
+// CONSTANTS AND GLOBAL VARIABLES
+//
+
+// Number of distinct random values formatted by each workload
+#define N_VALUES  4096
+
+// Workloads: format string with 3 double arguments, or with int, 3 doubles and string arguments
+static const struct
+{
+    const char*  name;
+    const char*  format;
+    int          is_log_line;
+}
+workloads_[] = {
+    { "%g",          "%g %g %g",                                       0 },
+    { "%.17g",       "%.17g %.17g %.17g",                              0 },
+    { "%.6f",        "%.6f %.6f %.6f",                                 0 },
+    { "%e",          "%e %e %e",                                       0 },
+    { "log line",    "id=%d t=%.3f x=%g y=%g name=%s",                 1 },
+};
+
+#define N_WORKLOADS  ( (int)( sizeof(workloads_) / sizeof(workloads_[0]) ) )
+
+static double    values_[N_VALUES];
+static uint64_t  rng_state_ = 1;
+static volatile unsigned int  sink_ = 0;   // keeps printed strings alive for optimizer
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Generate random double-precision value: magnitude from 1e-10 to 1e+10, 53 random bits
+ *
+ */
+static double  get_random_value()
+{
+    rng_state_ = 6364136223846793005ULL * rng_state_ + 1442695040888963407ULL;
+    uint64_t  a = rng_state_ >> 11;
+    rng_state_ = 6364136223846793005ULL * rng_state_ + 1442695040888963407ULL;
+    double  value = ((double)( a )) * (1.0 / 9007199254740992.0) * pow( 10.0, (double)( (int)( rng_state_ >> 59 ) - 10 ) );
+    return  ( (rng_state_ & 0x100) ? -value : value );
+}
+
+/**
+ *
+ *  Read monotonic wall clock in nanoseconds
+ *
+ */
+static uint64_t  read_wall_clock()
+{
+    struct timespec  ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return  ((uint64_t)ts.tv_sec) * 1000000000ULL + ((uint64_t)ts.tv_nsec);
+}
+
+/**
+ *
+ *  Run workload n_calls times and return average time of one snprintf() call, in nanoseconds
+ *
+ */
+static double  run_workload( int  w, uint64_t  n_calls )
+{
+    char  str[256];
+    uint64_t  t0 = read_wall_clock();
+    for( uint64_t  i = 0; i < n_calls; ++i )
+    {
+        const double*  v = values_ + ( (i * 3) % (N_VALUES - 2) );
+        int  n;
+        if( workloads_[w].is_log_line )
+            n = snprintf( str, sizeof(str), workloads_[w].format, (int)( i ), v[0], v[1], v[2], "request" );
+        else
+            n = snprintf( str, sizeof(str), workloads_[w].format, v[0], v[1], v[2] );
+        sink_ += (unsigned int)( n ) + (unsigned char)( str[n / 2] );
+    }
+    uint64_t  t1 = read_wall_clock();
+    return  ((double)( t1 - t0 )) / ((double)( n_calls ));
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main( int  argc, const char* const*  argv )
+{
+    // 1. Parse command line and generate values
+    fprintf( stderr, "Running dconvstr_benchmark_printf, build date " __DATE__ " " __TIME__ "\n" );
+    uint64_t  n_calls = 0x100000;
+    if( argc > 2 )
+    {
+        fprintf( stderr, "Usage: dconvstr_benchmark_printf [n_calls]\n" );
+        exit(-1);
+    }
+    if(( argc == 2 )&&( 0 == ( n_calls = strtoull( argv[1], NULL, 0 ) ) ))
+    {
+        fprintf( stderr, "Invalid number of calls: %s\n", argv[1] );
+        exit(-1);
+    }
+    for( int  i = 0; i < N_VALUES; ++i )
+        values_[i] = get_random_value();
+
+    // 2. Measure glibc conversions (with warm-up run)
+    double  glibc_ns[N_WORKLOADS];
+    for( int  w = 0; w < N_WORKLOADS; ++w )
+    {
+        run_workload( w, n_calls / 8 );
+        glibc_ns[w] = run_workload( w, n_calls );
+    }
+
+    // 3. Install handlers and measure them
+    if(! dconvstr_register_printf_handlers() )
+    {
+        fprintf( stderr, "Failed to install printf handlers\n" );
+        exit(-1);
+    }
+    fprintf( stdout, "%-12s %14s %16s %10s\n", "workload", "glibc ns/call", "dconvstr ns/call", "speedup" );
+    for( int  w = 0; w < N_WORKLOADS; ++w )
+    {
+        run_workload( w, n_calls / 8 );
+        double  dconvstr_ns = run_workload( w, n_calls );
+        fprintf( stdout, "%-12s %14.1f %16.1f %9.2fx\n",
+                 workloads_[w].name, glibc_ns[w], dconvstr_ns, glibc_ns[w] / dconvstr_ns );
+    }
+    return  0;
+}
@@ -0,0 +1,94 @@
+/*
+ *  Adapters of C++20 template printers of dconvstr_constexpr.hpp for dconvstr_benchmark.c
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "dconvstr_constexpr.hpp"
+
+extern "C" {
+
+int  dconvstr_benchmark_print_template( char*  str, int  str_size, double  value, int  format_char, int  format_precision );
+int  dconvstr_benchmark_scan_template( const char*  str, double*  value );
+
+}
+
+/**
+ *
+ *  Print value with dconvstr::print() instantiated for given format and precision
+ *
+ */
+template< dconvstr::Format  format, int  precision >
+static int  print_template( char*  str, int  str_size, double  value )
+{
+    if( str_size <= dconvstr::print_max_size<format, precision> )
+        return  -1;
+    char*  str_end = dconvstr::print<format, precision>( str, value );
+    if( str_end == str )
+        return  -1;
+    *str_end = 0;
+    return  (int)( str_end - str );
+}
+
+/**
+ *
+ *  Print value with template printer for one of output formats of dconvstr_benchmark.c
+ *
+ *  Format char and precision select instantiation of dconvstr::print() at runtime, like a call site
+ *  with literal format would select it at compile time. Returns length of printed string (terminated
+ *  with zero), or -1 on error or if there is no instantiation for given format.
+ *
+ */
+int  dconvstr_benchmark_print_template( char*  str, int  str_size, double  value, int  format_char, int  format_precision )
+{
+    using  dconvstr::Format;
+    if(( format_char == 'g' )&&( format_precision == 17 ))
+        return  print_template<Format::Shortest, 17>( str, str_size, value );
+    else if(( format_char == 'e' )&&( format_precision == 20 ))
+        return  print_template<Format::Scientific, 20>( str, str_size, value );
+    else if(( format_char == 'e' )&&( format_precision == 6 ))
+        return  print_template<Format::Scientific, 6>( str, str_size, value );
+    else if(( format_char == 'f' )&&( format_precision == 6 ))
+        return  print_template<Format::Fixed, 6>( str, str_size, value );
+    else if(( format_char == 'g' )&&( format_precision == 6 ))
+        return  print_template<Format::General, 6>( str, str_size, value );
+    return  -1;
+}
+
+/**
+ *
+ *  Scan value with dconvstr::scan() of dconvstr_constexpr.hpp (inlined into this function)
+ *
+ *  Returns number of scanned characters, or -1 on error.
+ *
+ */
+int  dconvstr_benchmark_scan_template( const char*  str, double*  value )
+{
+    const char*  str_end = nullptr;
+    int  erange_condition = 0;
+    if(! dconvstr::scan( str, &str_end, value, &erange_condition ) )
+        return  -1;
+    return  (int)( str_end - str );
+}
@@ -0,0 +1,1176 @@
+/*
+ *  Compile-time (C++20 constexpr) conversion of IEEE 754 double to string and vice versa
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  This header is a constexpr port of dconvstr_scan() and of shortest printing path of
+//  dconvstr_print() (format "%.17g"), so that conversions of constants are done by compiler:
+//
+//      constexpr double  x = dconvstr::parse( "0.1" );                 // x == 0.1
+//      static_assert( dconvstr::format( 3.14 ) == "3.14" );
+//
+//  Functions of namespace dconvstr::constexpr_detail repeat functions of dconvstr.c with the same
+//  names line by line, except for compiler intrinsics and memset()/memmove(), which are not allowed
+//  in constant expressions. Results are the same as results of dconvstr.c, including its rounding
+//  of denormals. Tables come from dconvstr_constexpr_tables.inc, which is output of
+//  "dconvstr_tablegen --constexpr". The header does not depend on dconvstr.c.
+//
+//  The same functions serve hot call sites with format known at compile time during runtime:
+//  dconvstr::print<dconvstr::Format::Fixed, 6>( buf, value ) prints like dconvstr_print() with "%.6f",
+//  leaving parsing of flags, width and padding to the compiler.
+//
+
+#ifndef DCONVSTR_CONSTEXPR_HPP
+#define DCONVSTR_CONSTEXPR_HPP
+
+#include <bit>
+#include <cstdint>
+
+namespace dconvstr {
+
+namespace constexpr_detail {
+
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+#include "dconvstr_constexpr_tables.inc"
+
+constexpr uint64_t  POW10_18 = (1000ULL * 1000ULL * 1000ULL) * (1000ULL * 1000ULL * 1000ULL);
+
+/**
+ *
+ *  Multiply two 64-bit unsigned integers and produce 128-bit result: (u * v) -> w
+ *
+ */
+constexpr void  multiply_128( uint64_t  u, uint64_t  v, uint64_t*  w )
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__) && (__SIZEOF_INT128__ == 16)
+    unsigned __int128  value_w = ((unsigned __int128)u) * v;
+    w[0] = ((uint64_t)( value_w       ));
+    w[1] = ((uint64_t)( value_w >> 64 ));
+#else
+    uint64_t  u1 = u >> 32;   uint64_t  u0 = u & 0xFFFFFFFFULL;
+    uint64_t  v1 = v >> 32;   uint64_t  v0 = v & 0xFFFFFFFFULL;
+
+    uint64_t  t  = u0 * v0;
+    uint64_t  w0 = t & 0xFFFFFFFFULL;
+    uint64_t  k  = t >> 32;
+    t            = u1 * v0 + k;
+
+    uint64_t  w1 = t & 0xFFFFFFFFULL;
+    uint64_t  w2 = t >> 32;
+    t            = u0 * v1 + w1;
+    k            = t >> 32;
+
+    w[0] = (t << 32) + w0;
+    w[1] = u1 * v1 + w2 + k;
+#endif
+}
+
+/**
+ *
+ *  Count the number of leading zero bits in provided 64-bit unsigned integer
+ *
+ */
+constexpr unsigned int  count_leading_zeros( uint64_t  a )
+{
+    return  ((unsigned int)( std::countl_zero( a ) ));
+}
+
+/**
+ *
+ *  Convert extended-precision decimal to double-precision binary: (a * 10^b) -> (c * 2^d)
+ *
+ */
+constexpr int  convert_extended_decimal_to_binary_and_round( uint64_t  a, int32_t  b, uint64_t*  c, int32_t*  d )
+{
+    // 1. Check input arguments
+    if(( a == 0 )||
+       ( b < powers_of_ten_[0].decimal_exponent )||
+       ( b > powers_of_ten_[sizeof(powers_of_ten_)/sizeof(powers_of_ten_[0]) - 1].decimal_exponent ))
+        return  0;
+
+    // 2. Convert (a * 10^b) -> (mantissa * 2^exponent)
+    uint64_t  mantissa = powers_of_ten_[ b - powers_of_ten_[0].decimal_exponent ].binary_mantissa;
+    int32_t   exponent = powers_of_ten_[ b - powers_of_ten_[0].decimal_exponent ].binary_exponent;
+    uint64_t  long_mantissa[2] = { 0, 0 };
+    multiply_128( a, mantissa, long_mantissa );
+    if( long_mantissa[1] != 0 )
+    {
+        unsigned int  lz = count_leading_zeros( long_mantissa[1] );
+        if( lz == 0 )
+            mantissa = long_mantissa[1];
+        else
+            mantissa = ( long_mantissa[1] << lz )|( long_mantissa[0] >> (64 - lz) );
+        exponent += (64 - lz);
+    }
+    else if( long_mantissa[0] != 0 )
+    {
+        unsigned int  lz = count_leading_zeros( long_mantissa[0] );
+        mantissa = ( long_mantissa[0] << lz );
+        exponent -= lz;
+    }
+    else
+        return  0;
+
+    // 3. Round mantissa
+    uint64_t  remainder = mantissa & 0x07FFULL;
+    if( remainder < 0x0400ULL )
+        mantissa -= remainder;
+    else
+    {
+        mantissa += (0x0800ULL - remainder);
+        if( mantissa == 0 )
+        {
+            mantissa = (1ULL << 63);
+            ++exponent;
+        }
+    }
+
+    // 4. Move binary point 63 bits to the left: adjust exponent
+    exponent += 63;
+
+    // 5. Save computation results and exit
+    (*c) = mantissa;
+    (*d) = exponent;
+    return  1;
+}
+
+/**
+ *
+ *  Determine if extended-precision decimal rounds to given double-precision binary with 53-bit mantissa
+ *
+ */
+constexpr int  does_extended_decimal_round_to_given_binary( uint64_t  a, int32_t  b, uint64_t  expected_c, int32_t  expected_d )
+{
+    // 1. Check/normalize binary (expected_c * 2^expected_d)
+    if( expected_c == 0 )
+        return  0;
+    unsigned int  lz = count_leading_zeros( expected_c );
+    expected_c <<= lz;
+    expected_d  -= lz;
+
+    // 2. Convert (a * 10^b) to binary with rounding to 53 bits (in round-to-nearest mode)
+    uint64_t  actual_c = 0;
+    int32_t   actual_d = 0;
+    if(! convert_extended_decimal_to_binary_and_round( a, b, &actual_c, &actual_d ) )
+        return  0;
+
+    // 3. Compare and compute result of this function
+    return(( actual_c == expected_c )&&( actual_d == expected_d ));
+}
+
+/**
+ *
+ *  Convert extended-precision binary to extended-precision decimal (first approximation)
+ *
+ */
+constexpr int  convert_binary_to_decimal_1st_approx( uint64_t  a, int32_t  b, uint64_t*  c, int32_t*  d )
+{
+    // 1. Check/normalize input mantissa.
+    if( a == 0 )
+        return  0;
+    unsigned int  lz = count_leading_zeros( a );
+    a <<= lz;
+    b  -= lz;
+
+    // 2. Move binary point to the right side of mantissa.
+    //    Do bounds check of the input exponent.
+    b -= 63;
+    if(( b < powers_of_two_[0].binary_exponent )||
+       ( b > powers_of_two_[sizeof(powers_of_two_)/sizeof(powers_of_two_[0]) - 1].binary_exponent ))
+        return  0;
+
+    // 3. Convert (a * 2^b) -> (long_mantissa * 10^exponent)
+    uint64_t  mantissa = powers_of_two_[ b - powers_of_two_[0].binary_exponent ].decimal_mantissa;
+    int32_t   exponent = powers_of_two_[ b - powers_of_two_[0].binary_exponent ].decimal_exponent;
+    uint64_t  long_mantissa[2] = { 0, 0 };
+    multiply_128( a, mantissa, long_mantissa );
+    mantissa = long_mantissa[1];
+
+    // 4. Force resulting decimal mantissa into the range 10^18 <= c < 10^19.
+    if( mantissa < POW10_18 )
+    {
+        mantissa *= 10ULL;
+        multiply_128( 10ULL, long_mantissa[0], long_mantissa );
+        mantissa += long_mantissa[1];
+        --exponent;
+    }
+    else if( mantissa >= (10ULL * POW10_18) )
+    {
+        mantissa /= 10ULL;
+        ++exponent;
+    }
+
+    // 5. Save computation results and exit
+    (*c) = mantissa;
+    (*d) = exponent;
+    return  1;
+}
+
+/**
+ *
+ *  Convert double-precision binary to extended-precision decimal: (a * 2^b) -> (c * 10^d)
+ *
+ */
+constexpr int  convert_binary_to_extended_decimal( uint64_t  a, int32_t  b, uint64_t*  c, int32_t*  d )
+{
+    // 1. Check input parameters and convert binary mantissa in such way that
+    //    its most significant bits are 01.
+    if( a == 0 )
+        return  0;
+    unsigned int  lz = count_leading_zeros( a );
+    a <<= lz;
+    a >>= 1;
+    b   = b - lz + 1;
+    a &= (~0x03FFULL);
+
+    // 2. Compute first approximation for (a * 2^b), also for ((a-1) * 2^b) and ((a+1) * 2^b).
+    uint64_t  prev_c = 0;  int32_t  prev_d = 0;
+    uint64_t  base_c = 0;  int32_t  base_d = 0;
+    uint64_t  next_c = 0;  int32_t  next_d = 0;
+    if((! convert_binary_to_decimal_1st_approx( a - 0x0400ULL, b, &prev_c, &prev_d ) )||
+       (! convert_binary_to_decimal_1st_approx( a            , b, &base_c, &base_d ) )||
+       (! convert_binary_to_decimal_1st_approx( a + 0x0400ULL, b, &next_c, &next_d ) ))
+        return  0;
+    if( prev_d < next_d )
+    {
+        prev_c /= 10ULL;
+        ++prev_d;
+    }
+    if( base_d < next_d )
+    {
+        base_c /= 10ULL;
+        ++base_d;
+    }
+
+    // 3. Check invariants before starting the binary search
+    if(( prev_c >= base_c )||( base_c >= next_c )||
+       (! does_extended_decimal_round_to_given_binary( prev_c, prev_d, a - 0x0400ULL, b ) )||
+       (! does_extended_decimal_round_to_given_binary( base_c, base_d, a,             b ) )||
+       (! does_extended_decimal_round_to_given_binary( next_c, next_d, a + 0x0400ULL, b ) ))
+        return  0;
+
+    // 4. Using binary search, compute range of attraction around (base_c * 10^base_d)
+    uint64_t  negative_extent = 0, negative_search_space = base_c - prev_c;
+    uint64_t  positive_extent = 0, positive_search_space = next_c - base_c;
+    for( uint64_t  bit = 1ULL << (63 - count_leading_zeros( negative_search_space )); bit != 0; bit >>= 1 )
+    {
+        if(( bit <= negative_search_space )&&
+           ( does_extended_decimal_round_to_given_binary( base_c - negative_extent - bit,
+                                                          base_d, a, b ) ))
+        {
+            negative_extent       += bit;
+            negative_search_space -= bit;
+        }
+    }
+    for( uint64_t  bit = 1ULL << (63 - count_leading_zeros( positive_search_space )); bit != 0; bit >>= 1 )
+    {
+        if(( bit <= positive_search_space )&&
+           ( does_extended_decimal_round_to_given_binary( base_c + positive_extent + bit,
+                                                          base_d, a, b ) ))
+        {
+            positive_extent       += bit;
+            positive_search_space -= bit;
+        }
+    }
+
+    // 5. Compute new decimal mantissa within range of attraction: digit after digit, most significant first
+    uint64_t  new_mantissa = 0;
+    for( uint64_t  current_scale = POW10_18; current_scale != 0; current_scale /= 10ULL )
+    {
+        uint64_t  next_digit = ((base_c + positive_extent) / current_scale) % 10ULL;
+        new_mantissa += (current_scale * next_digit);
+        if(( base_c - negative_extent <= new_mantissa )&&( new_mantissa <= base_c + positive_extent ))
+            break;
+    }
+
+    // 6. Perform final normalization and offload results
+    if( new_mantissa < POW10_18 )
+    {
+        new_mantissa *= 10ULL;
+        --base_d;
+    }
+    (*c) = new_mantissa;
+    (*d) = base_d;
+    return  1;
+}
+
+/**
+ *
+ *  Unpack floating-point double precision binary value according to IEEE 754
+ *
+ */
+constexpr void  unpack_ieee754_double(
+    double     input,
+    int*       out_is_nan,
+    int*       out_sign,
+    uint64_t*  out_binary_mantissa,
+    int32_t*   out_binary_exponent,
+    int*       out_is_infinity
+)
+{
+    // 1. Unpack bits
+    uint64_t  input_bits     = std::bit_cast<uint64_t>( input );
+    uint64_t  input_sign     = (input_bits >> 63);
+    uint64_t  input_exponent = (input_bits >> 52) & 0x7FFULL;
+    uint64_t  input_mantissa = (input_bits & ((1ULL << 52) - 1ULL));
+
+    // 2. Handle special case: NaN
+    *out_is_nan          = 0;
+    *out_sign            = 0;
+    *out_is_infinity     = 0;
+    *out_binary_exponent = 0;
+    *out_binary_mantissa = 0;
+    if(( input_exponent == 0x7FFULL )&&( input_mantissa != 0 ))
+    {
+        *out_is_nan = 1;
+        return;
+    }
+
+    // 3. Handle special case: +INF/-INF
+    *out_sign = (input_sign != 0);
+    if( input_exponent == 0x7FFULL )
+    {
+        *out_is_infinity = 1;
+        return;
+    }
+
+    // 4. Handle special case: +0/-0
+    if(( input_exponent == 0 )&&( input_mantissa == 0 ))
+        return;
+
+    // 5. Handle denormalized numbers
+    if( input_exponent == 0 )
+    {
+        *out_binary_exponent = -1022;
+        *out_binary_mantissa = (input_mantissa << 11);
+        return;
+    }
+
+    // 6. Handle normalized numbers
+    *out_binary_exponent = ((int32_t)input_exponent) - 1023;
+    *out_binary_mantissa = (1ULL << 63) | (input_mantissa << 11);
+}
+
+/**
+ *
+ *  Pack floating-point double precision binary value according to IEEE 754
+ *
+ *  @returns  0  overflow / underflow condition (when strtod(3) would have set errno = ERANGE).
+ *            1  exited normally, neither overflow nor underflow
+ *
+ */
+constexpr int  pack_ieee754_double(
+    int       input_is_nan,
+    int       input_sign,
+    uint64_t  input_binary_mantissa,
+    int32_t   input_binary_exponent,
+    int       input_is_infinity,
+    double*   output
+)
+{
+    // 1. Initialize values to pack
+    uint64_t  output_sign     = 0;
+    uint64_t  output_exponent = 0;
+    uint64_t  output_mantissa = 0;
+
+    // 2. Handle special case: NaN
+    int  had_overflow_or_underflow_in_exponent = 0;
+    if( input_is_nan )
+    {
+        output_sign     = 1;
+        output_exponent = 0x7FF;
+        output_mantissa = (1ULL << 51);
+    }
+    else
+    {
+        // 3. Handle special case: +INF/-INF
+        output_sign = (input_sign ? 1 : 0);
+        if( input_is_infinity )
+        {
+            output_exponent = 0x7FF;
+            output_mantissa = 0;
+        }
+        // 4. Handle special case: +0/-0
+        else if( input_binary_mantissa == 0 )
+        {
+            output_exponent = 0;
+            output_mantissa = 0;
+        }
+        else
+        {
+            unsigned int  lz = count_leading_zeros( input_binary_mantissa );
+            input_binary_mantissa <<= lz;
+            input_binary_exponent  -= lz;
+
+            if( input_binary_exponent > 1023 )
+            {
+                // 5. Handle unintentional infinity (due to exponent overflow)
+                output_exponent = 0x7FF;
+                output_mantissa = 0;
+                had_overflow_or_underflow_in_exponent = 1;
+            }
+            else if( input_binary_exponent >= -1022 )
+            {
+                // 6. Handle normalized numbers
+                output_exponent = ((uint64_t)( input_binary_exponent + 1023 ));
+                output_mantissa = (input_binary_mantissa >> 11) & ((1ULL << 52) - 1ULL);
+            }
+            else
+            {
+                // 7. Handle denormalized numbers
+                //    and unintentional zero (due to exponent underflow)
+                input_binary_mantissa >>= 11;
+                while(( input_binary_mantissa != 0 )&&( input_binary_exponent < -1022 ))
+                {
+                    input_binary_mantissa >>= 1;
+                    ++input_binary_exponent;
+                }
+                output_exponent = 0;
+                output_mantissa = input_binary_mantissa;
+                had_overflow_or_underflow_in_exponent = (input_binary_mantissa == 0);
+            }
+        }
+    }
+
+    // 8. Pack bits up
+    uint64_t  output_bits = (output_sign << 63) |
+                            ((output_exponent & 0x7FFULL) << 52) |
+                            (output_mantissa & ((1ULL << 52) - 1ULL));
+    *output = std::bit_cast<double>( output_bits );
+    return(! had_overflow_or_underflow_in_exponent );
+}
+
+/**
+ *
+ *  Decompress small integer in range 0..9999 to four-digit BCD representation
+ *
+ */
+constexpr void  bcd_decompress_small( uint32_t  compressed_bcd, uint8_t*  decompressed_bcd )
+{
+    uint32_t  high_pair = compressed_bcd / 100;
+    uint32_t  low_pair  = compressed_bcd % 100;
+
+    decompressed_bcd[0] = ((uint8_t)( high_pair / 10 ));
+    decompressed_bcd[1] = ((uint8_t)( high_pair % 10 ));
+    decompressed_bcd[2] = ((uint8_t)( low_pair  / 10 ));
+    decompressed_bcd[3] = ((uint8_t)( low_pair  % 10 ));
+}
+
+/**
+ *
+ *  Decompress full range unsigned 64-bit integer to twenty-digit BCD representation
+ *  (algorithm of Douglas W. Jones, as in dconvstr.c)
+ *
+ */
+constexpr void  bcd_decompress( uint64_t  compressed_bcd, uint8_t*  decompressed_bcd )
+{
+    uint32_t  d0 = compressed_bcd         & 0xFFFF;
+    uint32_t  d1 = (compressed_bcd >> 16) & 0xFFFF;
+    uint32_t  d2 = (compressed_bcd >> 32) & 0xFFFF;
+    uint32_t  d3 = (compressed_bcd >> 48) & 0xFFFF;
+
+              d0 = 656 * d3 + 7296 * d2 + 5536 * d1 + d0;
+    uint32_t  q  = d0 / 10000;
+              d0 = d0 % 10000;
+
+              d1 = q + 7671 * d3 + 9496 * d2 + 6 * d1;
+              q  = d1 / 10000;
+              d1 = d1 % 10000;
+
+              d2 = q + 4749 * d3 + 42 * d2;
+              q  = d2 / 10000;
+              d2 = d2 % 10000;
+
+              d3 = q + 281 * d3;
+              q  = d3 / 10000;
+              d3 = d3 % 10000;
+
+    bcd_decompress_small( q,  decompressed_bcd      );
+    bcd_decompress_small( d3, decompressed_bcd + 4  );
+    bcd_decompress_small( d2, decompressed_bcd + 8  );
+    bcd_decompress_small( d1, decompressed_bcd + 12 );
+    bcd_decompress_small( d0, decompressed_bcd + 16 );
+}
+
+/**
+ *
+ *  Compress twenty-digit BCD representation to full range unsigned 64-bit integer
+ *
+ */
+constexpr uint64_t  bcd_compress( const uint8_t*  decompressed_bcd )
+{
+    uint64_t  compressed_bcd = 0;
+    for( int  i = 0; i < 20; ++i )
+        compressed_bcd = compressed_bcd * 10ULL + decompressed_bcd[i];
+    return  compressed_bcd;
+}
+
+/**
+ *
+ *  Round BCD representation of (1 + ndigits) digits to given number of significant digits
+ *
+ *  @returns  Adjusted number of significant decimal digits
+ *
+ */
+constexpr int  bcd_round( int  new_ndigits, int  ndigits, uint8_t*  decimal_mantissa, int32_t*  exponent )
+{
+    // 1. Bounds check and adjustment
+    if( new_ndigits < 1 )
+        new_ndigits = 1;
+    else if( new_ndigits > ndigits )
+        new_ndigits = ndigits;
+
+    if( new_ndigits < ndigits )
+    {
+        for( ;; )
+        {
+            // 2. Compute round-up flag
+            int  round_up = ( decimal_mantissa[1 + new_ndigits] >= 5 );
+
+            // 3. Zero out the tail
+            for( int  i = 1 + new_ndigits; i <= ndigits; ++i )
+                decimal_mantissa[i] = 0;
+
+            // 4. Make round-up if necessary
+            if(! round_up )
+                break;
+            for( int  i = new_ndigits; i >= 0; --i )
+            {
+                uint8_t  new_value = decimal_mantissa[i] + 1;
+                if( new_value < 10 )
+                {
+                    decimal_mantissa[i] = new_value;
+                    break;
+                }
+                decimal_mantissa[i] = 0;
+            }
+
+            // 5. Handle overflow
+            if( decimal_mantissa[0] == 0 )
+                break;
+            for( int  i = ndigits; i > 0; --i )
+                decimal_mantissa[i] = decimal_mantissa[i - 1];
+            decimal_mantissa[0] = 0;
+            ++( *exponent );
+        }
+    }
+
+    // 6. Return adjusted number of significant decimal digits to the caller
+    return  new_ndigits;
+}
+
+/**
+ *
+ *  Parse decimal floating-point value from string, like scan_decimal() of dconvstr.c
+ *
+ *  On exit, parsed value is (out_decimal_mantissa * 10^out_decimal_exponent), with 19 significant
+ *  digits in decimal mantissa unless value is zero. Syntax errors are reported by setting
+ *  *input_end = input.
+ *
+ */
+constexpr void  scan_decimal(
+    const char*   input,
+    const char**  input_end,
+    int*          out_is_nan,
+    int*          out_sign,
+    uint64_t*     out_decimal_mantissa,
+    int32_t*      out_decimal_exponent,
+    int*          out_is_infinity
+)
+{
+    // 1. Handle special cases
+    constexpr int      ndigits      = 19;
+    constexpr int32_t  max_exponent = 350;
+    uint8_t  parsed_digits[1 + ndigits] = {};
+    *out_is_nan           = 0;
+    *out_sign             = 0;
+    *out_decimal_mantissa = 0;
+    *out_decimal_exponent = 0;
+    *out_is_infinity      = 0;
+    if((( input[0] == 'n' )||( input[0] == 'N' ))&&
+       (( input[1] == 'a' )||( input[1] == 'A' ))&&
+       (( input[2] == 'n' )||( input[2] == 'N' )))
+    {
+        if( input_end )
+            *input_end = input + 3;
+        *out_is_nan = 1;
+        return;
+    }
+    else if((( input[0] == 'i' )||( input[0] == 'I' ))&&
+            (( input[1] == 'n' )||( input[1] == 'N' ))&&
+            (( input[2] == 'f' )||( input[2] == 'F' )))
+    {
+        if( input_end )
+            *input_end = input + 3;
+        *out_is_infinity = 1;
+        return;
+    }
+    else if(( input[0] == '-' )&&
+            (( input[1] == 'i' )||( input[1] == 'I' ))&&
+            (( input[2] == 'n' )||( input[2] == 'N' ))&&
+            (( input[3] == 'f' )||( input[3] == 'F' )))
+    {
+        if( input_end )
+            *input_end = input + 4;
+        *out_sign        = 1;
+        *out_is_infinity = 1;
+        return;
+    }
+
+    // 2. Parse input string: states S0..S7 are the same as in scan_decimal_digits() of dconvstr.c
+    int      parsed_digits_size     = 1 + ndigits;
+    int      n_parsed_digits        = 0;
+    int32_t  exponent               = 0;
+    int32_t  exponent_offset        = 0;
+    int      flag_negative_mantissa = 0;
+    int      flag_negative_exponent = 0;
+    int      flag_syntax_error      = 0;
+    int      state                  = 0;
+    const char*  s = input;
+    while(( !flag_syntax_error )&&( *s ))
+    {
+        char  ch = *s;
+        int   is_digit = (( ch >= '0' )&&( ch <= '9' ));
+        switch( state )
+        {
+            // State 0: skip leading whitespaces, before mantissa sign and digits
+            case 0:
+                if(( ch == ' ' )||( ch == '\t' ))
+                    ++s;
+                else if(( ch == '-' )||( ch == '+' ))
+                {
+                    ++s;
+                    state = 1;
+                    flag_negative_mantissa = ( ch == '-' );
+                }
+                else if( is_digit )
+                    state = 2;
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = 3;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 1: after mantissa sign, before mantissa digits
+            case 1:
+                if( is_digit )
+                    state = 2;
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = 3;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 2: parsing mantissa digits before point
+            case 2:
+                if( is_digit )
+                {
+                    ++s;
+                    if( n_parsed_digits < parsed_digits_size )
+                    {
+                        parsed_digits[n_parsed_digits] = ch - '0';
+                        if(( ch != '0' )||( n_parsed_digits != 0 ))
+                            ++n_parsed_digits;
+                    }
+                    else
+                        ++exponent_offset;
+                }
+                else if( ch == '.' )
+                {
+                    ++s;
+                    state = 3;
+                }
+                else if(( ch == 'e' )||( ch == 'E' ))
+                {
+                    ++s;
+                    state = 5;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 3: parsing first mantissa digit just after the point
+            case 3:
+                if( is_digit )
+                    state = 4;
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 4: parsing mantissa digits after the point
+            case 4:
+                if( is_digit )
+                {
+                    ++s;
+                    if( n_parsed_digits < parsed_digits_size )
+                    {
+                        parsed_digits[n_parsed_digits] = ch - '0';
+                        if(( ch != '0' )||( n_parsed_digits != 0 ))
+                            ++n_parsed_digits;
+                        --exponent_offset;
+                    }
+                }
+                else if(( ch == 'e' )||( ch == 'E' ))
+                {
+                    ++s;
+                    state = 5;
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 5: parsing sign after the exponent
+            case 5:
+                if( is_digit )
+                    state = 7;
+                else if(( ch == '+' )||( ch == '-' ))
+                {
+                    ++s;
+                    state = 6;
+                    flag_negative_exponent = ( ch == '-' );
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 6: parsing first digits after exponent sign
+            case 6:
+                if( is_digit )
+                    state = 7;
+                else
+                    flag_syntax_error = 1;
+                break;
+
+            // State 7: parsing exponent digits
+            default:
+                if( is_digit )
+                {
+                    ++s;
+                    if( exponent < max_exponent )
+                        exponent = (exponent * 10) + (ch - '0');
+                }
+                else
+                    flag_syntax_error = 1;
+                break;
+        }
+    }
+    if((! flag_syntax_error )&&(( state == 0 )||( state == 1 )||( state == 3 )||
+                                ( state == 5 )||( state == 6 )))
+        flag_syntax_error = 1;
+    if( input_end )
+        *input_end = flag_syntax_error ? input : s;
+
+    // 3. Zero out the tail of mantissa (it's already zero).
+    //    Move decimal point to the right side of mantissa (adjust exponent offset).
+    //    Get rid of last mantissa digit and set first one to zero.
+    int  is_zero = ( n_parsed_digits == 0 );
+    if( n_parsed_digits < parsed_digits_size )
+        exponent_offset -= (parsed_digits_size - n_parsed_digits);
+    for( int  i = parsed_digits_size - 1; i > 0; --i )
+        parsed_digits[i] = parsed_digits[i - 1];
+    parsed_digits[0] = 0;
+    ++exponent_offset;
+
+    // 4. Compute exponent
+    if( is_zero )
+        exponent = 0;
+    else
+        exponent = ( (exponent < max_exponent) ? exponent_offset : 0 ) +
+                   ( flag_negative_exponent ? -exponent : exponent );
+
+    // 5. Save parsing results and exit
+    *out_sign             = flag_negative_mantissa;
+    *out_decimal_mantissa = bcd_compress( parsed_digits );
+    *out_decimal_exponent = exponent;
+}
+
+/**
+ *
+ *  Convert extended-precision decimal to IEEE 754 floating-point double precision value
+ *
+ */
+constexpr int  convert_decimal_to_double(
+    int       is_nan,
+    int       is_negative,
+    int       is_infinity,
+    uint64_t  mantissa,
+    int32_t   exponent,
+    double*   output,
+    int*      output_erange
+)
+{
+    // 1. Handle special cases
+    if(( is_nan )||( is_infinity ))
+    {
+        pack_ieee754_double( is_nan, is_negative, 0, 0, is_infinity, output );
+        *output_erange = 0;
+        return  1;
+    }
+
+    // 2. Check exponent for overflow and underflow
+    if(( exponent <= -350 )||( exponent >= 350 ))
+    {
+        pack_ieee754_double( 0, is_negative, 0, 0, ( exponent >= 350 ), output );
+        *output_erange = 1;
+        return  1;
+    }
+
+    // 3. Convert to binary representation, pack bits up and exit
+    if(( mantissa != 0 )&&
+       (! convert_extended_decimal_to_binary_and_round( mantissa, exponent, &mantissa, &exponent ) ))
+        return  0;
+    *output_erange = (! pack_ieee754_double( 0, is_negative, mantissa, exponent, 0, output ) );
+    return  1;
+}
+
+/**
+ *
+ *  Reports invalid argument of dconvstr::parse(); not defined as constexpr on purpose,
+ *  so that call of this function stops compilation
+ *
+ */
+inline void  parse_error_input_is_not_a_valid_double_constant() {}
+
+} // namespace constexpr_detail
+
+/**
+ *
+ *  Convert string to IEEE 754 floating-point double precision value at compile time
+ *
+ *  Parameters and return value are the same as in dconvstr_scan().
+ *
+ */
+constexpr int  scan( const char*  input, const char**  input_end, double*  output, int*  output_erange )
+{
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    constexpr_detail::scan_decimal( input, input_end, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+    return  constexpr_detail::convert_decimal_to_double( is_nan, is_negative, is_infinity, mantissa, exponent,
+                                                         output, output_erange );
+}
+
+/**
+ *
+ *  Convert string constant to double during compilation
+ *
+ *  Compilation fails if the whole string is not a valid number or if its conversion overflows
+ *  or underflows (when strtod(3) would set errno = ERANGE).
+ *
+ */
+consteval double  parse( const char*  input )
+{
+    const char*  input_end = input;
+    double  output = 0.0;
+    int     output_erange = 0;
+    if(( !scan( input, &input_end, &output, &output_erange ) )||( *input_end != 0 )||( output_erange ))
+        constexpr_detail::parse_error_input_is_not_a_valid_double_constant();
+    return  output;
+}
+
+/**
+ *
+ *  Output formats of dconvstr::print(), equivalent to format chars of dconvstr_print():
+ *  Scientific is 'e', Fixed is 'f', General is 'g', Shortest is 'g' with precision 17
+ *
+ */
+enum class Format
+{
+    Scientific,
+    Fixed,
+    General,
+    Shortest
+};
+
+/**
+ *
+ *  Maximum length of string printed by dconvstr::print() in given format with given precision
+ *
+ */
+template< Format  format, int  precision >
+inline constexpr int  print_max_size =
+    ( format == Format::Fixed      ) ? ( 1 + 309 + 1 + precision ) :     // -ddd.ddd, up to 309 digits before point
+    ( format == Format::Scientific ) ? ( 1 + 1 + 1 + precision + 5 ) :   // -d.ddde-ddd
+    ( format == Format::General    ) ? ( 1 + 1 + 5 + precision + 5 ) :   // -0.0000ddd or -d.ddde-ddd
+                                       ( 1 + 1 + 5 + 17 + 5 );
+
+/**
+ *
+ *  Print double to buf in format fixed at compile time, without width and flags
+ *
+ *  Output is the same as output of dconvstr_print() with format_flags = 0 and format char and
+ *  precision given by template arguments (precision is ignored for Format::Shortest):
+ *
+ *      char  buf[dconvstr::print_max_size<dconvstr::Format::Fixed, 6>];
+ *      char*  buf_end = dconvstr::print<dconvstr::Format::Fixed, 6>( buf, 0.1 );   // "0.100000"
+ *
+ *  Size of buf must be at least print_max_size<format, precision>; string is not terminated with zero.
+ *  Parsing of flags, width and padding of dconvstr_print() is resolved by the compiler, so that only
+ *  digit generation and layout are left in generated code.
+ *
+ *  @returns  End of printed string, or buf if internal error happened during conversion.
+ *
+ */
+template< Format  format, int  precision = 6 >
+constexpr char*  print( char*  buf, double  value )
+{
+    static_assert(( precision >= 0 )&&( precision <= 1000 ), "precision is out of range" );
+    constexpr bool  is_general = (( format == Format::General )||( format == Format::Shortest ));
+    char*  p = buf;
+
+    // 1. Unpack double precision value, handle special cases
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    constexpr_detail::unpack_ieee754_double( value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+    if(( is_nan )||( is_infinity ))
+    {
+        if(( is_infinity )&&( is_negative ))
+            *p++ = '-';
+        for( const char*  s = ( is_nan ? "nan" : "inf" ); *s; ++s )
+            *p++ = *s;
+        return  p;
+    }
+
+    // 2. Get exact decimal representation.
+    //    Decimal point is located on the right side of decimal mantissa
+    uint8_t  decimal_mantissa[20] = {};
+    if( mantissa == 0 )
+        exponent = -18;
+    else
+    {
+        if(! constexpr_detail::convert_binary_to_extended_decimal( mantissa, exponent, &mantissa, &exponent ) )
+            return  buf;
+        constexpr_detail::bcd_decompress( mantissa, decimal_mantissa );
+        if(( decimal_mantissa[0] != 0 )||( decimal_mantissa[1] == 0 ))
+            return  buf;
+    }
+
+    // 3. Compute z1 (zeros before digits), z2 (zeros after digits), point (digits before decimal point),
+    //    ndigits and exponent of suffix like in format_decimal() of dconvstr.c
+    int   point   = 1;
+    int   z1      = 0;
+    int   z2      = 0;
+    int   ndigits = 19;
+    bool  is_scientific    = ( format == Format::Scientific );
+    int   format_precision = ( format == Format::Shortest ) ? 17 : precision;
+    if constexpr( is_general )
+    {
+        // get rid of excess precision, choose format: e or f
+        if( format_precision == 0 )
+            format_precision = 1;
+        if( format_precision < ndigits )
+        {
+            exponent += (ndigits - format_precision);
+            ndigits = constexpr_detail::bcd_round( format_precision, 19, decimal_mantissa, &exponent );
+        }
+        int  e = exponent + (ndigits - 1);
+        if(!(( e >= -4 )&&( e < format_precision )))
+        {
+            is_scientific = true;
+            --format_precision;
+        }
+    }
+    if( is_scientific )
+    {
+        exponent += (ndigits - 1);
+        if( 1 + format_precision >= ndigits )
+            z2 = 1 + format_precision - ndigits;
+        else
+            ndigits = constexpr_detail::bcd_round( 1 + format_precision, 19, decimal_mantissa, &exponent );
+    }
+    else
+    {
+        // determine where digits go with respect to decimal point
+        if( ndigits + exponent > 0 )
+            point = ndigits + exponent;
+        else
+            z1 = 1 + -(ndigits + exponent);
+
+        // %g specifies prec = number of significant digits
+        if constexpr( is_general )
+            format_precision += (z1 - point);
+
+        // compute trailing zero padding or truncate digits
+        if( point + format_precision >= z1 + ndigits )
+            z2 = point + format_precision - (z1 + ndigits);
+        else
+        {
+            int  new_ndigits = point + format_precision - z1;
+            if( new_ndigits < 0 )
+            {
+                z1 += new_ndigits;
+                ndigits = 0;
+            }
+            else if( new_ndigits == 0 )
+            {
+                if( decimal_mantissa[1] >= 5 )
+                {
+                    decimal_mantissa[1] = 1;
+                    ndigits = 1;
+                    if( z1 > 0 )
+                        --z1;
+                    else
+                        ++point;
+                }
+                else
+                    ndigits = 0;
+            }
+            else
+            {
+                int32_t  new_exponent = exponent;
+                ndigits = constexpr_detail::bcd_round( new_ndigits, 19, decimal_mantissa, &new_exponent );
+                for( ; new_exponent > exponent; --new_exponent )
+                {
+                    ++z2;
+                    if( z1 > 0 )
+                        --z1;
+                    else
+                        ++point;
+                }
+            }
+        }
+    }
+
+    // 4. In general format, remove trailing zeros
+    if constexpr( is_general )
+    {
+        if( z1 + ndigits + z2 >= point )
+        {
+            if( z1 + ndigits < point )
+                z2 = point - (z1 + ndigits);
+            else
+            {
+                z2 = 0;
+                while(( z1 + ndigits > point )&&( decimal_mantissa[ndigits] == 0 ))
+                    --ndigits;
+            }
+        }
+    }
+    if( z1 + ndigits + z2 == point )
+        ++point;        // point is not printed at the end
+
+    // 5. Print sign, digits, decimal point and exponent
+    if( is_negative )
+        *p++ = '-';
+    const uint8_t*  digits = decimal_mantissa + 1;
+    for( ; z1 > 0; --z1 )
+    {
+        *p++ = '0';
+        if( --point == 0 )
+            *p++ = '.';
+    }
+    for( ; ndigits > 0; --ndigits )
+    {
+        *p++ = ((char)( '0' + *digits++ ));
+        if( --point == 0 )
+            *p++ = '.';
+    }
+    for( ; z2 > 0; --z2 )
+    {
+        *p++ = '0';
+        if( --point == 0 )
+            *p++ = '.';
+    }
+    if( is_scientific )
+    {
+        *p++ = 'e';
+        *p++ = ( (exponent < 0) ? '-' : '+' );
+        int32_t  abs_exponent = ( (exponent < 0) ? -exponent : exponent );
+        if( abs_exponent >= 100 )
+            *p++ = ((char)( '0' + abs_exponent / 100 ));
+        *p++ = ((char)( '0' + (abs_exponent / 10) % 10 ));
+        *p++ = ((char)( '0' + abs_exponent % 10 ));
+    }
+    return  p;
+}
+
+/**
+ *
+ *  Zero-terminated string with printed value, returned by dconvstr::format()
+ *
+ */
+struct shortest_string
+{
+    char  data[print_max_size<Format::Shortest, 0> + 1];
+    int   size;
+
+    constexpr const char*  c_str() const { return  data; }
+
+    constexpr bool  operator==( const char*  str ) const
+    {
+        int  i = 0;
+        for( ; ( i < size )&&( str[i] == data[i] ); ++i )
+            ;
+        return(( i == size )&&( str[i] == 0 ));
+    }
+};
+
+/**
+ *
+ *  Print double in the shortest representation which is converted back to the same value
+ *
+ *  Output is the same as output of dconvstr_print() with format_char = 'g', format_flags = 0
+ *  and format_precision = 17, e.g. "0.1", "-2.5e-07", "1e+22", "nan". Output is empty string
+ *  on internal error.
+ *
+ */
+constexpr shortest_string  format( double  value )
+{
+    shortest_string  result = {};
+    result.size = ((int)( print<Format::Shortest>( result.data, value ) - result.data ));
+    return  result;
+}
+
+/**
+ *
+ *  Print double constant given as template argument, e.g. dconvstr::format<3.14>()
+ *
+ */
+template< double  value >
+consteval shortest_string  format()
+{
+    return  format( value );
+}
+
+} // namespace dconvstr
+
+#endif // DCONVSTR_CONSTEXPR_HPP
@@ -0,0 +1,333 @@
+/*
+ *  Formatters of std::format() and {fmt} library backed by dconvstr
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  Values wrapped in dconvstr::number are formatted by dconvstr instead of the formatting library:
+//
+//      std::format( "{:.3f} {}", dconvstr::number{ price }, dconvstr::number{ ratio } );
+//      fmt::format( "{:>12e}", dconvstr::number{ x } );
+//
+//  Specializations for std::format() are declared if standard library has <format>, and for {fmt}
+//  if <fmt/format.h> was included before this header. To route formatting of own type through
+//  dconvstr, derive its formatter from dconvstr::basic_formatter<std::format_error> or
+//  dconvstr::basic_formatter<fmt::format_error> and call its format() with double value.
+//
+//  Standard format specification is supported: [[fill]align][sign][#][0][width][.precision][type]
+//  with types e, E, f, F, g, G or none, as in std::format(). Types e, f and g and "none with
+//  precision" (which is g) print the same digits as dconvstr_print() with the same printf(3) format;
+//  "none without precision" prints the shortest representation like dconvstr::to_chars().
+//  Hexadecimal format, locale-specific format (L) and width or precision given by argument
+//  ({} inside specification) are not supported and reported as format errors.
+//
+
+#ifndef DCONVSTR_FORMAT_HPP
+#define DCONVSTR_FORMAT_HPP
+
+#include "dconvstr.hpp"
+
+#include <climits>
+#include <cmath>
+#include <version>
+#ifdef __cpp_lib_format
+#  include <format>
+#endif
+
+namespace dconvstr {
+
+/**
+ *
+ *  Wrapper of double which selects formatters of this header
+ *
+ */
+struct number
+{
+    double  value;
+};
+
+/**
+ *
+ *  Formatter of double with parse() and format() compatible with std::formatter and fmt::formatter
+ *
+ *  FormatError is exception type thrown on errors: std::format_error or fmt::format_error.
+ *  Output is written to the output iterator of format context from buffer on stack.
+ *
+ */
+template< class  FormatError >
+class basic_formatter
+{
+public:
+    // Maximum precision: "%.700f" of the largest double fits into buffer of format()
+    static constexpr int  max_precision = 700;
+
+    /**
+     *
+     *  Parse format specification, from the beginning of parse context to closing brace
+     *
+     */
+    template< class  ParseContext >
+    constexpr typename ParseContext::iterator  parse( ParseContext&  ctx )
+    {
+        auto  it  = ctx.begin();
+        auto  end = ctx.end();
+
+        // 1. Parse fill and alignment; fill is one character (code point in UTF-8)
+        if(( it != end )&&( *it != '}' ))
+        {
+            int  n = 1;
+            unsigned char  lead = ((unsigned char)( *it ));
+            if( lead >= 0xF0 )
+                n = 4;
+            else if( lead >= 0xE0 )
+                n = 3;
+            else if( lead >= 0xC0 )
+                n = 2;
+            if(( end - it > n )&&( is_align( it[n] ) ))
+            {
+                if(( n == 1 )&&(( *it == '{' )||( *it == '}' )))
+                    throw  FormatError( "invalid fill character in format specification" );
+                for( int  i = 0; i < n; ++i )
+                    fill_[i] = it[i];
+                fill_size_ = n;
+                align_     = it[n];
+                it += n + 1;
+            }
+            else if( is_align( *it ) )
+                align_ = *it++;
+        }
+
+        // 2. Parse sign, alternate form and zero padding
+        if(( it != end )&&(( *it == '+' )||( *it == '-' )||( *it == ' ' )))
+            sign_ = *it++;
+        if(( it != end )&&( *it == '#' ))
+        {
+            is_alternate_ = true;
+            ++it;
+        }
+        if(( it != end )&&( *it == '0' ))
+        {
+            is_zero_padded_ = true;
+            ++it;
+        }
+
+        // 3. Parse width and precision
+        it = parse_integer( it, end, &width_ );
+        if(( it != end )&&( *it == '.' ))
+        {
+            ++it;
+            if(( it == end )||( *it < '0' )||( *it > '9' ))
+                throw  FormatError( "precision is expected in format specification" );
+            it = parse_integer( it, end, &precision_ );
+            if( precision_ > max_precision )
+                throw  FormatError( "precision is too large" );
+        }
+
+        // 4. Parse type
+        if(( it != end )&&( *it == 'L' ))
+            throw  FormatError( "locale-specific format is not supported" );
+        if(( it != end )&&( *it != '}' ))
+        {
+            char  ch = *it++;
+            if(( ch != 'e' )&&( ch != 'E' )&&( ch != 'f' )&&( ch != 'F' )&&( ch != 'g' )&&( ch != 'G' ))
+                throw  FormatError( "invalid type in format specification" );
+            type_ = ch;
+        }
+        if(( it != end )&&( *it != '}' ))
+            throw  FormatError( "invalid format specification" );
+        return  it;
+    }
+
+    /**
+     *
+     *  Format value and write it to the output iterator of format context
+     *
+     */
+    template< class  FormatContext >
+    typename FormatContext::iterator  format( double  value, FormatContext&  ctx ) const
+    {
+        // 1. Print value to buffer on stack
+        char   buf[16 + 309 + max_precision];
+        char*  buf_end = buf;
+        bool   is_uppercase = (( type_ == 'E' )||( type_ == 'F' )||( type_ == 'G' ));
+        bool   is_finite = std::isfinite( value );
+        if(! is_finite )
+        {
+            // sign of NaN is printed like in std::format()
+            if( std::signbit( value ) )
+                *buf_end++ = '-';
+            else if( sign_ != '-' )
+                *buf_end++ = sign_;
+            const char*  str = std::isnan( value ) ? ( is_uppercase ? "NAN" : "nan" ) : ( is_uppercase ? "INF" : "inf" );
+            for( int  i = 0; i < 3; ++i )
+                *buf_end++ = str[i];
+        }
+        else if(( type_ == 0 )&&( precision_ < 0 ))
+        {
+            // shortest representation
+            if(( !std::signbit( value ) )&&( sign_ != '-' ))
+                *buf_end++ = sign_;
+            buf_end = dconvstr::to_chars( buf_end, buf + sizeof(buf), value ).ptr;
+            if( is_alternate_ )
+                buf_end = insert_decimal_point( buf, buf_end );
+        }
+        else
+        {
+            unsigned int  flags = 0;
+            if( sign_ == '+' )
+                flags |= DCONVSTR_FLAG_PRINT_PLUS;
+            else if( sign_ == ' ' )
+                flags |= DCONVSTR_FLAG_SPACE_IF_PLUS;
+            if( is_alternate_ )
+                flags |= DCONVSTR_FLAG_SHARP;
+            if( is_uppercase )
+                flags |= DCONVSTR_FLAG_UPPERCASE;
+            int  format_char = ( (type_ == 0) ? 'g' : (type_ | 0x20) );
+            int  buf_size    = sizeof(buf);
+            if(! dconvstr_print( &buf_end, &buf_size, value, format_char, flags, 0,
+                                 (precision_ < 0) ? DCONVSTR_DEFAULT_PRECISION : precision_ ) )
+                throw  FormatError( "internal error in dconvstr_print()" );
+        }
+
+        // 2. Compute padding. Zero padding goes after sign, and is not applied if alignment is given
+        //    or value is not finite
+        int  n = ((int)( buf_end - buf ));
+        int  padding = ( (width_ > n) ? (width_ - n) : 0 );
+        auto  out = ctx.out();
+        const char*  p = buf;
+        if(( padding )&&( is_zero_padded_ )&&( align_ == 0 )&&( is_finite ))
+        {
+            if(( *p == '-' )||( *p == '+' )||( *p == ' ' ))
+                *out++ = *p++;
+            for( ; padding > 0; --padding )
+                *out++ = '0';
+        }
+        int  left_padding = 0;
+        if(( align_ == '>' )||( align_ == 0 ))
+            left_padding = padding;
+        else if( align_ == '^' )
+            left_padding = padding / 2;
+
+        // 3. Write padding and value
+        for( int  i = 0; i < left_padding; ++i )
+            out = write_fill( out );
+        for( ; p != buf_end; ++p )
+            *out++ = *p;
+        for( int  i = left_padding; i < padding; ++i )
+            out = write_fill( out );
+        return  out;
+    }
+
+private:
+    char  fill_[4]        = { ' ', 0, 0, 0 };
+    int   fill_size_      = 1;
+    char  align_          = 0;       // '<', '>', '^' or 0 if not given
+    char  sign_           = '-';     // '+', '-' or ' '
+    bool  is_alternate_   = false;   // '#'
+    bool  is_zero_padded_ = false;   // '0'
+    int   width_          = 0;
+    int   precision_      = -1;      // -1 if not given
+    char  type_           = 0;       // 'e', 'E', 'f', 'F', 'g', 'G' or 0 if not given
+
+    static constexpr bool  is_align( char  ch )
+    {
+        return(( ch == '<' )||( ch == '>' )||( ch == '^' ));
+    }
+
+    /**
+     *
+     *  Parse non-negative decimal integer (width or precision), if any
+     *
+     */
+    template< class  Iterator >
+    static constexpr Iterator  parse_integer( Iterator  it, Iterator  end, int*  output )
+    {
+        if(( it != end )&&( *it == '{' ))
+            throw  FormatError( "width or precision given by argument is not supported" );
+        for( ; ( it != end )&&( *it >= '0' )&&( *it <= '9' ); ++it )
+        {
+            if( *output > (INT_MAX - 9) / 10 )
+                throw  FormatError( "number is too big in format specification" );
+            *output = ( (*output < 0) ? 0 : *output * 10 ) + (*it - '0');
+        }
+        return  it;
+    }
+
+    /**
+     *
+     *  Insert decimal point before exponent or at the end of printed value, if there's no point
+     *
+     */
+    static char*  insert_decimal_point( char*  first, char*  last )
+    {
+        char*  e = first;
+        for( ; ( e != last )&&( *e != 'e' ); ++e )
+        {
+            if( *e == '.' )
+                return  last;
+        }
+        for( char*  p = last; p != e; --p )
+            *p = p[-1];
+        *e = '.';
+        return  last + 1;
+    }
+
+    template< class  OutputIterator >
+    OutputIterator  write_fill( OutputIterator  out ) const
+    {
+        for( int  i = 0; i < fill_size_; ++i )
+            *out++ = fill_[i];
+        return  out;
+    }
+};
+
+} // namespace dconvstr
+
+#ifdef __cpp_lib_format
+template<>
+struct  std::formatter<dconvstr::number, char> : dconvstr::basic_formatter<std::format_error>
+{
+    template< class  FormatContext >
+    typename FormatContext::iterator  format( dconvstr::number  value, FormatContext&  ctx ) const
+    {
+        return  dconvstr::basic_formatter<std::format_error>::format( value.value, ctx );
+    }
+};
+#endif
+
+#ifdef FMT_VERSION
+template<>
+struct  fmt::formatter<dconvstr::number, char> : dconvstr::basic_formatter<fmt::format_error>
+{
+    template< class  FormatContext >
+    typename FormatContext::iterator  format( dconvstr::number  value, FormatContext&  ctx ) const
+    {
+        return  dconvstr::basic_formatter<fmt::format_error>::format( value.value, ctx );
+    }
+};
+#endif
+
+#endif // DCONVSTR_FORMAT_HPP
@@ -0,0 +1,106 @@
+/*
+ *  Test-only interface to internal stages of dconvstr.c (double precision print and scan pipeline)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DCONVSTR_INTERNAL_H
+#define DCONVSTR_INTERNAL_H
+
+// Functions declared here are not part of public API of dconvstr library. They are defined only if
+// dconvstr.c is compiled with -DDCONVSTR_EXPOSE_INTERNALS, and are meant for per-stage benchmarks
+// and tests. Each function calls the internal stage of the same name with the same parameters;
+// see dconvstr.c for descriptions. Types uint8_t, int32_t and uint64_t must be defined before inclusion
+// (by <stdint.h>, or by typedefs with MSVC as in dconvstr.c).
+
+// dconvstr_print() stages
+void  dconvstr_internal_unpack_ieee754_double(
+    const double*  input,
+    int*           out_is_nan,
+    int*           out_sign,
+    uint64_t*      out_binary_mantissa,
+    int32_t*       out_binary_exponent,
+    int*           out_is_infinity
+);
+
+int  dconvstr_internal_convert_binary_to_extended_decimal(
+    uint64_t   a,
+    int32_t    b,
+    uint64_t*  c,
+    int32_t*   d
+);
+
+void  dconvstr_internal_bcd_decompress(
+    uint64_t  compressed_bcd,
+    uint8_t*  decompressed_bcd
+);
+
+int  dconvstr_internal_bcd_round( int  new_ndigits, int  ndigits, uint8_t*  decimal_mantissa, int32_t*  exponent );
+
+int  dconvstr_internal_format_decimal(
+    char**        outbuf,
+    int*          outbuf_size,
+    int           is_nan,
+    int           is_negative,
+    int           is_infinity,
+    uint8_t*      decimal_mantissa,
+    int           mantissa_ndigits,
+    int32_t       exponent,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+);
+
+// dconvstr_scan() stages
+void  dconvstr_internal_scan_decimal_digits(
+    const char*   input,
+    const char**  input_end,
+    uint8_t*      decimal_digits,
+    int*          out_is_nan,
+    int*          out_sign,
+    int32_t*      out_decimal_exponent,
+    int*          out_is_infinity
+);
+
+uint64_t  dconvstr_internal_bcd_compress( const uint8_t*  decompressed_bcd );
+
+int  dconvstr_internal_convert_extended_decimal_to_binary_and_round(
+    uint64_t   a,
+    int32_t    b,
+    uint64_t*  c,
+    int32_t*   d
+);
+
+int  dconvstr_internal_pack_ieee754_double(
+    int       input_is_nan,
+    int       input_sign,
+    uint64_t  input_binary_mantissa,
+    int32_t   input_binary_exponent,
+    int       input_is_infinity,
+    double*   output
+);
+
+#endif // DCONVSTR_INTERNAL_H
@@ -0,0 +1,562 @@
+/*
+ *  Interposer of strtod(3) and snprintf(3) family of glibc backed by dconvstr, for LD_PRELOAD
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  Shared object which replaces strtod(), strtof(), atof() and snprintf(), vsnprintf(), sprintf(),
+//  vsprintf() (also their _FORTIFY_SOURCE variants) in unmodified programs:
+//
+//      cc -O2 -shared -fPIC -o dconvstr_preload.so dconvstr_preload.c -ldl -lm
+//      LD_PRELOAD=/path/to/dconvstr_preload.so program
+//
+//  Output is the same as of glibc. Conversion is done by dconvstr only if its result is known to be
+//  exact; everything else is passed to the next definition of the same function (glibc):
+//
+//  - scanning: only decimal syntax with at most 19 significant digits, and only if the value is not
+//    close to the midpoint between two doubles (or floats), and the result is a normal number.
+//    Hexadecimal values, infinity, NaN and results which set errno = ERANGE are left to glibc;
+//
+//  - printing: only format strings with plain text, %% and conversions %e, %E, %f, %F, %g, %G
+//    with flags, width and precision, but without '*', length modifiers or argument numbers.
+//    Every printed value must be finite and normal, and its exact decimal expansion must not be
+//    close to the midpoint of rounding; in particular, 17 significant digits are always printed
+//    by glibc, since dconvstr computes only the shortest representation that round-trips;
+//
+//  - both: locale with decimal point other than '.', and rounding mode other than to nearest
+//    are left to glibc.
+//
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE      // for RTLD_NEXT
+#endif
+#undef _FORTIFY_SOURCE     // this file defines sprintf() and others, not their wrappers
+
+#define DCONVSTR_HEADER_ONLY
+#include "dconvstr.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <langinfo.h>
+#include <fenv.h>
+#include <dlfcn.h>
+
+
+//=====================================================================================================
+//
+// CONSTANTS AND GLOBAL VARIABLES
+//
+
+// Every value is printed into buffer on stack; larger output is left to glibc
+#define PRINT_BUFFER_SIZE   512
+
+// Maximal width or precision parsed from format string; larger ones are left to glibc
+#define MAX_FORMAT_NUMBER   400
+
+// Scanned value is rejected if remainder of 64-bit binary mantissa is within this distance
+// from the midpoint between two doubles (0x400); error of the mantissa is smaller
+#define SCAN_MARGIN         8
+
+// Functions of glibc called for input and output which are not converted by dconvstr
+enum
+{
+    REAL_STRTOD = 0,
+    REAL_STRTOF,
+    REAL_VSNPRINTF,
+    REAL_VSPRINTF,
+    REAL_VSNPRINTF_CHK,
+    REAL_VSPRINTF_CHK,
+    N_REAL_FUNCTIONS
+};
+
+typedef double  (*strtod_function)( const char*, char** );
+typedef float   (*strtof_function)( const char*, char** );
+typedef int     (*vsnprintf_function)( char*, size_t, const char*, va_list );
+typedef int     (*vsprintf_function)( char*, const char*, va_list );
+typedef int     (*vsnprintf_chk_function)( char*, size_t, int, size_t, const char*, va_list );
+typedef int     (*vsprintf_chk_function)( char*, int, size_t, const char*, va_list );
+
+static const char* const  real_function_names_[N_REAL_FUNCTIONS] = {
+    "strtod", "strtof", "vsnprintf", "vsprintf", "__vsnprintf_chk", "__vsprintf_chk"
+};
+static void*  real_functions_[N_REAL_FUNCTIONS];
+
+// Powers of ten 10^0 .. 10^19
+static const uint64_t  pow10_[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    POW10_18, POW10_19
+};
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Get next definition of function (in glibc), resolved once
+ *
+ */
+static void*  get_real_function( int  id )
+{
+    void*  function = __atomic_load_n( real_functions_ + id, __ATOMIC_ACQUIRE );
+    if( function == NULL )
+    {
+        function = dlsym( RTLD_NEXT, real_function_names_[id] );
+        if( function == NULL )
+            abort();
+        __atomic_store_n( real_functions_ + id, function, __ATOMIC_RELEASE );
+    }
+    return  function;
+}
+
+/**
+ *
+ *  Check that glibc would convert values in "C" locale with rounding to nearest
+ *
+ */
+static int  is_default_environment()
+{
+    const char*  decimal_point = nl_langinfo( RADIXCHAR );
+    return(( decimal_point[0] == '.' )&&( decimal_point[1] == 0 )&&( fegetround() == FE_TONEAREST ));
+}
+
+/**
+ *
+ *  Convert string to double like strtod(3), if result is known to be correctly rounded
+ *
+ *  @returns  1  if value was converted.
+ *            0  if conversion is left to glibc.
+ *
+ */
+static int  scan_exact( const char*  str, char**  str_end, double*  output )
+{
+    // 1. Skip white space and sign; hexadecimal values are left to glibc
+    const char*  p = str;
+    while(( *p == ' ' )||(( *p >= '\t' )&&( *p <= '\r' )))
+        ++p;
+    int  is_negative = 0;
+    if(( *p == '-' )||( *p == '+' ))
+        is_negative = ( *p++ == '-' );
+    if(( p[0] == '0' )&&(( p[1] == 'x' )||( p[1] == 'X' )))
+        return  0;
+
+    // 2. Parse decimal mantissa with at most 19 significant digits
+    uint64_t  mantissa  = 0;
+    int       ndigits   = 0;
+    int32_t   exponent  = 0;
+    int       is_digit_found = 0;
+    for( ; ( *p >= '0' )&&( *p <= '9' ); ++p )
+    {
+        is_digit_found = 1;
+        if(( mantissa == 0 )&&( *p == '0' ))
+            continue;
+        if( ndigits == 19 )
+            return  0;
+        mantissa = mantissa * 10ULL + (uint64_t)( *p - '0' );
+        ++ndigits;
+    }
+    if( *p == '.' )
+    {
+        for( ++p; ( *p >= '0' )&&( *p <= '9' ); ++p )
+        {
+            is_digit_found = 1;
+            --exponent;
+            if(( mantissa == 0 )&&( *p == '0' ))
+                continue;
+            if( ndigits == 19 )
+                return  0;
+            mantissa = mantissa * 10ULL + (uint64_t)( *p - '0' );
+            ++ndigits;
+        }
+    }
+    if(! is_digit_found )
+        return  0;     // infinity, NaN or syntax error
+
+    // 3. Parse exponent, if it's there
+    if(( *p == 'e' )||( *p == 'E' ))
+    {
+        const char*  q = p + 1;
+        int  is_exponent_negative = 0;
+        if(( *q == '-' )||( *q == '+' ))
+            is_exponent_negative = ( *q++ == '-' );
+        if(( *q >= '0' )&&( *q <= '9' ))
+        {
+            int32_t  written_exponent = 0;
+            for( ; ( *q >= '0' )&&( *q <= '9' ); ++q )
+            {
+                if( written_exponent > 9999 )
+                    return  0;
+                written_exponent = written_exponent * 10 + (*q - '0');
+            }
+            exponent += ( is_exponent_negative ? -written_exponent : written_exponent );
+            p = q;
+        }
+    }
+
+    // 4. Convert to binary; values close to the midpoint between two doubles, and also subnormal,
+    //    zero and infinite results of non-zero input are left to glibc
+    if( mantissa == 0 )
+        *output = ( is_negative ? -0.0 : 0.0 );
+    else
+    {
+        uint64_t  binary_mantissa = 0;
+        int32_t   binary_exponent = 0;
+        if(! convert_extended_decimal_to_binary( mantissa, exponent, &binary_mantissa, &binary_exponent ) )
+            return  0;
+        uint64_t  remainder = binary_mantissa & 0x07FFULL;
+        if(( remainder + SCAN_MARGIN >= 0x0400ULL )&&( remainder <= 0x0400ULL + SCAN_MARGIN ))
+            return  0;
+        if(! convert_extended_decimal_to_binary_and_round( mantissa, exponent, &binary_mantissa, &binary_exponent ) )
+            return  0;
+        if(( binary_exponent < -1022 )||( binary_exponent > 1023 ))
+            return  0;
+        if(! pack_ieee754_double( 0, is_negative, binary_mantissa, binary_exponent, 0, output ) )
+            return  0;
+    }
+    if( str_end )
+        *str_end = (char*) p;
+    return  1;
+}
+
+/**
+ *
+ *  Check that rounding of decimal mantissa c (10^18 <= c < 10^19) computed by
+ *  convert_binary_to_extended_decimal() to ndigits digits gives the same result as rounding
+ *  of exact value of double
+ *
+ */
+static int  is_rounding_exact( uint64_t  c, int  ndigits )
+{
+    if( ndigits < 0 )
+        return  1;     // value is less than 1/10 of the last printed digit: zero is printed
+    if( ndigits >= 19 )
+        return  0;
+
+    // c is within 1/2 ulp of exact value, and ulp <= 2^-52 of value; bound of error is 4 times larger
+    uint64_t  scale    = pow10_[19 - ndigits];
+    uint64_t  tail     = c % scale;
+    uint64_t  half     = scale / 2;
+    uint64_t  error    = (c >> 50) + 2;
+    uint64_t  distance = ( (tail > half) ? (tail - half) : (half - tail) );
+    return( distance > error );
+}
+
+/**
+ *
+ *  Print double like dconvstr_print(), if output is known to be the same as of glibc
+ *
+ *  @returns  1  if value was printed.
+ *            0  if printing is left to glibc.
+ *
+ */
+static int  print_exact(
+    char**        outbuf,
+    int*          outbuf_size,
+    double        value,
+    int           format_char,
+    unsigned int  format_flags,
+    int           format_width,
+    int           format_precision
+)
+{
+    // 1. Unpack value; infinity, NaN and subnormal values are left to glibc
+    uint64_t  bits = 0;
+    memcpy( &bits, &value, sizeof(bits) );
+    uint64_t  biased_exponent = (bits >> 52) & 0x7FFULL;
+    if(( biased_exponent == 0x7FFULL )||(( biased_exponent == 0 )&&( (bits << 1) != 0 )))
+        return  0;
+    int       is_nan      = 0;
+    int       is_negative = 0;
+    int       is_infinity = 0;
+    uint64_t  mantissa    = 0;
+    int32_t   exponent    = 0;
+    unpack_ieee754_double( &value, &is_nan, &is_negative, &mantissa, &exponent, &is_infinity );
+
+    // 2. Alternative form of 'g' is left to glibc: it chooses style and number of digits
+    //    before rounding, e.g. "%#.2g" of 99.68 gives "1.e+02" there
+    if(( format_char == 'g' )&&( format_flags & DCONVSTR_FLAG_SHARP ))
+        return  0;
+
+    // 3. Get decimal representation and check that its rounding to printed digits is exact.
+    //    Rounding to 16 or more significant digits never passes the check, so it's rejected early
+    uint8_t  decimal_mantissa[20];
+    int      ndigits = 0;
+    if( format_char == 'e' )
+        ndigits = format_precision + 1;
+    else if( format_char == 'g' )
+        ndigits = ( (format_precision == 0) ? 1 : format_precision );
+    if( ndigits >= 16 )
+        return  0;
+    if( mantissa == 0 )
+    {
+        memset( decimal_mantissa, 0, sizeof(decimal_mantissa) );
+        exponent = -18;
+    }
+    else
+    {
+        if(! convert_binary_to_extended_decimal( mantissa, exponent, &mantissa, &exponent ) )
+            return  0;
+        if( format_char == 'f' )
+            ndigits = exponent + 19 + format_precision;
+        if(! is_rounding_exact( mantissa, ndigits ) )
+            return  0;
+        bcd_decompress( mantissa, decimal_mantissa );
+    }
+
+    // 4. Print decimal representation
+    return  format_decimal( outbuf, outbuf_size, 0, is_negative, 0, decimal_mantissa, 19, exponent,
+                            format_char, format_flags, format_width, format_precision );
+}
+
+/**
+ *
+ *  Format output like vsnprintf(3), if every conversion is supported and exact
+ *
+ *  @returns  length of output (without terminating zero)
+ *            -1 if formatting is left to glibc.
+ *
+ */
+static int  format_exact( char*  str, size_t  size, const char*  format, va_list  args )
+{
+    // 1. Check locale and rounding mode
+    if(! is_default_environment() )
+        return  -1;
+
+    // 2. Copy plain text and print conversions; characters beyond (size - 1) are only counted
+    size_t  n = 0;
+    for( const char*  p = format; *p; )
+    {
+        if(( *p != '%' )||( p[1] == '%' ))
+        {
+            if( n + 1 < size )
+                str[n] = *p;
+            ++n;
+            p += ( (*p == '%') ? 2 : 1 );
+            continue;
+        }
+
+        // 3. Parse flags, width, precision and conversion char
+        unsigned int  flags = 0;
+        for( ++p; ; ++p )
+        {
+            if( *p == '-' )
+                flags |= DCONVSTR_FLAG_LEFT_JUSTIFY;
+            else if( *p == '+' )
+                flags |= DCONVSTR_FLAG_PRINT_PLUS;
+            else if( *p == ' ' )
+                flags |= DCONVSTR_FLAG_SPACE_IF_PLUS;
+            else if( *p == '#' )
+                flags |= DCONVSTR_FLAG_SHARP;
+            else if( *p == '0' )
+                flags |= DCONVSTR_FLAG_PAD_WITH_ZERO;
+            else
+                break;
+        }
+        int  width = 0;
+        for( ; ( *p >= '0' )&&( *p <= '9' ); ++p )
+        {
+            width = width * 10 + (*p - '0');
+            if( width > MAX_FORMAT_NUMBER )
+                return  -1;
+        }
+        if( width > 0 )
+            flags |= DCONVSTR_FLAG_HAVE_WIDTH;
+        int  precision = DCONVSTR_DEFAULT_PRECISION;
+        if( *p == '.' )
+        {
+            for( precision = 0, ++p; ( *p >= '0' )&&( *p <= '9' ); ++p )
+            {
+                precision = precision * 10 + (*p - '0');
+                if( precision > MAX_FORMAT_NUMBER )
+                    return  -1;
+            }
+        }
+        int  format_char = *p++;
+        if(( format_char == 'E' )||( format_char == 'F' )||( format_char == 'G' ))
+        {
+            flags |= DCONVSTR_FLAG_UPPERCASE;
+            format_char |= 0x20;
+        }
+        if(( format_char != 'e' )&&( format_char != 'f' )&&( format_char != 'g' ))
+            return  -1;
+
+        // 4. Print value
+        char   buf[PRINT_BUFFER_SIZE];
+        char*  buf_end  = buf;
+        int    buf_size = sizeof(buf);
+        if(! print_exact( &buf_end, &buf_size, va_arg( args, double ), format_char, flags, width, precision ) )
+            return  -1;
+        for( const char*  q = buf; q != buf_end; ++q, ++n )
+        {
+            if( n + 1 < size )
+                str[n] = *q;
+        }
+    }
+
+    // 5. Terminate output with zero
+    if( n > INT_MAX )
+        return  -1;
+    if( size > 0 )
+        str[ (n < size) ? n : (size - 1) ] = 0;
+    return  (int)( n );
+}
+
+//=====================================================================================================
+//
+// INTERPOSED FUNCTIONS
+//
+
+double  strtod( const char*  str, char**  str_end )
+{
+    double  value;
+    if(( is_default_environment() )&&( scan_exact( str, str_end, &value ) ))
+        return  value;
+    return  ((strtod_function) get_real_function( REAL_STRTOD ))( str, str_end );
+}
+
+float  strtof( const char*  str, char**  str_end )
+{
+    // Rounding of correctly rounded double to float gives correctly rounded float, unless double
+    // is exactly the midpoint between two floats. Subnormal, zero and infinite results of non-zero
+    // input are left to glibc, since they set errno = ERANGE
+    double  value;
+    char*   value_end;
+    if(( is_default_environment() )&&( scan_exact( str, &value_end, &value ) ))
+    {
+        uint64_t  bits = 0;
+        memcpy( &bits, &value, sizeof(bits) );
+        float  result = (float)( value );
+        float  magnitude = fabsf( result );
+        if(( (bits & 0x1FFFFFFFULL) != 0x10000000ULL )&&
+           (( value == 0.0 )||(( magnitude >= FLT_MIN )&&( magnitude <= FLT_MAX ))))
+        {
+            if( str_end )
+                *str_end = value_end;
+            return  result;
+        }
+    }
+    return  ((strtof_function) get_real_function( REAL_STRTOF ))( str, str_end );
+}
+
+double  atof( const char*  str )
+{
+    return  strtod( str, NULL );
+}
+
+int  vsnprintf( char*  str, size_t  size, const char*  format, va_list  args )
+{
+    va_list  args_copy;
+    va_copy( args_copy, args );
+    int  n = format_exact( str, size, format, args_copy );
+    va_end( args_copy );
+    if( n >= 0 )
+        return  n;
+    return  ((vsnprintf_function) get_real_function( REAL_VSNPRINTF ))( str, size, format, args );
+}
+
+int  snprintf( char*  str, size_t  size, const char*  format, ... )
+{
+    va_list  args;
+    va_start( args, format );
+    int  n = vsnprintf( str, size, format, args );
+    va_end( args );
+    return  n;
+}
+
+int  vsprintf( char*  str, const char*  format, va_list  args )
+{
+    va_list  args_copy;
+    va_copy( args_copy, args );
+    int  n = format_exact( str, SIZE_MAX, format, args_copy );
+    va_end( args_copy );
+    if( n >= 0 )
+        return  n;
+    return  ((vsprintf_function) get_real_function( REAL_VSPRINTF ))( str, format, args );
+}
+
+int  sprintf( char*  str, const char*  format, ... )
+{
+    va_list  args;
+    va_start( args, format );
+    int  n = vsprintf( str, format, args );
+    va_end( args );
+    return  n;
+}
+
+// _FORTIFY_SOURCE variants: overflow of destination object (of slen bytes) is left to glibc,
+// which aborts the program
+
+int  __vsnprintf_chk( char*  str, size_t  maxlen, int  flag, size_t  slen, const char*  format, va_list  args )
+{
+    if( maxlen <= slen )
+    {
+        va_list  args_copy;
+        va_copy( args_copy, args );
+        int  n = format_exact( str, maxlen, format, args_copy );
+        va_end( args_copy );
+        if( n >= 0 )
+            return  n;
+    }
+    return  ((vsnprintf_chk_function) get_real_function( REAL_VSNPRINTF_CHK ))( str, maxlen, flag, slen, format, args );
+}
+
+int  __snprintf_chk( char*  str, size_t  maxlen, int  flag, size_t  slen, const char*  format, ... )
+{
+    va_list  args;
+    va_start( args, format );
+    int  n = __vsnprintf_chk( str, maxlen, flag, slen, format, args );
+    va_end( args );
+    return  n;
+}
+
+int  __vsprintf_chk( char*  str, int  flag, size_t  slen, const char*  format, va_list  args )
+{
+    va_list  args_copy;
+    va_copy( args_copy, args );
+    int  n = format_exact( str, slen, format, args_copy );
+    va_end( args_copy );
+    if(( n >= 0 )&&( (size_t)( n ) < slen ))
+        return  n;
+    return  ((vsprintf_chk_function) get_real_function( REAL_VSPRINTF_CHK ))( str, flag, slen, format, args );
+}
+
+int  __sprintf_chk( char*  str, int  flag, size_t  slen, const char*  format, ... )
+{
+    va_list  args;
+    va_start( args, format );
+    int  n = __vsprintf_chk( str, flag, slen, format, args );
+    va_end( args );
+    return  n;
+}
@@ -0,0 +1,146 @@
+/*
+ *  printf(3) handlers of glibc which print floating-point values with dconvstr
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE      // for register_printf_specifier()
+#endif
+
+#include "dconvstr_printf.h"
+#include "dconvstr.h"
+
+#include <stdio.h>
+#include <locale.h>
+#include <math.h>
+
+#ifdef __GLIBC__
+#  include <printf.h>
+#endif
+
+// Handler prints value into buffer on stack; larger output is left to glibc
+#define PRINTF_BUFFER_SIZE  512
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+#ifdef __GLIBC__
+/**
+ *
+ *  Describe argument of conversion to glibc: one double or long double
+ *
+ */
+static int  dconvstr_printf_arginfo(
+    const struct printf_info*  info,
+    size_t                     n,
+    int*                       argtypes,
+    int*                       size
+)
+{
+    (void) size;
+    if( n > 0 )
+        argtypes[0] = PA_DOUBLE | ( info->is_long_double ? PA_FLAG_LONG_DOUBLE : 0 );
+    return  1;
+}
+
+/**
+ *
+ *  Print double argument of conversion with dconvstr_print()
+ *
+ *  Returns number of written characters, -1 on output error,
+ *  or -2 if conversion is left to glibc
+ *
+ */
+static int  dconvstr_printf_handler(
+    FILE*                      stream,
+    const struct printf_info*  info,
+    const void* const*         args
+)
+{
+    // 1. Leave unsupported conversions to glibc; dconvstr_print() doesn't print sign and padding
+    //    of infinity and NaN like printf(3) does, so they are left to glibc too
+    if( info->is_long_double || info->group || info->i18n || info->wide )
+        return  -2;
+    double  value = *(const double*)( args[0] );
+    if(! isfinite( value ) )
+        return  -2;
+    const char*  decimal_point = localeconv()->decimal_point;
+    if(( decimal_point[0] != '.' )||( decimal_point[1] != 0 ))
+        return  -2;
+
+    // 2. Translate printf_info to arguments of dconvstr_print()
+    unsigned int  flags = 0;
+    if( info->width > 0 )
+        flags |= DCONVSTR_FLAG_HAVE_WIDTH;
+    if( info->left )
+        flags |= DCONVSTR_FLAG_LEFT_JUSTIFY;
+    if( info->alt )
+        flags |= DCONVSTR_FLAG_SHARP;
+    if( info->showsign )
+        flags |= DCONVSTR_FLAG_PRINT_PLUS;
+    if( info->space )
+        flags |= DCONVSTR_FLAG_SPACE_IF_PLUS;
+    if( info->pad == '0' )
+        flags |= DCONVSTR_FLAG_PAD_WITH_ZERO;
+    if(( info->spec >= 'A' )&&( info->spec <= 'Z' ))
+        flags |= DCONVSTR_FLAG_UPPERCASE;
+    int  precision = ( (info->prec < 0) ? DCONVSTR_DEFAULT_PRECISION : info->prec );
+
+    // 3. Print value to buffer and write it to stream
+    char   buf[PRINTF_BUFFER_SIZE];
+    char*  buf_end  = buf;
+    int    buf_size = sizeof(buf);
+    if(! dconvstr_print( &buf_end, &buf_size, value, info->spec | 0x20, flags,
+                         info->width, precision ) )
+        return  -2;
+    size_t  n = (size_t)( buf_end - buf );
+    if( fwrite( buf, 1, n, stream ) != n )
+        return  -1;
+    return  (int)( n );
+}
+#endif
+
+/**
+ *
+ *  Install printf(3) handlers of floating-point conversions
+ *
+ */
+int  dconvstr_register_printf_handlers( void )
+{
+#ifdef __GLIBC__
+    static const char  specs[] = "eEfFgG";
+    for( const char*  spec = specs; *spec; ++spec )
+    {
+        if( 0 != register_printf_specifier( *spec, dconvstr_printf_handler, dconvstr_printf_arginfo ) )
+            return  0;
+    }
+    return  1;
+#else
+    return  0;
+#endif
+}
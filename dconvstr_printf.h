@@ -0,0 +1,61 @@
+/*
+ *  printf(3) handlers of glibc which print floating-point values with dconvstr
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DCONVSTR_PRINTF_H
+#define DCONVSTR_PRINTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *
+ *  Install handlers of %e, %E, %f, %F, %g and %G conversions of printf(3) family in glibc,
+ *  so that double arguments are printed with dconvstr_print()
+ *
+ *  @returns  1  if handlers were installed.
+ *            0  if C runtime library is not glibc, or register_printf_specifier(3) failed.
+ *
+ *  Handlers are process-wide and cannot be uninstalled. Install them at startup, before other
+ *  threads call printf(3) functions. Flags '-', '+', ' ', '#' and '0', width and precision
+ *  (including ones given by '*' argument) are passed to dconvstr_print(). Conversions with 'L'
+ *  modifier (long double), with apostrophe or I flags, to wide streams, of infinity and NaN, with locale
+ *  whose decimal point is not '.', or with width or precision which don't fit into internal buffer
+ *  are left to glibc.
+ *
+ *  Output differs from glibc in digits beyond the 19th significant digit (dconvstr prints zeros)
+ *  and in rounding of exact ties (dconvstr rounds half up, glibc rounds half to even).
+ *
+ */
+int  dconvstr_register_printf_handlers( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DCONVSTR_PRINTF_H
@@ -0,0 +1,762 @@
+/*
+ *  Generator of precomputed tables for bijective, heapless and bignumless conversion
+ *  of IEEE 754 double to string and vice versa
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  This program computes tables powers_of_ten_[] and powers_of_two_[] from exact big integer
+//  arithmetic, verifies every entry by independent computation and prints them as C source.
+//  Output of the program without options is identical to the tables built into dconvstr.c.
+//
+//  Usage: dconvstr_tablegen [--bits=64|128|192] [--ten=MIN:MAX] [--two=MIN:MAX] [--step=N]
+//                               [--only=ten|two] [--suffix=NAME] [--constexpr]  > tables.inc
+//
+//    --bits    width of table mantissas in bits (default 64)
+//    --ten     range of decimal exponents in table of powers of ten (default -344:293)
+//    --two     range of binary exponents in table of powers of two (default -1140:963)
+//    --step    emit only every N-th exponent of the range, starting from MIN (default 1)
+//    --only    emit only one of two tables
+//    --suffix  name tables powers_of_ten_NAME_[] and powers_of_two_NAME_[] and omit struct
+//              definitions, so generated tables can be added next to existing ones
+//    --constexpr  declare tables as C++ constexpr arrays instead of static const ones
+//
+//  Tables with 64-bit mantissas can replace built-in tables of dconvstr.c by compiling it with
+//  -DDCONVSTR_TABLES_FILE='"tables.inc"'. Tables with 128-bit and 192-bit mantissas use separate
+//  structure types (struct power_of_ten_128, struct power_of_two_192 and so on) with mantissa
+//  split in 64-bit parts: high and low, or high, middle and low.
+//  Output with --constexpr option is dconvstr_constexpr_tables.inc, used by dconvstr_constexpr.hpp.
+//
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#ifndef _MSC_VER
+#  include <stdint.h>
+#else
+   typedef __int32           int32_t;
+   typedef unsigned __int32  uint32_t;
+   typedef unsigned __int64  uint64_t;
+#endif
+
+
+//=====================================================================================================
+//
+// TYPES AND CONSTANTS
+//
+
+// Capacity of big integers: 640 limbs of 32 bits cover 10^5000 * 2^256 with margin,
+// which is enough for tables covering IEEE 754 quadruple precision.
+#define BIGNUM_LIMBS  640
+
+// Unsigned big integer, least significant limb first
+struct  bignum
+{
+    int       nlimbs;                  // number of used limbs, limb[nlimbs-1] != 0 unless zero
+    uint32_t  limb[BIGNUM_LIMBS];
+};
+
+// Table entry computed by generator: 10^decimal_exponent ~= mantissa * 2^binary_exponent
+// or 2^binary_exponent ~= mantissa * 2^(-bits) * 10^decimal_exponent.
+// Mantissa is kept as three 64-bit parts, least significant first; unused parts are zero.
+struct  table_entry
+{
+    int32_t   decimal_exponent;
+    int32_t   binary_exponent;
+    uint64_t  mantissa[3];
+};
+
+//=====================================================================================================
+//
+// FUNCTIONS: BIG INTEGER ARITHMETIC
+//
+
+/**
+ *
+ *  Report fatal error and terminate the program
+ *
+ */
+static void  fatal( const char*  message, int  exponent )
+{
+    fprintf( stderr, "dconvstr_tablegen: %s (exponent %d)\n", message, exponent );
+    exit(-1);
+}
+
+/**
+ *
+ *  Drop most significant zero limbs
+ *
+ */
+static void  bignum_trim( struct bignum*  a )
+{
+    while(( a->nlimbs > 0 )&&( a->limb[a->nlimbs - 1] == 0 ))
+        --(a->nlimbs);
+}
+
+/**
+ *
+ *  a = value
+ *
+ */
+static void  bignum_set_uint64( struct bignum*  a, uint64_t  value )
+{
+    a->limb[0] = ((uint32_t)( value       ));
+    a->limb[1] = ((uint32_t)( value >> 32 ));
+    a->nlimbs  = 2;
+    bignum_trim( a );
+}
+
+/**
+ *
+ *  a = a * m, where m is small multiplier
+ *
+ */
+static void  bignum_mul_small( struct bignum*  a, uint32_t  m )
+{
+    uint64_t  carry = 0;
+    for( int  i = 0; i < a->nlimbs; ++i )
+    {
+        uint64_t  t = ((uint64_t)( a->limb[i] )) * m + carry;
+        a->limb[i] = ((uint32_t)( t ));
+        carry      = t >> 32;
+    }
+    if( carry != 0 )
+    {
+        if( a->nlimbs >= BIGNUM_LIMBS )
+            fatal( "big integer overflow", 0 );
+        a->limb[(a->nlimbs)++] = ((uint32_t)( carry ));
+    }
+}
+
+/**
+ *
+ *  a = a * 2^n
+ *
+ */
+static void  bignum_shift_left( struct bignum*  a, int  n )
+{
+    if( a->nlimbs == 0 )
+        return;
+    int  limb_shift = n / 32;
+    int  bit_shift  = n % 32;
+    if( a->nlimbs + limb_shift + 1 > BIGNUM_LIMBS )
+        fatal( "big integer overflow", n );
+    a->limb[a->nlimbs + limb_shift] = 0;
+    for( int  i = a->nlimbs - 1; i >= 0; --i )
+    {
+        uint64_t  t = ((uint64_t)( a->limb[i] )) << bit_shift;
+        a->limb[i + limb_shift + 1] |= ((uint32_t)( t >> 32 ));
+        a->limb[i + limb_shift]      = ((uint32_t)( t       ));
+    }
+    for( int  i = 0; i < limb_shift; ++i )
+        a->limb[i] = 0;
+    a->nlimbs += limb_shift + 1;
+    bignum_trim( a );
+}
+
+/**
+ *
+ *  a = 10^n * 2^k
+ *
+ */
+static void  bignum_set_power( struct bignum*  a, int  n, int  k )
+{
+    bignum_set_uint64( a, 1 );
+    for( ; n >= 9; n -= 9 )
+        bignum_mul_small( a, 1000000000U );
+    for( ; n > 0; --n )
+        bignum_mul_small( a, 10U );
+    bignum_shift_left( a, k );
+}
+
+/**
+ *
+ *  a = a * b
+ *
+ */
+static void  bignum_mul( struct bignum*  a, const struct bignum*  b )
+{
+    static struct bignum  product;
+    if( a->nlimbs + b->nlimbs > BIGNUM_LIMBS )
+        fatal( "big integer overflow", 0 );
+    memset( product.limb, 0, sizeof(uint32_t) * (a->nlimbs + b->nlimbs) );
+    for( int  i = 0; i < a->nlimbs; ++i )
+    {
+        uint64_t  carry = 0;
+        for( int  j = 0; j < b->nlimbs; ++j )
+        {
+            uint64_t  t = ((uint64_t)( a->limb[i] )) * b->limb[j] + product.limb[i + j] + carry;
+            product.limb[i + j] = ((uint32_t)( t ));
+            carry               = t >> 32;
+        }
+        product.limb[i + b->nlimbs] = ((uint32_t)( carry ));
+    }
+    product.nlimbs = a->nlimbs + b->nlimbs;
+    bignum_trim( &product );
+    memcpy( a, &product, sizeof(product) );
+}
+
+/**
+ *
+ *  Compare a with (b * 2^k)
+ *
+ *  @returns  -1, 0 or 1 if a is less than, equal to or greater than b * 2^k
+ *
+ */
+static int  bignum_compare_shifted( const struct bignum*  a, const struct bignum*  b, int  k )
+{
+    int  limb_shift = k / 32;
+    int  bit_shift  = k % 32;
+    int  n = b->nlimbs + limb_shift + 1;
+    if( n < a->nlimbs )
+        n = a->nlimbs;
+    for( int  i = n - 1; i >= 0; --i )
+    {
+        uint32_t  x = (i < a->nlimbs) ? a->limb[i] : 0;
+        uint32_t  y = 0;
+        int  j = i - limb_shift;
+        if(( j >= 0 )&&( j < b->nlimbs ))
+            y |= ((uint32_t)( ((uint64_t)( b->limb[j] )) << bit_shift ));
+        if(( bit_shift != 0 )&&( j - 1 >= 0 )&&( j - 1 < b->nlimbs ))
+            y |= b->limb[j - 1] >> (32 - bit_shift);
+        if( x != y )
+            return  (x < y) ? -1 : 1;
+    }
+    return  0;
+}
+
+/**
+ *
+ *  a = a - b * 2^k, where a >= b * 2^k
+ *
+ */
+static void  bignum_sub_shifted( struct bignum*  a, const struct bignum*  b, int  k )
+{
+    int  limb_shift = k / 32;
+    int  bit_shift  = k % 32;
+    int64_t  borrow = 0;
+    for( int  i = limb_shift; i < a->nlimbs; ++i )
+    {
+        uint32_t  y = 0;
+        int  j = i - limb_shift;
+        if( j < b->nlimbs )
+            y |= ((uint32_t)( ((uint64_t)( b->limb[j] )) << bit_shift ));
+        if(( bit_shift != 0 )&&( j - 1 >= 0 )&&( j - 1 < b->nlimbs ))
+            y |= b->limb[j - 1] >> (32 - bit_shift);
+        int64_t  t = ((int64_t)( a->limb[i] )) - y - borrow;
+        borrow     = (t < 0);
+        a->limb[i] = ((uint32_t)( t + (borrow << 32) ));
+    }
+    bignum_trim( a );
+}
+
+/**
+ *
+ *  Divide a by b and round quotient to nearest integer, halfway cases are rounded up
+ *
+ *  Quotient must be less than 2^(max_bits+1). On exit, a is destroyed.
+ *
+ */
+static void  bignum_divide_and_round(
+    struct bignum*        a,
+    const struct bignum*  b,
+    int                   max_bits,
+    struct bignum*        quotient
+)
+{
+    memset( quotient->limb, 0, sizeof(quotient->limb) );
+    quotient->nlimbs = max_bits / 32 + 2;
+    for( int  k = max_bits; k >= 0; --k )
+    {
+        if( bignum_compare_shifted( a, b, k ) >= 0 )
+        {
+            bignum_sub_shifted( a, b, k );
+            quotient->limb[k / 32] |= (1U << (k % 32));
+        }
+    }
+    bignum_trim( quotient );
+
+    // remainder is left in a: round up if 2 * remainder >= b
+    bignum_shift_left( a, 1 );
+    if( bignum_compare_shifted( a, b, 0 ) >= 0 )
+    {
+        for( int  i = 0; ; ++i )
+        {
+            if( i == quotient->nlimbs )
+                quotient->limb[(quotient->nlimbs)++] = 0;
+            if( ++(quotient->limb[i]) != 0 )
+                break;
+        }
+    }
+}
+
+/**
+ *
+ *  Number of significant bits in big integer
+ *
+ */
+static int  bignum_bit_length( const struct bignum*  a )
+{
+    if( a->nlimbs == 0 )
+        return  0;
+    int  n = 32 * (a->nlimbs - 1);
+    for( uint32_t  top = a->limb[a->nlimbs - 1]; top != 0; top >>= 1 )
+        ++n;
+    return  n;
+}
+
+/**
+ *
+ *  Extract 192 least significant bits of big integer as three 64-bit parts, least significant first
+ *
+ */
+static void  bignum_get_uint192( const struct bignum*  a, uint64_t*  m )
+{
+    uint32_t  w[6] = { 0, 0, 0, 0, 0, 0 };
+    for( int  i = 0; (i < 6)&&(i < a->nlimbs); ++i )
+        w[i] = a->limb[i];
+    for( int  i = 0; i < 3; ++i )
+        m[i] = (((uint64_t)( w[2 * i + 1] )) << 32) | w[2 * i];
+}
+
+/**
+ *
+ *  Convert 192-bit mantissa (three 64-bit parts, least significant first) to big integer
+ *
+ */
+static void  bignum_set_uint192( struct bignum*  a, const uint64_t*  m )
+{
+    for( int  i = 0; i < 3; ++i )
+    {
+        a->limb[2 * i]     = ((uint32_t)( m[i]       ));
+        a->limb[2 * i + 1] = ((uint32_t)( m[i] >> 32 ));
+    }
+    a->nlimbs = 6;
+    bignum_trim( a );
+}
+
+//=====================================================================================================
+//
+// FUNCTIONS: TABLE COMPUTATION
+//
+
+/**
+ *
+ *  Compute 10^d ~= mantissa * 2^binary_exponent, where 2^(bits-1) <= mantissa < 2^bits
+ *
+ */
+static void  compute_power_of_ten( int32_t  d, int  bits, struct table_entry*  entry )
+{
+    static struct bignum  num, den, q;
+
+    // 1. Represent 10^d as fraction num/den and find binary exponent e such that
+    //    (num/den) * 2^(-e) lies in range [2^(bits-1), 2^bits]
+    if( d >= 0 )
+    {
+        bignum_set_power( &num, d, 0 );
+        int  e = bignum_bit_length( &num ) - bits;
+        bignum_set_power( &den, 0, 0 );
+        if( e < 0 )
+            bignum_shift_left( &num, -e );
+        else
+            bignum_shift_left( &den, e );
+        entry->binary_exponent = e;
+    }
+    else
+    {
+        bignum_set_power( &den, -d, 0 );
+        int  s = bignum_bit_length( &den ) + bits - 1;
+        bignum_set_power( &num, 0, s );
+        entry->binary_exponent = -s;
+    }
+    entry->decimal_exponent = d;
+
+    // 2. Round quotient to nearest integer and handle carry out of the most significant bit
+    bignum_divide_and_round( &num, &den, bits, &q );
+    if( bignum_bit_length( &q ) > bits )
+    {
+        bignum_set_power( &q, 0, bits - 1 );
+        ++(entry->binary_exponent);
+    }
+    bignum_get_uint192( &q, entry->mantissa );
+}
+
+/**
+ *
+ *  Compute 2^b ~= (mantissa / 2^bits) * 10^decimal_exponent, where 0.1 <= mantissa / 2^bits < 1
+ *
+ */
+static void  compute_power_of_two( int32_t  b, int  bits, struct table_entry*  entry )
+{
+    static struct bignum  num, den, q, limit;
+
+    // 1. Initial guess of decimal exponent: 10^(d-1) <= 2^b < 10^d, with log10(2) ~= 0.30103
+    int32_t  d = ((int32_t)( (b >= 0) ? (b * 30103LL) / 100000 : -((-b * 30103LL + 99999) / 100000) )) + 1;
+
+    // 2. Compute (2^b / 10^d) * 2^bits, then adjust d until result falls into range [0.1, 1) * 2^bits
+    bignum_set_power( &limit, 0, bits );
+    for( int  attempt = 0; ; ++attempt )
+    {
+        if( attempt > 4 )
+            fatal( "can't find decimal exponent", b );
+
+        int  k = b + bits;
+        bignum_set_power( &num, (d < 0) ? -d : 0, (k > 0) ? k : 0 );
+        bignum_set_power( &den, (d > 0) ? d : 0, (k < 0) ? -k : 0 );
+        bignum_divide_and_round( &num, &den, bits + 4, &q );
+
+        if( bignum_compare_shifted( &q, &limit, 0 ) >= 0 )
+            ++d;
+        else
+        {
+            struct bignum  q10;
+            memcpy( &q10, &q, sizeof(q) );
+            bignum_mul_small( &q10, 10U );
+            if( bignum_compare_shifted( &q10, &limit, 0 ) < 0 )
+                --d;
+            else
+                break;
+        }
+    }
+    entry->binary_exponent  = b;
+    entry->decimal_exponent = d;
+    bignum_get_uint192( &q, entry->mantissa );
+}
+
+/**
+ *
+ *  Verify entry of table of powers of ten by independent computation:
+ *  mantissa is normalized and |mantissa * 2^e - 10^d| <= 2^e / 2
+ *
+ */
+static void  verify_power_of_ten( const struct table_entry*  entry, int  bits )
+{
+    static struct bignum  a, b, c, m;
+    int32_t  d = entry->decimal_exponent;
+    int32_t  e = entry->binary_exponent;
+
+    // 1. Check range of mantissa
+    bignum_set_uint192( &m, entry->mantissa );
+    if( bignum_bit_length( &m ) != bits )
+        fatal( "verification failed: mantissa is not normalized", d );
+
+    // 2. Scale all terms by 2^max(-e,0) * 10^max(-d,0), so they all become integers:
+    //    a = mantissa * 2^e, b = 10^d, c = 2^e
+    bignum_set_power( &a, (d < 0) ? -d : 0, (e > 0) ? e : 0 );
+    bignum_mul( &a, &m );
+    bignum_set_power( &b, (d > 0) ? d : 0, (e < 0) ? -e : 0 );
+    bignum_set_power( &c, (d < 0) ? -d : 0, (e > 0) ? e : 0 );
+
+    // 3. Check 2 * |a - b| <= c
+    if( bignum_compare_shifted( &a, &b, 0 ) >= 0 )
+        bignum_sub_shifted( &a, &b, 0 );
+    else
+    {
+        bignum_sub_shifted( &b, &a, 0 );
+        memcpy( &a, &b, sizeof(b) );
+    }
+    bignum_shift_left( &a, 1 );
+    if( bignum_compare_shifted( &a, &c, 0 ) > 0 )
+        fatal( "verification failed: mantissa is not rounded to nearest", d );
+}
+
+/**
+ *
+ *  Verify entry of table of powers of two by independent computation:
+ *  0.1 <= mantissa / 2^bits < 1 and |(mantissa / 2^bits) * 10^d - 2^b| <= (10^d / 2^bits) / 2
+ *
+ */
+static void  verify_power_of_two( const struct table_entry*  entry, int  bits )
+{
+    static struct bignum  a, b, c, m, m10;
+    int32_t  d  = entry->decimal_exponent;
+    int32_t  bb = entry->binary_exponent;
+
+    // 1. Check range of mantissa
+    bignum_set_uint192( &m, entry->mantissa );
+    memcpy( &m10, &m, sizeof(m) );
+    bignum_mul_small( &m10, 10U );
+    bignum_set_power( &c, 0, bits );
+    if(( bignum_bit_length( &m ) > bits )||( bignum_compare_shifted( &m10, &c, 0 ) < 0 ))
+        fatal( "verification failed: mantissa is out of range", bb );
+
+    // 2. Scale all terms by 2^(bits + max(-bb,0)) * 10^max(-d,0), so they all become integers:
+    //    a = mantissa * 2^(-bits) * 10^d, b = 2^bb, c = 2^(-bits) * 10^d
+    bignum_set_power( &a, (d > 0) ? d : 0, (bb < 0) ? -bb : 0 );
+    bignum_mul( &a, &m );
+    bignum_set_power( &b, (d < 0) ? -d : 0, bits + ((bb > 0) ? bb : 0) );
+    bignum_set_power( &c, (d > 0) ? d : 0, (bb < 0) ? -bb : 0 );
+
+    // 3. Check 2 * |a - b| <= c
+    if( bignum_compare_shifted( &a, &b, 0 ) >= 0 )
+        bignum_sub_shifted( &a, &b, 0 );
+    else
+    {
+        bignum_sub_shifted( &b, &a, 0 );
+        memcpy( &a, &b, sizeof(b) );
+    }
+    bignum_shift_left( &a, 1 );
+    if( bignum_compare_shifted( &a, &c, 0 ) > 0 )
+        fatal( "verification failed: mantissa is not rounded to nearest", bb );
+}
+
+//=====================================================================================================
+//
+// FUNCTIONS: OUTPUT
+//
+
+/**
+ *
+ *  Number of characters needed to print integer in decimal
+ *
+ */
+static int  decimal_width( int32_t  n )
+{
+    char  buffer[16];
+    return  snprintf( buffer, sizeof(buffer), "%d", ((int)( n )) );
+}
+
+/**
+ *
+ *  Print comment line describing range of table exponents
+ *
+ */
+static void  print_range_comment( int  is_power_of_ten, int32_t  range_min, int32_t  range_max, int32_t  step )
+{
+    printf( "// Covers range of %s exponents from %d to %d", is_power_of_ten ? "decimal" : "binary",
+            (int)range_min, (int)range_max );
+    if( step > 1 )
+        printf( " with step %d", (int)step );
+    printf( ".\n" );
+}
+
+/**
+ *
+ *  Compute, verify and print one table
+ *
+ */
+static void  emit_table(
+    int          is_power_of_ten,
+    int32_t      range_min,
+    int32_t      range_max,
+    int32_t      step,
+    int          bits,
+    const char*  suffix,
+    int          is_constexpr
+)
+{
+    // 1. Compute and verify all entries
+    int  n = (range_max - range_min) / step + 1;
+    struct table_entry*  entries = ((struct table_entry*)( calloc( n, sizeof(struct table_entry) ) ));
+    if( entries == NULL )
+        fatal( "out of memory", 0 );
+    int  width_decimal = 1, width_binary = 1;
+    for( int  i = 0; i < n; ++i )
+    {
+        if( is_power_of_ten )
+        {
+            compute_power_of_ten( range_min + i * step, bits, entries + i );
+            verify_power_of_ten( entries + i, bits );
+        }
+        else
+        {
+            compute_power_of_two( range_min + i * step, bits, entries + i );
+            verify_power_of_two( entries + i, bits );
+        }
+        if( width_decimal < decimal_width( entries[i].decimal_exponent ) )
+            width_decimal = decimal_width( entries[i].decimal_exponent );
+        if( width_binary < decimal_width( entries[i].binary_exponent ) )
+            width_binary = decimal_width( entries[i].binary_exponent );
+    }
+
+    // 2. Print comment and structure definition
+    const char*  name_suffix = (bits == 192) ? "_192" : ((bits == 128) ? "_128" : "");
+    const char*  kind        = is_power_of_ten ? "ten" : "two";
+    if( is_power_of_ten )
+        printf( "// Table: powers of ten in binary representation.\n"
+                "// 10^decimal_exponent ~= binary_mantissa * 2^binary_exponent.\n"
+                "// 2^%d < binary_mantissa < 2^%d, mantissa has been rounded to nearest integer.\n",
+                bits - 1, bits );
+    else
+        printf( "// Table: powers of two in binary representation.\n"
+                "// 2^binary_exponent ~= decimal_mantissa * 10^decimal_exponent.\n"
+                "// 0.1 < decimal_mantissa < 1, mantissa was premultiplied by 2^%d and rounded to nearest integer.\n",
+                bits );
+    if( suffix == NULL )
+    {
+        if(( range_min == (is_power_of_ten ? -344 : -1140) )&&( range_max == (is_power_of_ten ? 293 : 963) )&&( step == 1 ))
+            printf( "// Covers entire range of IEEE 754 double, including denormals, plus small spare.\n" );
+        else
+            print_range_comment( is_power_of_ten, range_min, range_min + (n - 1) * step, step );
+
+        const char*  field_1 = is_power_of_ten ? "decimal_exponent" : "binary_exponent";
+        const char*  field_2 = is_power_of_ten ? "binary_exponent"  : "decimal_exponent";
+        const char*  field_m = is_power_of_ten ? "binary_mantissa"  : "decimal_mantissa";
+        printf( "struct  power_of_%s%s\n{\n    int32_t   %s;\n    int32_t   %s;\n", kind, name_suffix, field_1, field_2 );
+        if( bits == 192 )
+            printf( "    uint64_t  %s_high;\n    uint64_t  %s_middle;\n    uint64_t  %s_low;\n", field_m, field_m, field_m );
+        else if( bits == 128 )
+            printf( "    uint64_t  %s_high;\n    uint64_t  %s_low;\n", field_m, field_m );
+        else
+            printf( "    uint64_t  %s;\n", field_m );
+        printf( "};\n" );
+    }
+    else
+        print_range_comment( is_power_of_ten, range_min, range_min + (n - 1) * step, step );
+
+    // 3. Print table
+    const char*  qualifiers = is_constexpr ? "constexpr" : "static const";
+    if( suffix == NULL )
+        printf( "%s struct power_of_%s%s  powers_of_%s%s_[] = {\n", qualifiers, kind, name_suffix, kind, name_suffix );
+    else
+        printf( "%s struct power_of_%s%s  powers_of_%s_%s%s_[] = {\n", qualifiers, kind, name_suffix, kind, suffix, name_suffix );
+    int  w1 = is_power_of_ten ? width_decimal : width_binary;
+    int  w2 = is_power_of_ten ? width_binary  : width_decimal;
+    for( int  i = 0; i < n; ++i )
+    {
+        int32_t  f1 = is_power_of_ten ? entries[i].decimal_exponent : entries[i].binary_exponent;
+        int32_t  f2 = is_power_of_ten ? entries[i].binary_exponent  : entries[i].decimal_exponent;
+        if( bits == 192 )
+        {
+            printf( "    { %*d, %*d,  0x%016llXULL, 0x%016llXULL, 0x%016llXULL }%s\n", w1, (int)f1, w2, (int)f2,
+                    (unsigned long long)entries[i].mantissa[2],
+                    (unsigned long long)entries[i].mantissa[1],
+                    (unsigned long long)entries[i].mantissa[0],
+                    (i + 1 < n) ? "," : "" );
+        }
+        else if( bits == 128 )
+        {
+            printf( "    { %*d, %*d,  0x%016llXULL, 0x%016llXULL }%s\n", w1, (int)f1, w2, (int)f2,
+                    (unsigned long long)entries[i].mantissa[1],
+                    (unsigned long long)entries[i].mantissa[0],
+                    (i + 1 < n) ? "," : "" );
+        }
+        else
+        {
+            // two entries per line, like in dconvstr.c
+            printf( "    { %*d, %*d,  %20lluULL }%s",
+                    w1, (int)f1, w2, (int)f2,
+                    (unsigned long long)entries[i].mantissa[0],
+                    (i + 1 == n) ? "\n" : ((i % 2 == 1) ? ",\n" : ",") );
+        }
+    }
+    printf( "};\n" );
+    free( entries );
+}
+
+/**
+ *
+ *  Parse range argument like "-344:293"
+ *
+ *  @returns  1  if parsed normally
+ *            0  if there were syntax errors
+ *
+ */
+static int  parse_range( const char*  str, int32_t*  range_min, int32_t*  range_max )
+{
+    char*  end = NULL;
+    long  a = strtol( str, &end, 10 );
+    if(( end == str )||( *end != ':' ))
+        return  0;
+    const char*  str2 = end + 1;
+    long  b = strtol( str2, &end, 10 );
+    if(( end == str2 )||( *end != 0 )||( a > b )||( a < -20000 )||( b > 20000 ))
+        return  0;
+    *range_min = ((int32_t)( a ));
+    *range_max = ((int32_t)( b ));
+    return  1;
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main( int  argc, const char* const*  argv )
+{
+    // 1. Parse command line
+    int          bits      = 64;
+    int32_t      ten_min   = -344,  ten_max = 293;
+    int32_t      two_min   = -1140, two_max = 963;
+    int32_t      step      = 1;
+    int          emit_ten  = 1,     emit_two = 1;
+    const char*  suffix    = NULL;
+    int          is_constexpr = 0;
+    for( int  i = 1; i < argc; ++i )
+    {
+        const char*  arg = argv[i];
+        int  ok = 0;
+        if( strncmp( arg, "--bits=", 7 ) == 0 )
+        {
+            bits = atoi( arg + 7 );
+            ok = (( bits == 64 )||( bits == 128 )||( bits == 192 ));
+        }
+        else if( strncmp( arg, "--ten=", 6 ) == 0 )
+            ok = parse_range( arg + 6, &ten_min, &ten_max );
+        else if( strncmp( arg, "--two=", 6 ) == 0 )
+            ok = parse_range( arg + 6, &two_min, &two_max );
+        else if( strncmp( arg, "--step=", 7 ) == 0 )
+        {
+            step = atoi( arg + 7 );
+            ok = (( step >= 1 )&&( step <= 1000 ));
+        }
+        else if( strcmp( arg, "--only=ten" ) == 0 )
+        {
+            emit_two = 0;
+            ok = emit_ten;
+        }
+        else if( strcmp( arg, "--only=two" ) == 0 )
+        {
+            emit_ten = 0;
+            ok = emit_two;
+        }
+        else if( strncmp( arg, "--suffix=", 9 ) == 0 )
+        {
+            suffix = arg + 9;
+            ok = ( *suffix != 0 );
+        }
+        else if( strcmp( arg, "--constexpr" ) == 0 )
+        {
+            is_constexpr = 1;
+            ok = 1;
+        }
+        if(! ok )
+        {
+            fprintf( stderr, "Usage: dconvstr_tablegen [--bits=64|128|192] [--ten=MIN:MAX] [--two=MIN:MAX] [--step=N]\n"
+                             "                             [--only=ten|two] [--suffix=NAME] [--constexpr]\n" );
+            exit(-1);
+        }
+    }
+
+    // 2. Compute, verify and print tables
+    if( emit_ten )
+        emit_table( 1, ten_min, ten_max, step, bits, suffix, is_constexpr );
+    if( emit_ten && emit_two )
+        printf( "\n" );
+    if( emit_two )
+        emit_table( 0, two_min, two_max, step, bits, suffix, is_constexpr );
+    return  0;
+}
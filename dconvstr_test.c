@@ -39,9 +39,26 @@
 #  define  strtoull              _strtoui64
 #  define  __DBL_DENORM_MIN__    ((double)4.94065645841246544177e-324L)
 #  define  __DBL_MAX__           ((double)1.79769313486231570815e+308L)
+#  define  __FLT_DENORM_MIN__    1.40129846432481707092e-45F
+#  define  __FLT_MIN__           1.17549435082228750797e-38F
+#  define  __FLT_MAX__           3.40282346638528859812e+38F
+   typedef unsigned __int32      uint32_t;
    typedef unsigned __int64      uint64_t;
 #endif
 
+#ifdef _MSC_VER
+#  define  THREAD_LOCAL          __declspec(thread)
+#else
+#  define  THREAD_LOCAL          __thread
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
 #if defined(_WIN32) || defined(_WIN64)       // not only for MSVC compiler, MinGW too
 #  define  UINT64_FORMAT_STRING  "%I64u"
 #else
@@ -58,7 +75,10 @@
 // CONSTANTS AND GLOBAL VARIABLES
 //
 
-static uint64_t  local_rng_state_ = 0;
+// Maximal number of test threads
+#define MAX_THREADS  1024
+
+static THREAD_LOCAL uint64_t  local_rng_state_ = 0;    // every thread of parallel test has its own
 
 //=====================================================================================================
 //
@@ -81,6 +101,31 @@ static inline uint64_t  local_rng_get_random_uint64()
     return  (a << 32) | b;
 }
 
+/**
+ *
+ *  Advance local RNG by n steps in O(log n) time
+ *
+ *  Composition of two steps of linear congruential generator is LCG too, so n steps are
+ *  composed of LCGs for 2^k steps by binary expansion of n.
+ *
+ */
+static void  local_rng_skip( uint64_t  n )
+{
+    uint64_t  step_mul = 6364136223846793005ULL, step_add = 1442695040888963407ULL;
+    uint64_t  total_mul = 1, total_add = 0;
+    for( ; n != 0; n >>= 1 )
+    {
+        if( n & 1 )
+        {
+            total_mul *= step_mul;
+            total_add  = total_add * step_mul + step_add;
+        }
+        step_add *= (step_mul + 1);
+        step_mul *= step_mul;
+    }
+    local_rng_state_ = total_mul * local_rng_state_ + total_add;
+}
+
 /**
  *
  *  Parse printf(3)-like format flags
@@ -297,269 +342,1499 @@ static void  single_static_test( const char*  fmt, const char*  str, double  val
 
 /**
  *
- *  Ensure string argument is not parseable
+ *  Execute single static test of single precision conversions
  *
  */
-static void  ensure_not_parseable( const char*  str )
+static void  single_static_test_float( const char*  fmt, const char*  str, float  val, int  flag_reverse_test )
 {
-    const char*  str_end          = str + strlen( str );
-    const char*  str_returned_end = NULL;
-    double       val              = 0.0;
-    int          erange_condition = 1;
-    int  dconvstr_scan_status = dconvstr_scan(
-        str, &str_returned_end, &val, &erange_condition
-    );
-    if(! dconvstr_scan_status )
+    // 1. Parse format string
+    int           format_char      = 0;
+    unsigned int  format_flags     = 0;
+    int           format_width     = 0;
+    int           format_precision = DCONVSTR_DEFAULT_PRECISION;
+    if(! parse_printf_format_flags( fmt, &format_char, &format_flags, &format_width, &format_precision ) )
     {
         fprintf(
             stderr,
-            "Unexpected internal error in non-parseability test\n"
-            "Test failed for str=%s\n", str
+            "Can't parse format string\n"
+            "Test failed for fmt=%s str=%s val=%.9g\n", fmt, str, val
         );
         exit(-1);
     }
-    if( str_returned_end == str_end )
+
+    // 2. Check conversion val -> str
+    char  alt_str[128];
+    memset( alt_str, 0, sizeof(alt_str) );
+    int  alt_str_size = sizeof(alt_str) - 1;
+    char*  alt_str_end = alt_str;
+    int  dconvstr_print_status = dconvstr_print_float(
+        &alt_str_end, &alt_str_size, val,
+        format_char, format_flags, format_width, format_precision
+    );
+    *alt_str_end = 0;
+    if(( !dconvstr_print_status )||( 0 != strcmp( str, alt_str ) ))
     {
         fprintf(
             stderr,
-            "Unexpected positive result in non-parseability test\n"
-            "Test failed for str=%s\n", str
+            "Formatting result not as expected:\n"
+            "    expected \"%s\",\n"
+            "    got      \"%s\"\n", str, alt_str
+        );
+        fprintf(
+            stderr,
+            "Test failed for fmt=%s str=%s val=%.9g\n", fmt, str, val
         );
         exit(-1);
     }
+
+    // 3. Check conversion str -> val
+    if( flag_reverse_test )
+    {
+        const char*  str_actual_end = NULL;
+        float  alt_val = 0.0f;
+        int  erange_condition = 1;
+        int  dconvstr_scan_status = dconvstr_scan_float(
+            str, &str_actual_end, &alt_val, &erange_condition
+        );
+        if(( !dconvstr_scan_status )||( erange_condition )||( str_actual_end != str + strlen( str ) )||
+           ( 0 != memcmp( &alt_val, &val, sizeof(float) ) ))
+        {
+            fprintf(
+                stderr,
+                "Scanning result not as expected:\n"
+                "    expected %.9e,\n"
+                "    got      %.9e\n", val, alt_val
+            );
+            fprintf(
+                stderr,
+                "Test failed for fmt=%s str=%s val=%.9g\n", fmt, str, val
+            );
+            exit(-1);
+        }
+    }
 }
 
 /**
  *
- *  Execute all static tests
+ *  Ensure string argument is converted to given single precision value with correct rounding
  *
  */
-static void  all_static_tests()
+static void  ensure_scanned_float( const char*  str, float  val )
 {
-    fprintf( stderr, "Running static tests...\n" );
-
-    single_static_test( "%17.17f",     "1.00000000000000000",            1.0, 1 );
-    single_static_test( "%17.17f",    "-1.00000000000000000",           -1.0, 1 );
-    single_static_test( "%17.17f",    "10.00000000000000000",           10.0, 1 );
-    single_static_test( "%17.17f",   "-10.00000000000000000",          -10.0, 1 );
-    single_static_test( "%17.17f",    "11.00000000000000000",           11.0, 1 );
-
-    single_static_test( "%+#22.15e",  "+7.894561230000000e+08",  789456123.0, 1 );
-    single_static_test( "%-#22.15e",   "7.894561230000000e+08 ", 789456123.0, 0 );
-    single_static_test( "%#22.15e",   " 7.894561230000000e+08",  789456123.0, 1 );
-    single_static_test( "%#1.1g",      "8.e+08",                 789456123.0, 0 );
-    single_static_test( "%.0f",        "1",                              0.6, 0 );
-    single_static_test( "%2.4e",       "8.6000e+00",                     8.6, 1 );
-    single_static_test( "%2.4g",       "8.6",                            8.6, 1 );
-    single_static_test( "%e",          "-inf",                     -HUGE_VAL, 1 );
-
-    single_static_test( "%e",          "1.234000e+01",                 12.34, 1 );
-    single_static_test( "%e",          "1.234000e-01",                0.1234, 1 );
-    single_static_test( "%e",          "1.234000e-03",              0.001234, 1 );
-    single_static_test( "%.60e",       "1.000000000000000000000000000000000000000000000000000000000000e+20",
-                                                               1e20, 1  );
-    single_static_test( "%e",          "1.000000e-01",                   0.1, 1 );
-    single_static_test( "%f",          "12.340000",                    12.34, 1 );
-    single_static_test( "%f",          "0.123400",                    0.1234, 1 );
-    single_static_test( "%f",          "0.001234",                  0.001234, 1 );
-    single_static_test( "%g",          "12.34",                        12.34, 1 );
-    single_static_test( "%g",          "0.1234",                      0.1234, 1 );
-    single_static_test( "%g",          "0.001234",                  0.001234, 1 );
-    single_static_test( "%.60g",       "100000000000000000000",         1e20, 1 );
-    single_static_test( "%f",          "0.000000",                       0.0, 1 );
-    single_static_test( "%f",          "-0.000000",                     -0.0, 1 );
-    single_static_test( "%g",          "0",                              0.0, 1 );
-    single_static_test( "%g",          "-0",                            -0.0, 1 );
-
-    single_static_test( "%6.5f",       "0.10000",       0.099999999860301614, 0 );
-    single_static_test( "%6.5f",       "0.10000",                         .1, 1 );
-    single_static_test( "%5.4f",       "0.5000",                          .5, 1 );
-    single_static_test( "%15.5e",   "   4.94066e-324",    __DBL_DENORM_MIN__, 0 );
-    single_static_test( "%15.5e",   "   1.79769e+308",           __DBL_MAX__, 0 );
-    single_static_test( "%e",          "1.234568e+06",             1234567.8, 0 );
-    single_static_test( "%f",          "1234567.800000",           1234567.8, 1 );
-    single_static_test( "%g",          "1.23457e+06",              1234567.8, 0 );
-    single_static_test( "%g",          "123.456",                    123.456, 1 );
-    single_static_test( "%g",          "1e+06",                    1000000.0, 1 );
-    single_static_test( "%g",          "10",                            10.0, 1 );
-    single_static_test( "%g",          "0.02",                          0.02, 1 );
-
-    ensure_not_parseable( "."        );
-    ensure_not_parseable( ".e"       );
-    ensure_not_parseable( ".e+"      );
-    ensure_not_parseable( ".e-"      );
-    ensure_not_parseable( "1.0e"     );
-    ensure_not_parseable( "1.0e+"    );
-    ensure_not_parseable( "1.0e-"    );
-    ensure_not_parseable( "e+100"    );
-    ensure_not_parseable( "1.1."     );
-    ensure_not_parseable( "1.1.e+22" );
-    ensure_not_parseable( ".1."      );
-    ensure_not_parseable( ".1.e+22"  );
-    ensure_not_parseable( "1.1e0+22" );
-    ensure_not_parseable( "1.1e0-22" );
-    ensure_not_parseable( ".-1"      );
-    ensure_not_parseable( "1.1e+.5"  );
-    ensure_not_parseable( "1.1e-.5"  );
-    ensure_not_parseable( "1.1e-22-" );
-    ensure_not_parseable( "1.1e-22+" );
+    float  alt_val = 0.0f;
+    int    erange_condition = 1;
+    if(( !dconvstr_scan_float( str, NULL, &alt_val, &erange_condition ) )||
+       ( 0 != memcmp( &alt_val, &val, sizeof(float) ) ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %.9e,\n"
+            "    got      %.9e\n"
+            "Test failed for str=%s\n", val, alt_val, str
+        );
+        exit(-1);
+    }
 }
 
 /**
  *
- *  Execute stress test of forward-backward conversion without loss of precision (bijectivity test)
+ *  Execute single static test of half precision / bfloat16 array conversions:
+ *  array is printed with "%g" format and comma separator, then string is scanned back
  *
  */
-static void  stress_test()
+static void  single_static_test_float16( int  is_bfloat16, const char*  str, const unsigned short*  values, int  n_values )
 {
-    fprintf( stderr, "Running stress test...\n" );
-
-    for( uint64_t  i = 0; ; ++i )
+    // 1. Check conversion values -> str
+    char  alt_str[256];
+    memset( alt_str, 0, sizeof(alt_str) );
+    int  alt_str_size = sizeof(alt_str) - 1;
+    char*  alt_str_end = alt_str;
+    int  dconvstr_print_status = is_bfloat16 ?
+        dconvstr_print_bfloat16_array( &alt_str_end, &alt_str_size, values, n_values, ',', 'g', 0, 0,
+                                       DCONVSTR_DEFAULT_PRECISION ) :
+        dconvstr_print_half_array( &alt_str_end, &alt_str_size, values, n_values, ',', 'g', 0, 0,
+                                   DCONVSTR_DEFAULT_PRECISION );
+    *alt_str_end = 0;
+    if(( !dconvstr_print_status )||( 0 != strcmp( str, alt_str ) ))
     {
-        // 1. Remember initial state of RNG which would be very useful in case of errors
-        uint64_t  initial_rng_state = local_rng_state_;
-
-        // 2. Generate random double-precision floating point value
-        uint64_t  raw_random_value = local_rng_get_random_uint64();
-        if(( ((raw_random_value >> 52) & 0x7FF) == 0x7FF )&&
-           ( raw_random_value & ((1ULL<<52)-1ULL)        ))
-            raw_random_value = (0xFFF8ULL << 48);   // if NaN: set NaN sign and clear payload
-        double  random_value = 0.0;
-        memcpy( &random_value, &raw_random_value, sizeof(random_value) );
-
-        // 3. Print random double-precision floating point value to string (using full precision)
-        char   str[128];
-        int    str_size = sizeof(str) - 1;
-        char*  str_end = str;
-        int  dconvstr_print_status = dconvstr_print(
-            &str_end, &str_size, random_value,
-            'e', 0, 0, 20
-        );
-        if(! dconvstr_print_status )
-        {
-            fprintf(
-                stderr,
-                "Can't convert double to string\n"
-                "Stress test failed for val=%.20e\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, initial_rng_state
-            );
-            exit(-1);
-        }
-        if( str_end + str_size != str + sizeof(str) - 1 )
-        {
-            fprintf(
-                stderr,
-                "Unexpected buffer state after converting double to string\n"
-                "Stress test failed for val=%.20e\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, initial_rng_state
-            );
-            exit(-1);
-        }
-        *str_end = 0;
-
-        // 4. Convert string back to number
-        const char*  str_actual_end = NULL;
-        double  alt_random_value = 0.0;
-        int  erange_condition = 1;
-        int  dconvstr_scan_status = dconvstr_scan(
-            str, &str_actual_end, &alt_random_value, &erange_condition
+        fprintf(
+            stderr,
+            "Formatting result not as expected:\n"
+            "    expected \"%s\",\n"
+            "    got      \"%s\"\n"
+            "Test failed for %s array str=%s\n", str, alt_str, (is_bfloat16 ? "bfloat16" : "half"), str
         );
-        uint64_t  raw_alt_random_value = 0;
-        memcpy( &raw_alt_random_value, &alt_random_value, sizeof(raw_alt_random_value) );
-        if(! dconvstr_scan_status )
-        {
-            fprintf(
-                stderr,
-                "Unexpected internal error during string-to-number conversion\n"
-                "Stress test failed for val=%.20e str=%s\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, str, initial_rng_state
-            );
-            exit(-1);
-        }
-        if( erange_condition )
-        {
-            fprintf(
-                stderr,
-                "Unexpected ERANGE condition during string-to-number conversion\n"
-                "Stress test failed for val=%.20e str=%s\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, str, initial_rng_state
-            );
-            exit(-1);
-        }
-        if( str_actual_end != str_end )
-        {
-            fprintf(
-                stderr,
-                "Unexpected syntax error during string-to-number conversion\n"
-                "Stress test failed for val=%.20e str=%s\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, str, initial_rng_state
-            );
-            exit(-1);
-        }
+        exit(-1);
+    }
 
-        // 5. Make sure initial and converted-back-and-forth floating point values have exact match
-        if( 0 != memcmp( &random_value, &alt_random_value, sizeof(double) ) )
-        {
-            fprintf(
-                stderr,
-                "Strict equality check in stress test failed:\n"
-                "    initial double value:     %.20e (raw: 0x" UINT64_FORMAT_STRING ")\n"
-                "    converted to string:     `%s'\n"
-                "    converted back to double: %.20e (raw: 0x" UINT64_FORMAT_STRING ")\n"
-                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
-                random_value, raw_random_value,
-                str,
-                alt_random_value, raw_alt_random_value,
-                initial_rng_state
-            );
-            exit(-1);
-        }
-        
-        // 6. Indication to user: stress test is running normally
-        if( i == 0x100000 )
-        {
-            fprintf( stderr, "." );
-            fflush( stderr );
-            i = 0;
-        }
+    // 2. Check conversion str -> values
+    unsigned short  alt_values[16];
+    const char*  str_actual_end = NULL;
+    int  n_alt_values = 0;
+    int  erange_condition = 1;
+    int  dconvstr_scan_status = is_bfloat16 ?
+        dconvstr_scan_bfloat16_array( str, &str_actual_end, alt_values, 16, &n_alt_values, ',', &erange_condition ) :
+        dconvstr_scan_half_array( str, &str_actual_end, alt_values, 16, &n_alt_values, ',', &erange_condition );
+    if(( !dconvstr_scan_status )||( erange_condition )||( str_actual_end != str + strlen( str ) )||
+       ( n_alt_values != n_values )||( 0 != memcmp( alt_values, values, n_values * sizeof(unsigned short) ) ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected\n"
+            "Test failed for %s array str=%s\n", (is_bfloat16 ? "bfloat16" : "half"), str
+        );
+        exit(-1);
     }
 }
 
 /**
  *
- *  Program entry point
+ *  Ensure string argument is converted to given half precision value with correct rounding
  *
  */
-int  main( int  argc, const char* const*  argv )
+static void  ensure_scanned_half( const char*  str, unsigned short  val )
 {
-    // 1. Check command line
-    if( argc > 2 )
+    unsigned short  alt_val = 0;
+    int  n_values = 0;
+    int  erange_condition = 1;
+    if(( !dconvstr_scan_half_array( str, NULL, &alt_val, 1, &n_values, ',', &erange_condition ) )||
+       ( n_values != 1 )||( alt_val != val ))
     {
-        fprintf( stderr, "Usage: dconvstr_test [initial_rng_state]\n" );
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected 0x%04X,\n"
+            "    got      0x%04X\n"
+            "Test failed for str=%s\n", val, alt_val, str
+        );
         exit(-1);
     }
-    fprintf( stderr, "Running dconvstr_test, build date " __DATE__ " " __TIME__ "\n" );
+}
 
-    // 2. Initialize local RNG (optional)
-    if( argc == 2 )
+/**
+ *
+ *  Ensure string argument is scanned as given half precision array, up to given offset in string
+ *
+ */
+static void  ensure_scanned_half_array( const char*  str, int  separator, const unsigned short*  values,
+                                        int  n_values, int  end_offset )
+{
+    unsigned short  alt_values[16];
+    const char*  str_actual_end = NULL;
+    int  n_alt_values = -1;
+    int  erange_condition = 1;
+    if(( !dconvstr_scan_half_array( str, &str_actual_end, alt_values, 16, &n_alt_values, separator,
+                                    &erange_condition ) )||
+       ( erange_condition )||( str_actual_end != str + end_offset )||( n_alt_values != n_values )||
+       ( 0 != memcmp( alt_values, values, n_values * sizeof(unsigned short) ) ))
     {
-        errno = 0;
-        uint64_t  parse_result = strtoull( argv[1], 0, 10 );
-        if( errno != 0 )
-        {
-            fprintf( stderr, "Can't parse command line (initial RNG state)\n" );
-            exit(-1);
-        }
-        local_rng_state_ = parse_result;
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %d values, end offset %d,\n"
+            "    got      %d values, end offset %d\n"
+            "Test failed for half array str=\"%s\"\n", n_values, end_offset,
+            n_alt_values, (int)( str_actual_end - str ), str
+        );
+        exit(-1);
     }
+}
 
-    // 3. Run tests
-    all_static_tests();
-    stress_test();
-    return  0;    // not reached
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
+/**
+ *
+ *  Execute single static test of extended precision conversions
+ *
+ */
+static void  single_static_test_ld( const char*  fmt, const char*  str, long double  val, int  flag_reverse_test )
+{
+    // 1. Parse format string
+    int           format_char      = 0;
+    unsigned int  format_flags     = 0;
+    int           format_width     = 0;
+    int           format_precision = DCONVSTR_DEFAULT_PRECISION;
+    if(! parse_printf_format_flags( fmt, &format_char, &format_flags, &format_width, &format_precision ) )
+    {
+        fprintf(
+            stderr,
+            "Can't parse format string\n"
+            "Test failed for fmt=%s str=%s val=%.21Lg\n", fmt, str, val
+        );
+        exit(-1);
+    }
+
+    // 2. Check conversion val -> str
+    char  alt_str[128];
+    memset( alt_str, 0, sizeof(alt_str) );
+    int  alt_str_size = sizeof(alt_str) - 1;
+    char*  alt_str_end = alt_str;
+    int  dconvstr_print_status = dconvstr_print_ld(
+        &alt_str_end, &alt_str_size, val,
+        format_char, format_flags, format_width, format_precision
+    );
+    *alt_str_end = 0;
+    if(( !dconvstr_print_status )||( 0 != strcmp( str, alt_str ) ))
+    {
+        fprintf(
+            stderr,
+            "Formatting result not as expected:\n"
+            "    expected \"%s\",\n"
+            "    got      \"%s\"\n", str, alt_str
+        );
+        fprintf(
+            stderr,
+            "Test failed for fmt=%s str=%s val=%.21Lg\n", fmt, str, val
+        );
+        exit(-1);
+    }
+
+    // 3. Check conversion str -> val
+    if( flag_reverse_test )
+    {
+        const char*  str_actual_end = NULL;
+        long double  alt_val = 0.0L;
+        int  erange_condition = 1;
+        int  dconvstr_scan_status = dconvstr_scan_ld(
+            str, &str_actual_end, &alt_val, &erange_condition
+        );
+        if(( !dconvstr_scan_status )||( erange_condition )||( str_actual_end != str + strlen( str ) )||
+           ( alt_val != val )||( signbit( alt_val ) != signbit( val ) ))
+        {
+            fprintf(
+                stderr,
+                "Scanning result not as expected:\n"
+                "    expected %.21Le,\n"
+                "    got      %.21Le\n", val, alt_val
+            );
+            fprintf(
+                stderr,
+                "Test failed for fmt=%s str=%s val=%.21Lg\n", fmt, str, val
+            );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Ensure string argument is converted to given extended precision value with correct rounding
+ *
+ */
+static void  ensure_scanned_ld( const char*  str, long double  val )
+{
+    long double  alt_val = 0.0L;
+    int          erange_condition = 1;
+    if(( !dconvstr_scan_ld( str, NULL, &alt_val, &erange_condition ) )||( alt_val != val ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %.21Le,\n"
+            "    got      %.21Le\n"
+            "Test failed for str=%s\n", val, alt_val, str
+        );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Ensure string argument is scanned as extended precision value with overflow/underflow condition
+ *
+ */
+static void  ensure_scanned_ld_erange( const char*  str, long double  val )
+{
+    long double  alt_val = 1.0L;
+    int          erange_condition = 0;
+    if(( !dconvstr_scan_ld( str, NULL, &alt_val, &erange_condition ) )||( !erange_condition )||
+       ( alt_val != val )||( signbit( alt_val ) != signbit( val ) ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %.21Le (erange=1),\n"
+            "    got      %.21Le (erange=%d)\n"
+            "Test failed for str=%s\n", val, alt_val, erange_condition, str
+        );
+        exit(-1);
+    }
+}
+#endif // DCONVSTR_HAVE_LONG_DOUBLE_X87
+
+#ifdef DCONVSTR_HAVE_FLOAT128
+/**
+ *
+ *  Format raw bits of quadruple precision value for diagnostics (printf() can't print __float128)
+ *
+ */
+static const char*  format_raw_float128( char*  buf, __float128  val )
+{
+    uint64_t  raw[2];
+    memcpy( raw, &val, sizeof(raw) );
+    sprintf( buf, "0x%016llX%016llX", (unsigned long long)raw[1], (unsigned long long)raw[0] );
+    return  buf;
+}
+
+/**
+ *
+ *  Execute single static test of quadruple precision conversions
+ *
+ */
+static void  single_static_test_float128( const char*  fmt, const char*  str, __float128  val, int  flag_reverse_test )
+{
+    char  raw_buf[2][40];
+
+    // 1. Parse format string
+    int           format_char      = 0;
+    unsigned int  format_flags     = 0;
+    int           format_width     = 0;
+    int           format_precision = DCONVSTR_DEFAULT_PRECISION;
+    if(! parse_printf_format_flags( fmt, &format_char, &format_flags, &format_width, &format_precision ) )
+    {
+        fprintf(
+            stderr,
+            "Can't parse format string\n"
+            "Test failed for fmt=%s str=%s val=%s\n", fmt, str, format_raw_float128( raw_buf[0], val )
+        );
+        exit(-1);
+    }
+
+    // 2. Check conversion val -> str
+    char  alt_str[128];
+    memset( alt_str, 0, sizeof(alt_str) );
+    int  alt_str_size = sizeof(alt_str) - 1;
+    char*  alt_str_end = alt_str;
+    int  dconvstr_print_status = dconvstr_print_float128(
+        &alt_str_end, &alt_str_size, val,
+        format_char, format_flags, format_width, format_precision
+    );
+    *alt_str_end = 0;
+    if(( !dconvstr_print_status )||( 0 != strcmp( str, alt_str ) ))
+    {
+        fprintf(
+            stderr,
+            "Formatting result not as expected:\n"
+            "    expected \"%s\",\n"
+            "    got      \"%s\"\n", str, alt_str
+        );
+        fprintf(
+            stderr,
+            "Test failed for fmt=%s str=%s val=%s\n", fmt, str, format_raw_float128( raw_buf[0], val )
+        );
+        exit(-1);
+    }
+
+    // 3. Check conversion str -> val
+    if( flag_reverse_test )
+    {
+        const char*  str_actual_end = NULL;
+        __float128   alt_val = 0;
+        int  erange_condition = 1;
+        int  dconvstr_scan_status = dconvstr_scan_float128(
+            str, &str_actual_end, &alt_val, &erange_condition
+        );
+        if(( !dconvstr_scan_status )||( erange_condition )||( str_actual_end != str + strlen( str ) )||
+           ( 0 != memcmp( &alt_val, &val, sizeof(val) ) ))
+        {
+            fprintf(
+                stderr,
+                "Scanning result not as expected:\n"
+                "    expected %s,\n"
+                "    got      %s\n", format_raw_float128( raw_buf[0], val ), format_raw_float128( raw_buf[1], alt_val )
+            );
+            fprintf(
+                stderr,
+                "Test failed for fmt=%s str=%s\n", fmt, str
+            );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Ensure string argument is converted to given quadruple precision value with correct rounding
+ *
+ */
+static void  ensure_scanned_float128( const char*  str, __float128  val )
+{
+    char        raw_buf[2][40];
+    __float128  alt_val = 0;
+    int         erange_condition = 1;
+    if(( !dconvstr_scan_float128( str, NULL, &alt_val, &erange_condition ) )||( alt_val != val ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %s,\n"
+            "    got      %s\n"
+            "Test failed for str=%s\n", format_raw_float128( raw_buf[0], val ), format_raw_float128( raw_buf[1], alt_val ), str
+        );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Ensure string argument is scanned as quadruple precision value with overflow/underflow condition
+ *
+ */
+static void  ensure_scanned_float128_erange( const char*  str, __float128  val )
+{
+    char        raw_buf[2][40];
+    __float128  alt_val = 1;
+    int         erange_condition = 0;
+    if(( !dconvstr_scan_float128( str, NULL, &alt_val, &erange_condition ) )||( !erange_condition )||
+       ( 0 != memcmp( &alt_val, &val, sizeof(__float128) ) ))
+    {
+        fprintf(
+            stderr,
+            "Scanning result not as expected:\n"
+            "    expected %s (erange=1),\n"
+            "    got      %s (erange=%d)\n"
+            "Test failed for str=%s\n", format_raw_float128( raw_buf[0], val ), format_raw_float128( raw_buf[1], alt_val ),
+            erange_condition, str
+        );
+        exit(-1);
+    }
+}
+#endif // DCONVSTR_HAVE_FLOAT128
+
+/**
+ *
+ *  Execute single static test of conversion between double and decimal64
+ *
+ */
+static void  single_static_test_decimal64( double  val, int  mode, unsigned long long  bits, int  lossy )
+{
+    // 1. Check conversion val -> bits
+    unsigned long long  alt_bits = 0;
+    int  alt_lossy = -1;
+    if(( !dconvstr_double_to_decimal64( val, mode, &alt_bits, &alt_lossy ) )||
+       ( alt_bits != bits )||( alt_lossy != lossy ))
+    {
+        fprintf(
+            stderr,
+            "Conversion to decimal64 not as expected:\n"
+            "    expected 0x%016llX (lossy=%d),\n"
+            "    got      0x%016llX (lossy=%d)\n"
+            "Test failed for val=%.17g mode=%d\n", bits, lossy, alt_bits, alt_lossy, val, mode
+        );
+        exit(-1);
+    }
+
+    // 2. Check conversion bits -> val
+    if(! lossy )
+    {
+        double  alt_val = 0.0;
+        int  erange_condition = 1;
+        if(( !dconvstr_decimal64_to_double( bits, &alt_val, &erange_condition ) )||( erange_condition )||
+           ( alt_val != val )||( signbit( alt_val ) != signbit( val ) ))
+        {
+            fprintf(
+                stderr,
+                "Conversion from decimal64 not as expected:\n"
+                "    expected %.17g,\n"
+                "    got      %.17g\n"
+                "Test failed for bits=0x%016llX\n", val, alt_val, bits
+            );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Ensure decimal64 value is converted to given double with given overflow/underflow condition
+ *
+ */
+static void  ensure_converted_decimal64( unsigned long long  bits, double  val, int  erange )
+{
+    double  alt_val = 0.0;
+    int     erange_condition = -1;
+    if(( !dconvstr_decimal64_to_double( bits, &alt_val, &erange_condition ) )||( erange_condition != erange )||
+       ( isnan( alt_val ) != isnan( val ) )||
+       (( !isnan( val ) )&&(( alt_val != val )||( signbit( alt_val ) != signbit( val ) ))))
+    {
+        fprintf(
+            stderr,
+            "Conversion from decimal64 not as expected:\n"
+            "    expected %.17g (erange=%d),\n"
+            "    got      %.17g (erange=%d)\n"
+            "Test failed for bits=0x%016llX\n", val, erange, alt_val, erange_condition, bits
+        );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Ensure string argument is not parseable
+ *
+ */
+static void  ensure_not_parseable( const char*  str )
+{
+    const char*  str_end          = str + strlen( str );
+    const char*  str_returned_end = NULL;
+    double       val              = 0.0;
+    int          erange_condition = 1;
+    int  dconvstr_scan_status = dconvstr_scan(
+        str, &str_returned_end, &val, &erange_condition
+    );
+    if(! dconvstr_scan_status )
+    {
+        fprintf(
+            stderr,
+            "Unexpected internal error in non-parseability test\n"
+            "Test failed for str=%s\n", str
+        );
+        exit(-1);
+    }
+    if( str_returned_end == str_end )
+    {
+        fprintf(
+            stderr,
+            "Unexpected positive result in non-parseability test\n"
+            "Test failed for str=%s\n", str
+        );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Test counters of internal code paths (if they are compiled in, otherwise ensure they are zeros)
+ *
+ */
+static void  test_stats()
+{
+    // 1. Take every counted path at least once
+    char    buf[64];
+    char*   buf_ptr  = buf;
+    int     buf_size = sizeof(buf);
+    double  val      = 0.0;
+    int     erange   = 0;
+    dconvstr_stats_reset();
+    dconvstr_print( &buf_ptr, &buf_size, NAN,  'g', 0, 0, DCONVSTR_DEFAULT_PRECISION );
+    dconvstr_print( &buf_ptr, &buf_size, 0.0,  'g', 0, 0, DCONVSTR_DEFAULT_PRECISION );
+    dconvstr_print( &buf_ptr, &buf_size, 9.96, 'e', 0, 0, 1 );             // 9.96 -> 1.0e+01
+    dconvstr_scan( "inf",                       NULL, &val, &erange );
+    dconvstr_scan( "0.000",                     NULL, &val, &erange );
+    dconvstr_scan( "1e-310",                    NULL, &val, &erange );    // denormal
+    dconvstr_scan( "1e-325",                    NULL, &val, &erange );    // underflow while packing
+    dconvstr_scan( "1e400",                     NULL, &val, &erange );    // overflow of decimal exponent
+    dconvstr_scan( "1.00000000000000000000001", NULL, &val, &erange );    // truncated after the point
+    dconvstr_scan( "123456789012345678901234",  NULL, &val, &erange );    // truncated before the point
+
+    // 2. Check counters
+    struct dconvstr_stats  stats;
+    int  is_enabled = dconvstr_stats_snapshot( &stats );
+    if(( stats.special_values             != (is_enabled ? 2 : 0) )||
+       ( stats.zeros                      != (is_enabled ? 2 : 0) )||
+       ( stats.subnormals_packed          != (is_enabled ? 1 : 0) )||
+       ( stats.bcd_round_carries          != (is_enabled ? 1 : 0) )||
+       ( stats.erange                     != (is_enabled ? 2 : 0) )||
+       ( stats.scan_digit_truncations     != (is_enabled ? 2 : 0) )||
+       (( stats.negative_search_iterations == 0 ) == is_enabled )||
+       (( stats.positive_search_iterations == 0 ) == is_enabled ))
+    {
+        fprintf( stderr, "Unexpected counters of internal code paths (enabled=%d)\n", is_enabled );
+        exit(-1);
+    }
+
+    // 3. Check reset
+    dconvstr_stats_reset();
+    dconvstr_stats_snapshot( &stats );
+    if(( stats.special_values != 0 )||( stats.negative_search_iterations != 0 ))
+    {
+        fprintf( stderr, "Counters of internal code paths were not reset\n" );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute all static tests
+ *
+ */
+static void  all_static_tests()
+{
+    fprintf( stderr, "Running static tests...\n" );
+
+    single_static_test( "%17.17f",     "1.00000000000000000",            1.0, 1 );
+    single_static_test( "%17.17f",    "-1.00000000000000000",           -1.0, 1 );
+    single_static_test( "%17.17f",    "10.00000000000000000",           10.0, 1 );
+    single_static_test( "%17.17f",   "-10.00000000000000000",          -10.0, 1 );
+    single_static_test( "%17.17f",    "11.00000000000000000",           11.0, 1 );
+
+    single_static_test( "%+#22.15e",  "+7.894561230000000e+08",  789456123.0, 1 );
+    single_static_test( "%-#22.15e",   "7.894561230000000e+08 ", 789456123.0, 0 );
+    single_static_test( "%#22.15e",   " 7.894561230000000e+08",  789456123.0, 1 );
+    single_static_test( "%+ .2e",      "+7.89e+08",              789456123.0, 0 );
+    single_static_test( "% +.2e",      "+7.89e+08",              789456123.0, 0 );
+    single_static_test( "%#1.1g",      "8.e+08",                 789456123.0, 0 );
+    single_static_test( "%.0f",        "1",                              0.6, 0 );
+    single_static_test( "%.0f",        "0",                              0.4, 0 );
+    single_static_test( "%.2f",        "0.00",                         0.001, 0 );
+    single_static_test( "%.2f",        "-0.01",                       -0.006, 0 );
+    single_static_test( "%2.4e",       "8.6000e+00",                     8.6, 1 );
+    single_static_test( "%2.4g",       "8.6",                            8.6, 1 );
+    single_static_test( "%e",          "-inf",                     -HUGE_VAL, 1 );
+
+    single_static_test( "%e",          "1.234000e+01",                 12.34, 1 );
+    single_static_test( "%e",          "1.234000e-01",                0.1234, 1 );
+    single_static_test( "%e",          "1.234000e-03",              0.001234, 1 );
+    single_static_test( "%.60e",       "1.000000000000000000000000000000000000000000000000000000000000e+20",
+                                                               1e20, 1  );
+    single_static_test( "%e",          "1.000000e-01",                   0.1, 1 );
+    single_static_test( "%f",          "12.340000",                    12.34, 1 );
+    single_static_test( "%f",          "0.123400",                    0.1234, 1 );
+    single_static_test( "%f",          "0.001234",                  0.001234, 1 );
+    single_static_test( "%g",          "12.34",                        12.34, 1 );
+    single_static_test( "%g",          "0.1234",                      0.1234, 1 );
+    single_static_test( "%g",          "0.001234",                  0.001234, 1 );
+    single_static_test( "%.60g",       "100000000000000000000",         1e20, 1 );
+    single_static_test( "%f",          "0.000000",                       0.0, 1 );
+    single_static_test( "%f",          "-0.000000",                     -0.0, 1 );
+    single_static_test( "%g",          "0",                              0.0, 1 );
+    single_static_test( "%g",          "-0",                            -0.0, 1 );
+
+    single_static_test( "%6.5f",       "0.10000",       0.099999999860301614, 0 );
+    single_static_test( "%6.5f",       "0.10000",                         .1, 1 );
+    single_static_test( "%5.4f",       "0.5000",                          .5, 1 );
+    single_static_test( "%15.5e",   "   4.94066e-324",    __DBL_DENORM_MIN__, 0 );
+    single_static_test( "%15.5e",   "   1.79769e+308",           __DBL_MAX__, 0 );
+    single_static_test( "%e",          "1.234568e+06",             1234567.8, 0 );
+    single_static_test( "%f",          "1234567.800000",           1234567.8, 1 );
+    single_static_test( "%g",          "1.23457e+06",              1234567.8, 0 );
+    single_static_test( "%g",          "123.456",                    123.456, 1 );
+    single_static_test( "%g",          "1e+06",                    1000000.0, 1 );
+    single_static_test( "%g",          "10",                            10.0, 1 );
+    single_static_test( "%g",          "0.02",                          0.02, 1 );
+
+    single_static_test_float( "%g",          "0.1",                          0.1f, 1 );
+    single_static_test_float( "%.17g",       "0.1",                          0.1f, 1 );
+    single_static_test_float( "%.20e",       "1.00000000000000000000e-01",   0.1f, 1 );
+    single_static_test_float( "%.8g",        "16777216",               16777216.0f, 1 );
+    single_static_test_float( "%.9g",        "3.4028235e+38",          __FLT_MAX__, 1 );
+    single_static_test_float( "%.9g",        "1.1754944e-38",          __FLT_MIN__, 1 );
+    single_static_test_float( "%g",          "1e-45",           __FLT_DENORM_MIN__, 1 );
+    single_static_test_float( "%f",          "-0.000000",                   -0.0f, 1 );
+    single_static_test_float( "%e",          "inf",                  (float)HUGE_VAL, 1 );
+    single_static_test_float( "%.3f",        "1234.500",                  1234.5f, 1 );
+
+    ensure_scanned_float( "16777217",                16777216.0f    );   // exact midpoint, ties to even
+    ensure_scanned_float( "16777219",                16777220.0f    );
+    ensure_scanned_float( "8388608.5",               8388608.0f     );
+    ensure_scanned_float( "1.000000059604644776",    1.00000012f    );   // just above midpoint
+    ensure_scanned_float( "7.006492321624085e-46",   0.0f           );   // just below half of denormal min
+    ensure_scanned_float( "7.006492321624086e-46",   __FLT_DENORM_MIN__ );
+    ensure_scanned_float( "3.4028235677973367e38",   (float)HUGE_VAL );
+    ensure_scanned_float( "3.4028235677973362e38",   __FLT_MAX__    );
+    ensure_scanned_float( "2.04485356807708740234375",  0x1.05bdc4p+1f );   // exact midpoint with 24 digits, ties to even
+    ensure_scanned_float( "2.04485356807708740234376",  0x1.05bdc4p+1f );   // above midpoint only after 19 digits
+    ensure_scanned_float( "7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46",
+                          0.0f );                                            // exact half of denormal min, ties to even
+    ensure_scanned_float( "7.006492321624085354618647916449580656401309709382578858785341419448955413429303007433190941810607910156251e-46",
+                          __FLT_DENORM_MIN__ );
+
+    const unsigned short  half_values[]     = { 0x3C00, 0x3555, 0x7BFF, 0x0001, 0xC000, 0x7C00 };
+    const unsigned short  bfloat16_values[] = { 0x3F80, 0x3DCD, 0x7F7F, 0x0001, 0x4049, 0xFF80 };
+    single_static_test_float16( 0, "1,0.3333,65500,6e-08,-2,inf",              half_values,     6 );
+    single_static_test_float16( 1, "1,0.1,3.39e+38,9e-41,3.14,-inf",           bfloat16_values, 6 );
+
+    ensure_scanned_half( "2049",      0x6800 );   // exact midpoint, ties to even
+    ensure_scanned_half( "2051",      0x6802 );
+    ensure_scanned_half( "65519.99",  0x7BFF );
+    ensure_scanned_half( "65520",     0x7C00 );   // overflow
+    ensure_scanned_half( "2.98e-8",   0x0000 );   // just below half of denormal min
+    ensure_scanned_half( "2.99e-8",   0x0001 );
+
+    static const unsigned short  one_and_two[2] = { 0x3C00, 0x4000 };
+    static const unsigned short  half_and_7e3[2] = { 0xB800, 0x6ED6 };
+    ensure_scanned_half_array( "1\r\n2\r\n",      '\n', one_and_two,  2,  4 );   // CRLF line ends
+    ensure_scanned_half_array( "1 ,2",            ',',  one_and_two,  2,  4 );
+    ensure_scanned_half_array( "  -0.5\t,7e3",    ',',  half_and_7e3, 2, 11 );
+    ensure_scanned_half_array( "1\t 2",           ' ',  one_and_two,  2,  4 );
+    ensure_scanned_half_array( "1,2 x",           ',',  one_and_two,  1,  1 );   // syntax error after value
+    ensure_scanned_half_array( "1 x,2",           ',',  one_and_two,  0,  0 );
+
+    single_static_test_decimal64( 0.1,            DCONVSTR_DECIMAL64_SHORTEST, 0x31A0000000000001ULL, 0 );
+    single_static_test_decimal64( 0.1,            DCONVSTR_DECIMAL64_NEAREST,  0x31A0000000000001ULL, 0 );
+    single_static_test_decimal64( 1.0 / 3.0,      DCONVSTR_DECIMAL64_SHORTEST, 0x2FCBD7A625405555ULL, 0 );
+    single_static_test_decimal64( 0.9999999999999999, DCONVSTR_DECIMAL64_SHORTEST, 0x6BF386F26FC0FFFFULL, 0 );
+    single_static_test_decimal64( 1e308,          DCONVSTR_DECIMAL64_SHORTEST, 0x5840000000000001ULL, 0 );
+    single_static_test_decimal64( -0.0,           DCONVSTR_DECIMAL64_SHORTEST, 0xB1C0000000000000ULL, 0 );
+    single_static_test_decimal64( -HUGE_VAL,      DCONVSTR_DECIMAL64_NEAREST,  0xF800000000000000ULL, 0 );
+    single_static_test_decimal64( 123456789012345678.0, DCONVSTR_DECIMAL64_SHORTEST, 0x320462D53C8ABAC1ULL, 1 );
+    single_static_test_decimal64( 1125899906842624.5, DCONVSTR_DECIMAL64_NEAREST, 0x31C4000000000000ULL, 1 );   // tie, to even
+    single_static_test_decimal64( 1125899906842625.5, DCONVSTR_DECIMAL64_NEAREST, 0x31C4000000000002ULL, 1 );
+
+    ensure_converted_decimal64( 0x7C00000000000000ULL,  NAN,        0 );
+    ensure_converted_decimal64( 0x7E00000000000000ULL,  NAN,        0 );   // signaling NaN
+    ensure_converted_decimal64( 0xF800000000000000ULL, -HUGE_VAL,   0 );
+    ensure_converted_decimal64( 0x6FFFFFFFFFFFFFFFULL,  0.0,        0 );   // non-canonical mantissa
+    ensure_converted_decimal64( 0x77FB86F26FC0FFFFULL,  HUGE_VAL,   1 );   // 9999999999999999E369
+    ensure_converted_decimal64( 0x0000000000000001ULL,  0.0,        1 );   // 1E-398
+    ensure_converted_decimal64( 0x5C6CF82551C70833ULL,  HUGE_VAL,   1 );   // 3.65E356
+    ensure_converted_decimal64( 0xDD6E993B7846789AULL, -HUGE_VAL,   1 );   // -4.1E364
+    ensure_converted_decimal64( 0x584000000000000AULL,  HUGE_VAL,   1 );   // 10E308
+    ensure_converted_decimal64( 0x0920000000000001ULL,  0.0,        1 );   // 1E-325
+    ensure_converted_decimal64( 0x0940000000000005ULL,  4.9406564584124654e-324, 0 );   // 5E-324
+    ensure_converted_decimal64( 0x0920000000000019ULL,  4.9406564584124654e-324, 0 );   // 25E-325, above half of denormal min
+    ensure_converted_decimal64( 0xB2077C9237C4D3D4ULL, -210729227969019584.0, 0 );    // -210729227969019600, near midpoint
+    ensure_converted_decimal64( 0x6C70000000000001ULL,  9007199254740992.0, 0 );    // 2^53 + 1, tie to even
+    ensure_converted_decimal64( 0x6C70000000000003ULL,  9007199254740996.0, 0 );    // 2^53 + 3, tie to even
+
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
+    single_static_test_ld( "%g",          "0.1",                                    0.1L, 1 );
+    single_static_test_ld( "%.25e",       "1.0000000000000000000000000e-01",        0.1L, 1 );
+    single_static_test_ld( "%.21g",       "0.33333333333333333334",           1.0L / 3.0L, 1 );
+    single_static_test_ld( "%.21g",       "18446744073709551615",    18446744073709551615.0L, 1 );
+    single_static_test_ld( "%.21g",       "1.189731495357231765e+4932",       __LDBL_MAX__, 1 );
+    single_static_test_ld( "%.21g",       "3.3621031431120935063e-4932",      __LDBL_MIN__, 1 );
+    single_static_test_ld( "%g",          "4e-4951",                   __LDBL_DENORM_MIN__, 1 );
+    single_static_test_ld( "%f",          "-0.000000",                             -0.0L, 1 );
+    single_static_test_ld( "%e",          "-inf",                             -HUGE_VALL, 1 );
+    single_static_test_ld( "%.3f",        "1234.500",                            1234.5L, 1 );
+
+    ensure_scanned_ld( "18446744073709551617",           18446744073709551616.0L );   // exact midpoint, ties to even
+    ensure_scanned_ld( "18446744073709551619",           18446744073709551620.0L );
+    ensure_scanned_ld( "1.0000000000000000000542",       1.0L                    );
+    ensure_scanned_ld( "1.0000000000000000000543",       1.0L + __LDBL_EPSILON__ );   // just above midpoint
+    ensure_scanned_ld( "1.8225997659412373012e-4951",    0.0L                    );   // just below half of denormal min
+    ensure_scanned_ld( "1.8225997659412373013e-4951",    __LDBL_DENORM_MIN__     );
+    ensure_scanned_ld( "1.189731495357231765053e4932",   __LDBL_MAX__            );
+    ensure_scanned_ld( "1.189731495357231765054e4932",   HUGE_VALL               );
+    ensure_scanned_ld_erange( "1e-5000",                 0.0L                    );
+    ensure_scanned_ld_erange( "-1e-500000000",          -0.0L                    );   // saturated exponent
+    ensure_scanned_ld_erange( "100000e-5002",            0.0L                    );
+    ensure_scanned_ld_erange( "-1e5000",                -HUGE_VALL               );
+    ensure_scanned_ld_erange( "0.001e500000000",         HUGE_VALL               );
+#endif
+
+#ifdef DCONVSTR_HAVE_FLOAT128
+    single_static_test_float128( "%g",    "0.1",                                              0.1Q, 1 );
+    single_static_test_float128( "%.40e", "1.0000000000000000000000000000000000000000e-01",   0.1Q, 1 );
+    single_static_test_float128( "%.36g", "0.3333333333333333333333333333333333",     1.0Q / 3.0Q, 1 );
+    single_static_test_float128( "%.36g", "10384593717069655257060992658440192", 10384593717069655257060992658440192.0Q, 1 );
+    single_static_test_float128( "%.36g", "1.189731495357231765085759326628007e+4932",    __FLT128_MAX__, 1 );
+    single_static_test_float128( "%.36g", "3.3621031431120935062626778173217526e-4932",   __FLT128_MIN__, 1 );
+    single_static_test_float128( "%g",    "6e-4966",                                __FLT128_DENORM_MIN__, 1 );
+    single_static_test_float128( "%f",    "-0.000000",                                       -0.0Q, 1 );
+    single_static_test_float128( "%.3f",  "1234.500",                                      1234.5Q, 1 );
+
+    ensure_scanned_float128( "10384593717069655257060992658440193",  10384593717069655257060992658440192.0Q );   // exact midpoint, ties to even
+    ensure_scanned_float128( "10384593717069655257060992658440195",  10384593717069655257060992658440196.0Q );
+    ensure_scanned_float128( "1.00000000000000000000000000000000009629",  1.0Q                     );
+    ensure_scanned_float128( "1.0000000000000000000000000000000000963",   1.0Q + __FLT128_EPSILON__ );   // just above midpoint
+    ensure_scanned_float128( "3.2375875597190125554622194791138232762e-4966",  0.0Q                 );   // just below half of denormal min
+    ensure_scanned_float128( "3.2375875597190125554622194791138232763e-4966",  __FLT128_DENORM_MIN__ );
+    ensure_scanned_float128( "1.1897314953572317650857593266280070734e4932",   __FLT128_MAX__       );
+    ensure_scanned_float128( "1.1897314953572317650857593266280070735e4932",   __builtin_infq()     );
+    ensure_scanned_float128_erange( "1e-5000",                   0.0Q                );
+    ensure_scanned_float128_erange( "-1e-500000000",            -0.0Q                );   // saturated exponent
+    ensure_scanned_float128_erange( "100000e-5002",              0.0Q                );
+    ensure_scanned_float128_erange( "-1e5000",                  -__builtin_infq()    );
+    ensure_scanned_float128_erange( "0.001e500000000",           __builtin_infq()    );
+#endif
+
+    ensure_not_parseable( "."        );
+    ensure_not_parseable( ".e"       );
+    ensure_not_parseable( ".e+"      );
+    ensure_not_parseable( ".e-"      );
+    ensure_not_parseable( "1.0e"     );
+    ensure_not_parseable( "1.0e+"    );
+    ensure_not_parseable( "1.0e-"    );
+    ensure_not_parseable( "e+100"    );
+    ensure_not_parseable( "1.1."     );
+    ensure_not_parseable( "1.1.e+22" );
+    ensure_not_parseable( ".1."      );
+    ensure_not_parseable( ".1.e+22"  );
+    ensure_not_parseable( "1.1e0+22" );
+    ensure_not_parseable( "1.1e0-22" );
+    ensure_not_parseable( ".-1"      );
+    ensure_not_parseable( "1.1e+.5"  );
+    ensure_not_parseable( "1.1e-.5"  );
+    ensure_not_parseable( "1.1e-22-" );
+    ensure_not_parseable( "1.1e-22+" );
+
+    test_stats();
+}
+
+/**
+ *
+ *  Check forward-backward conversion of double precision value without loss of precision
+ *
+ *  Value is printed to string, scanned back and converted to decimal64 and back. NaN is expected
+ *  to come back as NaN with sign set and payload cleared.
+ *
+ *  @returns  1  if value was converted back and forth exactly
+ *            0  otherwise (details are printed to stderr)
+ *
+ */
+static int  verify_double( uint64_t  raw_value )
+{
+    // 1. Make double-precision floating point value from its bits
+    if(( ((raw_value >> 52) & 0x7FF) == 0x7FF )&&
+       ( raw_value & ((1ULL<<52)-1ULL)        ))
+        raw_value = (0xFFF8ULL << 48);   // if NaN: set NaN sign and clear payload
+    double  value = 0.0;
+    memcpy( &value, &raw_value, sizeof(value) );
+
+    // 2. Print value to string (using full precision)
+    char   str[128];
+    int    str_size = sizeof(str) - 1;
+    char*  str_end = str;
+    int  dconvstr_print_status = dconvstr_print(
+        &str_end, &str_size, value,
+        'e', 0, 0, 20
+    );
+    if(! dconvstr_print_status )
+    {
+        fprintf(
+            stderr,
+            "Can't convert double to string\n"
+            "Test failed for val=%.20e\n",
+            value
+        );
+        return  0;
+    }
+    if( str_end + str_size != str + sizeof(str) - 1 )
+    {
+        fprintf(
+            stderr,
+            "Unexpected buffer state after converting double to string\n"
+            "Test failed for val=%.20e\n",
+            value
+        );
+        return  0;
+    }
+    *str_end = 0;
+
+    // 3. Convert string back to number
+    const char*  str_actual_end = NULL;
+    double  alt_value = 0.0;
+    int  erange_condition = 1;
+    int  dconvstr_scan_status = dconvstr_scan(
+        str, &str_actual_end, &alt_value, &erange_condition
+    );
+    uint64_t  raw_alt_value = 0;
+    memcpy( &raw_alt_value, &alt_value, sizeof(raw_alt_value) );
+    if(! dconvstr_scan_status )
+    {
+        fprintf(
+            stderr,
+            "Unexpected internal error during string-to-number conversion\n"
+            "Test failed for val=%.20e str=%s\n",
+            value, str
+        );
+        return  0;
+    }
+    if( erange_condition )
+    {
+        fprintf(
+            stderr,
+            "Unexpected ERANGE condition during string-to-number conversion\n"
+            "Test failed for val=%.20e str=%s\n",
+            value, str
+        );
+        return  0;
+    }
+    if( str_actual_end != str_end )
+    {
+        fprintf(
+            stderr,
+            "Unexpected syntax error during string-to-number conversion\n"
+            "Test failed for val=%.20e str=%s\n",
+            value, str
+        );
+        return  0;
+    }
+
+    // 4. Make sure initial and converted-back-and-forth floating point values have exact match
+    if( 0 != memcmp( &value, &alt_value, sizeof(double) ) )
+    {
+        fprintf(
+            stderr,
+            "Strict equality check failed:\n"
+            "    initial double value:     %.20e (raw: 0x%016llX)\n"
+            "    converted to string:     `%s'\n"
+            "    converted back to double: %.20e (raw: 0x%016llX)\n",
+            value, (unsigned long long)raw_value,
+            str,
+            alt_value, (unsigned long long)raw_alt_value
+        );
+        return  0;
+    }
+
+    // 5. Make sure double value converted to decimal64 (in shortest mode) and back has exact match,
+    //    unless conversion is reported as lossy (shortest decimal has 17 digits)
+    unsigned long long  decimal64 = 0;
+    int  decimal64_lossy = 1;
+    double  alt_decimal64_value = 0.0;
+    if(( !dconvstr_double_to_decimal64( value, DCONVSTR_DECIMAL64_SHORTEST,
+                                        &decimal64, &decimal64_lossy ) )||
+       ( !dconvstr_decimal64_to_double( decimal64, &alt_decimal64_value, &erange_condition ) )||
+       (( !decimal64_lossy )&&( 0 != memcmp( &value, &alt_decimal64_value, sizeof(double) ) )))
+    {
+        fprintf(
+            stderr,
+            "Strict equality check of decimal64 conversion failed:\n"
+            "    initial double value:     %.20e (raw: 0x%016llX)\n"
+            "    converted to decimal64:   0x%016llX (lossy=%d)\n"
+            "    converted back to double: %.20e\n",
+            value, (unsigned long long)raw_value,
+            decimal64, decimal64_lossy,
+            alt_decimal64_value
+        );
+        return  0;
+    }
+    return  1;
+}
+
+/**
+ *
+ *  Check forward-backward conversion of single precision value without loss of precision
+ *
+ *  NaN is expected to come back as NaN with sign set and payload cleared.
+ *
+ *  @returns  1  if value was converted back and forth exactly
+ *            0  otherwise (details are printed to stderr)
+ *
+ */
+static int  verify_float( uint32_t  raw_value )
+{
+    // 1. Make single-precision floating point value from its bits
+    if(( ((raw_value >> 23) & 0xFF) == 0xFF )&&( raw_value & ((1U<<23)-1U) ))
+        raw_value = 0xFFC00000U;   // if NaN: set NaN sign and clear payload
+    float  value = 0.0f, alt_value = 0.0f;
+    memcpy( &value, &raw_value, sizeof(value) );
+
+    // 2. Print value to string and convert it back
+    char         str[128];
+    int          str_size = sizeof(str) - 1;
+    char*        str_end  = str;
+    const char*  str_actual_end = NULL;
+    int          erange_condition = 1;
+    int  dconvstr_print_status = dconvstr_print_float(
+        &str_end, &str_size, value,
+        'e', 0, 0, 20
+    );
+    *str_end = 0;
+    int  dconvstr_scan_status = dconvstr_scan_float(
+        str, &str_actual_end, &alt_value, &erange_condition
+    );
+
+    // 3. Make sure initial and converted-back-and-forth values have exact match
+    if(( !dconvstr_print_status )||( !dconvstr_scan_status )||( erange_condition )||
+       ( str_actual_end != str_end )||
+       ( 0 != memcmp( &value, &alt_value, sizeof(float) ) ))
+    {
+        fprintf(
+            stderr,
+            "Strict equality check of single precision value failed:\n"
+            "    initial float value:     %.20e (raw: 0x%08X)\n"
+            "    converted to string:    `%s'\n"
+            "    converted back to float: %.20e\n",
+            value, (unsigned int)raw_value,
+            str,
+            alt_value
+        );
+        return  0;
+    }
+    return  1;
+}
+
+#ifdef __DEC64_MANT_DIG__
+/**
+ *
+ *  Verify conversion of decimal64 value to double against conversion of GCC's _Decimal64 type
+ *
+ *  Canonical finite decimal64 value is made of bits of scrambled random value: sign, exponent,
+ *  and coefficient with random number of digits (up to 16).
+ *
+ */
+static int  verify_decimal64( uint64_t  raw_value )
+{
+    // 1. Make decimal64 value from bits of random value, in BID encoding
+    uint64_t  scrambled = raw_value * 0x9E3779B97F4A7C15ULL;
+    uint64_t  mantissa  = (scrambled >> 10) % 10000000000000000ULL;
+    for( uint64_t  n = (raw_value >> 59); n > 0; --n )
+        mantissa /= 10;
+    uint64_t  biased_exponent = (raw_value >> 10) % 768;
+    uint64_t  bits = (raw_value & (1ULL << 58)) << 5;
+    if( mantissa < (1ULL << 53) )
+        bits |= (biased_exponent << 53) | mantissa;
+    else
+        bits |= (3ULL << 61) | (biased_exponent << 51) | (mantissa & ((1ULL << 51) - 1ULL));
+
+    // 2. Convert it to double and compare with conversion done by compiler
+    _Decimal64  value = 0;
+    double      alt_value = 0.0;
+    int         erange_condition = 1;
+    memcpy( &value, &bits, sizeof(value) );
+    double      expected_value = (double) value;
+    if(( !dconvstr_decimal64_to_double( bits, &alt_value, &erange_condition ) )||
+       ( 0 != memcmp( &expected_value, &alt_value, sizeof(double) ) ))
+    {
+        fprintf(
+            stderr,
+            "Conversion from decimal64 differs from _Decimal64 conversion:\n"
+            "    decimal64 value:   0x%016llX\n"
+            "    expected double:   %a\n"
+            "    converted double:  %a\n",
+            (unsigned long long) bits, expected_value, alt_value
+        );
+        return  0;
+    }
+    return  1;
+}
+#endif // __DEC64_MANT_DIG__
+
+/**
+ *
+ *  Thread of parallel test, see run_test_threads()
+ *
+ */
+struct test_thread
+{
+    void      (*proc)( const struct test_thread* );
+    int       index;               // 0 ... n_threads-1
+    int       n_threads;
+    uint64_t  initial_rng_state;
+    uint64_t  first;               // test-specific parameters
+    uint64_t  last;
+};
+
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI  test_thread_proc( LPVOID  arg )
+#else
+static void*  test_thread_proc( void*  arg )
+#endif
+{
+    const struct test_thread*  thread = (const struct test_thread*) arg;
+    thread->proc( thread );
+    return  0;
+}
+
+/**
+ *
+ *  Get number of CPUs available to the process
+ *
+ */
+static int  get_number_of_cpus()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO  system_info;
+    GetSystemInfo( &system_info );
+    return  (int) system_info.dwNumberOfProcessors;
+#else
+    long  n_cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    return  ( (n_cpus > 0) ? (int) n_cpus : 1 );
+#endif
+}
+
+/**
+ *
+ *  Run test procedure in n_threads threads and wait for all of them to complete
+ *
+ *  Every thread gets its own index and the same parameters. Single thread is run as a plain call,
+ *  so that the test is run in the main thread exactly as before threads were introduced.
+ *
+ */
+static void  run_test_threads(
+    void      (*proc)( const struct test_thread* ),
+    int       n_threads,
+    uint64_t  first,
+    uint64_t  last
+)
+{
+    static struct test_thread  threads[MAX_THREADS];
+#if defined(_WIN32) || defined(_WIN64)
+    static HANDLE  handles[MAX_THREADS];
+#else
+    static pthread_t  handles[MAX_THREADS];
+#endif
+    for( int  t = 0; t < n_threads; ++t )
+    {
+        threads[t].proc              = proc;
+        threads[t].index             = t;
+        threads[t].n_threads         = n_threads;
+        threads[t].initial_rng_state = local_rng_state_;
+        threads[t].first             = first;
+        threads[t].last              = last;
+    }
+    if( n_threads == 1 )
+    {
+        proc( threads );
+        return;
+    }
+    for( int  t = 0; t < n_threads; ++t )
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        handles[t] = CreateThread( NULL, 0, test_thread_proc, threads + t, 0, NULL );
+        if( handles[t] == NULL )
+#else
+        if( 0 != pthread_create( &handles[t], NULL, test_thread_proc, threads + t ) )
+#endif
+        {
+            fprintf( stderr, "Can't create thread\n" );
+            exit(-1);
+        }
+    }
+    for( int  t = 0; t < n_threads; ++t )
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        WaitForSingleObject( handles[t], INFINITE );
+        CloseHandle( handles[t] );
+#else
+        pthread_join( handles[t], NULL );
+#endif
+    }
+}
+
+/**
+ *
+ *  Execute stress test of forward-backward conversion without loss of precision (bijectivity test)
+ *
+ *  RNG stream is partitioned across threads: thread k starts 2^64 * k / n_threads steps ahead of the
+ *  initial RNG state, so threads never test the same values. RNG state reported on failure reproduces
+ *  it with a single thread.
+ *
+ */
+static void  stress_test( const struct test_thread*  thread )
+{
+    local_rng_state_ = thread->initial_rng_state;
+    local_rng_skip( (~0ULL / (uint64_t)thread->n_threads) * (uint64_t)thread->index );
+
+    for( uint64_t  i = 0; ; ++i )
+    {
+        // 1. Remember initial state of RNG which would be very useful in case of errors
+        uint64_t  initial_rng_state = local_rng_state_;
+
+        // 2. Generate random double-precision floating point value
+        uint64_t  raw_random_value = local_rng_get_random_uint64();
+
+        // 3. Make sure it's converted to string and back (also to decimal64 and back) exactly
+        if(! verify_double( raw_random_value ) )
+        {
+            fprintf( stderr, "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n", initial_rng_state );
+            exit(-1);
+        }
+
+        // 4. Make sure the same holds for single precision value made of 32 least significant bits
+        if(! verify_float( (uint32_t)( raw_random_value ) ) )
+        {
+            fprintf( stderr, "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n", initial_rng_state );
+            exit(-1);
+        }
+
+#ifdef __DEC64_MANT_DIG__
+        // 5. Make sure decimal64 value made of the same bits is converted to double like in GCC
+        if(! verify_decimal64( raw_random_value ) )
+        {
+            fprintf( stderr, "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n", initial_rng_state );
+            exit(-1);
+        }
+#endif
+
+#if defined(DCONVSTR_HAVE_LONG_DOUBLE_X87) || defined(DCONVSTR_HAVE_FLOAT128)
+        char         str[128];
+        int          str_size = 0;
+        char*        str_end  = NULL;
+        const char*  str_actual_end = NULL;
+        int          erange_condition = 1;
+        int          dconvstr_print_status = 0;
+        int          dconvstr_scan_status  = 0;
+#endif
+
+#ifdef DCONVSTR_HAVE_LONG_DOUBLE_X87
+        // 6. Make sure the same holds for extended precision value: sign and exponent are taken from
+        //    16 most significant bits, mantissa is scrambled 64-bit random value with explicit bit set
+        //    for normalized values
+        uint16_t  raw_random_ld_exponent = ((uint16_t)( raw_random_value >> 48 ));
+        uint64_t  raw_random_ld_mantissa = raw_random_value * 0x9E3779B97F4A7C15ULL;
+        if( raw_random_ld_exponent & 0x7FFF )
+            raw_random_ld_mantissa |= (1ULL << 63);
+        else
+            raw_random_ld_mantissa &= ~(1ULL << 63);
+        if(( (raw_random_ld_exponent & 0x7FFF) == 0x7FFF )&&( raw_random_ld_mantissa << 1 ))
+        {
+            raw_random_ld_exponent = 0xFFFF;   // if NaN: set NaN sign and clear payload
+            raw_random_ld_mantissa = (3ULL << 62);
+        }
+        long double  random_ld = 0.0L, alt_random_ld = 0.0L;
+        memcpy( &random_ld, &raw_random_ld_mantissa, sizeof(raw_random_ld_mantissa) );
+        memcpy( ((char*)( &random_ld )) + 8, &raw_random_ld_exponent, sizeof(raw_random_ld_exponent) );
+        str_size = sizeof(str) - 1;
+        str_end  = str;
+        dconvstr_print_status = dconvstr_print_ld(
+            &str_end, &str_size, random_ld,
+            'e', 0, 0, 25
+        );
+        *str_end = 0;
+        dconvstr_scan_status = dconvstr_scan_ld(
+            str, &str_actual_end, &alt_random_ld, &erange_condition
+        );
+        if(( !dconvstr_print_status )||( !dconvstr_scan_status )||( erange_condition )||
+           ( str_actual_end != str_end )||
+           ( 0 != memcmp( &random_ld, &alt_random_ld, 10 ) ))
+        {
+            fprintf(
+                stderr,
+                "Strict equality check of extended precision value in stress test failed:\n"
+                "    initial long double value:     %.21Le (raw: exponent 0x%04X, mantissa " UINT64_FORMAT_STRING ")\n"
+                "    converted to string:          `%s'\n"
+                "    converted back to long double: %.21Le\n"
+                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
+                random_ld, (unsigned int)raw_random_ld_exponent, raw_random_ld_mantissa,
+                str,
+                alt_random_ld,
+                initial_rng_state
+            );
+            exit(-1);
+        }
+#endif
+
+#ifdef DCONVSTR_HAVE_FLOAT128
+        // 7. Make sure the same holds for quadruple precision value: sign and exponent are taken from
+        //    16 most significant bits, 112-bit fraction is built from two scrambled 64-bit random values
+        uint64_t  raw_random_float128[2];
+        raw_random_float128[0] = raw_random_value * 0x9E3779B97F4A7C15ULL;
+        raw_random_float128[1] = (raw_random_value & 0xFFFF000000000000ULL) |
+                                 ((raw_random_value * 0xC2B2AE3D27D4EB4FULL) >> 16);
+        if((( raw_random_float128[1] >> 48 ) & 0x7FFF ) == 0x7FFF )
+        {
+            raw_random_float128[0] = 0;   // if NaN or infinity: make it NaN with fixed sign and payload
+            raw_random_float128[1] = 0xFFFF800000000000ULL;
+        }
+        __float128  random_float128 = 0, alt_random_float128 = 0;
+        memcpy( &random_float128, raw_random_float128, sizeof(random_float128) );
+        str_size = sizeof(str) - 1;
+        str_end  = str;
+        dconvstr_print_status = dconvstr_print_float128(
+            &str_end, &str_size, random_float128,
+            'e', 0, 0, 40
+        );
+        *str_end = 0;
+        dconvstr_scan_status = dconvstr_scan_float128(
+            str, &str_actual_end, &alt_random_float128, &erange_condition
+        );
+        if(( !dconvstr_print_status )||( !dconvstr_scan_status )||( erange_condition )||
+           ( str_actual_end != str_end )||
+           ( 0 != memcmp( &random_float128, &alt_random_float128, sizeof(random_float128) ) ))
+        {
+            char  raw_buf[2][40];
+            fprintf(
+                stderr,
+                "Strict equality check of quadruple precision value in stress test failed:\n"
+                "    initial __float128 value (raw):     %s\n"
+                "    converted to string:               `%s'\n"
+                "    converted back to __float128 (raw): %s\n"
+                "RNG state to reproduce this condition: " UINT64_FORMAT_STRING "\n",
+                format_raw_float128( raw_buf[0], random_float128 ),
+                str,
+                format_raw_float128( raw_buf[1], alt_random_float128 ),
+                initial_rng_state
+            );
+            exit(-1);
+        }
+#endif
+
+        // 8. Indication to user: stress test is running normally
+        if( i == 0x100000 )
+        {
+            fprintf( stderr, "." );
+            fflush( stderr );
+            i = 0;
+        }
+    }
+}
+
+/**
+ *
+ *  Execute exhaustive test of forward-backward conversion of single precision values
+ *
+ *  Bit patterns from thread->first to thread->last (inclusive) are split into chunks of 2^24,
+ *  and chunks are dealt out to threads in turn.
+ *
+ */
+static void  float_exhaustive_test( const struct test_thread*  thread )
+{
+    uint64_t  chunk_size = (1ULL << 24);
+    for( uint64_t  chunk = thread->first + chunk_size * (uint64_t)thread->index;
+         chunk <= thread->last;
+         chunk += chunk_size * (uint64_t)thread->n_threads )
+    {
+        uint64_t  chunk_last = ( (thread->last - chunk < chunk_size) ? thread->last : chunk + chunk_size - 1 );
+        for( uint64_t  raw_value = chunk; raw_value <= chunk_last; ++raw_value )
+        {
+            if(! verify_float( (uint32_t) raw_value ) )
+                exit(-1);
+        }
+        fprintf( stderr, "." );
+        fflush( stderr );
+    }
+}
+
+/**
+ *
+ *  Execute exponent-stratified test of forward-backward conversion of double precision values
+ *
+ *  For each of 4096 combinations of sign and biased exponent (NaN and infinities included), checks
+ *  mantissas nearest to the ends of binade and thread->first random mantissas. Strata are dealt out
+ *  to threads in turn; RNG stream of every stratum starts 2^52 * stratum steps ahead of the initial
+ *  RNG state, so results don't depend on number of threads.
+ *
+ */
+static void  double_sweep_test( const struct test_thread*  thread )
+{
+    static const uint64_t  edge_mantissas[] = {
+        0, 1, 2, (1ULL << 51) - 1, (1ULL << 51), (1ULL << 52) - 2, (1ULL << 52) - 1
+    };
+    for( uint64_t  stratum = (uint64_t) thread->index; stratum < 4096; stratum += (uint64_t) thread->n_threads )
+    {
+        // 1. Check mantissas at the ends and in the middle of binade
+        for( size_t  i = 0; i < sizeof(edge_mantissas) / sizeof(edge_mantissas[0]); ++i )
+        {
+            uint64_t  raw_value = (stratum << 52) | edge_mantissas[i];
+            if(! verify_double( raw_value ) )
+            {
+                fprintf( stderr, "Raw bits of tested value: 0x%016llX\n", (unsigned long long) raw_value );
+                exit(-1);
+            }
+        }
+
+        // 2. Check random mantissas
+        local_rng_state_ = thread->initial_rng_state;
+        local_rng_skip( stratum << 52 );
+        for( uint64_t  i = 0; i < thread->first; ++i )
+        {
+            uint64_t  initial_rng_state = local_rng_state_;
+            uint64_t  raw_value = (stratum << 52) | (local_rng_get_random_uint64() & ((1ULL << 52) - 1ULL));
+            if(! verify_double( raw_value ) )
+            {
+                fprintf( stderr, "Raw bits of tested value: 0x%016llX, RNG state: " UINT64_FORMAT_STRING "\n",
+                         (unsigned long long) raw_value, initial_rng_state );
+                exit(-1);
+            }
+        }
+
+        // 3. Indication to user: test is running normally
+        if( (stratum & 0x3F) == 0x3F )
+        {
+            fprintf( stderr, "." );
+            fflush( stderr );
+        }
+    }
+}
+
+/**
+ *
+ *  Print usage and exit
+ *
+ */
+static void  print_usage()
+{
+    fprintf(
+        stderr,
+        "Usage: dconvstr_test [options] [initial_rng_state]\n"
+        "Options:\n"
+        "  --threads[=N]                  run tests in N threads (default: number of CPUs)\n"
+        "  --float-exhaustive[=FIRST:LAST] check all single precision bit patterns (or hexadecimal range)\n"
+        "                                 instead of stress test\n"
+        "  --double-sweep[=N]             check N random mantissas (default: 16384) and edge mantissas\n"
+        "                                 for every sign and exponent of double instead of stress test\n"
+    );
+    exit(-1);
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main( int  argc, const char* const*  argv )
+{
+    // 1. Check command line
+    int       n_threads        = 1;
+    int       float_exhaustive = 0;
+    uint64_t  float_first      = 0;
+    uint64_t  float_last       = 0xFFFFFFFFULL;
+    int       double_sweep     = 0;
+    uint64_t  double_sweep_n   = 16384;
+    int       have_rng_state   = 0;
+    for( int  a = 1; a < argc; ++a )
+    {
+        const char*  arg = argv[a];
+        if( 0 == strcmp( arg, "--threads" ) )
+            n_threads = get_number_of_cpus();
+        else if( 0 == strncmp( arg, "--threads=", 10 ) )
+        {
+            n_threads = atoi( arg + 10 );
+            if(( n_threads < 1 )||( n_threads > MAX_THREADS ))
+                print_usage();
+        }
+        else if( 0 == strcmp( arg, "--float-exhaustive" ) )
+            float_exhaustive = 1;
+        else if( 0 == strncmp( arg, "--float-exhaustive=", 19 ) )
+        {
+            char*  range_end = NULL;
+            float_exhaustive = 1;
+            float_first = strtoull( arg + 19, &range_end, 16 );
+            if( *range_end != ':' )
+                print_usage();
+            float_last = strtoull( range_end + 1, &range_end, 16 );
+            if(( *range_end != 0 )||( float_first > float_last )||( float_last > 0xFFFFFFFFULL ))
+                print_usage();
+        }
+        else if( 0 == strcmp( arg, "--double-sweep" ) )
+            double_sweep = 1;
+        else if( 0 == strncmp( arg, "--double-sweep=", 15 ) )
+        {
+            double_sweep   = 1;
+            double_sweep_n = strtoull( arg + 15, 0, 10 );
+        }
+        else if(( arg[0] != '-' )&&( !have_rng_state ))
+        {
+            // 2. Initialize local RNG (optional)
+            errno = 0;
+            uint64_t  parse_result = strtoull( arg, 0, 10 );
+            if( errno != 0 )
+            {
+                fprintf( stderr, "Can't parse command line (initial RNG state)\n" );
+                exit(-1);
+            }
+            local_rng_state_ = parse_result;
+            have_rng_state   = 1;
+        }
+        else
+            print_usage();
+    }
+    if( float_exhaustive && double_sweep )
+        print_usage();
+    fprintf( stderr, "Running dconvstr_test, build date " __DATE__ " " __TIME__ "\n" );
+
+    // 3. Run tests
+    all_static_tests();
+    if( float_exhaustive )
+    {
+        fprintf( stderr, "Running exhaustive single precision test in %d thread(s)...\n", n_threads );
+        run_test_threads( float_exhaustive_test, n_threads, float_first, float_last );
+        fprintf( stderr, "\nPassed: " UINT64_FORMAT_STRING " bit patterns\n", float_last - float_first + 1 );
+    }
+    else if( double_sweep )
+    {
+        fprintf( stderr, "Running exponent-stratified double precision test in %d thread(s)...\n", n_threads );
+        run_test_threads( double_sweep_test, n_threads, double_sweep_n, 0 );
+        fprintf( stderr, "\nPassed: 4096 strata\n" );
+    }
+    else
+    {
+        fprintf( stderr, "Running stress test in %d thread(s)...\n", n_threads );
+        run_test_threads( stress_test, n_threads, 0, 0 );    // never returns
+    }
+    return  0;
 }
@@ -0,0 +1,212 @@
+/*
+ *  Test of compile-time conversions of dconvstr (dconvstr_constexpr.hpp)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "dconvstr_constexpr.hpp"
+#include "dconvstr.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <limits>
+
+
+//=====================================================================================================
+//
+// COMPILE-TIME TESTS
+//
+
+static_assert( dconvstr::parse( "0.1" )                     == 0.1                     );
+static_assert( dconvstr::parse( "-2.5e-7" )                 == -2.5e-7                 );
+static_assert( dconvstr::parse( "  1.7976931348623157e308" ) == 1.7976931348623157e308  );
+static_assert( dconvstr::parse( "4.9406564584124654e-324" ) == 4.9406564584124654e-324 );
+static_assert( dconvstr::parse( "-inf" )                    == -std::numeric_limits<double>::infinity() );
+
+static_assert( dconvstr::format( 0.1 )                     == "0.1"                     );
+static_assert( dconvstr::format( -0.0 )                    == "-0"                      );
+static_assert( dconvstr::format( 100.0 )                   == "100"                     );
+static_assert( dconvstr::format( 1e16 )                    == "10000000000000000"       );
+static_assert( dconvstr::format( 1e17 )                    == "1e+17"                   );
+static_assert( dconvstr::format( 1.5e-7 )                  == "1.5e-07"                 );
+static_assert( dconvstr::format( 0.0001 )                  == "0.0001"                  );
+static_assert( dconvstr::format( 1.7976931348623157e308 )  == "1.7976931348623158e+308" );
+static_assert( dconvstr::format<3.14>()                    == "3.14"                    );
+
+// Printing with format fixed at compile time
+template< dconvstr::Format  format, int  precision >
+constexpr bool  is_printed( double  value, const char*  expected )
+{
+    char  buf[dconvstr::print_max_size<format, precision>] = {};
+    char*  buf_end = dconvstr::print<format, precision>( buf, value );
+    int  i = 0;
+    for( ; ( buf + i != buf_end )&&( buf[i] == expected[i] ); ++i )
+        ;
+    return(( buf + i == buf_end )&&( expected[i] == 0 ));
+}
+static_assert( is_printed<dconvstr::Format::Fixed,      6>( 0.1,     "0.100000"     ) );
+static_assert( is_printed<dconvstr::Format::Fixed,      0>( 2.5,     "3"            ) );
+static_assert( is_printed<dconvstr::Format::Fixed,      2>( -0.001,  "-0.00"        ) );
+static_assert( is_printed<dconvstr::Format::Scientific, 6>( 1234.5,  "1.234500e+03" ) );
+static_assert( is_printed<dconvstr::Format::Scientific, 0>( 1e-300,  "1e-300"       ) );
+static_assert( is_printed<dconvstr::Format::General,    6>( 1e-5,    "1e-05"        ) );
+static_assert( is_printed<dconvstr::Format::General,    6>( 123456.7, "123457"      ) );
+
+// Round trip of constants
+static_assert( dconvstr::parse( dconvstr::format( 0.3 ).c_str() )             == 0.3            );
+static_assert( dconvstr::parse( dconvstr::format( 1.0 / 3.0 ).c_str() )       == 1.0 / 3.0      );
+static_assert( dconvstr::parse( dconvstr::format( 2.2250738585072014e-308 ).c_str() ) == 2.2250738585072014e-308 );
+
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Make sure dconvstr::print() gives the same result as dconvstr_print() during runtime
+ *
+ */
+template< dconvstr::Format  format, int  precision >
+static void  compare_print_with_runtime( double  value, int  format_char )
+{
+    char   buf[400];
+    char*  buf_end  = buf;
+    int    buf_size = sizeof(buf);
+    if(! dconvstr_print( &buf_end, &buf_size, value, format_char, 0, 0, precision ) )
+    {
+        fprintf( stderr, "dconvstr_print() failed for val=%.17g\n", value );
+        exit(-1);
+    }
+    char   alt_buf[dconvstr::print_max_size<format, precision>];
+    char*  alt_buf_end = dconvstr::print<format, precision>( alt_buf, value );
+    if(( alt_buf_end - alt_buf != buf_end - buf )||( 0 != std::memcmp( alt_buf, buf, buf_end - buf ) ))
+    {
+        *buf_end = 0;
+        fprintf( stderr, "Test failed for val=%.17g format=%c precision=%d: printed `%.*s', expected `%s'\n",
+                 value, format_char, precision, (int)( alt_buf_end - alt_buf ), alt_buf, buf );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Make sure dconvstr::format() and dconvstr::scan() give the same results as dconvstr_print()
+ *  and dconvstr_scan() during runtime
+ *
+ */
+static void  compare_with_runtime( double  value )
+{
+    // 1. Print value
+    char   buf[64];
+    char*  buf_end  = buf;
+    int    buf_size = sizeof(buf);
+    if(! dconvstr_print( &buf_end, &buf_size, value, 'g', 0, 0, 17 ) )
+    {
+        fprintf( stderr, "dconvstr_print() failed for val=%.17g\n", value );
+        exit(-1);
+    }
+    *buf_end = 0;
+    dconvstr::shortest_string  str = dconvstr::format( value );
+    if(!( str == buf ))
+    {
+        fprintf( stderr, "Test failed for val=%.17g: printed `%s', expected `%s'\n", value, str.c_str(), buf );
+        exit(-1);
+    }
+
+    // 2. Print value in other formats
+    compare_print_with_runtime<dconvstr::Format::Scientific, 0>(  value, 'e' );
+    compare_print_with_runtime<dconvstr::Format::Scientific, 6>(  value, 'e' );
+    compare_print_with_runtime<dconvstr::Format::Scientific, 20>( value, 'e' );
+    compare_print_with_runtime<dconvstr::Format::Fixed,      0>(  value, 'f' );
+    compare_print_with_runtime<dconvstr::Format::Fixed,      6>(  value, 'f' );
+    compare_print_with_runtime<dconvstr::Format::Fixed,      20>( value, 'f' );
+    compare_print_with_runtime<dconvstr::Format::General,    0>(  value, 'g' );
+    compare_print_with_runtime<dconvstr::Format::General,    6>(  value, 'g' );
+    compare_print_with_runtime<dconvstr::Format::General,    25>( value, 'g' );
+
+    // 3. Scan printed value, also with truncated mantissa
+    for( int  n = buf_end - buf; n > 0; n -= 3 )
+    {
+        buf[n] = 0;
+        const char*  end1 = nullptr;   double  value1 = 0.0;   int  erange1 = 0;
+        const char*  end2 = nullptr;   double  value2 = 0.0;   int  erange2 = 0;
+        int  status1 = dconvstr_scan( buf, &end1, &value1, &erange1 );
+        int  status2 = dconvstr::scan( buf, &end2, &value2, &erange2 );
+        if(( status1 != status2 )||( end1 != end2 )||( erange1 != erange2 )||
+           ( 0 != std::memcmp( &value1, &value2, sizeof(value1) ) ))
+        {
+            fprintf( stderr, "Test failed for str=%s: scanned %.17g, expected %.17g\n", buf, value2, value1 );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Execute test of random values
+ *
+ */
+static void  random_test( int  n_values )
+{
+    fprintf( stderr, "Running random test...\n" );
+
+    static const double  special_values[] = {
+        0.0, -0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(), 1e22, 1e23, 5e-324, 2.2250738585072009e-308
+    };
+    for( double  value : special_values )
+        compare_with_runtime( value );
+
+    std::uint64_t  rng_state = 1;
+    for( int  i = 0; i < n_values; ++i )
+    {
+        rng_state = 6364136223846793005ULL * rng_state + 1442695040888963407ULL;
+        std::uint64_t  raw_value = rng_state ^ (rng_state >> 29);
+        double  value = 0.0;
+        std::memcpy( &value, &raw_value, sizeof(value) );
+        compare_with_runtime( value );
+
+        // values of moderate magnitude, which are printed in fixed format with rounding
+        double  price = ((double)( raw_value % 100000000ULL )) / 1000.0;
+        compare_with_runtime( price );
+        compare_with_runtime( price * 1e-7 );
+    }
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main()
+{
+    fprintf( stderr, "Running dconvstr_test_constexpr, build date " __DATE__ " " __TIME__ "\n" );
+    random_test( 1000000 );
+    fprintf( stderr, "Passed\n" );
+    return  0;
+}
@@ -0,0 +1,220 @@
+/*
+ *  Test of formatters of dconvstr for {fmt} library (dconvstr_format.hpp)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <fmt/format.h>
+#include "dconvstr_format.hpp"
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Make sure value is formatted by dconvstr as expected
+ *
+ */
+static void  ensure_formatted( const char*  spec, double  value, const char*  expected )
+{
+    std::string  str = fmt::format( fmt::runtime( spec ), dconvstr::number{ value } );
+    if( str != expected )
+    {
+        fprintf( stderr, "Test failed for spec=%s val=%.17g: got `%s', expected `%s'\n", spec, value, str.c_str(), expected );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Make sure format specification is rejected
+ *
+ */
+static void  ensure_rejected( const char*  spec )
+{
+    try
+    {
+        std::string  str = fmt::format( fmt::runtime( spec ), dconvstr::number{ 1.0 } );
+        fprintf( stderr, "Test failed for spec=%s: got `%s', expected format error\n", spec, str.c_str() );
+        exit(-1);
+    }
+    catch( const fmt::format_error& )
+    {
+    }
+}
+
+/**
+ *
+ *  Execute all static tests
+ *
+ */
+static void  all_static_tests()
+{
+    fprintf( stderr, "Running static tests...\n" );
+
+    const double  inf = std::numeric_limits<double>::infinity();
+    const double  nan = std::numeric_limits<double>::quiet_NaN();
+    ensure_formatted( "{}",           0.1,       "0.1"             );
+    ensure_formatted( "{}",           1e22,      "1e+22"           );
+    ensure_formatted( "{}",           -0.0,      "-0"              );
+    ensure_formatted( "{:+}",         2.5,       "+2.5"            );
+    ensure_formatted( "{: }",         2.5,       " 2.5"            );
+    ensure_formatted( "{:#}",         1.0,       "1."              );
+    ensure_formatted( "{:#}",         1e22,      "1.e+22"          );
+    ensure_formatted( "{:e}",         1234.5,    "1.234500e+03"    );
+    ensure_formatted( "{:.2E}",       1234.5,    "1.23E+03"        );
+    ensure_formatted( "{:f}",         0.1,       "0.100000"        );
+    ensure_formatted( "{:.0f}",       2.5,       "3"               );
+    ensure_formatted( "{:#.0f}",      2.5,       "3."              );
+    ensure_formatted( "{:g}",         1e-5,      "1e-05"           );
+    ensure_formatted( "{:G}",         1e-5,      "1E-05"           );
+    ensure_formatted( "{:#g}",        1.5,       "1.50000"         );
+    ensure_formatted( "{:.3}",        1234.5,    "1.23e+03"        );
+    ensure_formatted( "{:10.3f}",     -1.5,      "    -1.500"      );
+    ensure_formatted( "{:<10.3f}",    -1.5,      "-1.500    "      );
+    ensure_formatted( "{:^10.3f}",    -1.5,      "  -1.500  "      );
+    ensure_formatted( "{:*^11.3f}",   -1.5,      "**-1.500***"     );
+    ensure_formatted( "{:010.3f}",    -1.5,      "-00001.500"      );
+    ensure_formatted( "{:+010}",      1.5,       "+0000001.5"      );
+    ensure_formatted( "{:<010}",      1.5,       "1.5       "      );
+    ensure_formatted( "{:0>6}",       1.5,       "0001.5"          );
+    ensure_formatted( "{:\xC2\xB7>6}", 1.5,      "\xC2\xB7\xC2\xB7\xC2\xB7" "1.5" );
+    ensure_formatted( "{}",           inf,       "inf"             );
+    ensure_formatted( "{:+F}",        inf,       "+INF"            );
+    ensure_formatted( "{:06}",        -inf,      "  -inf"          );
+    ensure_formatted( "{}",           nan,       "nan"             );
+    ensure_formatted( "{:E}",         -nan,      "-NAN"            );
+    ensure_formatted( "{:.700f}",     1e308,     ("1" + std::string( 308, '0' ) + "." + std::string( 700, '0' )).c_str() );
+
+    ensure_rejected( "{:a}"    );
+    ensure_rejected( "{:d}"    );
+    ensure_rejected( "{:L}"    );
+    ensure_rejected( "{:.}"    );
+    ensure_rejected( "{:.701f}" );
+    ensure_rejected( "{:{}}"   );
+    ensure_rejected( "{:5.2fx}" );
+    ensure_rejected( "{:99999999999}" );
+
+    // Formatter of own type derived from dconvstr formatter
+    std::string  str = fmt::format( "{:.2f} {:>8.1e}", dconvstr::number{ 3.14159 }, dconvstr::number{ 1234.5 } );
+    if( str != "3.14  1.2e+03" )
+    {
+        fprintf( stderr, "Test failed for two arguments: got `%s'\n", str.c_str() );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute test of random values: formatting must give the same result as dconvstr_print() with
+ *  equivalent printf(3) format
+ *
+ */
+static void  random_test( int  n_values )
+{
+    fprintf( stderr, "Running random test...\n" );
+
+    static const char* const  specs[] = {
+        "{:e}", "{:.3e}", "{:+015.6E}", "{:f}", "{:.2f}", "{:#.0f}", "{:g}", "{:.12g}", "{:-#20.10G}", "{: .17}"
+    };
+    static const char  flags[] = { 0, 0, '+', 0, 0, '#', 0, 0, '#', ' ' };
+    static const int    widths[] = { 0, 0, 15, 0, 0, 0, 0, 0, 20, 0 };
+    static const int    precisions[] = { 6, 3, 6, 6, 2, 0, 6, 12, 10, 17 };
+    static const char   types[] = { 'e', 'e', 'E', 'f', 'f', 'f', 'g', 'g', 'G', 'g' };
+    std::uint64_t  rng_state = 1;
+    for( int  i = 0; i < n_values; ++i )
+    {
+        // 1. Generate random double-precision floating point value of moderate magnitude
+        rng_state = 6364136223846793005ULL * rng_state + 1442695040888963407ULL;
+        std::uint64_t  raw_value = rng_state ^ (rng_state >> 29);
+        double  value = ((double)( (std::int64_t)( raw_value ) >> 11 )) * 1e-9;
+        if( i % 4 == 1 )
+            value *= 1e-20;
+        else if( i % 4 == 2 )
+            value = ((double)( (std::int64_t)( raw_value ) >> 50 )) / 64.0;
+
+        // 2. Format value with each specification
+        for( int  s = 0; s < (int)( sizeof(specs) / sizeof(specs[0]) ); ++s )
+        {
+            std::string  str = fmt::format( fmt::runtime( specs[s] ), dconvstr::number{ value } );
+            char   buf[400];
+            char*  buf_end  = buf;
+            int    buf_size = sizeof(buf);
+            unsigned int  format_flags = ( (flags[s] == '+') ? DCONVSTR_FLAG_PRINT_PLUS : 0 ) |
+                                         ( (flags[s] == '#') ? DCONVSTR_FLAG_SHARP : 0 ) |
+                                         ( (flags[s] == ' ') ? DCONVSTR_FLAG_SPACE_IF_PLUS : 0 ) |
+                                         ( (types[s] < 'a') ? DCONVSTR_FLAG_UPPERCASE : 0 ) |
+                                         ( widths[s] ? (DCONVSTR_FLAG_HAVE_WIDTH | DCONVSTR_FLAG_PAD_WITH_ZERO) : 0 );
+            if( s == 8 )
+                format_flags &= ~DCONVSTR_FLAG_PAD_WITH_ZERO;
+            if(! dconvstr_print( &buf_end, &buf_size, value, types[s] | 0x20, format_flags, widths[s], precisions[s] ) )
+            {
+                fprintf( stderr, "dconvstr_print() failed for val=%.17g\n", value );
+                exit(-1);
+            }
+            if( str != std::string( buf, buf_end ) )
+            {
+                fprintf( stderr, "Random test failed for spec=%s val=%.17g: got `%s', expected `%.*s'\n",
+                         specs[s], value, str.c_str(), (int)( buf_end - buf ), buf );
+                exit(-1);
+            }
+        }
+
+        // 3. Shortest representation is converted back to the same value
+        std::string  str = fmt::format( "{}", dconvstr::number{ value } );
+        double  alt_value = 0.0;
+        dconvstr::from_chars( str.data(), str.data() + str.size(), alt_value );
+        if( alt_value != value )
+        {
+            fprintf( stderr, "Random test failed for val=%.17g: shortest `%s' is scanned as %.17g\n",
+                     value, str.c_str(), alt_value );
+            exit(-1);
+        }
+    }
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main()
+{
+    fprintf( stderr, "Running dconvstr_test_format, build date " __DATE__ " " __TIME__ "\n" );
+    all_static_tests();
+    random_test( 200000 );
+    fprintf( stderr, "Passed\n" );
+    return  0;
+}
@@ -0,0 +1,233 @@
+/*
+ *  Test of C++ interface of dconvstr (dconvstr.hpp)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "dconvstr.hpp"
+
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Make sure dconvstr::to_chars() prints value in shortest representation with given format
+ *  (fmt_index: 0 = no format, 1 = fixed, 2 = scientific, 3 = general)
+ *
+ */
+static void  ensure_printed( double  value, int  fmt_index, const char*  expected )
+{
+    static const std::chars_format  formats[4] = {
+        std::chars_format::general, std::chars_format::fixed, std::chars_format::scientific, std::chars_format::general
+    };
+    char  buf[400];
+    std::to_chars_result  result = ( (fmt_index == 0) ? dconvstr::to_chars( buf, buf + sizeof(buf), value )
+                                                      : dconvstr::to_chars( buf, buf + sizeof(buf), value, formats[fmt_index] ) );
+    size_t  expected_size = std::strlen( expected );
+    if(( result.ec != std::errc() )||( (size_t)( result.ptr - buf ) != expected_size )||
+       ( 0 != std::memcmp( buf, expected, expected_size ) ))
+    {
+        fprintf( stderr, "Test failed for val=%.17g fmt=%d: expected `%s'\n", value, fmt_index, expected );
+        exit(-1);
+    }
+
+    // Buffer which is one char shorter is not enough
+    result = ( (fmt_index == 0) ? dconvstr::to_chars( buf, buf + expected_size - 1, value )
+                                : dconvstr::to_chars( buf, buf + expected_size - 1, value, formats[fmt_index] ) );
+    if(( result.ec != std::errc::value_too_large )||( result.ptr != buf + expected_size - 1 ))
+    {
+        fprintf( stderr, "Overflow test failed for val=%.17g fmt=%d\n", value, fmt_index );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Make sure dconvstr::from_chars() parses expected_size chars of str with expected result
+ *
+ */
+static void  ensure_scanned( const char*  str, std::chars_format  fmt, int  expected_size, std::errc  expected_ec, double  expected )
+{
+    double  value = -12345.0;
+    std::from_chars_result  result = dconvstr::from_chars( str, str + std::strlen( str ), value, fmt );
+    if( result.ec != std::errc() )
+        expected = -12345.0;   // value is not modified on error
+    if(( result.ec != expected_ec )||( result.ptr != str + expected_size )||
+       (( value != expected )&&(!( std::isnan( value ) && std::isnan( expected ) )))||
+       ( std::signbit( value ) != std::signbit( expected ) ))
+    {
+        fprintf( stderr, "Test failed for str=%s: parsed %d chars, value=%.17g\n", str, (int)( result.ptr - str ), value );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute all static tests
+ *
+ */
+static void  all_static_tests()
+{
+    fprintf( stderr, "Running static tests...\n" );
+
+    ensure_printed( 0.1,        0, "0.1"          );
+    ensure_printed( -0.0,       0, "-0"           );
+    ensure_printed( 100.0,      0, "100"          );
+    ensure_printed( 1e22,       0, "1e+22"        );
+    ensure_printed( 1.5e-7,     0, "1.5e-07"      );
+    ensure_printed( 0.001,      0, "0.001"        );    // tie of lengths, fixed one is preferred
+    ensure_printed( 1e300,      0, "1e+300"       );
+    ensure_printed( -HUGE_VAL,  0, "-inf"         );
+    ensure_printed( NAN,        0, "nan"          );
+    ensure_printed( 1e22,       1, "10000000000000000000000" );
+    ensure_printed( 1.5e-7,     1, "0.00000015"   );
+    ensure_printed( 123.25,     1, "123.25"       );
+    ensure_printed( 100.0,      2, "1e+02"        );
+    ensure_printed( 0.1,        2, "1e-01"        );
+    ensure_printed( 123.25,     2, "1.2325e+02"   );
+    ensure_printed( 123456.0,   3, "123456"       );
+    ensure_printed( 1234567.0,  3, "1.234567e+06" );
+    ensure_printed( 0.0001,     3, "0.0001"       );
+    ensure_printed( 0.00001,    3, "1e-05"        );
+
+    char  buf[64];
+    std::to_chars_result  result = dconvstr::to_chars( buf, buf + sizeof(buf), 1.5, std::chars_format::fixed, 3 );
+    if(( result.ec != std::errc() )||( result.ptr != buf + 5 )||( 0 != std::memcmp( buf, "1.500", 5 ) ))
+    {
+        fprintf( stderr, "Test failed for precision 3 in fixed format\n" );
+        exit(-1);
+    }
+    result = dconvstr::to_chars( buf, buf + sizeof(buf), 1.5, std::chars_format::hex );
+    if( result.ec != std::errc::invalid_argument )
+    {
+        fprintf( stderr, "Test failed for hexadecimal format\n" );
+        exit(-1);
+    }
+
+    const std::chars_format  general = std::chars_format::general;
+    const std::chars_format  fixed   = std::chars_format::fixed;
+    const std::chars_format  sci     = std::chars_format::scientific;
+    ensure_scanned( "1.5",           general,  3, std::errc(),                     1.5       );
+    ensure_scanned( "-.5e+3x",       general,  6, std::errc(),                  -500.0       );
+    ensure_scanned( "1.",            general,  2, std::errc(),                     1.0       );
+    ensure_scanned( "1e",            general,  1, std::errc(),                     1.0       );
+    ensure_scanned( "1e+",           general,  1, std::errc(),                     1.0       );
+    ensure_scanned( "1e5",           fixed,    1, std::errc(),                     1.0       );
+    ensure_scanned( "1e5",           sci,      3, std::errc(),                1.0e5          );
+    ensure_scanned( "15",            sci,      0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( "-0",            general,  2, std::errc(),                    -0.0       );
+    ensure_scanned( "00001.5000",    general, 10, std::errc(),                     1.5       );
+    ensure_scanned( "0e99999999999", general, 13, std::errc(),                     0.0       );
+    ensure_scanned( "InFiNiTy",      general,  8, std::errc(),                HUGE_VAL       );
+    ensure_scanned( "-infx",         general,  4, std::errc(),               -HUGE_VAL       );
+    ensure_scanned( "nan(abc_1)",    general, 10, std::errc(),                     NAN       );
+    ensure_scanned( "nan(",          general,  3, std::errc(),                     NAN       );
+    ensure_scanned( "1e400",         general,  5, std::errc::result_out_of_range,  0.0       );
+    ensure_scanned( "-1e-400",       general,  7, std::errc::result_out_of_range,  0.0       );
+    ensure_scanned( "1e320",         general,  5, std::errc::result_out_of_range,  0.0       );
+    ensure_scanned( "1e-400000",     general,  9, std::errc::result_out_of_range,  0.0       );
+    ensure_scanned( "-1e-330",       general,  7, std::errc::result_out_of_range,  0.0       );
+    ensure_scanned( "",              general,  0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( ".",             general,  0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( "-",             general,  0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( "+1",            general,  0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( " 1",            general,  0, std::errc::invalid_argument,     0.0       );
+    ensure_scanned( "0.000000000000000000000000000000000000000000000000123456789012345678901234567890",
+                                     general, 80, std::errc(),          1.2345678901234568e-49 );
+    ensure_scanned( "123456789012345678901234567890123456789012345678901234567890",
+                                     general, 60, std::errc(),          1.2345678901234568e+59 );
+
+    // String is not required to be terminated with zero
+    const char*  str = "2.5e10";
+    double  value = 0.0;
+    std::from_chars_result  scan_result = dconvstr::from_chars( str, str + 3, value );
+    if(( scan_result.ec != std::errc() )||( scan_result.ptr != str + 3 )||( value != 2.5 ))
+    {
+        fprintf( stderr, "Test failed for string which is not terminated with zero\n" );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute test of forward-backward conversion of random values in all formats
+ *
+ */
+static void  random_test( int  n_values )
+{
+    fprintf( stderr, "Running random test...\n" );
+
+    static const std::chars_format  formats[3] = {
+        std::chars_format::fixed, std::chars_format::scientific, std::chars_format::general
+    };
+    std::uint64_t  rng_state = 1;
+    for( int  i = 0; i < n_values; ++i )
+    {
+        // 1. Generate random double-precision floating point value (NaNs are skipped)
+        rng_state = 6364136223846793005ULL * rng_state + 1442695040888963407ULL;
+        std::uint64_t  raw_value = rng_state ^ (rng_state >> 29);
+        double  value = 0.0;
+        std::memcpy( &value, &raw_value, sizeof(value) );
+        if( std::isnan( value ) )
+            continue;
+
+        // 2. Print it in every format and convert back
+        for( int  f = 0; f < 4; ++f )
+        {
+            char  buf[400];
+            std::to_chars_result  result = ( (f == 3) ? dconvstr::to_chars( buf, buf + sizeof(buf), value )
+                                                      : dconvstr::to_chars( buf, buf + sizeof(buf), value, formats[f] ) );
+            double  alt_value = 0.0;
+            std::from_chars_result  scan_result = dconvstr::from_chars( buf, result.ptr, alt_value );
+            if(( result.ec != std::errc() )||( scan_result.ec != std::errc() )||( scan_result.ptr != result.ptr )||
+               ( 0 != std::memcmp( &value, &alt_value, sizeof(value) ) ))
+            {
+                fprintf( stderr, "Random test failed for val=%.17g fmt=%d\n", value, f );
+                exit(-1);
+            }
+        }
+    }
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main()
+{
+    fprintf( stderr, "Running dconvstr_test_hpp, build date " __DATE__ " " __TIME__ "\n" );
+    all_static_tests();
+    random_test( 1000000 );
+    fprintf( stderr, "Passed\n" );
+    return  0;
+}
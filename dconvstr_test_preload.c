@@ -0,0 +1,339 @@
+/*
+ *  Test of interposer of strtod(3) and snprintf(3) family (dconvstr_preload.c)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+//
+//  Compares interposed functions with the same functions of glibc. Run with interposer preloaded:
+//
+//      LD_PRELOAD=./dconvstr_preload.so ./dconvstr_test_preload
+//
+
+#ifndef _GNU_SOURCE
+#  define _GNU_SOURCE      // for RTLD_DEFAULT
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <errno.h>
+#include <math.h>
+#include <fenv.h>
+#include <locale.h>
+#include <dlfcn.h>
+
+
+//=====================================================================================================
+//
+// CONSTANTS AND GLOBAL VARIABLES
+//
+
+typedef double  (*strtod_function)( const char*, char** );
+typedef float   (*strtof_function)( const char*, char** );
+typedef int     (*vsnprintf_function)( char*, size_t, const char*, va_list );
+
+static strtod_function     real_strtod_    = NULL;
+static strtof_function     real_strtof_    = NULL;
+static vsnprintf_function  real_vsnprintf_ = NULL;
+
+static uint64_t  rng_state_ = 1;
+
+// _FORTIFY_SOURCE variant of snprintf(), normally called by macro of <stdio.h>
+int  __snprintf_chk( char*  str, size_t  maxlen, int  flag, size_t  slen, const char*  format, ... );
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Generate random 64-bit unsigned integer
+ *
+ */
+static uint64_t  get_random_uint64()
+{
+    rng_state_ = 6364136223846793005ULL * rng_state_ + 1442695040888963407ULL;
+    uint64_t  a = rng_state_ >> 32;
+    rng_state_ = 6364136223846793005ULL * rng_state_ + 1442695040888963407ULL;
+    return  (a << 32) | (rng_state_ >> 32);
+}
+
+/**
+ *
+ *  Generate random double: any bit pattern, or random mantissa with moderate exponent
+ *
+ */
+static double  get_random_double()
+{
+    uint64_t  bits = get_random_uint64();
+    double  value;
+    memcpy( &value, &bits, sizeof(value) );
+    if( bits & 1 )
+        value = ldexp( value, -ilogb( value ) + (int)( (bits >> 1) % 80 ) - 40 );
+    return  value;
+}
+
+/**
+ *
+ *  Call vsnprintf() of glibc
+ *
+ */
+static int  real_snprintf( char*  str, size_t  size, const char*  format, ... )
+{
+    va_list  args;
+    va_start( args, format );
+    int  n = real_vsnprintf_( str, size, format, args );
+    va_end( args );
+    return  n;
+}
+
+/**
+ *
+ *  Make sure strtod(), strtof() and atof() give the same results as in glibc
+ *
+ */
+static void  ensure_scanned( const char*  str )
+{
+    char*   end = NULL;
+    char*   expected_end = NULL;
+    errno = 0;
+    double  value = strtod( str, &end );
+    int     value_errno = errno;
+    errno = 0;
+    double  expected = real_strtod_( str, &expected_end );
+    int     expected_errno = errno;
+    if(( 0 != memcmp( &value, &expected, sizeof(value) ) )||( end != expected_end )||( value_errno != expected_errno ))
+    {
+        fprintf( stderr, "Test failed for strtod(\"%s\"): got %a (end %d, errno %d), expected %a (end %d, errno %d)\n",
+                 str, value, (int)( end - str ), value_errno, expected, (int)( expected_end - str ), expected_errno );
+        exit(-1);
+    }
+    double  atof_value = atof( str );
+    if( 0 != memcmp( &atof_value, &expected, sizeof(value) ) )
+    {
+        fprintf( stderr, "Test failed for atof(\"%s\"): got %a, expected %a\n", str, atof_value, expected );
+        exit(-1);
+    }
+    errno = 0;
+    float  float_value = strtof( str, &end );
+    value_errno = errno;
+    errno = 0;
+    float  float_expected = real_strtof_( str, &expected_end );
+    expected_errno = errno;
+    if(( 0 != memcmp( &float_value, &float_expected, sizeof(float_value) ) )||( end != expected_end )||
+       ( value_errno != expected_errno ))
+    {
+        fprintf( stderr, "Test failed for strtof(\"%s\"): got %a (end %d, errno %d), expected %a (end %d, errno %d)\n",
+                 str, float_value, (int)( end - str ), value_errno, float_expected, (int)( expected_end - str ),
+                 expected_errno );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Make sure snprintf() with one double argument gives the same result as in glibc
+ *
+ */
+static void  ensure_printed( const char*  format, double  value, size_t  size )
+{
+    char  str[1200], expected[1200];
+    memset( str, 'x', sizeof(str) );
+    memset( expected, 'x', sizeof(expected) );
+    int  n = snprintf( str, size, format, value );
+    int  expected_n = real_snprintf( expected, size, format, value );
+    if(( n != expected_n )||( 0 != memcmp( str, expected, sizeof(str) ) ))
+    {
+        fprintf( stderr, "Test failed for snprintf(size=%d, \"%s\", %a): got %d `%.*s', expected %d `%.*s'\n",
+                 (int)( size ), format, value, n, (int)( size ), str, expected_n, (int)( size ), expected );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute all static tests
+ *
+ */
+static void  all_static_tests()
+{
+    fprintf( stderr, "Running static tests...\n" );
+
+    static const char* const  strings[] = {
+        "0", "-0", "+0.0e10", "1", "  -1.5e3xyz", "\t\n.5", "5.", ".", "-.e5", "1e", "1e+", "1e-x", "0x1p3",
+        "0X1.8P1", "inf", "-Infinity", "nan", "nan(123)", "", "   ", "abc", "1e400", "-1e-400", "4.9e-324",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "1.7976931348623157e308", "1.7976931348623159e308",
+        "8.130e21", "2.377e72", "7.125e-87", "9007199254740993", "9007199254740992.5", "0.1", "3.14159",
+        "123456789012345678", "1234567890123456789", "12345678901234567890", "0.000000000000000000001234",
+        "1e99999999999", "1e-99999999999", "000000000000000000000000001.5", "3.4028235e38", "3.4028236e38",
+        "1.4e-45", "1.17549435e-38", "16777217", "16777216.000000001", "0.100000001490116119384765625",
+        "1,5", "1.5.5", "--1", "+-1"
+    };
+    for( size_t  i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i )
+        ensure_scanned( strings[i] );
+
+    static const char* const  formats[] = {
+        "%g", "%e", "%f", "%G", "%E", "%F", "%.0f", "%.0e", "%.0g", "%#.0f", "%#.0e", "%#g", "%.3f", "%.15g",
+        "%.16g", "%.17g", "%.20e", "%.300f", "%-08.3f|", "%+ .2e", "% g", "%012.4e", "%-12g|", "%+f",
+        "x=%g%%", "%%%f%%", "%5.1f %5.1f", "%d", "%s", "%*g", "%.*f", "%Lg", "%lf", "%a", "%1$g", "%'.2f",
+        "%500f", "%.500f", "%'f", "%I"
+    };
+    static const double  values[] = {
+        0.0, -0.0, 1.0, -1.5, 0.1, 0.125, 2.5, 0.5, 1e22, 1e23, 123456.789, 9.5, 0.05, 1e-5, 0.0001, 99999.5,
+        1.7976931348623157e308, 2.2250738585072014e-308, 4.9e-324, INFINITY, -INFINITY, NAN, -NAN
+    };
+    for( size_t  f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f )
+    {
+        // formats with int or long double arguments are not printed with these values
+        if(( strstr( formats[f], "%d" ) )||( strstr( formats[f], "%s" ) )||( strchr( formats[f], '*' ) )||
+           ( strstr( formats[f], "%L" ) ))
+            continue;
+        for( size_t  v = 0; v < sizeof(values) / sizeof(values[0]); ++v )
+        {
+            ensure_printed( formats[f], values[v], 1200 );
+            ensure_printed( formats[f], values[v], 4 );
+            ensure_printed( formats[f], values[v], 0 );
+        }
+    }
+
+    // Other conversions and argument types are left to glibc
+    char  str[200];
+    snprintf( str, sizeof(str), "%d %s %*.*f %Lg %.3f", 42, "abc", 8, 2, 3.14159, 0.1L, 2.0 );
+    if( 0 != strcmp( str, "42 abc     3.14 0.1 2.000" ) )
+    {
+        fprintf( stderr, "Test failed for mixed conversions: got `%s'\n", str );
+        exit(-1);
+    }
+    int  n = sprintf( str, "[%8.3e]", -1234.5678 );
+    if(( n != 12 )||( 0 != strcmp( str, "[-1.235e+03]" ) ))
+    {
+        fprintf( stderr, "Test failed for sprintf(): got %d `%s'\n", n, str );
+        exit(-1);
+    }
+    volatile size_t  truncated_size = 6;    // not known at compile time, no truncation warning
+    n = __snprintf_chk( str, truncated_size, 1, sizeof(str), "%.4f", 0.1 );
+    if(( n != 6 )||( 0 != strcmp( str, "0.100" ) ))
+    {
+        fprintf( stderr, "Test failed for __snprintf_chk(): got %d `%s'\n", n, str );
+        exit(-1);
+    }
+
+    // Alternative form of 'g' is left to glibc, where rounding to new decade gives "1.e+02"
+    ensure_printed( "%#.2g", 0x1.8eb74bc6a7efap+6, 100 );
+    ensure_printed( "%#.3G", 999.75, 100 );
+
+    // Rounding mode other than to nearest is left to glibc
+    fesetround( FE_UPWARD );
+    ensure_scanned( "0.1" );
+    ensure_printed( "%.3f", 0.1234, 100 );
+    fesetround( FE_TONEAREST );
+
+    // Locale with other decimal point is left to glibc, if such locale is installed
+    if( setlocale( LC_NUMERIC, "de_DE.UTF-8" ) )
+    {
+        ensure_scanned( "1,5" );
+        ensure_scanned( "1.5" );
+        ensure_printed( "%.3f", 1.5, 100 );
+        setlocale( LC_NUMERIC, "C" );
+    }
+}
+
+/**
+ *
+ *  Execute test of random values and strings
+ *
+ */
+static void  random_test( int  n_values )
+{
+    fprintf( stderr, "Running random test...\n" );
+
+    static const char* const  formats[] = {
+        "%g", "%.17g", "%.16g", "%.15g", "%.12g", "%e", "%.3e", "%.10e", "%f", "%.2f", "%.0f", "%.12f",
+        "%+#014.5G", "%-20.8E|"
+    };
+    for( int  i = 0; i < n_values; ++i )
+    {
+        // 1. Print random value with each format
+        double  value = get_random_double();
+        for( size_t  f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f )
+            ensure_printed( formats[f], value, 1200 );
+
+        // 2. Scan strings printed by glibc, and random decimal strings
+        char  str[64];
+        real_snprintf( str, sizeof(str), "%.17g", value );
+        ensure_scanned( str );
+        real_snprintf( str, sizeof(str), "%.9g", value );
+        ensure_scanned( str );
+        uint64_t  bits = get_random_uint64();
+        int  ndigits = 1 + (int)( bits % 20 );
+        char*  p = str;
+        *p++ = (char)( '1' + (bits >> 8) % 9 );
+        *p++ = '.';
+        for( int  d = 1; d < ndigits; ++d )
+            *p++ = (char)( '0' + get_random_uint64() % 10 );
+        sprintf( p, "e%d", (int)( (bits >> 16) % 700 ) - 350 );
+        ensure_scanned( str );
+    }
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main()
+{
+    fprintf( stderr, "Running dconvstr_test_preload, build date " __DATE__ " " __TIME__ "\n" );
+
+    // 1. Find functions of glibc and make sure they are interposed
+    void*  libc = dlopen( "libc.so.6", RTLD_NOW | RTLD_NOLOAD );
+    if( libc )
+    {
+        real_strtod_    = (strtod_function) dlsym( libc, "strtod" );
+        real_strtof_    = (strtof_function) dlsym( libc, "strtof" );
+        real_vsnprintf_ = (vsnprintf_function) dlsym( libc, "vsnprintf" );
+    }
+    if(( real_strtod_ == NULL )||( real_strtof_ == NULL )||( real_vsnprintf_ == NULL ))
+    {
+        fprintf( stderr, "Functions of glibc are not found\n" );
+        return  -1;
+    }
+    if(( dlsym( RTLD_DEFAULT, "strtod" ) == (void*) real_strtod_ )||
+       ( dlsym( RTLD_DEFAULT, "vsnprintf" ) == (void*) real_vsnprintf_ ))
+    {
+        fprintf( stderr, "Interposer is not loaded, run with LD_PRELOAD=./dconvstr_preload.so\n" );
+        return  -1;
+    }
+
+    // 2. Run tests
+    all_static_tests();
+    random_test( 300000 );
+    fprintf( stderr, "Passed\n" );
+    return  0;
+}
@@ -0,0 +1,165 @@
+/*
+ *  Test of printf(3) handlers of glibc backed by dconvstr (dconvstr_printf.h)
+ *  http://www.gurucoding.com/en/dconvstr/
+ *
+ *  Copyright (c) 2014 Mikhail Kupchik <Mikhail.Kupchik@prime-expert.com>
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without modification, are permitted 
+ *  provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *     and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *     and the following disclaimer in the documentation and/or other materials provided with the 
+ *     distribution.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR 
+ *  IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ *  FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+ *  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ *  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ *  OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "dconvstr_printf.h"
+#include "dconvstr.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+
+
+//=====================================================================================================
+//
+// FUNCTIONS
+//
+
+/**
+ *
+ *  Make sure string printed by snprintf() is as expected
+ *
+ */
+static void  ensure_equal( const char*  format, const char*  printed, const char*  expected )
+{
+    if( 0 != strcmp( printed, expected ) )
+    {
+        fprintf( stderr, "Test failed for format `%s': got `%s', expected `%s'\n", format, printed, expected );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute all static tests: formats with exact results, conversions left to glibc and other
+ *  conversions in the same format string
+ *
+ */
+static void  all_static_tests()
+{
+    fprintf( stderr, "Running static tests...\n" );
+
+    char  buf[2048];
+    snprintf( buf, sizeof(buf), "%g|%08.3f|%-10.2e|%+G|%#.0f|% f|%.0f", 0.1, -1.5, 1234.5, 1e-5, 2.5, 0.25, 2.5 );
+    ensure_equal( "float", buf, "0.1|-001.500|1.23e+03  |+1E-05|3.| 0.250000|3" );
+    snprintf( buf, sizeof(buf), "%*.*f|%-*g", 9, 2, 3.14159, 6, 1.5 );
+    ensure_equal( "star", buf, "     3.14|1.5   " );
+    snprintf( buf, sizeof(buf), "%2$.1f|%1$+e", 0.5, 3.14159 );
+    ensure_equal( "positional", buf, "3.1|+5.000000e-01" );
+    snprintf( buf, sizeof(buf), "%d %s %.3e %c %lu %5.1F", 42, "abc", -0.0, 'x', 7UL, 6.25 );
+    ensure_equal( "mixed", buf, "42 abc -0.000e+00 x 7   6.3" );
+    snprintf( buf, sizeof(buf), "%5g|%-+6G|%05f|%Lg|%a", -INFINITY, NAN, INFINITY, 0.1L, 1.0 );
+    ensure_equal( "glibc", buf, " -inf|+NAN  |  inf|0.1|0x1p+0" );
+    snprintf( buf, sizeof(buf), "%.1000f", 1.0 );
+    ensure_equal( "long", buf + 990, "000000000000" );
+
+    // snprintf() returns number of characters which would have been printed
+    volatile size_t  truncated_size = 4;
+    int  n = snprintf( buf, truncated_size, "%.3f", 12.5 );
+    ensure_equal( "truncated", buf, "12." );
+    if( n != 6 )
+    {
+        fprintf( stderr, "Test failed for truncated output: returned %d, expected 6\n", n );
+        exit(-1);
+    }
+}
+
+/**
+ *
+ *  Execute test of random values: snprintf() must give the same result as dconvstr_print()
+ *  with the same format
+ *
+ */
+static void  random_test( int  n_values )
+{
+    fprintf( stderr, "Running random test...\n" );
+
+    static const struct { const char*  format; int  format_char; unsigned int  flags; int  width; int  precision; }  formats[] = {
+        { "%g",        'g', 0,                                                                      0, DCONVSTR_DEFAULT_PRECISION },
+        { "%.17g",     'g', 0,                                                                      0, 17 },
+        { "%e",        'e', 0,                                                                      0, DCONVSTR_DEFAULT_PRECISION },
+        { "%+.3E",     'e', DCONVSTR_FLAG_PRINT_PLUS | DCONVSTR_FLAG_UPPERCASE,                     0, 3  },
+        { "%f",        'f', 0,                                                                      0, DCONVSTR_DEFAULT_PRECISION },
+        { "%#.0f",     'f', DCONVSTR_FLAG_SHARP,                                                    0, 0  },
+        { "%020.10f",  'f', DCONVSTR_FLAG_HAVE_WIDTH | DCONVSTR_FLAG_PAD_WITH_ZERO,                20, 10 },
+        { "%-24.12g",  'g', DCONVSTR_FLAG_HAVE_WIDTH | DCONVSTR_FLAG_LEFT_JUSTIFY,                 24, 12 },
+        { "% #G",      'g', DCONVSTR_FLAG_SPACE_IF_PLUS | DCONVSTR_FLAG_SHARP | DCONVSTR_FLAG_UPPERCASE, 0, DCONVSTR_DEFAULT_PRECISION },
+    };
+    uint64_t  rng_state = 1;
+    for( int  i = 0; i < n_values; ++i )
+    {
+        // 1. Generate random finite double-precision floating point value
+        double  value;
+        do
+        {
+            rng_state = 6364136223846793005ULL * rng_state + 1442695040888963407ULL;
+            uint64_t  raw_value = rng_state ^ (rng_state >> 29);
+            memcpy( &value, &raw_value, sizeof(value) );
+            if( i % 2 )
+                value = ldexp( value, -ilogb( value ) + (int)( raw_value % 64 ) - 20 );
+        }
+        while(! isfinite( value ) );
+
+        // 2. Print value with each format
+        for( int  f = 0; f < (int)( sizeof(formats) / sizeof(formats[0]) ); ++f )
+        {
+            char   printed[400], expected[400];
+            char*  expected_end  = expected;
+            int    expected_size = sizeof(expected) - 1;
+            snprintf( printed, sizeof(printed), formats[f].format, value );
+            if(! dconvstr_print( &expected_end, &expected_size, value, formats[f].format_char, formats[f].flags,
+                                 formats[f].width, formats[f].precision ) )
+            {
+                fprintf( stderr, "dconvstr_print() failed for val=%a\n", value );
+                exit(-1);
+            }
+            *expected_end = 0;
+            ensure_equal( formats[f].format, printed, expected );
+        }
+    }
+}
+
+/**
+ *
+ *  Program entry point
+ *
+ */
+int  main()
+{
+    fprintf( stderr, "Running dconvstr_test_printf, build date " __DATE__ " " __TIME__ "\n" );
+    if(! dconvstr_register_printf_handlers() )
+    {
+        fprintf( stderr, "Failed to install printf handlers\n" );
+        return  -1;
+    }
+    all_static_tests();
+    random_test( 200000 );
+    fprintf( stderr, "Passed\n" );
+    return  0;
+}